@@ -245,6 +245,10 @@ option(INSTALL_PYTHON_SYMLINKS "Install Python .py files as symlinks" OFF)
 
 # For SiconosConfig.h
 option(SICONOS_USE_MAP_FOR_HASH "Prefer std::map to std::unordered_map even if C++xy is enabled" ON)
+option(SICONOS_USE_FLAT_GRAPH "Use contiguous storage (SiconosFlatGraph) instead of boost::adjacency_list for the simulation graphs. Not available with WITH_SERIALIZATION or WITH_PYTHON_WRAPPER (no serialization or SWIG adaptors for SiconosFlatGraph)" OFF)
+if(SICONOS_USE_FLAT_GRAPH AND (WITH_SERIALIZATION OR WITH_PYTHON_WRAPPER))
+  message(FATAL_ERROR "SICONOS_USE_FLAT_GRAPH is not available with serialization or python bindings (set WITH_SERIALIZATION and WITH_PYTHON_WRAPPER to OFF).")
+endif()
 
 # Check Siconos compilation with include-what-you-use
 # See https://github.com/include-what-you-use/include-what-you-use
@@ -123,10 +123,11 @@ endmacro()
 # Add a test into the ctest suite.
 #
 # Usage :
-# new_test(NAME <name> SOURCES <sources list> DEPS <dependencies list> DATA <data files list)
+# new_test(NAME <name> SOURCES <sources list> DEPS <dependencies list> DATA <data files list) [NO_TEST]
 #
 # required : SOURCES
 # others are optional.
+# NO_TEST : build the executable (benchmarks ...) but do not add it to the ctest suite.
 #
 # Process:
 # - Copy data files to binary dir
@@ -138,6 +139,7 @@ endmacro()
 # - add a test (ctest) named <name>. If NAME is not set, use name of first source file (without ext).
 # ========================================
 function(new_test)
+  set(options NO_TEST)
   set(oneValueArgs NAME HDF5)
   set(multiValueArgs SOURCES DATA DEPS)
   cmake_parse_arguments(TEST "${options}" "${oneValueArgs}" "${multiValueArgs}" ${ARGN} )
@@ -248,6 +250,10 @@ function(new_test)
   endif()
 
   # ---- The exe is ready, let's turn to test(s) ----
+  if(TEST_NO_TEST)
+    return()
+  endif()
+
   # -- set test command --
   set(command ${TEST_NAME})
   if(CMAKE_SYSTEM_NAME MATCHES Windows)
@@ -32,6 +32,8 @@ Example : if cmake is executed with WITH_MPI=ON
 // Which version of C++ was used to compile siconos, needed for swig
 //#define SICONOS_CXXVERSION @CXXVERSION@
 #cmakedefine SICONOS_USE_MAP_FOR_HASH
+// simulation graphs with contiguous storage (SiconosFlatGraph)
+#cmakedefine SICONOS_USE_FLAT_GRAPH
 // are int 64 bits longs
 #cmakedefine SICONOS_INT64
 
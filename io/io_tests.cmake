@@ -1,13 +1,22 @@
 include(tools4tests)
 
 if(WITH_TESTING)
-  
-  
+
+  if(WITH_SERIALIZATION OR (HAVE_SICONOS_MECHANICS AND WITH_HDF5))
+    begin_tests(src/test DEPS "CPPUNIT::CPPUNIT")
+  endif()
+
   if(WITH_SERIALIZATION)
     configure_file(${CMAKE_CURRENT_SOURCE_DIR}/src/test/result.ref src/test/result.ref COPYONLY)
-    begin_tests(src/test DEPS "CPPUNIT::CPPUNIT")
     new_test(SOURCES BasicTest.cpp ${SIMPLE_TEST_MAIN})
     new_test(SOURCES KernelTest.cpp ${SIMPLE_TEST_MAIN})
   endif()
-  
+
+  # --- MechanicsHDF5Writer: the file is read back with the HDF5 C API ---
+  if(HAVE_SICONOS_MECHANICS AND WITH_HDF5)
+    find_package(HDF5 REQUIRED COMPONENTS C)
+    new_test(SOURCES MechanicsHDF5WriterTest.cpp ${SIMPLE_TEST_MAIN} DEPS "${HDF5_C_LIBRARIES}")
+    target_include_directories(MechanicsHDF5WriterTest PRIVATE ${HDF5_C_INCLUDE_DIRS})
+  endif()
+
 endif()
@@ -137,10 +137,6 @@ SICONOS_IO_REGISTER(BoundaryCondition,
 SICONOS_IO_REGISTER_WITH_BASES(NewtonImpactNSL,(NonSmoothLaw),
   (_e))
 SICONOS_IO_REGISTER_WITH_BASES(NewtonEuler1DR,(NewtonEulerR),
-  (_AUX1)
-  (_AUX2)
-  (_NPG1)
-  (_NPG2)
   (_Nc)
   (_Pc1)
   (_Pc2)
@@ -496,6 +492,7 @@ SICONOS_IO_REGISTER_WITH_BASES(TimeSteppingDirectProjection,(TimeStepping),
 SICONOS_IO_REGISTER_WITH_BASES(LinearOSNS,(OneStepNSProblem),
   (_M)
   (_keepLambdaAndYState)
+  (_packedMBlocks)
   (_q)
   (_w)
   (_z))
@@ -516,7 +513,9 @@ SICONOS_IO_REGISTER_WITH_BASES(TimeStepping,(Simulation),
   (_computeResiduR)
   (_computeResiduY)
   (_displayNewtonConvergence)
+  (_incrementalIndexSetUpdate)
   (_isNewtonConverge)
+  (_maxApproachVelocity)
   (_newtonCumulativeNbIterations)
   (_newtonMaxIteration)
   (_newtonNbIterations)
@@ -583,9 +582,11 @@ SICONOS_IO_REGISTER(EventsManager,
   (_td))
 SICONOS_IO_REGISTER(OneStepNSProblem,
   (_hasBeenUpdated)
+  (_incrementalAssembly)
   (_indexSetLevel)
   (_inputOutputLevel)
   (_maxSize)
+  (_parallelAssembly)
   (_simulation)
   (_sizeOutput))
 SICONOS_IO_REGISTER(OSNSMatrix,
@@ -601,6 +602,8 @@ SICONOS_IO_REGISTER(BlockCSRMatrix,
   (_diagsize1)
   (_nc)
   (_nr)
+  (_packedBlocks)
+  (_rowInteractions)
   (_sparseBlockStructuredMatrix)
   (colPos)
   (rowPos))
@@ -614,9 +617,11 @@ SICONOS_IO_REGISTER_WITH_BASES(MoreauJeanGOSI,(OneStepIntegrator),
 SICONOS_IO_REGISTER_WITH_BASES(MoreauJeanOSI,(OneStepIntegrator),
   (_explicitNewtonEulerDSOperators)
   (_gamma)
+  (_loopPolicy)
   (_theta)
   (_useGamma)
-  (_useGammaForRelation))
+  (_useGammaForRelation)
+  (_useRigidBodyStateStore))
 SICONOS_IO_REGISTER_WITH_BASES(EulerMoreauOSI,(OneStepIntegrator),
   (_gamma)
   (_theta)
@@ -0,0 +1,408 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "MechanicsHDF5Writer.hpp"
+
+#ifdef WITH_HDF5
+
+#include "SiconosException.hpp"
+#include "SimpleMatrix.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "Topology.hpp"
+#include "Simulation.hpp"
+#include "OneStepNSProblem.hpp"
+#include "SolverOptions.h"
+#include "Friction_cst.h"
+#include "GenericMechanical_cst.h"
+
+#include <hdf5.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+// #define DEBUG_STDOUT
+// #define DEBUG_MESSAGES
+#include "siconos_debug.h"
+
+/* name and number of columns of the datasets, as in mechanics_hdf5 */
+static const char* datasetNames[MechanicsHDF5Writer::NUMBER_OF_OUTPUTS] =
+{ "dynamic", "velocities", "cf", "cf_info", "solv" };
+
+static const hsize_t datasetColumns[MechanicsHDF5Writer::NUMBER_OF_OUTPUTS] =
+{ 9, 8, 26, 5, 4 };
+
+struct MechanicsHDF5Handles
+{
+  hid_t file = -1;
+  hid_t data = -1;
+  hid_t datasets[MechanicsHDF5Writer::NUMBER_OF_OUTPUTS] = { -1, -1, -1, -1, -1 };
+
+  /** number of rows of the datasets in the file */
+  hsize_t rows[MechanicsHDF5Writer::NUMBER_OF_OUTPUTS] = { 0, 0, 0, 0, 0 };
+
+  ~MechanicsHDF5Handles()
+  {
+    for(unsigned int i = 0; i < MechanicsHDF5Writer::NUMBER_OF_OUTPUTS; ++i)
+      if(datasets[i] >= 0) H5Dclose(datasets[i]);
+    if(data >= 0) H5Gclose(data);
+    if(file >= 0) H5Fclose(file);
+  }
+
+  /* append rows at the end of a dataset, return false on error */
+  bool append(unsigned int i, const std::vector<double>& buffer)
+  {
+    hsize_t columns = datasetColumns[i];
+    hsize_t count[2] = { buffer.size() / columns, columns };
+    if(count[0] == 0)
+      return true;
+
+    hsize_t extent[2] = { rows[i] + count[0], columns };
+    if(H5Dset_extent(datasets[i], extent) < 0)
+      return false;
+
+    hid_t filespace = H5Dget_space(datasets[i]);
+    hsize_t start[2] = { rows[i], 0 };
+    H5Sselect_hyperslab(filespace, H5S_SELECT_SET, start, NULL, count, NULL);
+    hid_t memspace = H5Screate_simple(2, count, NULL);
+    herr_t status = H5Dwrite(datasets[i], H5T_NATIVE_DOUBLE, memspace, filespace,
+                             H5P_DEFAULT, buffer.data());
+    H5Sclose(memspace);
+    H5Sclose(filespace);
+    if(status < 0)
+      return false;
+    rows[i] += count[0];
+    return true;
+  }
+};
+
+MechanicsHDF5Writer::MechanicsHDF5Writer(const std::string& filename,
+                                         int dimension,
+                                         unsigned int compression,
+                                         unsigned int chunkRows):
+  _dimension(dimension), _h5(new MechanicsHDF5Handles()),
+  _front(NUMBER_OF_OUTPUTS), _back(NUMBER_OF_OUTPUTS),
+  _pending(false), _stop(false)
+{
+  if(dimension != 2 && dimension != 3)
+    THROW_EXCEPTION("MechanicsHDF5Writer - the dimension must be 2 or 3");
+  if(chunkRows == 0)
+    THROW_EXCEPTION("MechanicsHDF5Writer - the chunks must have at least one row");
+
+  MechanicsHDF5Handles& h5 = *_h5;
+  if(std::ifstream(filename).good())
+    h5.file = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+  else
+    h5.file = H5Fcreate(filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  if(h5.file < 0)
+    THROW_EXCEPTION("MechanicsHDF5Writer - cannot open " + filename);
+
+  if(H5Lexists(h5.file, "data", H5P_DEFAULT) > 0)
+    h5.data = H5Gopen2(h5.file, "data", H5P_DEFAULT);
+  else
+    h5.data = H5Gcreate2(h5.file, "data", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+  if(h5.data < 0)
+    THROW_EXCEPTION("MechanicsHDF5Writer - cannot open the group data of " + filename);
+
+  for(unsigned int i = 0; i < NUMBER_OF_OUTPUTS; ++i)
+  {
+    hsize_t columns = datasetColumns[i];
+    if(H5Lexists(h5.data, datasetNames[i], H5P_DEFAULT) > 0)
+    {
+      // append to the existing dataset
+      h5.datasets[i] = H5Dopen2(h5.data, datasetNames[i], H5P_DEFAULT);
+      if(h5.datasets[i] < 0)
+        THROW_EXCEPTION(std::string("MechanicsHDF5Writer - cannot open the dataset ")
+                        + datasetNames[i]);
+      hid_t space = H5Dget_space(h5.datasets[i]);
+      hsize_t dims[2] = { 0, 0 };
+      int rank = H5Sget_simple_extent_dims(space, dims, NULL);
+      H5Sclose(space);
+      if(rank != 2 || dims[1] != columns)
+        THROW_EXCEPTION(std::string("MechanicsHDF5Writer - unexpected shape of the dataset ")
+                        + datasetNames[i]);
+      h5.rows[i] = dims[0];
+    }
+    else
+    {
+      hsize_t dims[2] = { 0, columns };
+      hsize_t maxdims[2] = { H5S_UNLIMITED, columns };
+      hsize_t chunk[2] = { chunkRows, columns };
+      hid_t space = H5Screate_simple(2, dims, maxdims);
+      hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+      H5Pset_chunk(dcpl, 2, chunk);
+      if(compression > 0)
+        H5Pset_deflate(dcpl, std::min(compression, 9u));
+      h5.datasets[i] = H5Dcreate2(h5.data, datasetNames[i], H5T_NATIVE_DOUBLE,
+                                  space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+      H5Pclose(dcpl);
+      H5Sclose(space);
+      if(h5.datasets[i] < 0)
+        THROW_EXCEPTION(std::string("MechanicsHDF5Writer - cannot create the dataset ")
+                        + datasetNames[i]);
+    }
+  }
+
+  _worker = std::thread(&MechanicsHDF5Writer::work, this);
+}
+
+MechanicsHDF5Writer::~MechanicsHDF5Writer()
+{
+  try
+  {
+    flush();
+  }
+  catch(...)
+  {
+    // a destructor must not throw, the error has been reported by the
+    // worker and the file is closed anyway.
+  }
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stop = true;
+  }
+  _condition.notify_all();
+  if(_worker.joinable())
+    _worker.join();
+}
+
+void MechanicsHDF5Writer::work()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  while(true)
+  {
+    _condition.wait(lock, [this] { return _pending || _stop; });
+    if(!_pending)
+      break;
+
+    // the back buffers belong to this thread until _pending is reset.
+    lock.unlock();
+    std::string error;
+    for(unsigned int i = 0; i < NUMBER_OF_OUTPUTS; ++i)
+    {
+      if(!_h5->append(i, _back[i]) && error.empty())
+        error = std::string("MechanicsHDF5Writer - cannot write the dataset ")
+                + datasetNames[i];
+      _back[i].clear();
+    }
+    lock.lock();
+
+    if(_error.empty())
+      _error = error;
+    _pending = false;
+    _condition.notify_all();
+  }
+}
+
+void MechanicsHDF5Writer::wait()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _condition.wait(lock, [this] { return !_pending; });
+  if(!_error.empty())
+    THROW_EXCEPTION(_error);
+}
+
+void MechanicsHDF5Writer::commit()
+{
+  DEBUG_BEGIN("MechanicsHDF5Writer::commit()\n");
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // the cleared back buffers keep their capacity for the next step.
+    std::swap(_front, _back);
+    _pending = true;
+  }
+  _condition.notify_all();
+  DEBUG_END("MechanicsHDF5Writer::commit()\n");
+}
+
+void MechanicsHDF5Writer::flush()
+{
+  commit();
+  wait();
+  // the worker is idle: the file can be used from this thread.
+  H5Fflush(_h5->file, H5F_SCOPE_LOCAL);
+}
+
+bool MechanicsHDF5Writer::isLibraryThreadsafe()
+{
+  hbool_t threadsafe = 0;
+  H5is_library_threadsafe(&threadsafe);
+  return threadsafe > 0;
+}
+
+std::string MechanicsHDF5Writer::libraryVersion()
+{
+  unsigned int major = 0, minor = 0, release = 0;
+  H5get_libversion(&major, &minor, &release);
+  return std::to_string(major) + "." + std::to_string(minor) + "."
+         + std::to_string(release);
+}
+
+void MechanicsHDF5Writer::appendRow(Output output, double time,
+                                    const double* row, unsigned int size)
+{
+  std::vector<double>& buffer = _front[output];
+  unsigned int columns = datasetColumns[output] - 1;
+  unsigned int n = std::min(size, columns);
+  buffer.push_back(time);
+  buffer.insert(buffer.end(), row, row + n);
+  buffer.insert(buffer.end(), columns - n, 0.0);
+}
+
+void MechanicsHDF5Writer::appendRows(Output output, double time,
+                                     const SimpleMatrix& m)
+{
+  unsigned int rows = m.size(0);
+  unsigned int columns = m.size(1);
+  _scratch.resize(columns);
+  for(unsigned int i = 0; i < rows; ++i)
+  {
+    for(unsigned int j = 0; j < columns; ++j)
+      _scratch[j] = m(i, j);
+    appendRow(output, time, _scratch.data(), columns);
+  }
+}
+
+void MechanicsHDF5Writer::outputDynamicObjects(double time,
+                                               const NonSmoothDynamicalSystem& nsds)
+{
+  unsigned int rows = nsds.getNumberOfDS();
+  if(rows == 0)
+    return;
+  // the rows are as wide as the largest q, the dataset keeps the
+  // first columns.
+  unsigned int columns = std::max((_dimension == 3) ? 8u : 4u,
+                                  _io.positionsColumns(nsds));
+  _scratch.resize(rows * columns);
+  rows = _io.positions(nsds, _scratch.data(), rows, columns);
+
+  for(unsigned int i = 0; i < rows; ++i)
+  {
+    const double* p = &_scratch[i * columns];
+    if(_dimension == 3)
+      appendRow(DYNAMIC, time, p, columns);
+    else
+    {
+      // id, x, y, theta: the rotation is written as a quaternion
+      double row[8] = { p[0], p[1], p[2], 0.,
+                        cos(p[3] / 2.0), 0., 0., sin(p[3] / 2.0)
+                      };
+      appendRow(DYNAMIC, time, row, 8);
+    }
+  }
+}
+
+void MechanicsHDF5Writer::outputVelocities(double time,
+                                           const NonSmoothDynamicalSystem& nsds)
+{
+  unsigned int rows = nsds.getNumberOfDS();
+  if(rows == 0)
+    return;
+  unsigned int columns = std::max((_dimension == 3) ? 7u : 4u,
+                                  _io.velocitiesColumns(nsds));
+  _scratch.resize(rows * columns);
+  rows = _io.velocities(nsds, _scratch.data(), rows, columns);
+
+  for(unsigned int i = 0; i < rows; ++i)
+  {
+    const double* v = &_scratch[i * columns];
+    if(_dimension == 3)
+      appendRow(VELOCITIES, time, v, columns);
+    else
+    {
+      double row[7] = { v[0], v[1], v[2], 0., 0., 0., v[3] };
+      appendRow(VELOCITIES, time, row, 7);
+    }
+  }
+}
+
+unsigned int MechanicsHDF5Writer::outputContactForces(double time,
+    const NonSmoothDynamicalSystem& nsds, unsigned int index_set)
+{
+  if(nsds.topology()->indexSetsSize() <= index_set)
+    return 0;
+
+  SP::SimpleMatrix contactPoints = _io.contactPoints(nsds, index_set);
+  unsigned int rows = contactPoints->size(0);
+  if(_dimension == 3)
+    appendRows(CF, time, *contactPoints);
+  else
+  {
+    // the 2D components are placed in the 3D layout, as in mechanics_run
+    static const unsigned int columns2d[18] =
+    { 0, 1, 2, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17, 19, 20, 22, 23, 24 };
+    const SimpleMatrix& m = *contactPoints;
+    unsigned int columns = std::min(18u, (unsigned int)m.size(1));
+    for(unsigned int i = 0; i < rows; ++i)
+    {
+      double row[25] = { 0. };
+      for(unsigned int j = 0; j < columns; ++j)
+        row[columns2d[j]] = m(i, j);
+      appendRow(CF, time, row, 25);
+    }
+  }
+  return rows;
+}
+
+unsigned int MechanicsHDF5Writer::outputContactInfo(double time,
+    const NonSmoothDynamicalSystem& nsds, unsigned int index_set)
+{
+  if(nsds.topology()->indexSetsSize() <= index_set)
+    return 0;
+
+  SP::SimpleMatrix contactInfo = _io.contactInfo(nsds, index_set);
+  appendRows(CF_INFO, time, *contactInfo);
+  return contactInfo->size(0);
+}
+
+void MechanicsHDF5Writer::outputSolverInfos(double time,
+                                            const SolverOptions& options)
+{
+  double iterations = options.iparam[SICONOS_IPARAM_ITER_DONE];
+  double precision = options.dparam[SICONOS_DPARAM_RESIDU];
+  double localPrecision = precision;
+  if(options.solverId == SICONOS_GENERIC_MECHANICAL_NSGS)
+    localPrecision = options.dparam[3];
+  else if(options.solverId == SICONOS_FRICTION_3D_NSGS)
+    localPrecision = 0.;
+
+  double row[3] = { iterations, precision, localPrecision };
+  appendRow(SOLV, time, row, 3);
+}
+
+void MechanicsHDF5Writer::outputResults(Simulation& simulation,
+                                        bool contactForces, bool contactInfo)
+{
+  double time = simulation.nextTime();
+  const NonSmoothDynamicalSystem& nsds = *simulation.nonSmoothDynamicalSystem();
+
+  outputDynamicObjects(time, nsds);
+  outputVelocities(time, nsds);
+  if(contactForces)
+    outputContactForces(time, nsds);
+  if(contactInfo)
+    outputContactInfo(time, nsds);
+  if(simulation.numberOfOSNSProblems() > 0 && (*simulation.oneStepNSProblems())[0])
+  {
+    SP::SolverOptions options = simulation.oneStepNSProblem(0)->numericsSolverOptions();
+    if(options)
+      outputSolverInfos(time, *options);
+  }
+}
+
+#endif
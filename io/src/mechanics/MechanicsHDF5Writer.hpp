@@ -0,0 +1,201 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file MechanicsHDF5Writer.hpp
+  \brief streaming of the mechanics simulation output to HDF5
+*/
+
+#ifndef MechanicsHDF5Writer_hpp
+#define MechanicsHDF5Writer_hpp
+
+#include "SiconosConfig.h"
+
+#ifdef WITH_HDF5
+
+#include "MechanicsIO.hpp"
+#include <SiconosPointers.hpp>
+#include <SiconosFwd.hpp>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct MechanicsHDF5Handles;
+
+/** \brief Appends the output of a mechanics simulation to the datasets
+ *  of an HDF5 file, with the layout read by siconos.io.mechanics_hdf5.
+ *
+ *  The rows of a time step are collected by the output* functions, then
+ *  commit() hands them to a background thread that extends the
+ *  datasets, compresses and writes the chunks while the next time step
+ *  is computed. There are two buffers: commit() waits only if the
+ *  writing of the previous step is not finished.
+ *
+ *  The datasets of the group /data (dynamic, velocities, cf, cf_info
+ *  and solv) are created when they do not exist. If the file is also
+ *  open with another handle of the process (for instance h5py), both
+ *  must use the same HDF5 library, which then shares the open file, and
+ *  the other handle must only be used after wait(). If the HDF5 library
+ *  is not thread-safe (see isLibraryThreadsafe()), no HDF5 function
+ *  may be called by the other threads while the rows are written.
+ */
+class MechanicsHDF5Writer
+{
+public:
+
+  /** the datasets of /data that are written */
+  enum Output { DYNAMIC, VELOCITIES, CF, CF_INFO, SOLV, NUMBER_OF_OUTPUTS };
+
+protected:
+
+  /** the buffers of the rows of a time step, one for each output */
+  typedef std::vector<std::vector<double> > Buffers;
+
+  MechanicsIO _io;
+
+  /** dimension of the simulation (2 or 3) */
+  int _dimension;
+
+  /** the file and the datasets, only used by the background thread
+   * after the construction */
+  std::unique_ptr<MechanicsHDF5Handles> _h5;
+
+  /** the rows collected for the current time step */
+  Buffers _front;
+
+  /** the rows written by the background thread */
+  Buffers _back;
+
+  /** temporary storage of a result of MechanicsIO */
+  std::vector<double> _scratch;
+
+  std::thread _worker;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _pending;
+  bool _stop;
+
+  /** the first error of the background thread */
+  std::string _error;
+
+  void work();
+
+  /** append a row to the front buffer of an output
+   * \param output the dataset
+   * \param time the time of the row
+   * \param row the values after the time column
+   * \param size the number of values
+   */
+  void appendRow(Output output, double time, const double* row,
+                 unsigned int size);
+
+  /** append the rows of a matrix
+   * \param output the dataset
+   * \param time the time of the rows
+   * \param m the matrix
+   */
+  void appendRows(Output output, double time, const SimpleMatrix& m);
+
+public:
+
+  /** open or create an HDF5 file
+   * \param filename the name of the file
+   * \param dimension 2 or 3, the output of a 2D simulation is converted to
+   *        the 3D layout as in mechanics_run
+   * \param compression gzip level of the chunks, 0 for no compression
+   * \param chunkRows number of rows of a chunk
+   */
+  MechanicsHDF5Writer(const std::string& filename, int dimension = 3,
+                      unsigned int compression = 0,
+                      unsigned int chunkRows = 4000);
+
+  /** write the pending rows and close the file */
+  virtual ~MechanicsHDF5Writer();
+
+  /** collect the positions of the dynamical systems
+   * \param time the current time
+   * \param nsds current nonsmooth dynamical system
+   */
+  void outputDynamicObjects(double time, const NonSmoothDynamicalSystem& nsds);
+
+  /** collect the velocities of the dynamical systems
+   * \param time the current time
+   * \param nsds current nonsmooth dynamical system
+   */
+  void outputVelocities(double time, const NonSmoothDynamicalSystem& nsds);
+
+  /** collect the contact points
+   * \param time the current time
+   * \param nsds current nonsmooth dynamical system
+   * \param index_set the index set of the contacts
+   * \return the number of contacts
+   */
+  unsigned int outputContactForces(double time,
+                                   const NonSmoothDynamicalSystem& nsds,
+                                   unsigned int index_set = 1);
+
+  /** collect the contact information
+   * \param time the current time
+   * \param nsds current nonsmooth dynamical system
+   * \param index_set the index set of the contacts
+   * \return the number of contacts
+   */
+  unsigned int outputContactInfo(double time,
+                                 const NonSmoothDynamicalSystem& nsds,
+                                 unsigned int index_set = 1);
+
+  /** collect the number of iterations and the precision of the solver
+   * \param time the current time
+   * \param options the options of the solver after the solve
+   */
+  void outputSolverInfos(double time, const SolverOptions& options);
+
+  /** collect all the outputs of a time step of a simulation
+   * \param simulation the simulation
+   * \param contactForces output the contact points
+   * \param contactInfo output the contact information
+   */
+  void outputResults(Simulation& simulation,
+                     bool contactForces = true, bool contactInfo = false);
+
+  /** send the rows of the time step to the background thread */
+  void commit();
+
+  /** wait for the end of the writing of the committed rows. The file
+   *  can then be used by another handle until the next commit().
+   */
+  void wait();
+
+  /** write all the rows and flush the file */
+  void flush();
+
+  /** \return true if the HDF5 library is built with thread-safety, so
+   *  that other threads may call HDF5 while the rows are written
+   */
+  static bool isLibraryThreadsafe();
+
+  /** \return the version of the HDF5 library, as "major.minor.release" */
+  static std::string libraryVersion();
+};
+
+#endif
+
+#endif
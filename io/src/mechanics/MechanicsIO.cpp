@@ -42,6 +42,11 @@ DUMMY(Bullet2d3DR, Lagrangian2d3DR);
 #include <Contact2dR.hpp>
 #include <Contact2d3DR.hpp>
 #include <BodyShapeRecord.hpp>
+#include <RigidBodyStateStore.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
 
 #define OCC_CLASSES() \
   REGISTER(OccBody) \
@@ -140,31 +145,48 @@ DUMMY(MBTB_ContactRelation, NewtonEuler1DR);
 
 using namespace Experimental;
 
+/* The getters write a row of the output at data[0], data[stride],
+ * data[2*stride], ... When data is null, only the size of the row is
+ * computed. */
 struct GetPosition : public SiconosVisitor
 {
 
-  SP::SiconosVector result;
+  double* data = nullptr;
+  unsigned int stride = 1;
+  unsigned int size = 0;
 
   template<typename T>
   void operator()(const T& ds)
   {
-    result.reset(new SiconosVector(1+ds.q()->size()));
-    result->setValue(0, ds.number());
-    result->setBlock(1, *ds.q());
+    const SiconosVector& q = *ds.q();
+    size = 1 + q.size();
+    if(data)
+    {
+      data[0] = ds.number();
+      for(unsigned int i = 0; i < q.size(); ++i)
+        data[(i + 1) * stride] = q(i);
+    }
   }
 };
 
 struct GetVelocity : public SiconosVisitor
 {
 
-  SP::SiconosVector result;
+  double* data = nullptr;
+  unsigned int stride = 1;
+  unsigned int size = 0;
 
   template<typename T>
   void operator()(const T& ds)
   {
-    result.reset(new SiconosVector(1+ds.velocity()->size()));
-    result->setValue(0, ds.number());
-    result->setBlock(1, *ds.velocity());
+    const SiconosVector& v = *ds.velocity();
+    size = 1 + v.size();
+    if(data)
+    {
+      data[0] = ds.number();
+      for(unsigned int i = 0; i < v.size(); ++i)
+        data[(i + 1) * stride] = v(i);
+    }
   }
 };
 
@@ -667,20 +689,81 @@ void ContactPointDomainVisitor::operator()(const NewtonEuler3DR& rel)
 }
 
 template<typename T, typename G>
-SP::SimpleMatrix MechanicsIO::visitAllVerticesForVector(const G& graph) const
+unsigned int MechanicsIO::columnsForVector(const G& graph) const
+{
+  unsigned int columns = 0;
+  typename G::VIterator vi, viend;
+  for(std::tie(vi,viend)=graph.vertices(); vi!=viend; ++vi)
+  {
+    T getter;
+    graph.bundle(*vi)->accept(getter);
+    columns = std::max(columns, getter.size);
+  }
+  return columns;
+}
+
+template<typename T, typename G>
+void MechanicsIO::writeAllVerticesForVector(const G& graph, double* data,
+                                            unsigned int rowStride,
+                                            unsigned int colStride) const
 {
-  SP::SimpleMatrix result(new SimpleMatrix());
   typename G::VIterator vi, viend;
   unsigned int current_row;
   for(current_row=0,std::tie(vi,viend)=graph.vertices();
       vi!=viend; ++vi, ++current_row)
   {
     T getter;
+    getter.data = data + current_row * rowStride;
+    getter.stride = colStride;
     graph.bundle(*vi)->accept(getter);
-    const SiconosVector& data = *getter.result;
-    result->resize(current_row+1, data.size());
-    result->setRow(current_row, data);
   }
+}
+
+template<typename T, typename G>
+SP::SimpleMatrix MechanicsIO::visitAllVerticesForVector(const G& graph) const
+{
+  // a sizing pass, then the rows are written in place: the matrix is
+  // allocated once and is column major.
+  unsigned int rows = graph.vertices_number();
+  unsigned int columns = columnsForVector<T>(graph);
+  SP::SimpleMatrix result(new SimpleMatrix(rows, columns));
+  if(rows > 0 && columns > 0)
+    writeAllVerticesForVector<T>(graph, result->getArray(), 1, rows);
+  return result;
+}
+
+template<typename T, typename G>
+unsigned int MechanicsIO::visitAllVerticesForVector(const G& graph,
+                                                    double* buffer,
+                                                    int rows, int cols) const
+{
+  unsigned int n = graph.vertices_number();
+  unsigned int columns = columnsForVector<T>(graph);
+  if(rows < 0 || cols < 0 || (unsigned int)rows < n || (unsigned int)cols < columns)
+    THROW_EXCEPTION("MechanicsIO - the buffer is too small, "
+                    + std::to_string(n) + "x" + std::to_string(columns)
+                    + " values are needed");
+  // the buffer is row major, the columns that are not written are zeroed.
+  std::fill(buffer, buffer + n * cols, 0.0);
+  writeAllVerticesForVector<T>(graph, buffer, cols, 1);
+  return n;
+}
+
+/* copy rows of possibly different sizes in a matrix allocated once, the
+ * shorter rows are completed with zeros */
+static SP::SimpleMatrix rowsToMatrix(const std::vector<SiconosVector>& rows)
+{
+  unsigned int n = rows.size();
+  unsigned int columns = 0;
+  for(unsigned int i = 0; i < n; ++i)
+    columns = std::max(columns, (unsigned int)rows[i].size());
+  SP::SimpleMatrix result(new SimpleMatrix(n, columns));
+  if(n == 0 || columns == 0)
+    return result;
+  double* data = result->getArray();
+  for(unsigned int i = 0; i < n; ++i)
+    for(unsigned int j = 0; j < rows[i].size(); ++j)
+      data[i + j * n] = rows[i](j);
   return result;
 }
 
@@ -713,6 +796,47 @@ SP::SimpleMatrix MechanicsIO::positions(const NonSmoothDynamicalSystem& nsds) co
 };
 
 
+unsigned int MechanicsIO::positions(const NonSmoothDynamicalSystem& nsds,
+                                    double* buffer, int rows, int cols) const
+{
+  typedef
+  Visitor < Classes < LagrangianDS, NewtonEulerDS >,
+          GetPosition >::Make Getter;
+
+  return visitAllVerticesForVector<Getter>
+         (*(nsds.topology()->dSG(0)), buffer, rows, cols);
+}
+
+unsigned int MechanicsIO::positionsColumns(const NonSmoothDynamicalSystem& nsds) const
+{
+  typedef
+  Visitor < Classes < LagrangianDS, NewtonEulerDS >,
+          GetPosition >::Make Getter;
+
+  return columnsForVector<Getter>(*(nsds.topology()->dSG(0)));
+}
+
+
+SP::SimpleMatrix MechanicsIO::positions(const RigidBodyStateStore& store) const
+{
+  unsigned int n = store.size();
+  SP::SimpleMatrix result(new SimpleMatrix(n, 8));
+  if(n == 0)
+    return result;
+
+  // the matrix is column major: one contiguous copy per component.
+  double* id = result->getArray(0, 0);
+  for(unsigned int i = 0; i < n; ++i)
+    id[i] = store.body(i)->number();
+  for(unsigned int c = 0; c < 7; ++c)
+  {
+    const double* qc = store.q(c);
+    std::copy(qc, qc + n, result->getArray(0, c + 1));
+  }
+  return result;
+}
+
+
 SP::SimpleMatrix MechanicsIO::velocities(const NonSmoothDynamicalSystem& nsds) const
 {
   typedef
@@ -723,6 +847,26 @@ SP::SimpleMatrix MechanicsIO::velocities(const NonSmoothDynamicalSystem& nsds) c
          (*nsds.topology()->dSG(0));
 }
 
+unsigned int MechanicsIO::velocities(const NonSmoothDynamicalSystem& nsds,
+                                     double* buffer, int rows, int cols) const
+{
+  typedef
+  Visitor < Classes < LagrangianDS, NewtonEulerDS >,
+          GetVelocity>::Make Getter;
+
+  return visitAllVerticesForVector<Getter>
+         (*nsds.topology()->dSG(0), buffer, rows, cols);
+}
+
+unsigned int MechanicsIO::velocitiesColumns(const NonSmoothDynamicalSystem& nsds) const
+{
+  typedef
+  Visitor < Classes < LagrangianDS, NewtonEulerDS >,
+          GetVelocity>::Make Getter;
+
+  return columnsForVector<Getter>(*nsds.topology()->dSG(0));
+}
+
 SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds,
     unsigned int index_set) const
 {
@@ -732,11 +876,11 @@ SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds
   {
     InteractionsGraph& graph =
       *nsds.topology()->indexSet(index_set);
-    unsigned int current_row;
-    result->resize(graph.vertices_number(), 25);
 
-    int data_size =0;
-    for(current_row=0, std::tie(vi,viend) = graph.vertices();
+    // the rows are collected, then copied in a matrix allocated once.
+    std::vector<SiconosVector> rows;
+    rows.reserve(graph.vertices_number());
+    for(std::tie(vi,viend) = graph.vertices();
         vi!=viend; ++vi)
     {
       DEBUG_PRINTF("process interaction : %p\n", &*graph.bundle(*vi));
@@ -756,7 +900,7 @@ SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds
       inspector.inter = graph.bundle(*vi);
       graph.bundle(*vi)->relation()->accept(inspector);
       SiconosVector& data = inspector.answer;
-      data_size = data.size();
+      unsigned int data_size = data.size();
 
       if(data_size ==0)
       {
@@ -774,16 +918,11 @@ SP::SimpleMatrix MechanicsIO::contactPoints(const NonSmoothDynamicalSystem& nsds
         data.setValue(data_size, ds1.number());
         data.setValue(data_size+1, ds2.number());
         DEBUG_EXPR(data.display(););
-        if(result->size(1) != data.size())
-        {
-          result->resize(graph.vertices_number(), data.size());
-        }
-        result->setRow(current_row++, data);
-        data_size +=2;
+        rows.push_back(data);
       }
 
     }
-    result->resize(current_row, data_size);
+    result = rowsToMatrix(rows);
     DEBUG_EXPR(result->display(););
   }
 
@@ -799,11 +938,11 @@ SP::SimpleMatrix MechanicsIO::contactInfo(const NonSmoothDynamicalSystem& nsds,
   {
     InteractionsGraph& graph =
       *nsds.topology()->indexSet(index_set);
-    unsigned int current_row;
-    result->resize(graph.vertices_number(), 25);
 
-    int data_size =0;
-    for(current_row=0, std::tie(vi,viend) = graph.vertices();
+    // the rows are collected, then copied in a matrix allocated once.
+    std::vector<SiconosVector> rows;
+    rows.reserve(graph.vertices_number());
+    for(std::tie(vi,viend) = graph.vertices();
         vi!=viend; ++vi)
     {
       DEBUG_PRINTF("process interaction : %p\n", &*graph.bundle(*vi));
@@ -819,9 +958,8 @@ SP::SimpleMatrix MechanicsIO::contactInfo(const NonSmoothDynamicalSystem& nsds,
       inspector.inter = graph.bundle(*vi);
       graph.bundle(*vi)->relation()->accept(inspector);
       SiconosVector& data = inspector.answer;
-      data_size = data.size();
 
-      if(data_size ==0)
+      if(data.size() ==0)
       {
         // Nothing is done since the relation does not appear as a relation
         // related to a contact points (perhaps a joint)
@@ -835,15 +973,11 @@ SP::SimpleMatrix MechanicsIO::contactInfo(const NonSmoothDynamicalSystem& nsds,
         DynamicalSystem& ds2 = *graph.properties(*vi).target;
         data.setValue(1, ds1.number());
         data.setValue(2, ds2.number());
+        rows.push_back(data);
       }
-      if(result->size(1) != data.size())
-      {
-        result->resize(graph.vertices_number(), data.size());
-      }
-      result->setRow(current_row++, data);
 
     }
-    result->resize(current_row, data_size);
+    result = rowsToMatrix(rows);
     DEBUG_EXPR(result->display(););
 
   }
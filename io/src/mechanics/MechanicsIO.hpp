@@ -30,9 +30,21 @@ class MechanicsIO
 {
 protected:
 
+  template<typename T, typename G>
+  unsigned int columnsForVector(const G& graph) const;
+
+  template<typename T, typename G>
+  void writeAllVerticesForVector(const G& graph, double* data,
+                                 unsigned int rowStride,
+                                 unsigned int colStride) const;
+
   template<typename T, typename G>
   SP::SimpleMatrix visitAllVerticesForVector(const G& graph) const;
 
+  template<typename T, typename G>
+  unsigned int visitAllVerticesForVector(const G& graph, double* buffer,
+                                         int rows, int cols) const;
+
   template<typename T, typename G>
   SP::SiconosVector visitAllVerticesForDouble(const G& graph) const;
 
@@ -50,6 +62,35 @@ public:
    */
   SP::SimpleMatrix positions(const NonSmoothDynamicalSystem& nsds) const;
 
+  /** write all positions, in the format of positions(nsds), into a
+   * row major buffer (for instance a numpy array), without any
+   * intermediate matrix. The columns of a row that are not used are
+   * set to zero.
+   * \param nsds current nonsmooth dynamical system
+   * \param buffer the data of the buffer
+   * \param rows the number of rows of the buffer, at least the number
+   *        of dynamical systems
+   * \param cols the number of columns of the buffer
+   * \return the number of rows written
+   */
+  unsigned int positions(const NonSmoothDynamicalSystem& nsds,
+                         double* buffer, int rows, int cols) const;
+
+  /** get the number of columns of positions(nsds), i.e. the size of the
+   * largest q plus one
+   * \param nsds current nonsmooth dynamical system
+   * \return the number of columns
+   */
+  unsigned int positionsColumns(const NonSmoothDynamicalSystem& nsds) const;
+
+  /** get the positions of the bodies of a store, in the same format as
+   * positions(nsds). The store must have been gathered.
+   * \param store the bodies
+   * \return a SP::SimpleMatrix where the columns are
+   *          id, x, y, z, qw, qx, qy, qz
+   */
+  SP::SimpleMatrix positions(const RigidBodyStateStore& store) const;
+
   /** get all velocities: translation (xdot, ydot, zdot) + orientation velocities
    * ox, oy, oz
    * \param nsds current nonsmooth dynamical system
@@ -59,6 +100,23 @@ public:
    */
   SP::SimpleMatrix velocities(const NonSmoothDynamicalSystem& nsds) const;
 
+  /** write all velocities, in the format of velocities(nsds), into a
+   * row major buffer, see positions(nsds, buffer, rows, cols)
+   * \param nsds current nonsmooth dynamical system
+   * \param buffer the data of the buffer
+   * \param rows the number of rows of the buffer
+   * \param cols the number of columns of the buffer
+   * \return the number of rows written
+   */
+  unsigned int velocities(const NonSmoothDynamicalSystem& nsds,
+                          double* buffer, int rows, int cols) const;
+
+  /** get the number of columns of velocities(nsds)
+   * \param nsds current nonsmooth dynamical system
+   * \return the number of columns
+   */
+  unsigned int velocitiesColumns(const NonSmoothDynamicalSystem& nsds) const;
+
   /** get the coordinates of all contact points, normals, reactions and velocities
    * \param nsds current nonsmooth dynamical system
    * \param index_set the index set number.
@@ -0,0 +1,252 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "MechanicsHDF5WriterTest.hpp"
+#include "MechanicsHDF5Writer.hpp"
+#include "SiconosKernel.hpp"
+#include "SolverOptions.h"
+#include "Friction_cst.h"
+
+#include <hdf5.h>
+
+#include <cstdio>
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(MechanicsHDF5WriterTest);
+
+namespace
+{
+const char* filename = "MechanicsHDF5WriterTest.hdf5";
+const unsigned int nbBodies = 3;
+
+/* rigid bodies whose position and velocity depend on the step */
+SP::NonSmoothDynamicalSystem buildBodies(std::vector<SP::NewtonEulerDS>& bodies)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0.0, 1.0));
+  SP::SimpleMatrix inertia(new SimpleMatrix(3, 3));
+  inertia->eye();
+  for(unsigned int i = 0; i < nbBodies; ++i)
+  {
+    SP::SiconosVector q(new SiconosVector(7));
+    (*q)(3) = 1.0;
+    SP::SiconosVector v(new SiconosVector(6));
+    SP::NewtonEulerDS body(new NewtonEulerDS(q, v, 1.0, inertia));
+    nsds->insertDynamicalSystem(body);
+    bodies.push_back(body);
+  }
+  return nsds;
+}
+
+void setStep(std::vector<SP::NewtonEulerDS>& bodies, unsigned int step)
+{
+  for(unsigned int i = 0; i < bodies.size(); ++i)
+  {
+    (*bodies[i]->q())(0) = 10.0 * step + i;
+    (*bodies[i]->twist())(2) = -1.0 * step - i;
+  }
+}
+
+/* the content of a dataset of /data */
+std::vector<double> readDataset(const char* name, hsize_t dims[2])
+{
+  hid_t file = H5Fopen(filename, H5F_ACC_RDONLY, H5P_DEFAULT);
+  CPPUNIT_ASSERT(file >= 0);
+  hid_t dataset = H5Dopen2(file, (std::string("data/") + name).c_str(), H5P_DEFAULT);
+  CPPUNIT_ASSERT(dataset >= 0);
+  hid_t space = H5Dget_space(dataset);
+  CPPUNIT_ASSERT_EQUAL(2, H5Sget_simple_extent_dims(space, dims, NULL));
+  std::vector<double> values(dims[0] * dims[1]);
+  if(!values.empty())
+    CPPUNIT_ASSERT(H5Dread(dataset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL,
+                           H5P_DEFAULT, values.data()) >= 0);
+  H5Sclose(space);
+  H5Dclose(dataset);
+  H5Fclose(file);
+  return values;
+}
+
+/* write the positions, velocities and solver infos of some steps */
+void writeSteps(unsigned int first, unsigned int last, unsigned int compression)
+{
+  std::vector<SP::NewtonEulerDS> bodies;
+  SP::NonSmoothDynamicalSystem nsds = buildBodies(bodies);
+  SolverOptions* options = solver_options_create(SICONOS_FRICTION_3D_NSGS);
+
+  // small chunks: the datasets are extended over several chunks
+  MechanicsHDF5Writer writer(filename, 3, compression, 4);
+  for(unsigned int step = first; step < last; ++step)
+  {
+    setStep(bodies, step);
+    options->iparam[SICONOS_IPARAM_ITER_DONE] = step;
+    writer.outputDynamicObjects(0.1 * step, *nsds);
+    writer.outputVelocities(0.1 * step, *nsds);
+    writer.outputSolverInfos(0.1 * step, *options);
+    writer.commit();
+  }
+  solver_options_delete(options);
+  // the destructor writes the last step
+}
+
+/* check the rows of the steps [0, steps) */
+void checkSteps(unsigned int steps)
+{
+  hsize_t dims[2];
+  std::vector<double> dynamic = readDataset("dynamic", dims);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)(steps * nbBodies), dims[0]);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)9, dims[1]);
+  for(unsigned int step = 0; step < steps; ++step)
+    for(unsigned int i = 0; i < nbBodies; ++i)
+    {
+      const double* row = &dynamic[(step * nbBodies + i) * 9];
+      CPPUNIT_ASSERT_EQUAL(0.1 * step, row[0]);   // time
+      CPPUNIT_ASSERT_EQUAL(10.0 * step + i, row[2]); // x
+      CPPUNIT_ASSERT_EQUAL(1.0, row[5]);          // qw
+    }
+
+  std::vector<double> velocities = readDataset("velocities", dims);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)(steps * nbBodies), dims[0]);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)8, dims[1]);
+  for(unsigned int step = 0; step < steps; ++step)
+    for(unsigned int i = 0; i < nbBodies; ++i)
+    {
+      const double* row = &velocities[(step * nbBodies + i) * 8];
+      CPPUNIT_ASSERT_EQUAL(0.1 * step, row[0]);
+      CPPUNIT_ASSERT_EQUAL(-1.0 * step - i, row[4]); // zdot
+      // same id as in dynamic
+      CPPUNIT_ASSERT_EQUAL(dynamic[(step * nbBodies + i) * 9 + 1], row[1]);
+    }
+
+  std::vector<double> solv = readDataset("solv", dims);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)steps, dims[0]);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)4, dims[1]);
+  for(unsigned int step = 0; step < steps; ++step)
+  {
+    CPPUNIT_ASSERT_EQUAL(0.1 * step, solv[step * 4]);
+    CPPUNIT_ASSERT_EQUAL((double)step, solv[step * 4 + 1]);
+  }
+
+  // no contact has been written
+  readDataset("cf", dims);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)0, dims[0]);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)26, dims[1]);
+}
+}
+
+void MechanicsHDF5WriterTest::setUp()
+{
+  std::remove(filename);
+}
+
+void MechanicsHDF5WriterTest::tearDown()
+{
+  std::remove(filename);
+}
+
+void MechanicsHDF5WriterTest::testWriteSteps()
+{
+  writeSteps(0, 10, 0);
+  checkSteps(10);
+}
+
+void MechanicsHDF5WriterTest::testAppend()
+{
+  writeSteps(0, 6, 5);
+  writeSteps(6, 10, 5);
+  checkSteps(10);
+}
+
+void MechanicsHDF5WriterTest::testWideSystems()
+{
+  std::vector<SP::NewtonEulerDS> bodies;
+  SP::NonSmoothDynamicalSystem nsds = buildBodies(bodies);
+  setStep(bodies, 1);
+  // 9 coordinates: the rows of the buffers are wider than the datasets
+  SP::SiconosVector q(new SiconosVector(9));
+  SP::SiconosVector v(new SiconosVector(9));
+  for(unsigned int i = 0; i < 9; ++i)
+  {
+    (*q)(i) = i + 1.0;
+    (*v)(i) = -(i + 1.0);
+  }
+  SP::SimpleMatrix mass(new SimpleMatrix(9, 9));
+  mass->eye();
+  nsds->insertDynamicalSystem(SP::LagrangianDS(new LagrangianDS(q, v, mass)));
+  {
+    MechanicsHDF5Writer writer(filename, 3);
+    writer.outputDynamicObjects(0.1, *nsds);
+    writer.outputVelocities(0.1, *nsds);
+    writer.commit();
+  }
+
+  hsize_t dims[2];
+  std::vector<double> dynamic = readDataset("dynamic", dims);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)(nbBodies + 1), dims[0]);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)9, dims[1]);
+  std::vector<double> velocities = readDataset("velocities", dims);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)(nbBodies + 1), dims[0]);
+  CPPUNIT_ASSERT_EQUAL((hsize_t)8, dims[1]);
+  for(unsigned int i = 0; i <= nbBodies; ++i)
+  {
+    const double* row = &dynamic[i * 9];
+    const double* vrow = &velocities[i * 8];
+    if(row[2] == 1.0)
+    {
+      // the lagrangian system: the first coordinates are kept
+      for(unsigned int j = 0; j < 7; ++j)
+        CPPUNIT_ASSERT_EQUAL(j + 1.0, row[j + 2]);
+      for(unsigned int j = 0; j < 6; ++j)
+        CPPUNIT_ASSERT_EQUAL(-(j + 1.0), vrow[j + 2]);
+    }
+    else
+      CPPUNIT_ASSERT_EQUAL(1.0, row[5]);   // qw of a body
+  }
+}
+
+void MechanicsHDF5WriterTest::testSharedFile()
+{
+  std::string version = std::to_string(H5_VERS_MAJOR) + "." + std::to_string(H5_VERS_MINOR)
+                        + "." + std::to_string(H5_VERS_RELEASE);
+  CPPUNIT_ASSERT_EQUAL(version, MechanicsHDF5Writer::libraryVersion());
+
+  // the file is created by another handle that stays open, the library
+  // shares the open file with the writer
+  hid_t other = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+  CPPUNIT_ASSERT(other >= 0);
+  H5Fflush(other, H5F_SCOPE_LOCAL);
+
+  std::vector<SP::NewtonEulerDS> bodies;
+  SP::NonSmoothDynamicalSystem nsds = buildBodies(bodies);
+  MechanicsHDF5Writer writer(filename, 3);
+  for(unsigned int step = 0; step < 3; ++step)
+  {
+    setStep(bodies, step);
+    writer.outputDynamicObjects(0.1 * step, *nsds);
+    writer.commit();
+    // the other handle may be used once the rows are written
+    writer.wait();
+    hid_t dataset = H5Dopen2(other, "data/dynamic", H5P_DEFAULT);
+    CPPUNIT_ASSERT(dataset >= 0);
+    hid_t space = H5Dget_space(dataset);
+    hsize_t dims[2];
+    H5Sget_simple_extent_dims(space, dims, NULL);
+    CPPUNIT_ASSERT_EQUAL((hsize_t)((step + 1) * nbBodies), dims[0]);
+    H5Sclose(space);
+    H5Dclose(dataset);
+  }
+  writer.flush();
+  H5Fclose(other);
+}
@@ -0,0 +1,52 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef MECHANICS_HDF5_WRITER_TEST_HPP
+#define MECHANICS_HDF5_WRITER_TEST_HPP
+
+#include "SiconosConfig.h"
+#include <cppunit/extensions/HelperMacros.h>
+
+class MechanicsHDF5WriterTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(MechanicsHDF5WriterTest);
+
+  CPPUNIT_TEST(testWriteSteps);
+  CPPUNIT_TEST(testAppend);
+  CPPUNIT_TEST(testWideSystems);
+  CPPUNIT_TEST(testSharedFile);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  // several steps written by the background thread, read back
+  void testWriteSteps();
+
+  // a second writer appends to the datasets of the file
+  void testAppend();
+
+  // systems with more coordinates than the columns of the datasets
+  void testWideSystems();
+
+  // the file is also open with another handle, as with h5py
+  void testSharedFile();
+
+public:
+  void setUp();
+  void tearDown();
+};
+
+#endif
@@ -26,8 +26,16 @@
 %include "SiconosRestart.hpp"
 #endif
 #ifdef WITH_MECHANICS
+// positions and velocities written in place into a numpy array
+%apply (double* INPLACE_ARRAY2, int DIM1, int DIM2) { (double* buffer, int rows, int cols) };
 %include <MechanicsIO.hpp>
 %{
 #include <MechanicsIO.hpp>
 %}
+#ifdef WITH_HDF5
+%{
+#include <MechanicsHDF5Writer.hpp>
+%}
+%include <MechanicsHDF5Writer.hpp>
+#endif
 #endif
@@ -41,6 +41,11 @@ from siconos.kernel import \
 from siconos.mechanics.collision.tools import Contactor, Shape
 from siconos.mechanics import joints
 from siconos.io.io_base import MechanicsIO
+try:
+    from siconos.io.io_base import MechanicsHDF5Writer
+except ImportError:
+    # siconos.io built without HDF5
+    MechanicsHDF5Writer = None
 from siconos.io.FrictionContactTrace import GlobalFrictionContactTrace as GFCTrace
 from siconos.io.FrictionContactTrace import FrictionContactTrace as FCTrace
 from siconos.io.FrictionContactTrace import GlobalRollingFrictionContactTrace as GRFCTrace
@@ -820,6 +825,9 @@ class MechanicsHdf5Runner_run_options(dict):
         d['osns_assembly_type']= None
         d['output_contact_forces']=True,
         d['output_contact_info']=True,
+        # 'h5py', or 'native' to write the outputs of the time steps with
+        # MechanicsHDF5Writer, in a background thread
+        d['output_backend']='h5py'
             
 
         super(self.__class__, self).__init__(d)
@@ -923,6 +931,8 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
         self._start_run_iteration_hook = None
         self._end_run_iteration_hook = None
         self._ds_positions=None
+        self._output_writer = None
+        self._output_writer_threadsafe = False
 
     def __enter__(self):
         super(MechanicsHdf5Runner, self).__enter__()
@@ -949,6 +959,11 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                 self._shape = ShapeCollection(io=self._shape_filename)
         return self
 
+    def __exit__(self, type_, value, traceback):
+        # the pending outputs are written before h5py closes the file
+        self.close_output_writer()
+        super(MechanicsHdf5Runner, self).__exit__(type_, value, traceback)
+
     def log(self, fun, with_timer=False, before=True):
         if with_timer:
             t = Timer()
@@ -2169,8 +2184,84 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                                             local_precision]
 
 
+    def open_output_writer(self):
+        """
+        Write the outputs of the time steps with a MechanicsHDF5Writer
+        """
+        if MechanicsHDF5Writer is None:
+            raise RuntimeError('output_backend native: siconos.io is built'
+                               ' without HDF5')
+        # the writer opens the file again, while h5py keeps it open. This
+        # is only safe if both use the same HDF5 library, which then
+        # shares the open file between the two handles.
+        if h5py.version.hdf5_version != MechanicsHDF5Writer.libraryVersion():
+            raise RuntimeError('output_backend native: h5py uses HDF5 {0} and'
+                               ' siconos.io HDF5 {1}, use output_backend'
+                               ' h5py'.format(
+                                   h5py.version.hdf5_version,
+                                   MechanicsHDF5Writer.libraryVersion()))
+        self._out.flush()
+        self._output_writer = MechanicsHDF5Writer(
+            self._io_filename, self._dimension,
+            [0, 9][self._use_compression])
+        # without thread-safety, h5py must not be used while the writer
+        # thread writes: the rows are then written before returning to
+        # the simulation.
+        self._output_writer_threadsafe = \
+            MechanicsHDF5Writer.isLibraryThreadsafe()
+        if not self._output_writer_threadsafe:
+            self.print_verbose('output_backend native: the HDF5 library is'
+                               ' not thread-safe, the outputs are not written'
+                               ' in the background')
+
+    def close_output_writer(self):
+        """
+        Write the pending outputs and release the MechanicsHDF5Writer
+        """
+        if self._output_writer is not None:
+            self._output_writer.flush()
+            self._output_writer = None
+
+    def output_results_native(self):
+        """
+        Outputs the results of the time step with the MechanicsHDF5Writer,
+        the datasets are written in a background thread
+        """
+        time = self.current_time()
+        writer = self._output_writer
+        writer.outputDynamicObjects(time, self._nsds)
+        writer.outputVelocities(time, self._nsds)
+        if self._nsds.topology().indexSetsSize() > 1:
+            if self._output_contact_forces:
+                writer.outputContactForces(time, self._nsds,
+                                           self._output_contact_index_set)
+            if self._output_contact_info and backend == 'bullet':
+                writer.outputContactInfo(time, self._nsds,
+                                         self._output_contact_index_set)
+        writer.outputSolverInfos(
+            time, self._simulation.oneStepNSProblem(0).numericsSolverOptions())
+        writer.commit()
+
     def output_results(self,with_timer=False):
 
+        if self._output_writer is not None:
+            # h5py uses the file only once the rows of the previous
+            # output are written
+            self.log(self._output_writer.wait, with_timer)()
+
+            self.log(self.output_static_objects, with_timer)()
+
+            if self._should_output_domains:
+                self.log(self.output_domains, with_timer)()
+
+            self.log(self._out.flush)()
+
+            self.log(self.output_results_native, with_timer)()
+
+            if not self._output_writer_threadsafe:
+                self.log(self._output_writer.wait, with_timer)()
+            return
+
         self.log(self.output_static_objects, with_timer)()
 
         self.log(self.output_dynamic_objects, with_timer)()
@@ -2464,6 +2555,7 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
             output_contact_info=True,
             friction_contact_trace_params=None,
             output_contact_index_set=1,
+            output_backend='h5py',
             osi=sk.MoreauJeanOSI,
             constraint_activation_threshold=0.0,
             explode_Newton_solve=False,
@@ -2600,6 +2692,13 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
         output_contact_index_set: int, optional
           index of the index set from which contact
           point information is retrieved. Default = 1
+        output_backend: string, optional
+          'h5py' or 'native'. With 'native', the dynamic, velocities, cf,
+          cf_info and solv datasets are written by the C++
+          MechanicsHDF5Writer in a background thread. siconos.io must be
+          built with HDF5, and with the HDF5 library used by h5py. The
+          writing overlaps the simulation only if this library is
+          thread-safe. Default = 'h5py'
         osi: sk.OneStepIntegrator, optional
             class type used to describe one-step integration,
             default = sk.MoreauJeanOSI
@@ -2659,6 +2758,7 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
             run_options['output_backup_frequency']=output_backup_frequency
             run_options['friction_contact_trace_params']=friction_contact_trace_params
             run_options['output_contact_index_set']=output_contact_index_set
+            run_options['output_backend']=output_backend
             run_options['osi']=osi
             run_options['constraint_activation_threshold']=constraint_activation_threshold
             run_options['explode_Newton_solve']=explode_Newton_solve
@@ -3008,6 +3108,9 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
 
         self.output_run_options()
 
+        if run_options.get('output_backend') == 'native':
+            self.open_output_writer()
+
         # nsds = model.nonSmoothDynamicalSystem()
         # nds= nsds.getNumberOfDS()
         # for i in range(nds):
@@ -3060,6 +3163,7 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                 if (k % self._output_backup_frequency == 0) or (k == 1):
 
                     # close io file, hdf5 memory is cleaned
+                    self.close_output_writer()
                     self._out.close()
                     try:
                         shutil.copyfile(self._io_filename,
@@ -3069,6 +3173,8 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                     # open the file again
                     finally:
                         self.__enter__()
+                        if run_options.get('output_backend') == 'native':
+                            self.open_output_writer()
 
             self.log(simulation.clearNSDSChangeLog, with_timer)()
 
@@ -3086,6 +3192,9 @@ class MechanicsHdf5Runner(siconos.io.mechanics_hdf5.MechanicsHdf5):
                                        'new_interactions_created :', bullet_statistics.new_interactions_created,
                                        'existing_interactions_processed :', bullet_statistics.existing_interactions_processed,
                                        'interaction_warnings :', bullet_statistics.interaction_warnings)
+                    if bullet_options.recycleInteractions:
+                        self.print_verbose('bullet_statistics:',
+                                           'interactions_recycled :', bullet_statistics.interactions_recycled)
                     self.print_verbose('number of contacts',
                                        number_of_contacts,
                                        '(detected)',
@@ -0,0 +1,51 @@
+#!/usr/bin/env python
+"""MechanicsIO exports: the versions of positions and velocities writing
+into a numpy array give the same values as the versions returning a matrix.
+"""
+
+import numpy as np
+import pytest
+
+import siconos.kernel as sk
+from siconos.io.io_base import MechanicsIO
+
+
+def make_nsds():
+    nsds = sk.NonSmoothDynamicalSystem(0.0, 1.0)
+    for i in range(3):
+        q = np.array([0.1 * i, 0.2 * i, 0.3 * i, 1.0, 0.0, 0.0, 0.0])
+        v = np.array([1.0 + i, 2.0, 3.0, 0.1 * i, 0.2, 0.3])
+        nsds.insertDynamicalSystem(sk.NewtonEulerDS(q, v, 1.0 + i, np.eye(3)))
+    # a 2D disk, with shorter rows than the 3D bodies
+    q = np.array([1.0, 2.0, 0.5])
+    v = np.array([0.1, 0.2, 0.3])
+    nsds.insertDynamicalSystem(sk.LagrangianLinearTIDS(q, v, np.eye(3)))
+    return nsds
+
+
+@pytest.mark.parametrize("export", ["positions", "velocities"])
+def test_buffer_export(export):
+    nsds = make_nsds()
+    io = MechanicsIO()
+
+    expected = getattr(io, export)(nsds)
+    rows, cols = expected.shape
+    assert rows == 4
+
+    # a larger buffer: the unused columns are zeroed, the extra rows are
+    # not written
+    buffer = np.full((rows + 2, cols + 1), -1.0)
+    written = getattr(io, export)(nsds, buffer)
+    assert written == rows
+    assert np.array_equal(buffer[:rows, :cols], expected)
+    assert np.all(buffer[:rows, cols:] == 0.0)
+    assert np.all(buffer[rows:, :] == -1.0)
+
+    # the short row of the disk is completed with zeros in both versions
+    assert np.all(expected[3, 4:] == 0.0)
+
+    # a buffer with too few rows or columns is refused
+    with pytest.raises(Exception):
+        getattr(io, export)(nsds, np.zeros((rows - 1, cols)))
+    with pytest.raises(Exception):
+        getattr(io, export)(nsds, np.zeros((rows, cols - 1)))
@@ -23,8 +23,12 @@ if(WITH_TESTING)
   # ---- Siconos tools tests ----
   begin_tests(src/utils/SiconosTools/test DEPS "CPPUNIT::CPPUNIT")
   new_test(SOURCES SiconosGraphTest.cpp ${SIMPLE_TEST_MAIN})
+  new_test(SOURCES SiconosFlatGraphTest.cpp ${SIMPLE_TEST_MAIN})
+  # SiconosGraph / SiconosFlatGraph traversal benchmark
+  new_test(SOURCES SiconosGraphBench.cpp)
   new_test(SOURCES SiconosVisitorTest.cpp ${SIMPLE_TEST_MAIN})
   new_test(SOURCES  SiconosPropertiesTest.cpp ${SIMPLE_TEST_MAIN})
+  new_test(SOURCES SiconosProfilerTest.cpp ${SIMPLE_TEST_MAIN})
 
   # ---- Modeling tools ---
   begin_tests(src/modelingTools/test DEPS "numerics;CPPUNIT::CPPUNIT")
@@ -41,11 +45,13 @@ if(WITH_TESTING)
   new_test(SOURCES LagrangianDSTest.cpp  ${SIMPLE_TEST_MAIN})
   new_test(SOURCES LagrangianLinearTIDSTest.cpp  ${SIMPLE_TEST_MAIN})
   new_test(SOURCES NewtonEulerDSTest.cpp  ${SIMPLE_TEST_MAIN})
+  new_test(SOURCES RigidBodyStateStoreTest.cpp  ${SIMPLE_TEST_MAIN})
   new_test(SOURCES NonSmoothDynamicalSystemTest.cpp  ${SIMPLE_TEST_MAIN})
   
   # ---- Simulation tools ---
   begin_tests(src/simulationTools/test DEPS "numerics;CPPUNIT::CPPUNIT")
   new_test(SOURCES OSNSPTest.cpp ${SIMPLE_TEST_MAIN})
+  new_test(SOURCES MoreauJeanOSITest.cpp ${SIMPLE_TEST_MAIN})
   new_test(SOURCES testAVI.cpp ${SIMPLE_TEST_MAIN} DEPS LAPACK::LAPACK)
   if(HAS_FORTRAN)
     new_test(SOURCES ZOHTest.cpp ${SIMPLE_TEST_MAIN} DEPS LAPACK::LAPACK)
@@ -88,6 +88,7 @@ DEFINE_SPTR(SecondOrderDS)
 DEFINE_SPTR(LagrangianLinearTIDS)
 DEFINE_SPTR(LagrangianLinearDiagonalDS)
 DEFINE_SPTR(NewtonEulerDS)
+DEFINE_SPTR(RigidBodyStateStore)
 
 DEFINE_SPTR(FirstOrderNonLinearDS)
 DEFINE_SPTR(FirstOrderLinearDS)
@@ -287,6 +287,25 @@ void Interaction::reset()
 }
 
 
+void Interaction::recycle(SP::NonSmoothLaw nslaw)
+{
+  if(nslaw->size() != _interactionSize)
+    THROW_EXCEPTION("Interaction::recycle - the nonsmooth law has not the size of the interaction.");
+
+  _number = __count++;
+  _nslaw = nslaw;
+  _has2Bodies = false;
+  _sizeOfDS = 0;
+
+  for(unsigned int i = _lowerLevelForOutput; i < _upperLevelForOutput + 1; i++)
+    if(_y[i])
+      _y[i]->zero();
+  resetAllLambda();
+  // the memories are emptied by initializeMemory and the links are
+  // set by initializeLinkToDsVariables when the interaction is linked
+}
+
+
 Interaction::Interaction(SP::NonSmoothLaw NSL, SP::Relation rel):
   _number(__count++), _interactionSize(NSL->size()),
   _y(2),  _nslaw(NSL), _relation(rel)
@@ -401,6 +420,19 @@ void Interaction::resetLambda(unsigned int level)
 }
 
 
+// An empty block vector, the one of a previous link being reused (a
+// recycled interaction is linked again)
+static void emptyBlockVector(SP::BlockVector& block)
+{
+  if(!block)
+    block.reset(new BlockVector());
+  else
+  {
+    VectorOfVectors none;
+    block->setAllVect(none);
+  }
+}
+
 // It could be interesting to make Interaction a pure virtual class and to derive 3
 // classes, one for each type of relation
 void Interaction::__initDataFirstOrder(VectorOfBlockVectors& DSlink, DynamicalSystem& ds1, DynamicalSystem& ds2)
@@ -501,14 +533,14 @@ void Interaction::__initDataNewtonEuler(VectorOfBlockVectors& DSlink, DynamicalS
   DEBUG_BEGIN("Interaction::initDataNewtonEuler(VectorOfBlockVectors& DSlink)\n");
   DSlink.resize(NewtonEulerR::DSlinkSize);
   //DSlink[NewtonEulerR::xfree].reset(new BlockVector());
-  DSlink[NewtonEulerR::q0].reset(new BlockVector()); // displacement
-  DSlink[NewtonEulerR::velocity].reset(new BlockVector()); // velocity
-  DSlink[NewtonEulerR::dotq].reset(new BlockVector()); // qdot
+  emptyBlockVector(DSlink[NewtonEulerR::q0]); // displacement
+  emptyBlockVector(DSlink[NewtonEulerR::velocity]); // velocity
+  emptyBlockVector(DSlink[NewtonEulerR::dotq]); // qdot
   //  data[NewtonEulerR::q2].reset(new BlockVector()); // acceleration
-  DSlink[NewtonEulerR::z].reset(new BlockVector()); // z vector
-  DSlink[NewtonEulerR::p0].reset(new BlockVector());
-  DSlink[NewtonEulerR::p1].reset(new BlockVector());
-  DSlink[NewtonEulerR::p2].reset(new BlockVector());
+  emptyBlockVector(DSlink[NewtonEulerR::z]); // z vector
+  emptyBlockVector(DSlink[NewtonEulerR::p0]);
+  emptyBlockVector(DSlink[NewtonEulerR::p1]);
+  emptyBlockVector(DSlink[NewtonEulerR::p2]);
   DEBUG_END("Interaction::initDataNewtonEuler(VectorOfBlockVectors& DSlink)\n");
   __initDSDataNewtonEuler(ds1, DSlink);
   if(&ds1 != &ds2)
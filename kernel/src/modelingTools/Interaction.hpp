@@ -204,6 +204,16 @@ public:
   */
   void reset();
 
+  /** Prepare an interaction removed from the simulation to be linked
+   *  again, in place of a new interaction with the same kind of
+   *  relation: the interaction gets a new number and the nonsmooth
+   *  law, y and lambda are set to zero. The vectors, the memories and
+   *  the links to the DynamicalSystem(s) keep their allocated storage.
+   *  \param nslaw the nonsmooth law, of the same type and size as the
+   *  current one
+   */
+  void recycle(SP::NonSmoothLaw nslaw);
+
   /** set the links to the DynamicalSystem(s) and allocate the required workspaces
    *  \param interProp the InteractionProperties of this Interaction
       \param ds1 first ds linked to this Interaction (i.e IG->vertex.source)
@@ -41,6 +41,7 @@ Include files related to modeling part of Siconos.
 #include "LagrangianLinearDiagonalDS.hpp"
 #include "FirstOrderLinearTIDS.hpp"
 #include "NewtonEulerDS.hpp"
+#include "RigidBodyStateStore.hpp"
 #include "NewtonEulerR.hpp"
 #include "NewtonEuler1DR.hpp"
 #include "NewtonEuler3DR.hpp"
@@ -22,6 +22,7 @@
 #include "RotationQuaternion.hpp"
 #include "Interaction.hpp"
 #include "BlockVector.hpp"
+#include "NewtonEulerContactKernels.hpp"
 #include <boost/math/quaternion.hpp>
 
 //#define NERI_DEBUG
@@ -36,15 +37,6 @@ See devNotes.pdf for details. A detailed documentation is available in DevNotes.
 */
 void NewtonEuler1DR::NIcomputeJachqTFromContacts(SP::SiconosVector q1)
 {
-  double Nx = _Nc->getValue(0);
-  double Ny = _Nc->getValue(1);
-  double Nz = _Nc->getValue(2);
-  double Px = _Pc1->getValue(0);
-  double Py = _Pc1->getValue(1);
-  double Pz = _Pc1->getValue(2);
-  double G1x = q1->getValue(0);
-  double G1y = q1->getValue(1);
-  double G1z = q1->getValue(2);
 #ifdef NEFC3D_DEBUG
   printf("contact normal:\n");
   _Nc->display();
@@ -53,34 +45,11 @@ void NewtonEuler1DR::NIcomputeJachqTFromContacts(SP::SiconosVector q1)
   printf("center of masse :\n");
   q1->display();
 #endif
-  _rotationAbsoluteToContactFrame->setValue(0, 0, Nx);
-  _rotationAbsoluteToContactFrame->setValue(0, 1, Ny);
-  _rotationAbsoluteToContactFrame->setValue(0, 2, Nz);
+  assert(_jachqT->num() == Siconos::DENSE);
 
-  _NPG1->zero();
-
-  (*_NPG1)(0, 0) = 0;
-  (*_NPG1)(0, 1) = -(G1z - Pz);
-  (*_NPG1)(0, 2) = (G1y - Py);
-  (*_NPG1)(1, 0) = (G1z - Pz);
-  (*_NPG1)(1, 1) = 0;
-  (*_NPG1)(1, 2) = -(G1x - Px);
-  (*_NPG1)(2, 0) = -(G1y - Py);
-  (*_NPG1)(2, 1) = (G1x - Px);
-  (*_NPG1)(2, 2) = 0;
-
-
-  computeRotationMatrix(q1,_rotationBodyToAbsoluteFrame);
-  prod(*_NPG1, *_rotationBodyToAbsoluteFrame, *_AUX1, true);
-
-  prod(*_rotationAbsoluteToContactFrame, *_AUX1, *_AUX2, true);
-
-
-  for(unsigned int jj = 0; jj < 3; jj++)
-    _jachqT->setValue(0, jj, _rotationAbsoluteToContactFrame->getValue(0, jj));
-
-  for(unsigned int jj = 3; jj < 6; jj++)
-    _jachqT->setValue(0, jj, _AUX2->getValue(0, jj - 3));
+  // only the normal row of the contact frame
+  double R[9] = { _Nc->getValue(0), 0.0, 0.0, _Nc->getValue(1), 0.0, 0.0, _Nc->getValue(2), 0.0, 0.0 };
+  NewtonEulerContactKernels::contactJacobian<1>(R, *_Pc1, *q1, 1.0, _jachqT->getArray());
 
 #ifdef NEFC3D_DEBUG
   printf("NewtonEuler1DR jhqt\n");
@@ -90,70 +59,12 @@ void NewtonEuler1DR::NIcomputeJachqTFromContacts(SP::SiconosVector q1)
 
 void NewtonEuler1DR::NIcomputeJachqTFromContacts(SP::SiconosVector q1, SP::SiconosVector q2)
 {
-  double Nx = _Nc->getValue(0);
-  double Ny = _Nc->getValue(1);
-  double Nz = _Nc->getValue(2);
-  double Px = _Pc1->getValue(0);
-  double Py = _Pc1->getValue(1);
-  double Pz = _Pc1->getValue(2);
-  double G1x = q1->getValue(0);
-  double G1y = q1->getValue(1);
-  double G1z = q1->getValue(2);
-
-  _rotationAbsoluteToContactFrame->setValue(0, 0, Nx);
-  _rotationAbsoluteToContactFrame->setValue(0, 1, Ny);
-  _rotationAbsoluteToContactFrame->setValue(0, 2, Nz);
-
-  _NPG1->zero();
-
-  (*_NPG1)(0, 0) = 0;
-  (*_NPG1)(0, 1) = -(G1z - Pz);
-  (*_NPG1)(0, 2) = (G1y - Py);
-  (*_NPG1)(1, 0) = (G1z - Pz);
-  (*_NPG1)(1, 1) = 0;
-  (*_NPG1)(1, 2) = -(G1x - Px);
-  (*_NPG1)(2, 0) = -(G1y - Py);
-  (*_NPG1)(2, 1) = (G1x - Px);
-  (*_NPG1)(2, 2) = 0;
-
-  computeRotationMatrix(q1,_rotationBodyToAbsoluteFrame);
-  prod(*_NPG1, *_rotationBodyToAbsoluteFrame, *_AUX1, true);
-  prod(*_rotationAbsoluteToContactFrame, *_AUX1, *_AUX2, true);
-
-  for(unsigned int jj = 0; jj < 3; jj++)
-    _jachqT->setValue(0, jj, _rotationAbsoluteToContactFrame->getValue(0, jj));
-
-
-  for(unsigned int jj = 3; jj < 6; jj++)
-    _jachqT->setValue(0, jj, _AUX2->getValue(0, jj - 3));
-
-  double G2x = q2->getValue(0);
-  double G2y = q2->getValue(1);
-  double G2z = q2->getValue(2);
-
-  _NPG2->zero();
-  (*_NPG2)(0, 0) = 0;
-  (*_NPG2)(0, 1) = -(G2z - Pz);
-  (*_NPG2)(0, 2) = (G2y - Py);
-  (*_NPG2)(1, 0) = (G2z - Pz);
-  (*_NPG2)(1, 1) = 0;
-  (*_NPG2)(1, 2) = -(G2x - Px);
-  (*_NPG2)(2, 0) = -(G2y - Py);
-  (*_NPG2)(2, 1) = (G2x - Px);
-  (*_NPG2)(2, 2) = 0;
-
-
-
-  computeRotationMatrix(q2,_rotationBodyToAbsoluteFrame);
-  prod(*_NPG2, *_rotationBodyToAbsoluteFrame, *_AUX1, true);
-
-  prod(*_rotationAbsoluteToContactFrame, *_AUX1, *_AUX2, true);
-
-  for(unsigned int jj = 0; jj < 3; jj++)
-    _jachqT->setValue(0, jj + 6, -_rotationAbsoluteToContactFrame->getValue(0, jj));
-
-  for(unsigned int jj = 3; jj < 6; jj++)
-    _jachqT->setValue(0, jj + 6, -_AUX2->getValue(0, jj - 3));
+  assert(_jachqT->num() == Siconos::DENSE);
+
+  double R[9] = { _Nc->getValue(0), 0.0, 0.0, _Nc->getValue(1), 0.0, 0.0, _Nc->getValue(2), 0.0, 0.0 };
+  double* jachqT = _jachqT->getArray();
+  NewtonEulerContactKernels::contactJacobian<1>(R, *_Pc1, *q1, 1.0, jachqT);
+  NewtonEulerContactKernels::contactJacobian<1>(R, *_Pc1, *q2, -1.0, jachqT + 6);
 }
 
 void NewtonEuler1DR::initialize(Interaction& inter)
@@ -162,14 +73,6 @@ void NewtonEuler1DR::initialize(Interaction& inter)
   //proj_with_q  _jachqProj.reset(new SimpleMatrix(_jachq->size(0),_jachq->size(1)));
   unsigned int qSize = 7 * (inter.getSizeOfDS() / 6);
   _jachq.reset(new SimpleMatrix(1, qSize));
-
-  /* VA 12/04/2016 All of what follows should be put in WorkM*/
-  _rotationAbsoluteToContactFrame.reset(new SimpleMatrix(1, 3));
-  _rotationBodyToAbsoluteFrame.reset(new SimpleMatrix(3, 3));
-  _AUX1.reset(new SimpleMatrix(3, 3));
-  _AUX2.reset(new SimpleMatrix(1, 3));
-  _NPG1.reset(new SimpleMatrix(3, 3));
-  _NPG2.reset(new SimpleMatrix(3, 3));
   //  _isContact=1;
 }
 
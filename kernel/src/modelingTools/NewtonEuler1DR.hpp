@@ -59,24 +59,6 @@ protected:
   /* _Nc must be calculated relative to q2 */
   SP::SiconosVector _relNc;
 
-  /* Rotation matrix converting the absolute coordinate to the contact frame
-   * coordinate. This matrix contains the unit vector(s)of the contact frame in
-   * row.
-   */
-  SP::SimpleMatrix _rotationAbsoluteToContactFrame;
-
-  /* Matrix converting */
-  SP::SimpleMatrix _rotationBodyToAbsoluteFrame;
-
-  /* Cross product matrices that correspond the lever arm from
-   * contact point to center of mass*/
-  SP::SimpleMatrix _NPG1;
-  SP::SimpleMatrix _NPG2;
-
-  /*buffer matrices*/
-  SP::SimpleMatrix _AUX1;
-  SP::SimpleMatrix _AUX2;
-
   /** Set the coordinates of first contact point.  Must only be done
    * in a computeh() override.
    * \param npc new coordinates
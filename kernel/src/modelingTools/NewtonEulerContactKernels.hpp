@@ -0,0 +1,128 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file NewtonEulerContactKernels.hpp
+\brief Fixed-size kernels for the Jacobians of the NewtonEuler contact relations
+ */
+
+#ifndef NewtonEulerContactKernels_H
+#define NewtonEulerContactKernels_H
+
+#include "SiconosVector.hpp"
+#include "op3x3.h"
+
+/* The 3x3 matrices are column-major arrays of 9 doubles, as in op3x3.h,
+ * so that they stay on the stack. */
+namespace NewtonEulerContactKernels
+{
+
+/* Rotation from the absolute frame to the contact frame, its rows are the
+ * normal and the two tangents built by orthoBaseFromVector.
+ * Return the error code of orthoBaseFromVector. */
+static inline int contactFrame(const SiconosVector& N, double* R)
+{
+  double Nx = N.getValue(0);
+  double Ny = N.getValue(1);
+  double Nz = N.getValue(2);
+  double t[6];
+  int info = orthoBaseFromVector(&Nx, &Ny, &Nz, t, t + 1, t + 2, t + 3, t + 4, t + 5);
+  R[0] = Nx;
+  R[1] = t[0];
+  R[2] = t[3];
+  R[3] = Ny;
+  R[4] = t[1];
+  R[5] = t[4];
+  R[6] = Nz;
+  R[7] = t[2];
+  R[8] = t[5];
+  return info;
+}
+
+/* Rotation from the body-fixed frame to the absolute frame, given by the
+ * quaternion of the configuration vector q (see computeRotationMatrix) */
+static inline void bodyRotation(const SiconosVector& q, double* Rb)
+{
+  double q0 = q.getValue(3);
+  double q1 = q.getValue(4);
+  double q2 = q.getValue(5);
+  double q3 = q.getValue(6);
+  Rb[0] = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
+  Rb[1] = 2.0 * (q1 * q2 + q0 * q3);
+  Rb[2] = 2.0 * (q1 * q3 - q0 * q2);
+  Rb[3] = 2.0 * (q1 * q2 - q0 * q3);
+  Rb[4] = q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3;
+  Rb[5] = 2.0 * (q2 * q3 + q0 * q1);
+  Rb[6] = 2.0 * (q1 * q3 + q0 * q2);
+  Rb[7] = 2.0 * (q2 * q3 - q0 * q1);
+  Rb[8] = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+}
+
+/* The 6 columns of the Jacobian of a contact with N rows (1: normal,
+ * 3: contact frame, 5: contact frame and rolling) for one body, multiplied
+ * by sign. jac is the first of these columns in a column-major matrix
+ * with N rows.
+ *
+ * The Jacobian is given by
+ *   R                  for the translation part,
+ *   R [G - P]x Rb      for the rotation part,
+ *   (R Rb)(1:2, :)     for the rotation part of the rolling rows,
+ * with R the rotation to the contact frame (only its first row is used
+ * if N == 1), P the contact point, G the center of mass and Rb the
+ * rotation of the body. */
+template<unsigned int N>
+static inline void contactJacobian(double* R, const SiconosVector& P,
+                                   const SiconosVector& q, double sign, double* jac)
+{
+  static_assert(N == 1 || N == 3 || N == 5, "contactJacobian: 1, 3 or 5 rows");
+  const unsigned int rows = (N < 3) ? N : 3;
+
+  double Rb[9];
+  bodyRotation(q, Rb);
+
+  // lever arm cross product matrix
+  double vx = q.getValue(0) - P.getValue(0);
+  double vy = q.getValue(1) - P.getValue(1);
+  double vz = q.getValue(2) - P.getValue(2);
+  double lever[9] = { 0.0, vz, -vy, -vz, 0.0, vx, vy, -vx, 0.0 };
+
+  double aux[9], rot[9];
+  mm3x3(lever, Rb, aux);
+  mm3x3(R, aux, rot);
+
+  for(unsigned int j = 0; j < 3; j++)
+    for(unsigned int i = 0; i < rows; i++)
+    {
+      jac[j * N + i] = sign * R[3 * j + i];
+      jac[(j + 3) * N + i] = sign * rot[3 * j + i];
+    }
+
+  if(N == 5)
+  {
+    mm3x3(R, Rb, rot);
+    for(unsigned int j = 0; j < 3; j++)
+      for(unsigned int i = 3; i < N; i++)
+      {
+        jac[j * N + i] = 0.0;
+        jac[(j + 3) * N + i] = sign * rot[3 * j + i - 2];
+      }
+  }
+}
+
+}
+
+#endif
@@ -568,6 +568,11 @@ public:
     _hasConstantFExt = true;
   }
 
+  /** get mExt
+   *  \return pointer on a plugged vector
+   */
+  inline SP::SiconosVector mExt() const { return _mExt; }
+
   /** set mExt to pointer newPtr
    *  \param newPtr a SP to a Simple vector
    */
@@ -248,6 +248,34 @@ void NewtonEulerR::computeJachqT(Interaction& inter, SP::BlockVector q0)
 
   unsigned int k = 0;
   unsigned int ySize = inter.dimension();
+
+  if(_jachq->num() == Siconos::DENSE && _jachqT->num() == Siconos::DENSE
+      && _T->num() == Siconos::DENSE)
+  {
+    // _jachqT(:, 6i:6i+6) = _jachq(:, 7i:7i+7) * T(q_i), directly on the
+    // dense arrays
+    const double* jachq = _jachq->getArray();
+    double* jachqT = _jachqT->getArray();
+    for(unsigned int i = 0; i < q0->numberOfBlocks(); i++)
+    {
+      computeT((q0->getAllVect())[i], _T);
+      const double* T = _T->getArray();
+      const double* H = jachq + 7 * i * ySize;
+      double* HT = jachqT + 6 * i * ySize;
+      for(unsigned int j = 0; j < 6; j++)
+        for(unsigned int r = 0; r < ySize; r++)
+        {
+          double sum = 0.0;
+          for(unsigned int l = 0; l < 7; l++)
+            sum += H[l * ySize + r] * T[j * 7 + l];
+          HT[j * ySize + r] = sum;
+        }
+    }
+    DEBUG_EXPR(_jachqT->display());
+    DEBUG_END("NewtonEulerR::computeJachqT(Interaction& inter, SP::BlockVector q0) \n");
+    return;
+  }
+
   SP::SimpleMatrix auxBloc(new SimpleMatrix(ySize, 7));
   SP::SimpleMatrix auxBloc2(new SimpleMatrix(ySize, 6));
   Index dimIndex(2);
@@ -0,0 +1,227 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "RigidBodyStateStore.hpp"
+#include "NewtonEulerDS.hpp"
+#include "SiconosConfig.h"
+#include "SiconosException.hpp"
+
+#include <cmath>
+
+// #define DEBUG_STDOUT
+// #define DEBUG_MESSAGES
+#include "siconos_debug.h"
+
+/* sin(x)/x, with the series of RotationQuaternion.cpp near 0 */
+static inline double sinc(double x)
+{
+  if(std::abs(x) <= 1e-3)
+  {
+    return 1.0 + x*x / 3.0 + pow(x,4) * 2.0 / 15.0 + pow(x,6) * 17.0 / 315.0 + pow(x,8) * 62.0 / 2835.0;
+  }
+  else
+  {
+    return sin(x)/x;
+  }
+}
+
+unsigned int RigidBodyStateStore::insert(SP::NewtonEulerDS ds)
+{
+  if(!ds)
+    THROW_EXCEPTION("RigidBodyStateStore::insert - null dynamical system");
+  if(ds->getqDim() != 7 || ds->dimension() != 6)
+    THROW_EXCEPTION("RigidBodyStateStore::insert - only 3D bodies are handled");
+  _bodies.push_back(ds);
+  return _bodies.size() - 1;
+}
+
+void RigidBodyStateStore::clear()
+{
+  _bodies.clear();
+  resize();
+}
+
+void RigidBodyStateStore::resize()
+{
+  _n = _bodies.size();
+  _q.resize(7 * _n);
+  _qOld.resize(7 * _n);
+  _twist.resize(6 * _n);
+  _twistOld.resize(6 * _n);
+  _fExt.resize(3 * _n);
+  _mExt.resize(3 * _n);
+  _inverseMass.resize(_n);
+  _inverseInertia.resize(9 * _n);
+}
+
+void RigidBodyStateStore::gather()
+{
+  if(_n != _bodies.size())
+    resize();
+
+  const unsigned int n = _n;
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    NewtonEulerDS& d = *_bodies[i];
+    const SiconosVector& q = *d.q();
+    const SiconosVector& v = *d.twist();
+    for(unsigned int c = 0; c < 7; ++c)
+      _q[c * n + i] = q(c);
+    for(unsigned int c = 0; c < 6; ++c)
+      _twist[c * n + i] = v(c);
+
+    // without memory (before the first step), the current state is used.
+    const SiconosVector& qold =
+      d.qMemory().nbVectorsInMemory() ? d.qMemory().getSiconosVector(0) : q;
+    const SiconosVector& vold =
+      d.twistMemory().nbVectorsInMemory() ? d.twistMemory().getSiconosVector(0) : v;
+    for(unsigned int c = 0; c < 7; ++c)
+      _qOld[c * n + i] = qold(c);
+    for(unsigned int c = 0; c < 6; ++c)
+      _twistOld[c * n + i] = vold(c);
+
+    SP::SiconosVector fExt = d.fExt();
+    SP::SiconosVector mExt = d.mExt();
+    for(unsigned int c = 0; c < 3; ++c)
+    {
+      _fExt[c * n + i] = fExt ? (*fExt)(c) : 0.0;
+      _mExt[c * n + i] = mExt ? (*mExt)(c) : 0.0;
+    }
+  }
+}
+
+void RigidBodyStateStore::gatherInertia()
+{
+  if(_n != _bodies.size())
+    resize();
+
+  const unsigned int n = _n;
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    NewtonEulerDS& d = *_bodies[i];
+    _inverseMass[i] = 1.0 / d.scalarMass();
+
+    const SiconosMatrix& I = *d.inertia();
+    double a = I(0, 0), b = I(0, 1), c = I(0, 2);
+    double e = I(1, 0), f = I(1, 1), g = I(1, 2);
+    double k = I(2, 0), l = I(2, 1), m = I(2, 2);
+    double c00 = f * m - g * l, c01 = g * k - e * m, c02 = e * l - f * k;
+    double det = a * c00 + b * c01 + c * c02;
+    if(det == 0.0)
+      THROW_EXCEPTION("RigidBodyStateStore::gatherInertia - singular inertia matrix");
+    double idet = 1.0 / det;
+    double* J = &_inverseInertia[0];
+    J[0 * n + i] = c00 * idet;
+    J[1 * n + i] = (c * l - b * m) * idet;
+    J[2 * n + i] = (b * g - c * f) * idet;
+    J[3 * n + i] = c01 * idet;
+    J[4 * n + i] = (a * m - c * k) * idet;
+    J[5 * n + i] = (c * e - a * g) * idet;
+    J[6 * n + i] = c02 * idet;
+    J[7 * n + i] = (b * k - a * l) * idet;
+    J[8 * n + i] = (a * f - b * e) * idet;
+  }
+}
+
+void RigidBodyStateStore::scatter() const
+{
+  const unsigned int n = _n;
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    NewtonEulerDS& d = *_bodies[i];
+    SiconosVector& q = *d.q();
+    SiconosVector& v = *d.twist();
+    for(unsigned int c = 0; c < 7; ++c)
+      q(c) = _q[c * n + i];
+    for(unsigned int c = 0; c < 6; ++c)
+      v(c) = _twist[c * n + i];
+  }
+}
+
+void RigidBodyStateStore::integratePositions(double h, double theta)
+{
+  DEBUG_BEGIN("RigidBodyStateStore::integratePositions(double h, double theta)\n");
+  const unsigned int n = _n;
+  if(n == 0)
+  {
+    DEBUG_END("RigidBodyStateStore::integratePositions(double h, double theta)\n");
+    return;
+  }
+  const double coeff = h * theta;
+  const double coeffOld = h * (1 - theta);
+
+  const double* v0 = &_twist[0];
+  const double* v1 = &_twist[n];
+  const double* v2 = &_twist[2 * n];
+  const double* v3 = &_twist[3 * n];
+  const double* v4 = &_twist[4 * n];
+  const double* v5 = &_twist[5 * n];
+  const double* vo0 = &_twistOld[0];
+  const double* vo1 = &_twistOld[n];
+  const double* vo2 = &_twistOld[2 * n];
+  const double* vo3 = &_twistOld[3 * n];
+  const double* vo4 = &_twistOld[4 * n];
+  const double* vo5 = &_twistOld[5 * n];
+  const double* qo0 = &_qOld[0];
+  const double* qo1 = &_qOld[n];
+  const double* qo2 = &_qOld[2 * n];
+  const double* qo3 = &_qOld[3 * n];
+  const double* qo4 = &_qOld[4 * n];
+  const double* qo5 = &_qOld[5 * n];
+  const double* qo6 = &_qOld[6 * n];
+  double* q0 = &_q[0];
+  double* q1 = &_q[n];
+  double* q2 = &_q[2 * n];
+  double* q3 = &_q[3 * n];
+  double* q4 = &_q[4 * n];
+  double* q5 = &_q[5 * n];
+  double* q6 = &_q[6 * n];
+
+  // Same operations as MoreauJeanOSI::updatePosition: the increment
+  // h*theta*v + h*(1-theta)*vold is composed with qold on the Lie group
+  // (quaternionFromTwistVector and compositionLawLieGroup).
+#ifdef WITH_OPENMP
+  #pragma omp simd
+#endif
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    double w0 = coeff * v0[i] + coeffOld * vo0[i];
+    double w1 = coeff * v1[i] + coeffOld * vo1[i];
+    double w2 = coeff * v2[i] + coeffOld * vo2[i];
+    double w3 = coeff * v3[i] + coeffOld * vo3[i];
+    double w4 = coeff * v4[i] + coeffOld * vo4[i];
+    double w5 = coeff * v5[i] + coeffOld * vo5[i];
+
+    double angle = sqrt(w3 * w3 + w4 * w4 + w5 * w5);
+    double f = 0.5 * sinc(angle * 0.5);
+    double b0 = cos(angle / 2.0);
+    double b1 = w3 * f;
+    double b2 = w4 * f;
+    double b3 = w5 * f;
+
+    q0[i] = qo0[i] + w0;
+    q1[i] = qo1[i] + w1;
+    q2[i] = qo2[i] + w2;
+
+    double a0 = qo3[i], a1 = qo4[i], a2 = qo5[i], a3 = qo6[i];
+    q3[i] = a0 * b0 - a1 * b1 - a2 * b2 - a3 * b3;
+    q4[i] = a0 * b1 + a1 * b0 + a2 * b3 - a3 * b2;
+    q5[i] = a0 * b2 - a1 * b3 + a2 * b0 + a3 * b1;
+    q6[i] = a0 * b3 + a1 * b2 - a2 * b1 + a3 * b0;
+  }
+  DEBUG_END("RigidBodyStateStore::integratePositions(double h, double theta)\n");
+}
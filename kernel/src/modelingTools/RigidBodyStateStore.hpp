@@ -0,0 +1,190 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file RigidBodyStateStore.hpp
+  \brief contiguous storage of the states of a set of NewtonEulerDS
+*/
+
+#ifndef RIGIDBODYSTATESTORE_HPP
+#define RIGIDBODYSTATESTORE_HPP
+
+#include "SiconosPointers.hpp"
+#include "SiconosFwd.hpp"
+
+#include <vector>
+
+/** \brief Structure-of-arrays storage of the states of a set of
+ *  NewtonEulerDS.
+ *
+ *  The bodies keep their own vectors. The store holds a contiguous copy of
+ *  the positions and quaternions (q), the twists, the state of the
+ *  previous time step, the external forces and moments and the inverse
+ *  mass and inertia, so that the operations on all the bodies run in
+ *  flat loops. The arrays are stored component by component: the
+ *  component c of the body i is at index c * size() + i.
+ *
+ *  Typical use:
+ *   - gather() the state from the bodies (gatherInertia() once, or when
+ *     the mass or the inertia of the bodies changes),
+ *   - run the batched operations (integratePositions(), ...),
+ *   - scatter() the result back into the bodies.
+ */
+class RigidBodyStateStore
+{
+protected:
+
+  /** the bodies, in the order of insertion */
+  std::vector<SP::NewtonEulerDS> _bodies;
+
+  /** number of bodies of the arrays */
+  unsigned int _n = 0;
+
+  /** positions and quaternions (7 components) */
+  std::vector<double> _q;
+
+  /** positions and quaternions at the beginning of the time step */
+  std::vector<double> _qOld;
+
+  /** twists (6 components) */
+  std::vector<double> _twist;
+
+  /** twists at the beginning of the time step */
+  std::vector<double> _twistOld;
+
+  /** external forces (3 components) */
+  std::vector<double> _fExt;
+
+  /** external moments (3 components) */
+  std::vector<double> _mExt;
+
+  /** inverse of the scalar masses */
+  std::vector<double> _inverseMass;
+
+  /** inverse of the inertia matrices (9 components, row major) */
+  std::vector<double> _inverseInertia;
+
+  /** allocate the arrays for the current number of bodies */
+  void resize();
+
+public:
+
+  /** default constructor */
+  RigidBodyStateStore() = default;
+
+  /** destructor */
+  virtual ~RigidBodyStateStore() = default;
+
+  /** add a body to the store
+   *  \param ds the body
+   *  \return the index of the body in the store
+   */
+  unsigned int insert(SP::NewtonEulerDS ds);
+
+  /** remove all the bodies */
+  void clear();
+
+  /** \return the number of bodies */
+  inline unsigned int size() const
+  {
+    return _bodies.size();
+  };
+
+  /** \param i index of the body
+   *  \return the body
+   */
+  inline SP::NewtonEulerDS body(unsigned int i) const
+  {
+    return _bodies[i];
+  };
+
+  /** copy q, twist, their values at the beginning of the time step and
+   *  the external forces and moments of the bodies into the store
+   */
+  void gather();
+
+  /** copy the inverse mass and inverse inertia of the bodies into the store */
+  void gatherInertia();
+
+  /** copy q and twist of the store into the bodies */
+  void scatter() const;
+
+  /** compute q from the state at the beginning of the time step and the
+   *  twists with the theta-scheme of MoreauJeanOSI::updatePosition
+   *  \param h the time step
+   *  \param theta the theta parameter
+   */
+  void integratePositions(double h, double theta);
+
+  /** \param c the component (0 to 6)
+   *  \return the array of this component of q for all the bodies
+   */
+  inline double* q(unsigned int c)
+  {
+    return &_q[c * _n];
+  };
+
+  inline const double* q(unsigned int c) const
+  {
+    return &_q[c * _n];
+  };
+
+  /** \param c the component (0 to 5)
+   *  \return the array of this component of the twists
+   */
+  inline double* twist(unsigned int c)
+  {
+    return &_twist[c * _n];
+  };
+
+  inline const double* twist(unsigned int c) const
+  {
+    return &_twist[c * _n];
+  };
+
+  /** \param c the component (0 to 2)
+   *  \return the array of this component of the external forces
+   */
+  inline const double* fExt(unsigned int c) const
+  {
+    return &_fExt[c * _n];
+  };
+
+  /** \param c the component (0 to 2)
+   *  \return the array of this component of the external moments
+   */
+  inline const double* mExt(unsigned int c) const
+  {
+    return &_mExt[c * _n];
+  };
+
+  /** \return the array of the inverse masses */
+  inline const double* inverseMass() const
+  {
+    return _inverseMass.data();
+  };
+
+  /** \param c the component (0 to 8, row major)
+   *  \return the array of this component of the inverse inertia matrices
+   */
+  inline const double* inverseInertia(unsigned int c) const
+  {
+    return &_inverseInertia[c * _n];
+  };
+};
+
+#endif // RIGIDBODYSTATESTORE_HPP
@@ -18,6 +18,7 @@
 #include "NewtonEulerDSTest.hpp"
 #include "SiconosMatrixSetBlock.hpp"
 #include "SiconosAlgebraProd.hpp"
+#include "NewtonEulerContactKernels.hpp"
 
 
 #define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
@@ -393,3 +394,64 @@ void NewtonEulerDSTest::testNewtonEulerDSQuaternionMatrix()
 
 // }
 
+void NewtonEulerDSTest::testContactJacobian()
+{
+  std::cout << "--> Test: contact Jacobian" <<std::endl;
+  SP::SiconosVector q(new SiconosVector(7));
+  SP::SiconosVector axis(new SiconosVector(3));
+  (*axis)(0) = 1.0;
+  (*axis)(1) = 2.0;
+  (*axis)(2) = -1.0;
+  ::quaternionFromAxisAngle(axis, 0.3, q);
+  (*q)(0) = 1.0;
+  (*q)(1) = 2.0;
+  (*q)(2) = 3.0;
+  SiconosVector P(3), N(3);
+  P(0) = 0.5;
+  P(1) = 2.5;
+  P(2) = 2.0;
+  N(0) = 1.0;
+  N(1) = -2.0;
+  N(2) = 2.0;
+  N *= 1.0 / N.norm2();
+
+  double R[9];
+  CPPUNIT_ASSERT(NewtonEulerContactKernels::contactFrame(N, R) == 0);
+  double jac[5 * 6];
+  NewtonEulerContactKernels::contactJacobian<5>(R, P, *q, -1.0, jac);
+
+  // the same products with SimpleMatrix
+  SimpleMatrix contactFrame(3, 3), lever(3, 3), aux(3, 3), rot(3, 3), rolling(3, 3);
+  SP::SimpleMatrix body(new SimpleMatrix(3, 3));
+  for(unsigned int i = 0; i < 3; i++)
+    for(unsigned int j = 0; j < 3; j++)
+      contactFrame(i, j) = R[3 * j + i];
+  lever.zero();
+  lever(0, 1) = -((*q)(2) - P(2));
+  lever(0, 2) = (*q)(1) - P(1);
+  lever(1, 0) = (*q)(2) - P(2);
+  lever(1, 2) = -((*q)(0) - P(0));
+  lever(2, 0) = -((*q)(1) - P(1));
+  lever(2, 1) = (*q)(0) - P(0);
+  ::computeRotationMatrix(q, body);
+  prod(lever, *body, aux, true);
+  prod(contactFrame, aux, rot, true);
+  prod(contactFrame, *body, rolling, true);
+
+  double error = 0.0;
+  for(unsigned int j = 0; j < 3; j++)
+  {
+    for(unsigned int i = 0; i < 3; i++)
+    {
+      error = std::max(error, std::abs(jac[j * 5 + i] + contactFrame(i, j)));
+      error = std::max(error, std::abs(jac[(j + 3) * 5 + i] + rot(i, j)));
+    }
+    for(unsigned int i = 3; i < 5; i++)
+    {
+      error = std::max(error, std::abs(jac[j * 5 + i]));
+      error = std::max(error, std::abs(jac[(j + 3) * 5 + i] + rolling(i - 2, j)));
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testContactJacobian : ", error <= 1e-14, true);
+  std::cout << "--> contact Jacobian test ended with success." <<std::endl;
+}
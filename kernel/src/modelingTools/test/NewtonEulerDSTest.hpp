@@ -39,6 +39,7 @@ private:
   CPPUNIT_TEST(testBuildNewtonEulerDS1);
   CPPUNIT_TEST(testNewtonEulerDSQuaternion);
   CPPUNIT_TEST(testNewtonEulerDSQuaternionMatrix);
+  CPPUNIT_TEST(testContactJacobian);
   CPPUNIT_TEST_SUITE_END();
 
   // \todo exception test
@@ -46,6 +47,7 @@ private:
   void testBuildNewtonEulerDS1();
   void testNewtonEulerDSQuaternion();
   void testNewtonEulerDSQuaternionMatrix();
+  void testContactJacobian();
   // void testcomputeDS();
 
   // Members
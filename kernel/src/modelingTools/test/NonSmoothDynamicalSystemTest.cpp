@@ -18,6 +18,7 @@
 #include "NonSmoothDynamicalSystemTest.hpp"
 #include "LagrangianLinearTIR.hpp"
 #include "NewtonImpactNSL.hpp"
+#include "EqualityConditionNSL.hpp"
 
 #define CPPUNIT_ASSERT_NOT_EQUAL(message, alpha, omega)      \
             if ((alpha) == (omega)) CPPUNIT_FAIL(message);
@@ -181,3 +182,44 @@ void NonSmoothDynamicalSystemTest::testremoveInteraction()
 
   std::cout << "------- test removeInteraction ok -------" <<std::endl;
 }
+
+// the pairs of DS linked by an EqualityConditionNSL are tracked by the topology
+void NonSmoothDynamicalSystemTest::testequalityInteractions()
+{
+  SP::NonSmoothDynamicalSystem  nsds(new NonSmoothDynamicalSystem(0., 10.));
+
+  SP::DynamicalSystem ds1(new LagrangianDS(std::make_shared<SiconosVector>(3),
+                          std::make_shared<SiconosVector>(3)));
+  SP::DynamicalSystem ds2(new LagrangianDS(std::make_shared<SiconosVector>(3),
+                          std::make_shared<SiconosVector>(3)));
+  SP::DynamicalSystem ds3(new LagrangianDS(std::make_shared<SiconosVector>(3),
+                          std::make_shared<SiconosVector>(3)));
+  nsds->insertDynamicalSystem(ds1);
+  nsds->insertDynamicalSystem(ds2);
+  nsds->insertDynamicalSystem(ds3);
+
+  SP::Relation r(new LagrangianLinearTIR(std::make_shared<SimpleMatrix>(1,6)));
+  SP::Interaction contact(new Interaction(std::make_shared<NewtonImpactNSL>(0.0), r));
+  SP::Interaction joint1(new Interaction(std::make_shared<EqualityConditionNSL>(1), r));
+  SP::Interaction joint2(new Interaction(std::make_shared<EqualityConditionNSL>(1), r));
+  SP::Topology topo = nsds->topology();
+
+  nsds->link(contact, ds1, ds2);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testequalityInteractionsA: ", topo->equalityInteractionsForPairOfDS(ds1, ds2).size(), (size_t)0);
+
+  nsds->link(joint1, ds1, ds2);
+  nsds->link(joint2, ds3, ds2);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testequalityInteractionsB: ", topo->equalityInteractionsForPairOfDS(ds2, ds1).size(), (size_t)1);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testequalityInteractionsC: ", topo->equalityInteractionsForPairOfDS(ds1, ds2)[0] == joint1, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testequalityInteractionsD: ", topo->equalityInteractionsForPairOfDS(ds2, ds3)[0] == joint2, true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testequalityInteractionsE: ", topo->equalityInteractionsForPairOfDS(ds1, ds3).size(), (size_t)0);
+
+  nsds->removeInteraction(joint1);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testequalityInteractionsF: ", topo->equalityInteractionsForPairOfDS(ds1, ds2).size(), (size_t)0);
+
+  nsds->removeDynamicalSystem(ds3);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testequalityInteractionsG: ", topo->equalityInteractionsForPairOfDS(ds2, ds3).size(), (size_t)0);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE(" testequalityInteractionsH: ", nsds->getNumberOfInteractions() == 1, true);
+
+  std::cout << "------- test equalityInteractions ok -------" <<std::endl;
+}
@@ -41,6 +41,7 @@ private:
   CPPUNIT_TEST(testinsertInteraction);
   CPPUNIT_TEST(testremoveDynamicalSystem);
   CPPUNIT_TEST(testremoveInteraction);
+  CPPUNIT_TEST(testequalityInteractions);
   CPPUNIT_TEST_SUITE_END();
 
   // \todo exception test
@@ -49,6 +50,7 @@ private:
   void testinsertInteraction();
   void testremoveDynamicalSystem();
   void testremoveInteraction();
+  void testequalityInteractions();
 
 public:
   void setUp();
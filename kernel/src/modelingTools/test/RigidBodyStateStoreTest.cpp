@@ -0,0 +1,151 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "RigidBodyStateStoreTest.hpp"
+#include "RotationQuaternion.hpp"
+#include "SiconosAlgebraScal.hpp"
+#include "SiconosAlgebraProd.hpp"
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(RigidBodyStateStoreTest);
+
+
+void RigidBodyStateStoreTest::setUp()
+{
+  bodies.clear();
+  for(unsigned int k = 0; k < 3; ++k)
+  {
+    SP::SiconosVector q0(new SiconosVector(7));
+    (*q0)(0) = 1.0 + k;
+    (*q0)(1) = 2.0 - k;
+    (*q0)(2) = 3.0 * k;
+    (*q0)(3) = 1.0;
+    SP::SiconosVector axis(new SiconosVector(3));
+    (*axis)(k) = 1.0;
+    ::quaternionFromAxisAngle(axis, 0.3 * (k + 1), q0);
+
+    SP::SiconosVector v0(new SiconosVector(6));
+    for(unsigned int c = 0; c < 6; ++c)
+      (*v0)(c) = 0.1 * (c + 1) * (k + 1);
+
+    SP::SimpleMatrix inertia(new SimpleMatrix(3, 3));
+    (*inertia)(0, 0) = 1.0 + k;
+    (*inertia)(1, 1) = 2.0;
+    (*inertia)(2, 2) = 3.0;
+    (*inertia)(0, 1) = 0.1;
+    (*inertia)(1, 0) = 0.1;
+
+    SP::NewtonEulerDS ds(new NewtonEulerDS(q0, v0, 10.0 * (k + 1), inertia));
+    SP::SiconosVector fExt(new SiconosVector(3));
+    (*fExt)(2) = -9.81 * ds->scalarMass();
+    ds->setFExtPtr(fExt);
+    ds->initMemory(1);
+    ds->swapInMemory();
+    bodies.push_back(ds);
+  }
+}
+
+void RigidBodyStateStoreTest::tearDown()
+{}
+
+void RigidBodyStateStoreTest::testGatherScatter()
+{
+  std::cout << "--> Test: gather and scatter." <<std::endl;
+  RigidBodyStateStore store;
+  for(unsigned int k = 0; k < bodies.size(); ++k)
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testGatherScatter : ", store.insert(bodies[k]), k);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testGatherScatter : ", store.size(), 3u);
+
+  store.gather();
+  for(unsigned int k = 0; k < bodies.size(); ++k)
+  {
+    for(unsigned int c = 0; c < 7; ++c)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testGatherScatter q : ", store.q(c)[k], (*bodies[k]->q())(c));
+    for(unsigned int c = 0; c < 6; ++c)
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testGatherScatter twist : ", store.twist(c)[k], (*bodies[k]->twist())(c));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testGatherScatter fExt : ", store.fExt(2)[k], (*bodies[k]->fExt())(2));
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testGatherScatter mExt : ", store.mExt(0)[k], 0.0);
+  }
+
+  store.q(0)[1] = 42.0;
+  store.twist(5)[2] = -1.0;
+  store.scatter();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testGatherScatter scatter : ", (*bodies[1]->q())(0), 42.0);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testGatherScatter scatter : ", (*bodies[2]->twist())(5), -1.0);
+  std::cout << "--> gather and scatter test ended with success." <<std::endl;
+}
+
+void RigidBodyStateStoreTest::testGatherInertia()
+{
+  std::cout << "--> Test: gather inertia." <<std::endl;
+  RigidBodyStateStore store;
+  for(unsigned int k = 0; k < bodies.size(); ++k)
+    store.insert(bodies[k]);
+  store.gatherInertia();
+
+  for(unsigned int k = 0; k < bodies.size(); ++k)
+  {
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 / bodies[k]->scalarMass(), store.inverseMass()[k], 1e-15);
+    SimpleMatrix invI(3, 3);
+    for(unsigned int c = 0; c < 9; ++c)
+      invI(c / 3, c % 3) = store.inverseInertia(c)[k];
+    SimpleMatrix id(3, 3);
+    prod(*bodies[k]->inertia(), invI, id, true);
+    for(unsigned int i = 0; i < 3; ++i)
+      for(unsigned int j = 0; j < 3; ++j)
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(i == j ? 1.0 : 0.0, id(i, j), 1e-14);
+  }
+  std::cout << "--> gather inertia test ended with success." <<std::endl;
+}
+
+void RigidBodyStateStoreTest::testIntegratePositions()
+{
+  std::cout << "--> Test: integrate positions." <<std::endl;
+  double h = 1e-2, theta = 0.5;
+  RigidBodyStateStore store;
+  for(unsigned int k = 0; k < bodies.size(); ++k)
+  {
+    // new twist for the end of the step
+    SiconosVector& v = *bodies[k]->twist();
+    for(unsigned int c = 0; c < 6; ++c)
+      v(c) += 0.5 * c - 1.0;
+    store.insert(bodies[k]);
+  }
+  store.gather();
+  store.integratePositions(h, theta);
+
+  for(unsigned int k = 0; k < bodies.size(); ++k)
+  {
+    // reference: MoreauJeanOSI::updatePosition
+    NewtonEulerDS& d = *bodies[k];
+    const SiconosVector& qold = d.qMemory().getSiconosVector(0);
+    const SiconosVector& vold = d.twistMemory().getSiconosVector(0);
+    SiconosVector q(7);
+    SiconosVector increment(6);
+    scal(h * theta, *d.twist(), increment);
+    scal(h * (1 - theta), vold, increment, false);
+    q.setValue(0, increment.getValue(0));
+    q.setValue(1, increment.getValue(1));
+    q.setValue(2, increment.getValue(2));
+    quaternionFromTwistVector(increment, q);
+    compositionLawLieGroup(qold, q);
+
+    for(unsigned int c = 0; c < 7; ++c)
+      CPPUNIT_ASSERT_DOUBLES_EQUAL(q(c), store.q(c)[k], 1e-15);
+  }
+  std::cout << "--> integrate positions test ended with success." <<std::endl;
+}
@@ -16,6 +16,7 @@
  * limitations under the License.
 */
 #include "AVI.hpp"
+#include "SiconosProfiler.hpp"
 #include "NumericsMatrix.h"
 #include <assert.h>
 #include "Simulation.hpp"
@@ -172,8 +173,11 @@ int AVI::compute(double time)
     _numerics_problem->M = _M->numericsMatrix().get();
     _numerics_problem->q = _q->getArray();
 
-    info = avi_driver(_numerics_problem.get(), _z->getArray(), _w->getArray(),
-                      _numerics_solver_options.get());
+    {
+      SiconosProfiler::Timer timer("solve");
+      info = avi_driver(_numerics_problem.get(), _z->getArray(), _w->getArray(),
+                        _numerics_solver_options.get());
+    }
 
     if(info != 0)
     {
@@ -29,6 +29,10 @@
 #include "SparseBlockMatrix.h" // From numerics, for SparseBlockStructuredMatrix
 #include "Tools.hpp"
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 //#define DEBUG_STDOUT
 //#define DEBUG_MESSAGES 1
 #include "siconos_debug.h"
@@ -41,7 +45,8 @@ BlockCSRMatrix::BlockCSRMatrix():
   _diagsize0(new IndexInt()),
   _diagsize1(new IndexInt()),
   rowPos(new IndexInt()),
-  colPos(new IndexInt())
+  colPos(new IndexInt()),
+  _packedBlocks(false)
 {}
 
 // Constructor with dimensions
@@ -58,7 +63,8 @@ BlockCSRMatrix::BlockCSRMatrix(unsigned int nRow):
   _diagsize0(new IndexInt(_nr)),
   _diagsize1(new IndexInt(_nr)),
   rowPos(new IndexInt(_nr)),
-  colPos(new IndexInt(_nr))
+  colPos(new IndexInt(_nr)),
+  _packedBlocks(false)
 {}
 
 // Basic constructor
@@ -69,7 +75,8 @@ BlockCSRMatrix::BlockCSRMatrix(InteractionsGraph& indexSet):
   _diagsize0(new IndexInt(_nr)),
   _diagsize1(new IndexInt(_nr)),
   rowPos(new IndexInt(_nr)),
-  colPos(new IndexInt(_nr))
+  colPos(new IndexInt(_nr)),
+  _packedBlocks(false)
 {
   DEBUG_BEGIN("BlockCSRMatrix::BlockCSRMatrix(SP::InteractionsGraph indexSet)\n");
   fill(indexSet);
@@ -77,7 +84,10 @@ BlockCSRMatrix::BlockCSRMatrix(InteractionsGraph& indexSet):
 }
 
 BlockCSRMatrix::~BlockCSRMatrix()
-{}
+{
+  // The other fields of the numerics structure are pointer links.
+  SBM_arena_free(_sparseBlockStructuredMatrix.get());
+}
 
 // Fill the SparseMat
 void BlockCSRMatrix::fill(InteractionsGraph& indexSet)
@@ -94,6 +104,15 @@ void BlockCSRMatrix::fill(InteractionsGraph& indexSet)
 
   _diagsize0->resize(_nr);
   _diagsize1->resize(_nr);
+  _rowInteractions.resize(_nr);
+
+  // The non null blocks are first collected and sorted by (row,
+  // column), then appended to _blockCSR. Inserting them in the order
+  // of the graph would shift the end of the compressed storage at each
+  // insertion, i.e. a cost quadratic in the number of blocks.
+  typedef std::tuple<unsigned int, unsigned int, double*> BlockEntry;
+  std::vector<BlockEntry> entries;
+  entries.reserve(_nr + 2 * indexSet.edges_number());
 
   // === Loop through "active" Interactions (ie present in
   // indexSets[level]) ===
@@ -112,11 +131,12 @@ void BlockCSRMatrix::fill(InteractionsGraph& indexSet)
     sizeV  += inter->nonSmoothLaw()->size();
     (*_diagsize0)[indexSet.index(*vi)] = sizeV;
     (*_diagsize1)[indexSet.index(*vi)] = sizeV;
+    _rowInteractions[indexSet.index(*vi)] = inter->number();
     assert((*_diagsize0)[indexSet.index(*vi)] > 0);
     assert((*_diagsize1)[indexSet.index(*vi)] > 0);
 
-    (*_blockCSR)(indexSet.index(*vi), indexSet.index(*vi)) =
-      indexSet.properties(*vi).block->getArray();
+    entries.emplace_back(indexSet.index(*vi), indexSet.index(*vi),
+                         indexSet.properties(*vi).block->getArray());
   }
 
   InteractionsGraph::EIterator ei, eiend;
@@ -142,13 +162,146 @@ void BlockCSRMatrix::fill(InteractionsGraph& indexSet)
 
     assert(pos != col);
 
-    (*_blockCSR)(std::min(pos, col), std::max(pos, col)) =
-      indexSet.properties(*ei).upper_block->getArray();
+    entries.emplace_back(std::min(pos, col), std::max(pos, col),
+                         indexSet.properties(*ei).upper_block->getArray());
 
-    (*_blockCSR)(std::max(pos, col), std::min(pos, col)) =
-      indexSet.properties(*ei).lower_block->getArray();
+    entries.emplace_back(std::max(pos, col), std::min(pos, col),
+                         indexSet.properties(*ei).lower_block->getArray());
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const BlockEntry& a, const BlockEntry& b)
+  {
+    return std::get<0>(a) < std::get<0>(b)
+           || (std::get<0>(a) == std::get<0>(b) && std::get<1>(a) < std::get<1>(b));
+  });
+
+  _blockCSR->reserve(entries.size(), false);
+  for(size_t k = 0; k < entries.size(); ++k)
+  {
+    // two edges (two common dynamical systems) between the same
+    // interactions share the same blocks
+    if(k > 0 && std::get<0>(entries[k]) == std::get<0>(entries[k - 1])
+        && std::get<1>(entries[k]) == std::get<1>(entries[k - 1]))
+    {
+      assert(std::get<2>(entries[k]) == std::get<2>(entries[k - 1]));
+      continue;
+    }
+    _blockCSR->push_back(std::get<0>(entries[k]), std::get<1>(entries[k]),
+                         std::get<2>(entries[k]));
+  }
+  DEBUG_EXPR(display(););
+}
+
+unsigned int BlockCSRMatrix::update(InteractionsGraph& indexSet)
+{
+  if(_rowInteractions.size() != _nr || _blockCSR->size1() != _nr)
+  {
+    // no previous call to fill()
+    fill(indexSet);
+    return 0;
+  }
+
+  unsigned int nr = indexSet.size();
+  std::vector<size_t> rowInteractions(nr);
+  std::vector<InteractionsGraph::VDescriptor> rowVertex(nr);
+  InteractionsGraph::VIterator vi, viend;
+  for(std::tie(vi, viend) = indexSet.vertices();
+      vi != viend; ++vi)
+  {
+    rowInteractions[indexSet.index(*vi)] = indexSet.bundle(*vi)->number();
+    rowVertex[indexSet.index(*vi)] = *vi;
+  }
+
+  // Old row r becomes row newRow[r] if its Interaction is still in the
+  // index set, in the same order. The rows from 'kept' on are new.
+  std::vector<int> newRow(_nr, -1);
+  unsigned int kept = 0;
+  for(unsigned int r = 0; r < _nr && kept < nr; ++r)
+  {
+    if(_rowInteractions[r] == rowInteractions[kept])
+      newRow[r] = kept++;
+  }
+  unsigned int first = 0;
+  while(first < kept && newRow[first] == (int) first)
+    ++first;
+  if(first == nr && nr == _nr)
+    return nr;
+
+  // The blocks between two kept rows are unchanged (an edge of the index
+  // set between two Interactions is created with the last of them) and
+  // already sorted by (row, column).
+  typedef std::tuple<unsigned int, unsigned int, double*> BlockEntry;
+  std::vector<BlockEntry> keptEntries, newEntries;
+  keptEntries.reserve(_blockCSR->nnz());
+  const CompressedRowMat& blockCSR = *_blockCSR;
+  for(CompressedRowMat::const_iterator1 it1 = blockCSR.begin1();
+      it1 != blockCSR.end1(); ++it1)
+  {
+    if(newRow[it1.index1()] < 0)
+      continue;
+    for(CompressedRowMat::const_iterator2 it2 = it1.begin(); it2 != it1.end(); ++it2)
+    {
+      if(newRow[it2.index2()] >= 0)
+        keptEntries.emplace_back(newRow[it2.index1()], newRow[it2.index2()], *it2);
+    }
+  }
+
+  // The blocks of the new rows and of their transposed positions
+  for(unsigned int i = kept; i < nr; ++i)
+  {
+    InteractionsGraph::VDescriptor vd = rowVertex[i];
+    newEntries.emplace_back(i, i, indexSet.properties(vd).block->getArray());
+    InteractionsGraph::OEIterator oei, oeiend;
+    for(std::tie(oei, oeiend) = indexSet.out_edges(vd);
+        oei != oeiend; ++oei)
+    {
+      unsigned int j = indexSet.index(indexSet.target(*oei));
+      assert(j != i);
+      newEntries.emplace_back(std::min(i, j), std::max(i, j),
+                              indexSet.properties(*oei).upper_block->getArray());
+      newEntries.emplace_back(std::max(i, j), std::min(i, j),
+                              indexSet.properties(*oei).lower_block->getArray());
+    }
+  }
+  auto lessEntry = [](const BlockEntry& a, const BlockEntry& b)
+  {
+    return std::get<0>(a) < std::get<0>(b)
+           || (std::get<0>(a) == std::get<0>(b) && std::get<1>(a) < std::get<1>(b));
+  };
+  std::sort(newEntries.begin(), newEntries.end(), lessEntry);
+  std::vector<BlockEntry> entries(keptEntries.size() + newEntries.size());
+  std::merge(keptEntries.begin(), keptEntries.end(),
+             newEntries.begin(), newEntries.end(), entries.begin(), lessEntry);
+
+  _nr = nr;
+  _blockCSR->resize(_nr, _nr, false);
+  _blockCSR->reserve(entries.size(), false);
+  for(size_t k = 0; k < entries.size(); ++k)
+  {
+    // the edges between two new rows are seen from both rows
+    if(k > 0 && std::get<0>(entries[k]) == std::get<0>(entries[k - 1])
+        && std::get<1>(entries[k]) == std::get<1>(entries[k - 1]))
+    {
+      assert(std::get<2>(entries[k]) == std::get<2>(entries[k - 1]));
+      continue;
+    }
+    _blockCSR->push_back(std::get<0>(entries[k]), std::get<1>(entries[k]),
+                         std::get<2>(entries[k]));
+  }
+
+  _diagsize0->resize(_nr);
+  _diagsize1->resize(_nr);
+  unsigned int sizeV = first ? (*_diagsize0)[first - 1] : 0;
+  for(unsigned int i = first; i < _nr; ++i)
+  {
+    sizeV += indexSet.bundle(rowVertex[i])->nonSmoothLaw()->size();
+    (*_diagsize0)[i] = sizeV;
+    (*_diagsize1)[i] = sizeV;
   }
+  _rowInteractions.swap(rowInteractions);
   DEBUG_EXPR(display(););
+  return first;
 }
 
 void BlockCSRMatrix::fillW(InteractionsGraph& indexSet)
@@ -287,7 +440,17 @@ void BlockCSRMatrix::convert()
   if(_nr > 0)
   {
     _sparseBlockStructuredMatrix->index2_data = _blockCSR->index2_data().begin();
-    _sparseBlockStructuredMatrix->block =  _blockCSR->value_data().begin();
+    if(_packedBlocks)
+    {
+      // Copy of the blocks into the arena of the numerics structure,
+      // which owns its array of block pointers.
+      if(!_sparseBlockStructuredMatrix->arena)
+        _sparseBlockStructuredMatrix->block = nullptr;
+      if(SBM_pack_blocks_from(_sparseBlockStructuredMatrix.get(), _blockCSR->value_data().begin()))
+        THROW_EXCEPTION("BlockCSRMatrix::convert, allocation of the packed blocks failed.");
+    }
+    else
+      _sparseBlockStructuredMatrix->block =  _blockCSR->value_data().begin();
   };
   if(_sparseBlockStructuredMatrix->diagonal_blocks)
   {
@@ -305,6 +468,16 @@ void BlockCSRMatrix::convert()
   DEBUG_END("void BlockCSRMatrix::convert()\n");
 }
 
+void BlockCSRMatrix::setPackedBlocks(bool packed)
+{
+  if(!packed && _packedBlocks)
+  {
+    // back to pointer links, set at the next call to convert()
+    SBM_arena_free(_sparseBlockStructuredMatrix.get());
+  }
+  _packedBlocks = packed;
+}
+
 // Display data
 void BlockCSRMatrix::display() const
 {
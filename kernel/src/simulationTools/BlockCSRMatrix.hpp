@@ -129,6 +129,14 @@ private:
   /** List of non null blocks positions (in col) */
   SP::IndexInt colPos;
 
+  /** If true, convert() copies the blocks into a contiguous storage
+   *  owned by _sparseBlockStructuredMatrix rather than linking the
+   *  numerics structure to the SiconosMatrix of each block */
+  bool _packedBlocks;
+
+  /** number of the Interaction of each block row, as set by fill() */
+  std::vector<size_t> _rowInteractions;
+
   /** Private copy constructor => no copy nor pass by value */
   BlockCSRMatrix(const BlockCSRMatrix&);
 
@@ -211,6 +219,17 @@ public:
    */
   void fill(InteractionsGraph& indexSet);
 
+  /** update the current class after a change of the index set used by
+   *  the last call to fill(). The blocks of the Interactions that are
+   *  still in the index set are kept and only the ones of the new
+   *  vertices are read from the graph. This assumes that the remaining
+   *  vertices keep their order and that the new ones come after them
+   *  (the rows that do not follow this rule are read from the graph).
+   *  \param indexSet set of the active constraints
+   *  \return the first block row whose position in the matrix changed
+   */
+  unsigned int update(InteractionsGraph& indexSet);
+
 
   /** fill the matrix with the Mass matrix 
    * \warning only for NewtonEulerDS
@@ -227,6 +246,21 @@ public:
   /** fill the numerics structure _sparseBlockStructuredMatrix using _blockCSR */
   void convert();
 
+  /** set the way blocks are handed to the numerics structure
+   *  \param packed if true, convert() copies all the blocks into a single
+   *  contiguous (cache-aligned) storage, which speeds up the traversals
+   *  made by the solvers (block Gauss-Seidel, products) at the price of
+   *  one copy per call to convert(). If false (default), the numerics
+   *  structure points to the data of the interaction blocks.
+   */
+  void setPackedBlocks(bool packed);
+
+  /** \return true if the blocks are copied into a contiguous storage */
+  inline bool packedBlocks() const
+  {
+    return _packedBlocks;
+  };
+
   /** display the current matrix
    */
   void display() const;
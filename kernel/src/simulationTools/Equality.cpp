@@ -16,6 +16,7 @@
  * limitations under the License.
 */
 #include "Equality.hpp"
+#include "SiconosProfiler.hpp"
 #include "Simulation.hpp"
 #include "OSNSMatrix.hpp"
 #include "EqualityConditionNSL.hpp"
@@ -72,7 +73,10 @@ int Equality::compute(double time)
     for(size_t i = 0; i < _sizeOutput; ++i) z_[i] = -q_[i];
     //info = NM_gesv(&*_M->numericsMatrix(), z_, true);
     //info = NM_LU_solve(NM_preserve(&*_M->numericsMatrix()), z_, 1);
-    info = NM_LU_solve(&*_M->numericsMatrix(), z_, 1);
+    {
+      SiconosProfiler::Timer timer("solve");
+      info = NM_LU_solve(&*_M->numericsMatrix(), z_, 1);
+    }
 
 
     // --- Recovering of the desired variables from EQUALITY output ---
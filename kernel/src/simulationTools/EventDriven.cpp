@@ -478,7 +478,9 @@ void EventDriven::computeJacobianfx(OneStepIntegrator& osi,
                                     integer *sizeOfX,
                                     doublereal *time,
                                     doublereal *x,
-                                    doublereal *jacob)
+                                    integer *mu,
+                                    doublereal *jacob,
+                                    integer *nrowpd)
 {
   assert(osi.getType() == OSI::LSODAROSI);
 
@@ -499,10 +501,14 @@ void EventDriven::computeJacobianfx(OneStepIntegrator& osi,
   lsodar.computeJacobianRhs(t, *_DSG0);
 
   // Save jacobianX values from dynamical system into current jacob
-  // (in-out parameter)
-
-  unsigned int i = 0;
-  unsigned pos = 0;
+  // (in-out parameter). The dynamical systems are coupled only through
+  // the interactions, so only their diagonal blocks are loaded, the
+  // remaining entries are set to zero by Lsodar.
+  // df(i)/dx(j) is stored in jacob(i, j) in full storage and in
+  // jacob(i - j + mu, j) in band storage.
+  bool banded = (lsodar.intData(8) == 4);
+  unsigned int ld = *nrowpd;
+  unsigned int pos = 0;
   DynamicalSystemsGraph::VIterator dsi, dsend;
   SP::DynamicalSystemsGraph osiDSGraph = lsodar.dynamicalSystemsGraph();
   for(std::tie(dsi, dsend) = osiDSGraph->vertices(); dsi != dsend; ++dsi)
@@ -511,26 +517,23 @@ void EventDriven::computeJacobianfx(OneStepIntegrator& osi,
 
     DynamicalSystem& ds = *(osiDSGraph->bundle(*dsi));
     Type::Siconos dsType = Type::value(ds);
-    if(dsType == Type::LagrangianDS || dsType == Type::LagrangianLinearTIDS)
+    if(dsType != Type::LagrangianDS && dsType != Type::LagrangianLinearTIDS
+        && dsType != Type::FirstOrderNonLinearDS && dsType != Type::FirstOrderLinearDS
+        && dsType != Type::FirstOrderLinearTIDS)
     {
-      LagrangianDS& lds = static_cast<LagrangianDS&>(ds);
-      BlockMatrix& jacotmp = static_cast<BlockMatrix&>(*lds.jacobianRhsx());
-      for(unsigned int j = 0; j < lds.n(); ++j)
-      {
-        for(unsigned int k = 0; k < lds.dimension(); ++k)
-          jacob[i++] = jacotmp(k, j);
-      }
-    }
-    else if(dsType == Type::FirstOrderNonLinearDS || dsType == Type::FirstOrderLinearDS
-            || dsType == Type::FirstOrderLinearTIDS)
-    {
-      SimpleMatrix& jacotmp = static_cast<SimpleMatrix&>(*(ds.jacobianRhsx())); // Pointer link !
-      pos += jacotmp.copyData(&jacob[pos]);
+      THROW_EXCEPTION("EventDriven::computeJacobianfx, type of DynamicalSystem not yet supported.");
     }
-    else
+
+    const SiconosMatrix& jacotmp = *ds.jacobianRhsx(); // Pointer link !
+    unsigned int n = ds.n();
+    for(unsigned int j = 0; j < n; ++j)
     {
-      THROW_EXCEPTION("EventDriven::computeJacobianfx, type of DynamicalSystem not yet supported.");
+      double* column = &jacob[(pos + j) * ld];
+      column += banded ? (int)*mu - (int)j : (int)pos;
+      for(unsigned int k = 0; k < n; ++k)
+        column[k] = jacotmp(k, j);
     }
+    pos += n;
   }
 }
 
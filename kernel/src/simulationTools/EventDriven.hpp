@@ -215,15 +215,20 @@ public:
   void computef(OneStepIntegrator &osi, integer *sizeOfX, doublereal *time,
                 doublereal *x, doublereal *xdot);
 
-  /** compute jacobian of the right-hand side
+  /** compute jacobian of the right-hand side. Only the diagonal blocks of
+   *  the dynamical systems are loaded, in full storage or, if the jt of the
+   *  integrator is 4, in the band storage of Lsodar.
    *  \param osi the integrator (Lsodar)
    *  \param sizeOfX size of vector x
    *  \param time current time given by the integrator
    *  \param x state vector
+   *  \param mu upper half-bandwidth of the jacobian (band storage only)
    *  \param jacob jacobian of f according to x
+   *  \param nrowpd leading dimension of jacob
    */
   void computeJacobianfx(OneStepIntegrator &osi, integer *sizeOfX,
-                         doublereal *time, doublereal *x, doublereal *jacob);
+                         doublereal *time, doublereal *x, integer *mu,
+                         doublereal *jacob, integer *nrowpd);
 
   /** compute the size of constraint function g(x,t,...) for osi
    * \return unsigned int
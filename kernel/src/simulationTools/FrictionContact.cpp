@@ -16,6 +16,7 @@
  * limitations under the License.
 */
 #include "FrictionContact.hpp"
+#include "SiconosProfiler.hpp"
 #include "Topology.hpp"
 #include "Simulation.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
@@ -133,6 +134,7 @@ FrictionContactProblem *FrictionContact::frictionContactProblemPtr()
 
 int FrictionContact::solve(SP::FrictionContactProblem problem)
 {
+  SiconosProfiler::Timer timer("solve");
   if(!problem)
   {
     problem = frictionContactProblem();
@@ -16,6 +16,7 @@
  * limitations under the License.
 */
 #include "GenericMechanical.hpp"
+#include "SiconosProfiler.hpp"
 #include "Topology.hpp"
 #include "Simulation.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
@@ -72,22 +73,20 @@ void GenericMechanical::initialize(SP::Simulation sim)
 }
 bool GenericMechanical::checkCompatibleNSLaw(NonSmoothLaw& nslaw)
 {
-  // do nothoing since it is check in GenericMechanical::computeDiagonalInteractionBlock
+  // do nothing since it is checked in GenericMechanical::prepareDiagonalInteractionBlock
   return true;
 }
 
-void GenericMechanical::computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)
+void GenericMechanical::prepareDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)
 {
+  LinearOSNS::prepareDiagonalInteractionBlock(vd);
   SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
-  //bool isTimeInvariant = simulation()->nonSmoothDynamicalSystem()->topology()->isTimeInvariant();
 
-  /*Build the corresponding numerics problems*/
+  /*Build the corresponding numerics problems, in the order of the index set*/
 
-  SP::DynamicalSystem DS1 = indexSet->properties(vd).source;
-  SP::DynamicalSystem DS2 = indexSet->properties(vd).target;
   SP::Interaction inter = indexSet->bundle(vd);
 
-  DEBUG_PRINT("GenericMechanical::computeInteractionBlock: add problem of type ");
+  DEBUG_PRINT("GenericMechanical::prepareDiagonalInteractionBlock: add problem of type ");
 
   if(!_hasBeenUpdated)
   {
@@ -150,11 +149,9 @@ void GenericMechanical::computeDiagonalInteractionBlock(const InteractionsGraph:
     }
     else
     {
-      THROW_EXCEPTION("GenericMechanical::computeDiagonalInteractionBlock- not yet implemented for that NSLAW type");
+      THROW_EXCEPTION("GenericMechanical::prepareDiagonalInteractionBlock- not yet implemented for that NSLAW type");
     }
   }
-
-  LinearOSNS::computeDiagonalInteractionBlock(vd);
 }
 
 void GenericMechanical::computeInteractionBlock(const InteractionsGraph::EDescriptor& ed)
@@ -206,10 +203,13 @@ int GenericMechanical::compute(double time)
     DEBUG_EXPR(display(););
     // Call Numerics Driver for GenericMechanical
     //    display();
-    info = gmp_driver(_pnumerics_GMP,
-                      &*_z->getArray(),
-                      &*_w->getArray(),
-                      &*_numerics_solver_options);
+    {
+      SiconosProfiler::Timer timer("solve");
+      info = gmp_driver(_pnumerics_GMP,
+                        &*_z->getArray(),
+                        &*_w->getArray(),
+                        &*_numerics_solver_options);
+    }
     //printf("GenericMechanical::compute : R:\n");
     //_z->display();
     postCompute();
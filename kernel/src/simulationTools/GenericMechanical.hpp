@@ -91,10 +91,10 @@ public:
   void
   computeInteractionBlock(const InteractionsGraph::EDescriptor &ed) override;
 
-  /** compute diagonal Interaction block
+  /** add the local problem of an Interaction to the numerics problem
    * \param vd  a vertex descriptor
    */
-  void computeDiagonalInteractionBlock(
+  void prepareDiagonalInteractionBlock(
       const InteractionsGraph::VDescriptor &vd) override;
 
   /** print the data to the screen */
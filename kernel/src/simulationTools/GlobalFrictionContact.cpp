@@ -18,6 +18,7 @@
 #include "SiconosPointers.hpp"
 #include "NumericsMatrix.h"
 #include "GlobalFrictionContact.hpp"
+#include "SiconosProfiler.hpp"
 #include "Simulation.hpp"
 //#include "Interaction.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
@@ -173,12 +174,11 @@ bool GlobalFrictionContact::checkCompatibleNSLaw(NonSmoothLaw& nslaw)
   return true;
 }
 
-//#define WITH_TIMER
-
 
 bool GlobalFrictionContact::preCompute(double time)
 {
   DEBUG_BEGIN("GlobalFrictionContact::preCompute(double time)\n");
+  SiconosProfiler::Timer timer("preCompute");
   // This function is used to prepare data for the GlobalFrictionContact problem
   // - computation of M, H _tildeLocalVelocity and q
   // - set _sizeOutput, sizeLocalOutput
@@ -225,34 +225,22 @@ bool GlobalFrictionContact::preCompute(double time)
 
     size_t sizeM = 0;
 
-#ifdef WITH_TIMER
-    std::chrono::time_point<std::chrono::system_clock> start, end, end_old;
-    start = std::chrono::system_clock::now();
-#endif
     // fill _W
-    _W->fillW(DSG0);
+    {
+      SiconosProfiler::Timer timer("fillW");
+      _W->fillW(DSG0);
+    }
     sizeM = _W->size();
     _sizeGlobalOutput = sizeM;
     DEBUG_PRINTF("sizeM = %lu \n", sizeM);
-#ifdef WITH_TIMER
-    end = std::chrono::system_clock::now();
-    int elapsed = std::chrono::duration_cast<std::chrono::microseconds> (end-start).count();
-    std::cout << "\nGlobalFrictionContact: fill W  " << elapsed << " ms" << std::endl;
-#endif    
 
     
     if (_assemblyType == GLOBAL_REDUCED)
     {
       // fill _W_inverse
+      SiconosProfiler::Timer timer("fillWinverse");
       _W_inverse->fillWinverse(DSG0);
     }
-#ifdef WITH_TIMER
-    end_old=end;
-    end = std::chrono::system_clock::now();
-    elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-      (end-end_old).count();
-    std::cout << "GlobalFrictionContact: fillW inverse " << elapsed << " ms" << std::endl;
-#endif
  
     // fill _q
     if(_q->size() != _sizeGlobalOutput)
@@ -285,30 +273,19 @@ bool GlobalFrictionContact::preCompute(double time)
       offset += dss;
     }
     DEBUG_EXPR(_q->display(););
-#ifdef WITH_TIMER
-    end_old=end;
-    end = std::chrono::system_clock::now();
-    elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-      (end-end_old).count();
-    std::cout << "GlobalFrictionContact: fill q " << elapsed << " ms" << std::endl;
-#endif
  
     /************************************/
 
 
     // fill H
-    _H->fillH(DSG0, indexSet);
+    {
+      SiconosProfiler::Timer timer("fillH");
+      _H->fillH(DSG0, indexSet);
+    }
     DEBUG_EXPR(NM_display(_H->numericsMatrix().get()););
 
     _sizeOutput =_H->sizeColumn();
     DEBUG_PRINTF("_sizeOutput = %i\n ", _sizeOutput);
-#ifdef WITH_TIMER
-    end_old=end;
-    end = std::chrono::system_clock::now();
-    elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-      (end-end_old).count();
-    std::cout << "GlobalFrictionContact: fill H " << elapsed << " ms" << std::endl;
-#endif
 
     //fill _b
     if(_b->size() != _sizeOutput)
@@ -344,13 +321,6 @@ bool GlobalFrictionContact::preCompute(double time)
       setBlock(osnsp_rhs, _b, sizeY, 0, pos);
     }
     DEBUG_EXPR(_b->display(););
-#ifdef WITH_TIMER
-    end_old=end;
-    end = std::chrono::system_clock::now();
-    elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-      (end-end_old).count();
-    std::cout << "GlobalFrictionContact: fill b " << elapsed << " ms" << std::endl;
-#endif
     
     // Checks z and w sizes and reset if necessary
     if(_z->size() != _sizeOutput)
@@ -370,13 +340,6 @@ bool GlobalFrictionContact::preCompute(double time)
       _globalVelocities->zero();
     }
   // nothing to do (IsLinear and not changed)
-#ifdef WITH_TIMER
-  end_old=end;
-  end = std::chrono::system_clock::now();
-  elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-    (end-end_old).count();
-  std::cout << "GlobalFrictionContact: init w and z and V " << elapsed << " ms" << std::endl;
-#endif
   }
   DEBUG_END("GlobalFrictionContact::preCompute(double time)\n");
   return true;
@@ -405,6 +368,7 @@ int GlobalFrictionContact::compute(double time)
 
 int GlobalFrictionContact::solve(SP::GlobalFrictionContactProblem problem)
 {
+  SiconosProfiler::Timer timer("solve");
   if(!problem)
   {
     problem = globalFrictionContactProblem();
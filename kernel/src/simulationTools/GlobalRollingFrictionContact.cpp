@@ -18,6 +18,7 @@
 #include "SiconosPointers.hpp"
 #include "NumericsMatrix.h"
 #include "GlobalRollingFrictionContact.hpp"
+#include "SiconosProfiler.hpp"
 #include "Simulation.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
 #include "Relation.hpp"
@@ -313,6 +314,7 @@ int GlobalRollingFrictionContact::compute(double time)
 
 int GlobalRollingFrictionContact::solve(SP::GlobalRollingFrictionContactProblem problem)
 {
+  SiconosProfiler::Timer timer("solve");
   if(!problem)
   {
     problem = globalRollingFrictionContactProblem();
@@ -38,6 +38,14 @@ public:
    * the Newton loop. */
   virtual void updateInteractions(SP::Simulation simulation) {}
 
+  /** Called by Simulation once a new interaction has been initialized
+   * (its memories are allocated), e.g. to set the initial guess of its
+   * reactions.
+   * \param time the current time
+   * \param inter the new interaction
+   */
+  virtual void initializeInteraction(double time, SP::Interaction inter) {}
+
   /** Specify a non-smooth law to use for a given combination of
    *  interaction groups.
    * \param nslaw the new nonsmooth law
@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 #include "LCP.hpp"
+#include "SiconosProfiler.hpp"
 #include "OSNSMatrix.hpp"
 #include "SolverOptions.h"
 #include "ComplementarityConditionNSL.hpp"
@@ -60,6 +61,7 @@ bool LCP::checkCompatibleNSLaw(NonSmoothLaw& nslaw)
 
 int LCP::solve()
 {
+  SiconosProfiler::Timer timer("solve");
   // Note FP : wrap call to numerics solver inside this function
   // for python API (e.g. to allow profiling without C struct handling)
 
@@ -42,16 +42,17 @@
 #include "LagrangianLinearTIDS.hpp"
 #include "NewtonEulerDS.hpp"
 #include "OSNSMatrix.hpp"
+#include "BlockCSRMatrix.hpp"
 
 #include "Tools.hpp"
-#include <chrono>
+#include "SiconosProfiler.hpp"
 
 using namespace RELATION;
 // #define DEBUG_NOCOLOR
 //#define DEBUG_STDOUT
 //#define DEBUG_MESSAGES
 #include "siconos_debug.h"
-//#define WITH_TIMER
+
 void LinearOSNS::initVectorsMemory()
 {
   // Memory allocation for _w, M, z and q.
@@ -81,6 +82,13 @@ void LinearOSNS::initVectorsMemory()
       _q->resize(maxSize());
   }
 }
+void LinearOSNS::setPackedMBlocks(bool val)
+{
+  _packedMBlocks = val;
+  if(_M && _M->blockCSRMatrix())
+    _M->blockCSRMatrix()->setPackedBlocks(val);
+}
+
 void LinearOSNS::initOSNSMatrix()
 {
   // Default size for M = maxSize()
@@ -107,6 +115,7 @@ void LinearOSNS::initOSNSMatrix()
         {
           _M.reset(new OSNSMatrix(1, _numericsMatrixStorageType));
         }
+        _M->blockCSRMatrix()->setPackedBlocks(_packedMBlocks);
         break;
       }
       {
@@ -355,6 +364,107 @@ void LinearOSNS::initialize(SP::Simulation sim)
 
 }
 
+/* Contribution H1 W^{-1} H2^T of a DS to an interaction block, with the
+ * sizes known at compile time: N rows for both interactions and a DS of
+ * size D. H1 and H2 are the columns of the DS in the Jacobians
+ * (column-major, N rows); H2^T is copied on the stack and solved with the
+ * factorization of W. */
+template<unsigned int N, unsigned int D>
+static void addFixedSizeBlock(const double* H1, const double* H2,
+                              SimpleMatrix& W, double* block)
+{
+  double X[D * N];
+  for(unsigned int i = 0; i < N; i++)
+    for(unsigned int j = 0; j < D; j++)
+      X[i * D + j] = H2[j * N + i];
+
+  W.Solve(X, N);
+
+  for(unsigned int c = 0; c < N; c++)
+    for(unsigned int r = 0; r < N; r++)
+    {
+      double sum = 0.0;
+      for(unsigned int k = 0; k < D; k++)
+        sum += H1[k * N + r] * X[c * D + k];
+      block[c * N + r] += sum;
+    }
+}
+
+/* The Jacobian of a Lagrangian or NewtonEuler relation, as used by
+ * Interaction::getLeftInteractionBlockForDS */
+static SiconosMatrix* secondOrderJacobian(const Interaction& inter)
+{
+  RELATION::TYPES relationType = inter.relation()->getType();
+  if(relationType == Lagrangian)
+    return static_cast<LagrangianR&>(*inter.relation()).jachq().get();
+  else if(relationType == NewtonEuler)
+    return static_cast<NewtonEulerR&>(*inter.relation()).jachqT().get();
+  return nullptr;
+}
+
+/* Fixed-size path of the interaction blocks for the usual contacts, two
+ * interactions with the same number of rows: 1, 3 or 5 rows and a
+ * NewtonEulerDS, 1, 2 or 3 rows and a 2D rigid body. Return false if it
+ * does not apply, the generic path is then used. */
+static bool fixedSizeInteractionBlock(const Interaction& inter1, unsigned int pos1,
+                                      const Interaction& inter2, unsigned int pos2,
+                                      unsigned int sizeDS, SimpleMatrix& W,
+                                      SiconosMatrix& block)
+{
+  unsigned int N = inter1.nonSmoothLaw()->size();
+  if(inter2.nonSmoothLaw()->size() != N)
+    return false;
+
+  SiconosMatrix* J1 = secondOrderJacobian(inter1);
+  SiconosMatrix* J2 = secondOrderJacobian(inter2);
+  if(!J1 || !J2 || J1->num() != Siconos::DENSE || J2->num() != Siconos::DENSE
+      || J1->size(0) != N || J2->size(0) != N
+      || W.num() != Siconos::DENSE || block.num() != Siconos::DENSE)
+    return false;
+
+  const double* H1 = J1->getArray() + pos1 * N;
+  const double* H2 = J2->getArray() + pos2 * N;
+  double* B = block.getArray();
+
+  if(sizeDS == 6)
+  {
+    switch(N)
+    {
+    case 1:
+      addFixedSizeBlock<1, 6>(H1, H2, W, B);
+      return true;
+    case 3:
+      addFixedSizeBlock<3, 6>(H1, H2, W, B);
+      return true;
+    case 5:
+      addFixedSizeBlock<5, 6>(H1, H2, W, B);
+      return true;
+    }
+  }
+  else if(sizeDS == 3)
+  {
+    switch(N)
+    {
+    case 1:
+      addFixedSizeBlock<1, 3>(H1, H2, W, B);
+      return true;
+    case 2:
+      addFixedSizeBlock<2, 3>(H1, H2, W, B);
+      return true;
+    case 3:
+      addFixedSizeBlock<3, 3>(H1, H2, W, B);
+      return true;
+    }
+  }
+  return false;
+}
+
+void LinearOSNS::prepareDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)
+{
+  SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
+  checkCompatibleNSLaw(*indexSet->bundle(vd)->nonSmoothLaw());
+}
+
 void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)
 {
   DEBUG_BEGIN("LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)\n");
@@ -407,9 +517,9 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
   DynamicalSystemsGraph& DSG0 = *simulation()->nonSmoothDynamicalSystem()->dynamicalSystems();
   SP::NonSmoothLaw nslaw = inter->nonSmoothLaw();
 
-  // --- Check compatible nslaws ----
-  checkCompatibleNSLaw(*nslaw);
-
+  // the compatibility of the nslaw is checked (and recorded in
+  // _nslawtype) by prepareDiagonalInteractionBlock, before the blocks
+  // are possibly computed in parallel.
 
   // --- Check block size ---
   assert(indexSet->properties(vd).block->size(0) == nslaw->size());
@@ -449,6 +559,18 @@ void LinearOSNS::computeDiagonalInteractionBlock(const InteractionsGraph::VDescr
     OSI::TYPES osiType = osi.getType();
     unsigned int sizeDS = ds->dimension();
 
+    if((relationType == Lagrangian || relationType == NewtonEuler)
+        && relationSubType != CompliantLinearTIR
+        && osiType != OSI::MOREAUJEANBILBAOOSI
+        && Type::value(*ds) != Type::LagrangianLinearDiagonalDS
+        && !std::static_pointer_cast<SecondOrderDS>(ds)->boundaryConditions()
+        && fixedSizeInteractionBlock(*inter, pos, *inter, pos, sizeDS,
+                                     *getOSIMatrix(osi, ds), *currentInteractionBlock))
+    {
+      pos = pos2;
+      continue;
+    }
+
     // get _interactionBlocks corresponding to the current DS
     // These _interactionBlocks depends on the relation type.
     leftInteractionBlock = inter->getLeftInteractionBlockForDS(pos, nslawSize, sizeDS);
@@ -669,6 +791,18 @@ void LinearOSNS::computeInteractionBlock(const InteractionsGraph::EDescriptor& e
   // loop over the common DS
   unsigned int sizeDS = ds->dimension();
 
+  if((relationType1 == Lagrangian || relationType1 == NewtonEuler)
+      && (relationType2 == Lagrangian || relationType2 == NewtonEuler)
+      && osiType != OSI::MOREAUJEANBILBAOOSI
+      && Type::value(*ds) != Type::LagrangianLinearDiagonalDS
+      && !std::static_pointer_cast<SecondOrderDS>(ds)->boundaryConditions()
+      && fixedSizeInteractionBlock(*inter1, pos1, *inter2, pos2, sizeDS,
+                                   *getOSIMatrix(osi, ds), *currentInteractionBlock))
+  {
+    DEBUG_END("LinearOSNS::computeInteractionBlock(const InteractionsGraph::EDescriptor& ed)\n");
+    return;
+  }
+
   // get _interactionBlocks corresponding to the current DS
   // These _interactionBlocks depends on the relation type.
   leftInteractionBlock = inter1->getLeftInteractionBlockForDS(pos1, nslawSize1, sizeDS);
@@ -887,6 +1021,7 @@ void LinearOSNS::computeq(double time)
 
 void LinearOSNS::computeM()
 {
+  SiconosProfiler::Timer timer("computeM");
   if (_assemblyType == REDUCED_BLOCK)
   {
 
@@ -896,42 +1031,32 @@ void LinearOSNS::computeM()
     updateInteractionBlocks();
 
     //    _M->fill(indexSet);
-    _M->fillM(indexSet, !_hasBeenUpdated);
+    if(!_hasBeenUpdated && _incrementalAssembly
+        && simulation()->nonSmoothDynamicalSystem()->isLinear())
+      _M->updateM(indexSet);
+    else
+      _M->fillM(indexSet, !_hasBeenUpdated);
 
   }
   else if (_assemblyType ==REDUCED_DIRECT)
   {
     InteractionsGraph& indexSet = *simulation()->indexSet(indexSetLevel());
     DynamicalSystemsGraph& DSG0 = *simulation()->nonSmoothDynamicalSystem()->dynamicalSystems();
-#ifdef WITH_TIMER
-    std::chrono::time_point<std::chrono::system_clock> start, end, end_old;
-    start = std::chrono::system_clock::now();
-#endif
     // fill _Winverse
-    _W_inverse->fillWinverse(DSG0);
-#ifdef WITH_TIMER
-    end = std::chrono::system_clock::now();
-    int elapsed = std::chrono::duration_cast<std::chrono::microseconds> (end-start).count();
-    std::cout << "\nLinearOSNS: fill W inverse " << elapsed << " ms" << std::endl;
-#endif
+    {
+      SiconosProfiler::Timer timer("fillWinverse");
+      _W_inverse->fillWinverse(DSG0);
+    }
     // fill H
-    _H->fillHtrans(DSG0, indexSet);
-#ifdef WITH_TIMER
-    end_old=end;
-    end = std::chrono::system_clock::now();
-    elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-      (end-end_old).count();
-    std::cout << "LinearOSNS: FillH " << elapsed << " ms" << std::endl;
-#endif
+    {
+      SiconosProfiler::Timer timer("fillH");
+      _H->fillHtrans(DSG0, indexSet);
+    }
     // ComputeM
-    _M->computeM(_W_inverse->numericsMatrix(), _H->numericsMatrix());
-#ifdef WITH_TIMER
-    end_old=end;
-    end = std::chrono::system_clock::now();
-    elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-      (end-end_old).count();
-    std::cout << "LinearOSNS: _computeM " << elapsed << " ms" << std::endl;
-#endif
+    {
+      SiconosProfiler::Timer timer("productHtWinvH");
+      _M->computeM(_W_inverse->numericsMatrix(), _H->numericsMatrix());
+    }
   }
   else
     THROW_EXCEPTION("LinearOSNS::computeM unknown _assemblyTYPE");
@@ -948,6 +1073,7 @@ void LinearOSNS::computeM()
 bool LinearOSNS::preCompute(double time)
 {
   DEBUG_BEGIN("bool LinearOSNS::preCompute(double time)\n");
+  SiconosProfiler::Timer timer("preCompute");
   // This function is used to prepare data for the
   // LinearComplementarityProblem
 
@@ -979,19 +1105,10 @@ bool LinearOSNS::preCompute(double time)
     DEBUG_END("bool LinearOSNS::preCompute(double time)\n");
     return false;
   }
-#ifdef WITH_TIMER
-  std::chrono::time_point<std::chrono::system_clock> start, end, end_old;
-  start = std::chrono::system_clock::now();
-#endif
   if(!_hasBeenUpdated || !isLinear)
   {
 
     computeM();
-#ifdef WITH_TIMER
-    end = std::chrono::system_clock::now();
-    elapsed = std::chrono::duration_cast<std::chrono::microseconds> (end-start).count();
-    std::cout << "\nLinearOSNS: ComputeM " << elapsed << " ms" << std::endl;
-#endif
     //      updateOSNSMatrix();
     _sizeOutput = _M->size();
 
@@ -1044,22 +1161,11 @@ bool LinearOSNS::preCompute(double time)
   }
   // else
   // nothing to do (IsLinear and not changed)
-#ifdef WITH_TIMER
-  end_old=end;
-  end = std::chrono::system_clock::now();
-  elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-    (end-end_old).count();
-  std::cout << "LinearOSNS: init w and z " << elapsed << " ms" << std::endl;
-#endif
   // Computes q of LinearOSNS
-  computeq(time);
-#ifdef WITH_TIMER
-  end_old=end;
-  end = std::chrono::system_clock::now();
-  elapsed = std::chrono::duration_cast<std::chrono::microseconds>
-    (end-end_old).count();
-  std::cout << "LinearOSNS: compute q " << elapsed << " ms" << std::endl;
-#endif
+  {
+    SiconosProfiler::Timer timer("computeq");
+    computeq(time);
+  }
   DEBUG_END("bool LinearOSNS::preCompute(double time)\n");
   return true;
 
@@ -1068,6 +1174,7 @@ bool LinearOSNS::preCompute(double time)
 void LinearOSNS::postCompute()
 {
   DEBUG_BEGIN("void LinearOSNS::postCompute()\n");
+  SiconosProfiler::Timer timer("postCompute");
   // This function is used to set y/lambda values using output from
   // lcp_driver (w,z).  Only Interactions (ie Interactions) of
   // indexSet(leveMin) are concerned.
@@ -88,6 +88,10 @@ protected:
       size */
   bool _keepLambdaAndYState = true;
 
+  /** if true, the blocks of M (NM_SPARSE_BLOCK storage) are copied into
+      a contiguous storage handed to the solver */
+  bool _packedMBlocks = false;
+
   /** nslaw effects : visitors experimentation
    */
   struct _TimeSteppingNSLEffect;
@@ -234,6 +238,13 @@ public:
       const InteractionsGraph::VDescriptor &vd) override;
   ;
 
+  /** check that the nonsmooth law of an Interaction is compatible with
+   * the problem (sequentially, see checkCompatibleNSLaw)
+   * \param vd a vertex descriptor
+   */
+  void prepareDiagonalInteractionBlock(
+      const InteractionsGraph::VDescriptor &vd) override;
+
   /** compute matrix M
    */
   virtual void computeM();
@@ -274,6 +285,17 @@ public:
   */
   void setKeepLambdaAndYState(bool val) { _keepLambdaAndYState = val; }
 
+  /** choose how the blocks of M are handed to the solver when M is stored
+      with NM_SPARSE_BLOCK (ignored for the other storages).
+      \param val true: copy them into a single contiguous storage at each
+      step, false (default): link the solver to the interaction blocks.
+      See BlockCSRMatrix::setPackedBlocks.
+  */
+  void setPackedMBlocks(bool val);
+
+  /** \return true if the blocks of M are copied into a contiguous storage */
+  bool packedMBlocks() const { return _packedMBlocks; }
+
   virtual bool checkCompatibleNSLaw(NonSmoothLaw &nslaw) = 0;
 
   /* visitors hook */
@@ -79,6 +79,8 @@ LsodarOSI::LsodarOSI():
   _itol=1;
   _intData.resize(9);
   for(int i = 0; i < 9; i++) _intData[i] = 0;
+  _intData[8] = 2; // jt, internally generated full Jacobian
+  _halfBandwidth = 0;
   _sizeMem = 2;
   _steps=1;
 
@@ -150,8 +152,12 @@ void LsodarOSI::updateData()
   // Used to update some data (iwork ...) when _intData is modified.
   // Warning: it only checks sizes and possibly reallocate memory, but no values are set.
 
+  // The optional inputs (first ten values of iwork and rwork) are kept.
+  SA::integer oldIwork = iwork;
   iwork.reset(new integer[_intData[7]]);
   for(int i = 0; i < _intData[7]; i++) iwork[i] = 0;
+  if(oldIwork)
+    for(int i = 0; i < 10; i++) iwork[i] = oldIwork[i];
 
   // This is for documentation purposes only
   // Set the flag to generate extra printing at method switches.
@@ -165,14 +171,40 @@ void LsodarOSI::updateData()
   // Set   the maximum order to be allowed for the stiff  (BDF) method.
   //iwork[8] = 0;
 
+  SA::doublereal oldRwork = rwork;
   rwork.reset(new doublereal[_intData[6]]);
   for(int i = 0; i < _intData[6]; i++) rwork[i] = 0.0;
+  if(oldRwork)
+    for(int i = 0; i < 10; i++) rwork[i] = oldRwork[i];
 
   jroot.reset(new integer[_intData[1]]);
   for(int i = 0; i < _intData[1]; i++) jroot[i] = 0;
 
 }
 
+void LsodarOSI::updateWorkSizes()
+{
+  integer neq = _intData[0];
+  integer ng = _intData[1];
+  // 5 - lrw, size of rwork
+  if(_intData[8] >= 4)  // banded Jacobian: (2 ML + MU + 1) NEQ values for the matrix
+    _intData[6] = 22 + neq * std::max(16, 10 + 3 * (int)_halfBandwidth) + 3 * ng;
+  else
+    _intData[6] = 22 + neq * std::max(16, (int)neq + 9) + 3 * ng;
+  // 6 - liw, size of iwork
+  _intData[7] = 20 + neq;
+
+  // memory allocation for doublereal*, according to _intData values
+  updateData();
+}
+
+void LsodarOSI::setJT(integer newJT)
+{
+  _intData[8] = newJT;
+  if(rwork)
+    updateWorkSizes();
+}
+
 void LsodarOSI::fillXWork(integer* sizeOfX, doublereal* x)
 {
   assert((unsigned int)(*sizeOfX) == _xWork->size() && "LsodarOSI::fillXWork xWork and sizeOfX have different sizes");
@@ -243,7 +275,7 @@ void LsodarOSI::g(integer* nEq, doublereal*  time, doublereal* x, integer* ng, d
 
 void LsodarOSI::jacobianfx(integer* sizeOfX, doublereal* time, doublereal* x, integer* ml, integer* mu,  doublereal* jacob, integer* nrowpd)
 {
-  std::static_pointer_cast<EventDriven>(_simulation)->computeJacobianfx(*this, sizeOfX, time, x, jacob);
+  std::static_pointer_cast<EventDriven>(_simulation)->computeJacobianfx(*this, sizeOfX, time, x, mu, jacob, nrowpd);
 }
 
 
@@ -276,17 +308,15 @@ void LsodarOSI::initializeWorkVectorsForDS(double t, SP::DynamicalSystem ds)
   }
   ds->swapInMemory();
 
+  // The dynamical systems are not coupled in the jacobian of the
+  // vector field, the band contains the largest diagonal block.
+  _halfBandwidth = std::max(_halfBandwidth, (integer)ds->n() - 1);
+
   // Update necessary data
 
   // 1 - Neq; x vector size.
   _intData[0] = _xWork->size();
-  // 5 - lrw, size of rwork
-  _intData[6] = 22 + _intData[0] * std::max(16, (int)_intData[0] + 9) + 3 * _intData[1];
-  // 6 - liw, size of iwork
-  _intData[7] = 20 + _intData[0];
-
-  // memory allocation for doublereal*, according to _intData values
-  updateData();
+  updateWorkSizes();
 
   _xtmp.reset(new SiconosVector(_xWork->size()));
 
@@ -450,8 +480,8 @@ void LsodarOSI::initialize()
 
 
 
-  // 7 - JT, Jacobian type indicator
-  _intData[8] = 2;   // jt, Jacobian type indicator.
+  // 7 - JT, Jacobian type indicator (set in the constructor or with setJT)
+  // jt, Jacobian type indicator.
   //           1 means a user-supplied full (NEQ by NEQ) Jacobian.
   //           2 means an internally generated (difference quotient) full Jacobian (using NEQ extra calls to f per df/dx value).
   //           4 means a user-supplied banded Jacobian.
@@ -474,6 +504,9 @@ void LsodarOSI::initialize()
   //   2     scalar     array      RTOL*ABS(Y(i)) + ATOL(i)
   //   3     array      scalar     RTOL(i)*ABS(Y(i)) + ATOL
   //   4     array      array      RTOL(i)*ABS(Y(i)) + ATOL(i)
+
+  // work arrays sizes, now that Ng is known
+  updateWorkSizes();
   DEBUG_END("LsodarOSI::initialize()\n");
 }
 
@@ -513,6 +546,13 @@ void LsodarOSI::integrate(double& tinit, double& tend, double& tout, int& istate
 
   _intData[4] = istate;
 
+  if(_intData[8] >= 4)
+  {
+    // ML and MU, half-bandwidths of the banded Jacobian
+    iwork[0] = _halfBandwidth;
+    iwork[1] = _halfBandwidth;
+  }
+
 #ifdef HAS_FORTRAN
   // call LSODAR to integrate dynamical equation
   CNAME(dlsodar)(pointerToF,
@@ -35,7 +35,8 @@
  * description of these parameters.  \n Most of them are read-only parameters
  * (ie can not be set by user). \n Except: \n
  *  - jt: Jacobian type indicator (1 means a user-supplied full Jacobian, 2
- * means an internally generated full Jacobian). \n Default = 2.
+ * means an internally generated full Jacobian, 4 and 5 the same with a banded
+ * Jacobian). \n Default = 2.
  *  - itol, rtol and atol \n
  *    ITOL   = an indicator for the type of error control. \n
  *    RTOL   = a relative error tolerance parameter, either a scalar or array of
@@ -58,6 +59,10 @@ private:
   /** Type of tolerances */
   unsigned int _itol;
 
+  /** half-bandwidths (ML = MU) of the banded Jacobian, size of the largest
+   * dynamical system minus one */
+  integer _halfBandwidth;
+
   /** relative tolerance */
   SA::doublereal rtol;
   /** absolute tolerance */
@@ -155,12 +160,20 @@ public:
    * extra calls to f per df/dy value). 4 means a user-supplied banded jacobian.
    *    5 means an internally generated banded jacobian (using
    *      ml+mu+1 extra calls to f per df/dy evaluation).
-   *  if jt = 1 or 4, the user must supply a subroutine jac
-   *  (the name is arbitrary) as described above under jac.
-   *  if jt = 2 or 5, a dummy argument can be used.
+   *  if jt = 1 or 4, the jacobian is computed by the dynamical systems
+   *  (see EventDriven::computeJacobianfx).
+   *  With 4 or 5, the half-bandwidths are the size of the largest dynamical
+   *  system minus one, so that the cost of the jacobian and of its
+   *  factorization depends on the size of the systems, not on their number.
+   *  The work arrays are resized if needed.
    *  \param newJT new value for the jt parameter.
    */
-  inline void setJT(integer newJT) { _intData[8] = newJT; };
+  void setJT(integer newJT);
+
+  /** get the half-bandwidths of the jacobian used when jt = 4 or 5
+   *  \return an integer
+   */
+  inline integer halfBandwidth() const { return _halfBandwidth; }
 
   /** set itol, rtol and atol (tolerance parameters for lsodar)
    *  \param newItol itol value
@@ -197,6 +210,10 @@ public:
    */
   void updateData();
 
+  /** compute lrw and liw from neq, ng and jt, and update the work arrays
+   */
+  void updateWorkSizes();
+
   /** fill xWork with a doublereal
    *  \param size size of x array
    *  \param array x array of double
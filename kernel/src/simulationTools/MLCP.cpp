@@ -16,6 +16,7 @@
  * limitations under the License.
 */
 #include "MLCP.hpp"
+#include "SiconosProfiler.hpp"
 #include "MixedComplementarityConditionNSL.hpp"
 #include "EqualityConditionNSL.hpp"
 #include "Simulation.hpp"
@@ -146,22 +147,19 @@ void MLCP::computeInteractionBlock(const InteractionsGraph::EDescriptor& ed)
   DEBUG_END("MLCP::computeInteractionBlock(const InteractionsGraph::EDescriptor& ed)\n")
 }
 
-void MLCP::computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)
+void MLCP::prepareDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd)
 {
-
+  LinearOSNS::prepareDiagonalInteractionBlock(vd);
+  // the blocks of the numerics problem follow the order of the index set
   SP::InteractionsGraph indexSet = simulation()->indexSet(indexSetLevel());
-  SP::DynamicalSystem DS1 = indexSet->properties(vd).source;
-  SP::DynamicalSystem DS2 = indexSet->properties(vd).target;
   SP::Interaction inter = indexSet->bundle(vd);
-
-  // commonDS here...
   if(!_hasBeenUpdated)
     computeOptions(inter, inter);
-  LinearOSNS::computeDiagonalInteractionBlock(vd);
 }
 
 int MLCP::solve()
 {
+  SiconosProfiler::Timer timer("solve");
   // Note FP : wrap call to numerics solver inside this function
   // for python API (e.g. to allow profiling without C struct handling)
 
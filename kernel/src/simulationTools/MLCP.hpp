@@ -133,10 +133,11 @@ public:
   void
   computeInteractionBlock(const InteractionsGraph::EDescriptor &ed) override;
 
-  /** compute diagonal Interaction block
+  /** add the equality and complementarity blocks of an Interaction to
+   * the numerics problem
    * \param vd a vertex descriptor
    */
-  void computeDiagonalInteractionBlock(
+  void prepareDiagonalInteractionBlock(
       const InteractionsGraph::VDescriptor &vd) override;
 
   /** Compute the unknown z and w and update the Interaction (y and lambda )
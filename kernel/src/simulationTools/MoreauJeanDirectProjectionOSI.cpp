@@ -195,6 +195,18 @@ void MoreauJeanDirectProjectionOSI::computeFreeState()
   MoreauJeanOSI::computeFreeState();
 }
 
+double MoreauJeanDirectProjectionOSI::timeBeforeActivation(SP::Interaction inter, unsigned int i,
+    double maxApproachVelocity)
+{
+#if defined(FIRSTWAY_ACTIVATION) || defined(SECONDWAY_ACTIVATION)
+  return _timeBeforeActivation(inter, i, maxApproachVelocity, _activateYPosThreshold);
+#elif defined(STANDARD_ACTIVATION)
+  return MoreauJeanOSI::timeBeforeActivation(inter, i, maxApproachVelocity);
+#else
+  return 0.0;
+#endif
+}
+
 #ifdef STANDARD_ACTIVATION
 bool MoreauJeanDirectProjectionOSI::addInteractionInIndexSet(SP::Interaction inter, unsigned int i)
 {
@@ -148,6 +148,16 @@ public:
   bool removeInteractionFromIndexSet(SP::Interaction inter,
                                      unsigned int i) override;
 
+  /** Lower bound of the time before the Interaction may be included in the
+   * IndexSet of level i
+   * \param inter concerned interaction
+   * \param i level
+   * \param maxApproachVelocity bound of the approach velocity
+   * \return double
+   */
+  double timeBeforeActivation(SP::Interaction inter, unsigned int i,
+                              double maxApproachVelocity) override;
+
   /** Perform the integration of the dynamical systems linked to this integrator
    *  without taking into account the nonsmooth input (_r or _p)
    */
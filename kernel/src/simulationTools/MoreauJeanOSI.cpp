@@ -21,6 +21,7 @@
 #include "Simulation.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
 #include "NewtonEulerDS.hpp"
+#include "RigidBodyStateStore.hpp"
 #include "RotationQuaternion.hpp"
 #include "LagrangianLinearTIDS.hpp"
 #include "LagrangianLinearDiagonalDS.hpp"
@@ -39,6 +40,9 @@
 
 #include "BlockVector.hpp"
 
+#include <algorithm>
+#include <exception>
+
 // #define DEBUG_NOCOLOR
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES
@@ -64,7 +68,9 @@ MoreauJeanOSI::MoreauJeanOSI(double theta, double gamma):
   _constraintActivationThreshold(0.0),
   _useGammaForRelation(false),
   _explicitNewtonEulerDSOperators(false),
-  _isWSymmetricDefinitePositive(false)
+  _isWSymmetricDefinitePositive(false),
+  _loopPolicy(SEQUENTIAL_LOOP),
+  _useRigidBodyStateStore(false)
 {
   _levelMinForOutput= 0;
   _levelMaxForOutput =1;
@@ -610,6 +616,18 @@ SP::SimpleMatrix MoreauJeanOSI::Winverse(SP::SecondOrderDS ds, bool keepW)
 }
 
 
+std::vector<DynamicalSystemsGraph::VIterator> MoreauJeanOSI::_dsIterators()
+{
+  std::vector<DynamicalSystemsGraph::VIterator> dsis;
+  DynamicalSystemsGraph::VIterator dsi, dsend;
+  for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  {
+    if(checkOSI(dsi))
+      dsis.push_back(dsi);
+  }
+  return dsis;
+}
+
 void MoreauJeanOSI::computeInitialNewtonState()
 {
   DEBUG_BEGIN("MoreauJeanOSI::computeInitialNewtonState()\n");
@@ -704,10 +722,19 @@ double MoreauJeanOSI::computeResidu()
   double maxResidu = 0;
   double normResidu = maxResidu;
 
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  // see setLoopPolicy. Exceptions must not escape from the parallel loop:
+  // the first one is rethrown afterwards.
+  std::vector<DynamicalSystemsGraph::VIterator> dsis = _dsIterators();
+  std::exception_ptr error;
+  int nbDS = (int) dsis.size();
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic, 16) if(_loopPolicy == PARALLEL_LOOP) \
+    private(dsType) firstprivate(normResidu) reduction(max:maxResidu)
+#endif
+  for(int k = 0; k < nbDS; ++k)
+  try
   {
-    if(!checkOSI(dsi)) continue;
+    DynamicalSystemsGraph::VIterator dsi = dsis[k];
     DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
     VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(*dsi).workVectors;
 
@@ -1042,6 +1069,15 @@ double MoreauJeanOSI::computeResidu()
     if(normResidu > maxResidu) maxResidu = normResidu;
 
   }
+  catch(...)
+  {
+#ifdef WITH_OPENMP
+    #pragma omp critical(MoreauJeanOSI_error)
+#endif
+    if(!error) error = std::current_exception();
+  }
+  if(error)
+    std::rethrow_exception(error);
   DEBUG_END("MoreauJeanOSI::computeResidu()\n");
   return maxResidu;
 
@@ -1069,11 +1105,17 @@ void MoreauJeanOSI::computeFreeState()
   //SP::SiconosMatrix W; // W MoreauJeanOSI matrix of the current DS.
   Type::Siconos dsType ; // Type of the current DS.
 
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-
-  for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  // see setLoopPolicy and computeResidu
+  std::vector<DynamicalSystemsGraph::VIterator> dsis = _dsIterators();
+  std::exception_ptr error;
+  int nbDS = (int) dsis.size();
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic, 16) if(_loopPolicy == PARALLEL_LOOP) private(dsType)
+#endif
+  for(int k = 0; k < nbDS; ++k)
+  try
   {
-    if(!checkOSI(dsi)) continue;
+    DynamicalSystemsGraph::VIterator dsi = dsis[k];
     DynamicalSystem & ds = *_dynamicalSystemsGraph->bundle(*dsi);
     dsType = Type::value(ds); // Its type
     SiconosMatrix& W = *_dynamicalSystemsGraph->properties(*dsi).W; // Its W MoreauJeanOSI matrix of iteration.
@@ -1271,6 +1313,15 @@ void MoreauJeanOSI::computeFreeState()
     //   THROW_EXCEPTION("MoreauJeanOSI::computeFreeState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
 
   }
+  catch(...)
+  {
+#ifdef WITH_OPENMP
+    #pragma omp critical(MoreauJeanOSI_error)
+#endif
+    if(!error) error = std::current_exception();
+  }
+  if(error)
+    std::rethrow_exception(error);
   DEBUG_END("MoreauJeanOSI::computeFreeState()\n");
 }
 
@@ -1677,13 +1728,21 @@ void MoreauJeanOSI::updateState(const unsigned int)
 
   double RelativeTol = _simulation->relativeConvergenceTol();
   bool useRCC = _simulation->useRelativeConvergenceCriteron();
-  if(useRCC)
-    _simulation->setRelativeConvergenceCriterionHeld(true);
-
-  DynamicalSystemsGraph::VIterator dsi, dsend;
-  for(std::tie(dsi, dsend) = _dynamicalSystemsGraph->vertices(); dsi != dsend; ++dsi)
+  // the relative convergence criterion is reduced over the dynamical
+  // systems and given to the simulation after the loop.
+  bool RCCHeld = true;
+
+  // see setLoopPolicy and computeResidu
+  std::vector<DynamicalSystemsGraph::VIterator> dsis = _dsIterators();
+  std::exception_ptr error;
+  int nbDS = (int) dsis.size();
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic, 16) if(_loopPolicy == PARALLEL_LOOP) reduction(&&:RCCHeld)
+#endif
+  for(int k = 0; k < nbDS; ++k)
+  try
   {
-    if(!checkOSI(dsi)) continue;
+    DynamicalSystemsGraph::VIterator dsi = dsis[k];
     DynamicalSystem& ds = *_dynamicalSystemsGraph->bundle(*dsi);
 
     VectorOfVectors& ds_work_vectors = *_dynamicalSystemsGraph->properties(*dsi).workVectors;
@@ -1703,7 +1762,7 @@ void MoreauJeanOSI::updateState(const unsigned int)
 
       //    SiconosVector *vfree = d.velocityFree();
       SiconosVector& v = *d.velocity();
-      bool baux = dsType == Type::LagrangianDS && useRCC && _simulation->relativeConvergenceCriterionHeld();
+      bool baux = dsType == Type::LagrangianDS && useRCC && RCCHeld;
 
       if(d.p(_levelMaxForInput) && d.p(_levelMaxForInput)->size() > 0)
       {
@@ -1778,7 +1837,7 @@ void MoreauJeanOSI::updateState(const unsigned int)
         local_buffer -= q;
         double aux = (local_buffer.norm2()) / ds_norm_ref;
         if(aux > RelativeTol)
-          _simulation->setRelativeConvergenceCriterionHeld(false);
+          RCCHeld = false;
       }
     }
     else if(dsType == Type::NewtonEulerDS)
@@ -1852,12 +1911,45 @@ void MoreauJeanOSI::updateState(const unsigned int)
         }
       }
 
-      updatePosition(ds);
+      // with the store, the positions are updated after the loop
+      if(!_useRigidBodyStateStore)
+        updatePosition(ds);
 
     }
     else THROW_EXCEPTION("MoreauJeanOSI::updateState - not yet implemented for Dynamical system of type: " +  Type::name(ds));
 
   }
+  catch(...)
+  {
+#ifdef WITH_OPENMP
+    #pragma omp critical(MoreauJeanOSI_error)
+#endif
+    if(!error) error = std::current_exception();
+  }
+  if(error)
+    std::rethrow_exception(error);
+
+  if(_useRigidBodyStateStore)
+  {
+    // same theta-scheme as updatePosition, on a contiguous copy of the
+    // states of all the NewtonEulerDS
+    if(!_rigidBodyStateStore)
+      _rigidBodyStateStore.reset(new RigidBodyStateStore());
+    RigidBodyStateStore& store = *_rigidBodyStateStore;
+    store.clear();
+    for(int k = 0; k < nbDS; ++k)
+    {
+      SP::DynamicalSystem ds = _dynamicalSystemsGraph->bundle(*dsis[k]);
+      if(Type::value(*ds) == Type::NewtonEulerDS)
+        store.insert(std::static_pointer_cast<NewtonEulerDS>(ds));
+    }
+    store.gather();
+    store.integratePositions(_simulation->timeStep(), _theta);
+    store.scatter();
+  }
+
+  if(useRCC)
+    _simulation->setRelativeConvergenceCriterionHeld(RCCHeld);
   DEBUG_END("MoreauJeanOSI::updateState(const unsigned int)\n");
 }
 
@@ -1892,6 +1984,32 @@ bool MoreauJeanOSI::removeInteractionFromIndexSet(SP::Interaction inter, unsigne
   return !(addInteractionInIndexSet(inter, i));
 }
 
+double MoreauJeanOSI::_timeBeforeActivation(SP::Interaction inter, unsigned int i,
+                                            double maxApproachVelocity, double threshold)
+{
+  assert(i == 1);
+  double h = _simulation->timeStep();
+  double y = (inter->y(i - 1))->getValue(0);
+  double yDot = (inter->y(i))->getValue(0);
+  double gamma = 1.0 / 2.0;
+  if(_useGamma)
+  {
+    gamma = _gamma;
+  }
+  // While |yDot| <= v, y + gamma * h * yDot >= y - v * (t' - t) - gamma * h * v
+  // stays above the threshold for t' - t < (y - threshold) / v - gamma * h
+  double v = std::max(maxApproachVelocity, -yDot);
+  if(v <= 0.0)
+    return 0.0;
+  return std::max(0.0, (y - threshold) / v - gamma * h);
+}
+
+double MoreauJeanOSI::timeBeforeActivation(SP::Interaction inter, unsigned int i,
+                                           double maxApproachVelocity)
+{
+  return _timeBeforeActivation(inter, i, maxApproachVelocity, _constraintActivationThreshold);
+}
+
 
 
 void MoreauJeanOSI::display()
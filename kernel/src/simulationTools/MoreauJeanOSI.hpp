@@ -121,6 +121,13 @@ const unsigned int MOREAUSTEPSINMEMORY = 1;
  *
  */
 class MoreauJeanOSI : public OneStepIntegrator {
+public:
+  /** execution policies of the loops over the dynamical systems */
+  enum MoreauJeanOSI_loop_policy {
+    SEQUENTIAL_LOOP,
+    PARALLEL_LOOP
+  };
+
 protected:
   /** serialization hooks
    */
@@ -160,6 +167,35 @@ protected:
       we subprod in computeFreeOuput*/
   std::vector<std::size_t> _selected_coordinates;
 
+  /** execution policy of the loops over the dynamical systems
+   *  (computeFreeState, computeResidu and updateState)
+   */
+  MoreauJeanOSI_loop_policy _loopPolicy;
+
+  /** a boolean to update the positions of the NewtonEulerDS in one
+   *  batched loop over a RigidBodyStateStore (see setUseRigidBodyStateStore)
+   */
+  bool _useRigidBodyStateStore;
+
+  /** contiguous copy of the states of the NewtonEulerDS, used by
+   *  updateState when _useRigidBodyStateStore is true
+   */
+  SP::RigidBodyStateStore _rigidBodyStateStore;
+
+  /** \return the iterators of the dynamical systems integrated by this osi */
+  std::vector<DynamicalSystemsGraph::VIterator> _dsIterators();
+
+  /** lower bound of the time before y + gamma h yDot reaches a threshold,
+   *  given a bound of the approach velocity
+   *  \param inter the Interaction
+   *  \param i level of the IndexSet
+   *  \param maxApproachVelocity bound of the approach velocity
+   *  \param threshold the activation threshold
+   *  \return the time, 0 if no bound is known
+   */
+  double _timeBeforeActivation(SP::Interaction inter, unsigned int i,
+                               double maxApproachVelocity, double threshold);
+
   /** nslaw effects
    */
   // struct _NSLEffectOnFreeOutput;
@@ -341,6 +377,35 @@ public:
     _explicitNewtonEulerDSOperators = newExplicitNewtonEulerDSOperators;
   };
 
+  /** get the execution policy of the loops over the dynamical systems
+   *  \return SEQUENTIAL_LOOP or PARALLEL_LOOP
+   */
+  inline MoreauJeanOSI_loop_policy loopPolicy() const { return _loopPolicy; };
+
+  /** set the execution policy of the loops over the dynamical systems
+   *  in computeFreeState, computeResidu and updateState (and thus
+   *  updatePosition). With PARALLEL_LOOP, the dynamical systems are
+   *  processed concurrently (Siconos must be built WITH_OPENMP), hence
+   *  their plugins must be reentrant.
+   *  \param policy SEQUENTIAL_LOOP (default) or PARALLEL_LOOP
+   */
+  inline void setLoopPolicy(MoreauJeanOSI_loop_policy policy) { _loopPolicy = policy; };
+
+  /** get the boolean to update the positions of the NewtonEulerDS
+   *  through a RigidBodyStateStore
+   *  \return a Boolean
+   */
+  inline bool useRigidBodyStateStore() const { return _useRigidBodyStateStore; };
+
+  /** set the boolean to update the positions of the NewtonEulerDS
+   *  through a RigidBodyStateStore. updateState then gathers the
+   *  states of all the NewtonEulerDS, integrates the positions in one
+   *  flat loop (RigidBodyStateStore::integratePositions) and scatters
+   *  them back, instead of calling updatePosition for each body.
+   *  \param val a Boolean (default false)
+   */
+  inline void setUseRigidBodyStateStore(bool val) { _useRigidBodyStateStore = val; };
+
   // --- OTHER FUNCTIONS ---
 
   /** initialization of the MoreauJeanOSI integrator; for linear time
@@ -450,6 +515,17 @@ public:
   bool removeInteractionFromIndexSet(SP::Interaction inter,
                                      unsigned int i) override;
 
+  /** Lower bound of the time before the Interaction may be included in the
+   * IndexSet of level i, from its current gap and the largest of its current
+   * approach velocity and maxApproachVelocity
+   * \param inter the Interaction
+   * \param i level of the IndexSet
+   * \param maxApproachVelocity bound of the approach velocity
+   * \return the time
+   */
+  double timeBeforeActivation(SP::Interaction inter, unsigned int i,
+                              double maxApproachVelocity) override;
+
   /** method to prepare the fist Newton iteration
    *   \param time
    */
@@ -281,12 +281,43 @@ void OSNSMatrix::fillM(InteractionsGraph& indexSet, bool update)
       DEBUG_EXPR(_M2->display(););
     }
   }
-  if(update)
+  // packed blocks are copies of the interaction blocks: they must be
+  // refreshed even if the structure is unchanged.
+  if(update || (_storageType == NM_SPARSE_BLOCK && _M2->packedBlocks()))
     convert();
   DEBUG_END("void OSNSMatrix::fillM(SP::InteractionsGraph indexSet, bool update)\n");
 }
 
 // convert current matrix to NumericsMatrix structure
+void OSNSMatrix::updateM(InteractionsGraph& indexSet)
+{
+  DEBUG_BEGIN("void OSNSMatrix::updateM(InteractionsGraph& indexSet)\n");
+  if(_storageType != NM_SPARSE_BLOCK || !_M2)
+  {
+    fillM(indexSet, true);
+    DEBUG_END("void OSNSMatrix::updateM(InteractionsGraph& indexSet)\n");
+    return;
+  }
+
+  unsigned int first = _M2->update(indexSet);
+
+  // the rows before the first change keep their position
+  unsigned int dim = 0;
+  InteractionsGraph::VIterator vi, viend;
+  for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+  {
+    if(indexSet.index(*vi) >= first)
+      indexSet.properties(*vi).absolute_position = dim;
+    else
+      assert(indexSet.properties(*vi).absolute_position == dim);
+    dim += indexSet.bundle(*vi)->nonSmoothLaw()->size();
+  }
+  _dimRow = _dimColumn = dim;
+
+  convert();
+  DEBUG_END("void OSNSMatrix::updateM(InteractionsGraph& indexSet)\n");
+}
+
 void OSNSMatrix::convert()
 {
   DEBUG_BEGIN("OSNSMatrix::convert()\n");
@@ -234,12 +234,31 @@ public:
     return _M1;
   };
 
+  /** get the matrix used for NM_SPARSE_BLOCK storage
+   * (null for the other storages)
+   * \return SP::BlockCSRMatrix
+   */
+  inline SP::BlockCSRMatrix blockCSRMatrix()
+  {
+    return _M2;
+  };
+
   /** fill the current class using an index set
    * \param indexSet the index set of the active constraints
    * \param update if true update the size of the Matrix (default true)
    */
   virtual void fillM(InteractionsGraph&indexSet, bool update = true);
 
+  /** update the current class after a change of the index set used by the
+   * last call to fillM (same result as fillM(indexSet, true)). With the
+   * NM_SPARSE_BLOCK storage, the blocks of the Interactions that remain
+   * in the index set are kept, see BlockCSRMatrix::update, and the
+   * positions are only set from the first row that moved. The other
+   * storages are filled again.
+   * \param indexSet the index set of the active constraints
+   */
+  virtual void updateM(InteractionsGraph& indexSet);
+
 
   /** Compute the M matrix given the inverse of W and H
    * \param Winverse the NumericsMatrix that contains the inverse of W
@@ -132,6 +132,15 @@ public:
   */
   void fillM(InteractionsGraph& indexSet, bool update = true);
 
+  /** fill the current class using an index set (the sizes of the blocks
+      are the ones of the projection, see computeSizeForProjection)
+      \param indexSet the index set of the active constraints
+  */
+  void updateM(InteractionsGraph& indexSet) override
+  {
+    fillM(indexSet, true);
+  };
+
 };
 
 DEFINE_SPTR(OSNSMatrixProjectOnConstraints)
@@ -430,6 +430,21 @@ public:
     return 0;
   };
 
+  /** Lower bound of the time before an Interaction out of the IndexSet of
+   * level i may be included in it (see addInteractionInIndexSet), used by the
+   * incremental update of the index sets of TimeStepping.
+   * \param inter the Interaction
+   * \param i level of the IndexSet
+   * \param maxApproachVelocity bound of the velocity at which the gap of the
+   * Interaction may decrease
+   * \return 0 by default, the Interaction is tested at each step
+   */
+  virtual double timeBeforeActivation(SP::Interaction inter, unsigned int i,
+                                      double maxApproachVelocity)
+  {
+    return 0.0;
+  };
+
   /** get the ExtraAdditionalTerms.
    * \return the ExtraAdditionalTerms
    */
@@ -33,6 +33,8 @@
 #include "NonSmoothLaw.hpp"
 #include "Simulation.hpp"
 
+#include <exception>
+
 // #define DEBUG_STDOUT
 // #define DEBUG_MESSAGES
 #include "siconos_debug.h"
@@ -75,26 +77,49 @@ void OneStepNSProblem::updateInteractionBlocks()
 
   bool isLinear = simulation()->nonSmoothDynamicalSystem()->isLinear();
 
+  // In the incremental case, the blocks that have been kept in the
+  // index set are still valid and only the new ones are computed.
+  bool incremental = _incrementalAssembly && isLinear;
+
   // we put diagonal information on vertices
   // self loops with bgl are a *nightmare* at the moment
   // (patch 65198 on standard boost install)
   if(indexSet->properties().symmetric)
   {
     DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Symmetric case");
+
+    // In the parallel case, the loops below only allocate (and zero) the
+    // blocks and record the ones to be computed. The computations are done
+    // afterwards, see computeInteractionBlocksInParallel. What modifies
+    // the problem itself (prepareDiagonalInteractionBlock) stays in the
+    // sequential loop.
+    bool parallel = _parallelAssembly && isParallelAssemblySafe(*indexSet);
+    std::vector<InteractionsGraph::VDescriptor> vertexTasks;
+    std::vector<std::vector<std::pair<InteractionsGraph::EDescriptor, bool> > > edgeTasks;
+    std::vector<int> edgeTaskOf;
+    if(parallel)
+      edgeTaskOf.resize(indexSet->edges_number(), -1);
+
     InteractionsGraph::VIterator vi, viend;
     for(std::tie(vi, viend) = indexSet->vertices();
         vi != viend; ++vi)
     {
       SP::Interaction inter = indexSet->bundle(*vi);
       unsigned int nslawSize = inter->nonSmoothLaw()->size();
+      bool newBlock = false;
       if(! indexSet->properties(*vi).block)
       {
         indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
+        newBlock = true;
       }
 
-      if(!isLinear || !_hasBeenUpdated)
+      prepareDiagonalInteractionBlock(*vi);
+      if(!isLinear || (!_hasBeenUpdated && (!incremental || newBlock)))
       {
-        computeDiagonalInteractionBlock(*vi);
+        if(parallel)
+          vertexTasks.push_back(*vi);
+        else
+          computeDiagonalInteractionBlock(*vi);
       }
     }
 
@@ -103,6 +128,9 @@ void OneStepNSProblem::updateInteractionBlocks()
     initialized.resize(indexSet->edges_number());
     std::fill(initialized.begin(), initialized.end(), false);
 
+    /* interactionBlocks allocated in this call */
+    std::vector<bool> newBlocks(indexSet->edges_number(), false);
+
     InteractionsGraph::EIterator ei, eiend;
     for(std::tie(ei, eiend) = indexSet->edges();
         ei != eiend; ++ei)
@@ -132,6 +160,7 @@ void OneStepNSProblem::updateInteractionBlocks()
         if(! indexSet->properties(ed1).upper_block)
         {
           indexSet->properties(ed1).upper_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
+          newBlocks[indexSet->index(ed1)] = true;
           if(ed2 != ed1)
             indexSet->properties(ed2).upper_block = indexSet->properties(ed1).upper_block;
         }
@@ -142,56 +171,50 @@ void OneStepNSProblem::updateInteractionBlocks()
         if(! indexSet->properties(ed1).lower_block)
         {
           indexSet->properties(ed1).lower_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
+          newBlocks[indexSet->index(ed1)] = true;
           if(ed2 != ed1)
             indexSet->properties(ed2).lower_block = indexSet->properties(ed1).lower_block;
         }
         currentInteractionBlock = indexSet->properties(ed1).lower_block;
       }
 
-      if(!initialized[indexSet->index(ed1)])
+      bool computeBlock = !isLinear ||
+        (!_hasBeenUpdated && (!incremental || newBlocks[indexSet->index(ed1)]));
+
+      if(computeBlock && !initialized[indexSet->index(ed1)])
       {
         initialized[indexSet->index(ed1)] = true;
         currentInteractionBlock->zero();
       }
-      if(!isLinear || !_hasBeenUpdated)
+      if(computeBlock)
       {
+        if(parallel)
         {
-          computeInteractionBlock(*ei);
-        }
-
-        // allocation for transposed block
-        // should be avoided
-
-        if(itar > isrc)  // upper block has been computed
-        {
-          if(!indexSet->properties(ed1).lower_block)
+          // edges sharing the same block are computed by the same task, in
+          // the order of the serial loop.
+          int& task = edgeTaskOf[indexSet->index(ed1)];
+          if(task < 0)
           {
-            indexSet->properties(ed1).lower_block.
-            reset(new SimpleMatrix(indexSet->properties(ed1).upper_block->size(1),
-                                   indexSet->properties(ed1).upper_block->size(0)));
+            task = edgeTasks.size();
+            edgeTasks.emplace_back();
           }
-          indexSet->properties(ed1).lower_block->trans(*indexSet->properties(ed1).upper_block);
-          indexSet->properties(ed2).lower_block = indexSet->properties(ed1).lower_block;
+          edgeTasks[task].push_back(std::make_pair(*ei, itar > isrc));
         }
         else
-        {
-          assert(itar < isrc);    // lower block has been computed
-          if(!indexSet->properties(ed1).upper_block)
-          {
-            indexSet->properties(ed1).upper_block.
-            reset(new SimpleMatrix(indexSet->properties(ed1).lower_block->size(1),
-                                   indexSet->properties(ed1).lower_block->size(0)));
-          }
-          indexSet->properties(ed1).upper_block->trans(*indexSet->properties(ed1).lower_block);
-          indexSet->properties(ed2).upper_block = indexSet->properties(ed1).upper_block;
-        }
+          computeSymmetricInteractionBlock(*indexSet, *ei, itar > isrc);
       }
     }
+
+    if(parallel)
+      computeInteractionBlocksInParallel(*indexSet, vertexTasks, edgeTasks);
   }
   else // not symmetric => follow out_edges for each vertices
   {
     DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Non symmetric case\n");
 
+    /* interactionBlocks allocated in this call */
+    std::set<SP::SiconosMatrix> newBlocks;
+
     InteractionsGraph::VIterator vi, viend;
     for(std::tie(vi, viend) = indexSet->vertices();
         vi != viend; ++vi)
@@ -199,12 +222,15 @@ void OneStepNSProblem::updateInteractionBlocks()
       DEBUG_PRINT("OneStepNSProblem::updateInteractionBlocks(). Computation of diaganal block\n");
       SP::Interaction inter = indexSet->bundle(*vi);
       unsigned int nslawSize = inter->nonSmoothLaw()->size();
+      bool newBlock = false;
       if(! indexSet->properties(*vi).block)
       {
         indexSet->properties(*vi).block.reset(new SimpleMatrix(nslawSize, nslawSize));
+        newBlock = true;
       }
 
-      if(!isLinear || !_hasBeenUpdated)
+      prepareDiagonalInteractionBlock(*vi);
+      if(!isLinear || (!_hasBeenUpdated && (!incremental || newBlock)))
       {
         computeDiagonalInteractionBlock(*vi);
       }
@@ -270,6 +296,7 @@ void OneStepNSProblem::updateInteractionBlocks()
           {
             indexSet->properties(ed1).upper_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
             initialized[indexSet->properties(ed1).upper_block] = false;
+            newBlocks.insert(indexSet->properties(ed1).upper_block);
             if(ed2 != ed1)
               indexSet->properties(ed2).upper_block = indexSet->properties(ed1).upper_block;
           }
@@ -282,6 +309,7 @@ void OneStepNSProblem::updateInteractionBlocks()
           {
             indexSet->properties(ed1).lower_block.reset(new SimpleMatrix(nslawSize1, nslawSize2));
             initialized[indexSet->properties(ed1).lower_block] = false;
+            newBlocks.insert(indexSet->properties(ed1).lower_block);
             if(ed2 != ed1)
               indexSet->properties(ed2).lower_block = indexSet->properties(ed1).lower_block;
           }
@@ -289,13 +317,16 @@ void OneStepNSProblem::updateInteractionBlocks()
         }
 
 
-        if(!initialized[currentInteractionBlock])
+        bool computeBlock = !isLinear ||
+          (!_hasBeenUpdated && (!incremental || newBlocks.count(currentInteractionBlock)));
+
+        if(computeBlock && !initialized[currentInteractionBlock])
         {
           initialized[currentInteractionBlock] = true;
           currentInteractionBlock->zero();
         }
 
-        if(!isLinear || !_hasBeenUpdated)
+        if(computeBlock)
         {
           if(isrc != itar)
             computeInteractionBlock(*oei);
@@ -370,6 +401,136 @@ void OneStepNSProblem::initialize(SP::Simulation sim)
     _maxSize = simulation()->nonSmoothDynamicalSystem()->topology()->numberOfConstraints();
 }
 
+void OneStepNSProblem::computeSymmetricInteractionBlock(InteractionsGraph& indexSet,
+    const InteractionsGraph::EDescriptor& ed, bool upper)
+{
+  computeInteractionBlock(ed);
+
+  /* on adjoint graph there is at most 2 edges between source and target */
+  InteractionsGraph::EDescriptor ed1, ed2;
+  std::tie(ed1, ed2) = indexSet.edges(indexSet.source(ed), indexSet.target(ed));
+
+  // allocation for transposed block
+  // should be avoided
+
+  if(upper)  // upper block has been computed
+  {
+    if(!indexSet.properties(ed1).lower_block)
+    {
+      indexSet.properties(ed1).lower_block.
+      reset(new SimpleMatrix(indexSet.properties(ed1).upper_block->size(1),
+                             indexSet.properties(ed1).upper_block->size(0)));
+    }
+    indexSet.properties(ed1).lower_block->trans(*indexSet.properties(ed1).upper_block);
+    indexSet.properties(ed2).lower_block = indexSet.properties(ed1).lower_block;
+  }
+  else  // lower block has been computed
+  {
+    if(!indexSet.properties(ed1).upper_block)
+    {
+      indexSet.properties(ed1).upper_block.
+      reset(new SimpleMatrix(indexSet.properties(ed1).lower_block->size(1),
+                             indexSet.properties(ed1).lower_block->size(0)));
+    }
+    indexSet.properties(ed1).upper_block->trans(*indexSet.properties(ed1).lower_block);
+    indexSet.properties(ed2).upper_block = indexSet.properties(ed1).upper_block;
+  }
+}
+
+bool OneStepNSProblem::isParallelAssemblySafe(InteractionsGraph& indexSet)
+{
+  // The blocks computations of different interactions only share the
+  // iteration matrices of the dynamical systems. They are read-only once
+  // factorized, provided that they are dense and owned by the integrator
+  // (getOSIMatrix returns a link and not a copy).
+  DynamicalSystemsGraph& DSG0 = *simulation()->nonSmoothDynamicalSystem()->dynamicalSystems();
+  InteractionsGraph::VIterator vi, viend;
+  for(std::tie(vi, viend) = indexSet.vertices(); vi != viend; ++vi)
+  {
+    SP::DynamicalSystem ds1 = indexSet.properties(*vi).source;
+    SP::DynamicalSystem ds2 = indexSet.properties(*vi).target;
+    bool endl = false;
+    for(SP::DynamicalSystem ds = ds1; !endl; ds = ds2)
+    {
+      endl = (ds == ds2);
+      OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds)).osi;
+      OSI::TYPES osiType = osi.getType();
+      if(osiType != OSI::MOREAUJEANOSI
+          && osiType != OSI::MOREAUDIRECTPROJECTIONOSI
+          && osiType != OSI::MOREAUJEANBILBAOOSI
+          && osiType != OSI::SCHATZMANPAOLIOSI
+          && osiType != OSI::EULERMOREAUOSI)
+        return false;
+
+      // these ones store the inverse of the iteration matrix and are only
+      // used through products.
+      if(osiType == OSI::MOREAUJEANBILBAOOSI
+          || Type::value(*ds) == Type::LagrangianLinearDiagonalDS)
+        continue;
+
+      SP::SimpleMatrix W = getOSIMatrix(osi, ds);
+      if(!W || W->num() != Siconos::DENSE)
+        return false;
+      if(!W->isFactorized())
+        W->Factorize();
+    }
+  }
+  return true;
+}
+
+void OneStepNSProblem::computeInteractionBlocksInParallel(InteractionsGraph& indexSet,
+    const std::vector<InteractionsGraph::VDescriptor>& vertexTasks,
+    const std::vector<std::vector<std::pair<InteractionsGraph::EDescriptor, bool> > >& edgeTasks)
+{
+  DEBUG_PRINTF("OneStepNSProblem::computeInteractionBlocksInParallel(), %zu vertices, %zu edges groups\n",
+               vertexTasks.size(), edgeTasks.size());
+
+  // exceptions must not escape from the parallel regions.
+  std::exception_ptr error;
+
+  int nv = (int) vertexTasks.size();
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for(int i = 0; i < nv; ++i)
+  {
+    try
+    {
+      computeDiagonalInteractionBlock(vertexTasks[i]);
+    }
+    catch(...)
+    {
+#ifdef WITH_OPENMP
+      #pragma omp critical(OneStepNSProblem_error)
+#endif
+      if(!error) error = std::current_exception();
+    }
+  }
+
+  int ne = (int) edgeTasks.size();
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for(int i = 0; i < ne; ++i)
+  {
+    try
+    {
+      for(auto& task : edgeTasks[i])
+        computeSymmetricInteractionBlock(indexSet, task.first, task.second);
+    }
+    catch(...)
+    {
+#ifdef WITH_OPENMP
+      #pragma omp critical(OneStepNSProblem_error)
+#endif
+      if(!error) error = std::current_exception();
+    }
+  }
+
+  if(error)
+    std::rethrow_exception(error);
+}
+
 SP::SimpleMatrix OneStepNSProblem::getOSIMatrix(OneStepIntegrator& Osi, SP::DynamicalSystem ds)
 {
   // Returns the integration matrix from one-step integrator and dynamical system.
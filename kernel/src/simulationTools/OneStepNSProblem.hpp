@@ -107,6 +107,46 @@ protected:
   /*During Newton it, this flag allows to update the numerics matrices only once if necessary.*/
   bool _hasBeenUpdated = false;
 
+  /** If true and the nonsmooth dynamical system is linear, a change of
+   *  topology only triggers the computation of the interaction blocks of
+   *  the vertices and edges that entered the index set since the last
+   *  assembly. The blocks of the other ones are kept as they are.
+   */
+  bool _incrementalAssembly = false;
+
+  /** If true, the interaction blocks are computed concurrently (with
+   *  OpenMP when available). The result is the same as the one of the
+   *  serial computation.
+   */
+  bool _parallelAssembly = false;
+
+  /** compute the block of an edge of a symmetric index set and
+   *  update the transposed block
+   *  \param indexSet the index set
+   *  \param ed the edge
+   *  \param upper true if the upper block is computed
+   */
+  void computeSymmetricInteractionBlock(InteractionsGraph& indexSet,
+                                        const InteractionsGraph::EDescriptor& ed,
+                                        bool upper);
+
+  /** check that the interaction blocks of the index set can be computed
+   *  concurrently and factorize the iteration matrices that will be used
+   *  \param indexSet the index set
+   *  \return true if the blocks can be computed in parallel
+   */
+  bool isParallelAssemblySafe(InteractionsGraph& indexSet);
+
+  /** compute the given interaction blocks in parallel. The edges of each
+   *  group share the same block and are computed sequentially.
+   *  \param indexSet the index set
+   *  \param vertexTasks the vertices to be computed
+   *  \param edgeTasks the groups of edges to be computed, with the upper flag
+   */
+  void computeInteractionBlocksInParallel(InteractionsGraph& indexSet,
+      const std::vector<InteractionsGraph::VDescriptor>& vertexTasks,
+      const std::vector<std::vector<std::pair<InteractionsGraph::EDescriptor, bool> > >& edgeTasks);
+
   // --- CONSTRUCTORS/DESTRUCTOR ---
   /** default constructor */
   OneStepNSProblem() = default;
@@ -248,6 +288,16 @@ public:
    */
   virtual void computeDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd) = 0;
 
+  /** prepare the computation of a diagonal Interaction block. It is called
+   * by updateInteractionBlocks for all the vertices of the index set,
+   * sequentially and in the order of the index set, even if the block
+   * itself is kept (incremental assembly) or computed in parallel. The
+   * problems whose description depends on the list of interactions
+   * (MLCP, GenericMechanical) build it here.
+   * \param vd a vertex descriptor
+   */
+  virtual void prepareDiagonalInteractionBlock(const InteractionsGraph::VDescriptor& vd) {};
+
   /**
    * \return bool _hasBeenUpdated
    */
@@ -264,6 +314,47 @@ public:
     _hasBeenUpdated = v;
   }
 
+  /**
+   * \return true if the interaction blocks are assembled incrementally
+   */
+  bool incrementalAssembly() const
+  {
+    return _incrementalAssembly;
+  }
+
+  /** set the incremental assembly of the interaction blocks. When the
+   *  topology changes, only the blocks of new interactions (and new couples
+   *  of interactions) are computed. This is valid only if the blocks
+   *  of the interactions that remain in the index set do not change,
+   *  hence it has no effect if the nonsmooth dynamical system is not
+   *  linear.
+   * \param v true to enable the incremental assembly
+   */
+  void setIncrementalAssembly(bool v)
+  {
+    _incrementalAssembly = v;
+  }
+
+  /**
+   * \return true if the interaction blocks are computed in parallel
+   */
+  bool parallelAssembly() const
+  {
+    return _parallelAssembly;
+  }
+
+  /** set the parallel computation of the interaction blocks. Only the
+   *  symmetric index sets are handled, and only when the iteration
+   *  matrices of the dynamical systems are dense and owned by the
+   *  integrators (MoreauJeanOSI, EulerMoreauOSI, ...). Otherwise the
+   *  serial computation is used.
+   * \param v true to enable the parallel assembly
+   */
+  void setParallelAssembly(bool v)
+  {
+    _parallelAssembly = v;
+  }
+
   /** initialize the problem(compute topology ...)
       \param sim the simulation, owner of this OSNSPB
     */
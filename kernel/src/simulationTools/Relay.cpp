@@ -16,6 +16,7 @@
  * limitations under the License.
 */
 #include "Relay.hpp"
+#include "SiconosProfiler.hpp"
 #include <iostream>
 #include <assert.h>
 #include "Tools.hpp"
@@ -177,8 +178,11 @@ int Relay::compute(double time)
 
     //      Relay_display(&numerics_problem);
 
-    info = relay_driver(&numerics_problem, _z->getArray(), _w->getArray(),
-                        &*_numerics_solver_options);
+    {
+      SiconosProfiler::Timer timer("solve");
+      info = relay_driver(&numerics_problem, _z->getArray(), _w->getArray(),
+                          &*_numerics_solver_options);
+    }
 
     if(info != 0)
     {
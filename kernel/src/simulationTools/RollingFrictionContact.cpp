@@ -16,6 +16,7 @@
  * limitations under the License.
 */
 #include "RollingFrictionContact.hpp"
+#include "SiconosProfiler.hpp"
 #include "Topology.hpp"
 #include "Simulation.hpp"
 #include "NonSmoothDynamicalSystem.hpp"
@@ -144,6 +145,7 @@ RollingFrictionContactProblem *RollingFrictionContact::frictionContactProblemPtr
 
 int RollingFrictionContact::solve(SP::RollingFrictionContactProblem problem)
 {
+  SiconosProfiler::Timer timer("solve");
   if(!problem)
   {
     problem = frictionContactProblem();
@@ -34,6 +34,8 @@
 #include "Relay.hpp"
 #include "NonSmoothLaw.hpp"
 #include "TypeName.hpp"
+#include "SiconosProfiler.hpp"
+#include "SolverOptions.h"
 // for Debug
 //#define DEBUG_BEGIN_END_ONLY
 // #define DEBUG_NOCOLOR
@@ -177,6 +179,7 @@ void Simulation::updateIndexSets()
 {
 
   DEBUG_BEGIN("Simulation::updateIndexSets()\n");
+  SiconosProfiler::Timer timer("updateIndexSets");
   // update I0 indices
   unsigned int nindexsets = _nsds->topology()->indexSetsSize();
 
@@ -293,8 +296,14 @@ void Simulation::initializeNSDSChangelog()
     {
       SP::Interaction inter = change.i;
       initializeInteraction(getTk(), inter);
+      if(_interman)
+        _interman->initializeInteraction(getTk(), inter);
       interactionInitialized = true;
     }
+    else if(change.typeOfChange == NonSmoothDynamicalSystem::rmInteraction)
+    {
+      releaseInteraction(change.i);
+    }
     else if(change.typeOfChange == NonSmoothDynamicalSystem::rmDynamicalSystem)
     {
       // also need to force an update in this case since indexSet1 may
@@ -391,6 +400,7 @@ void Simulation::firstInitialize()
 void Simulation::initialize()
 {
   DEBUG_BEGIN("Simulation::initialize()");
+  SiconosProfiler::Timer timer("initialize");
   DEBUG_EXPR_WE(std::cout << "Simulation name :"<< name() << std::endl;);
 
   // 1 - Process any pending OSI->DS associations
@@ -495,6 +505,7 @@ int Simulation::computeOneStepNSProblem(int Id)
 {
   DEBUG_BEGIN("Simulation::computeOneStepNSProblem(int Id)\n");
   DEBUG_PRINTF("with Id = %i\n", Id);
+  SiconosProfiler::Timer timer("computeOneStepNSProblem");
 
   if(!(*_allNSProblems)[Id])
     THROW_EXCEPTION("Simulation - computeOneStepNSProblem, OneStepNSProblem == nullptr, Id: " + std::to_string(Id));
@@ -509,8 +520,17 @@ int Simulation::computeOneStepNSProblem(int Id)
     }
   }
 
+  // the solver is not called when there is no active interaction: do not
+  // count again the iterations of its last call
+  SP::SolverOptions options = (*_allNSProblems)[Id]->numericsSolverOptions();
+  if(options && options->iparam)
+    options->iparam[SICONOS_IPARAM_ITER_DONE] = 0;
+
   int info = (*_allNSProblems)[Id]->compute(nextTime());
 
+  if(options && options->iparam)
+    SiconosProfiler::count("solverIterations", options->iparam[SICONOS_IPARAM_ITER_DONE]);
+
   DEBUG_END("Simulation::computeOneStepNSProblem(int Id)\n");
   return info;
 }
@@ -587,6 +607,7 @@ void Simulation::processEvents()
 {
   DEBUG_BEGIN("void Simulation::processEvents()\n");
   _eventsManager->processEvents(*this);
+  SiconosProfiler::endStep();
 
   // if(_eventsManager->hasNextEvent())
   // {
@@ -630,7 +651,10 @@ void Simulation::updateInteractions()
   // Update interactions if a manager was provided.  Changes will be
   // detected by Simulation::initialize() changelog code.
   if(_interman)
+  {
+    SiconosProfiler::Timer timer("updateInteractions");
     _interman->updateInteractions(shared_from_this());
+  }
 }
 
 void Simulation::computeResidu()
@@ -645,6 +669,7 @@ void Simulation::computeResidu()
 void Simulation::updateInput(unsigned int)
 {
   DEBUG_BEGIN("Simulation::updateInput()\n");
+  SiconosProfiler::Timer timer("updateInput");
   OSIIterator itOSI;
   // 1 - compute input (lambda -> r)
   if(!_allNSProblems->empty())
@@ -659,6 +684,7 @@ void Simulation::updateInput(unsigned int)
 void Simulation::updateState(unsigned int)
 {
   DEBUG_BEGIN("Simulation::updateState()\n");
+  SiconosProfiler::Timer timer("updateState");
   OSIIterator itOSI;
   // 2 - compute state for each dynamical system
   for(itOSI = _allOSI->begin(); itOSI != _allOSI->end() ; ++itOSI)
@@ -673,6 +699,7 @@ void Simulation::updateState(unsigned int)
 void Simulation::updateOutput(unsigned int)
 {
   DEBUG_BEGIN("Simulation::updateOutput()\n");
+  SiconosProfiler::Timer timer("updateOutput");
 
   // 3 - compute output ( x ... -> y)
   if(!_allNSProblems->empty())
@@ -370,6 +370,12 @@ public:
    *  topology updates. */
   virtual void initializeInteraction(double time, SP::Interaction inter);
 
+  /** Release the data of this Simulation about an Interaction removed from
+   *  the nsds, used for dynamic topology updates.
+   * \param inter the removed Interaction
+   */
+  virtual void releaseInteraction(SP::Interaction inter) {};
+
   /** Set an object to automatically manage interactions during the simulation
    * \param manager
    */
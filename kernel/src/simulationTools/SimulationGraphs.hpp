@@ -23,7 +23,11 @@
 #ifndef SimulationGraphs_H
 #define SimulationGraphs_H
 
+#include "SiconosConfig.h"
 #include "SiconosGraph.hpp"
+#ifdef SICONOS_USE_FLAT_GRAPH
+#include "SiconosFlatGraph.hpp"
+#endif
 #include "SiconosProperties.hpp"
 #include "SiconosPointers.hpp"
 #include "SiconosFwd.hpp" // for SP::DynamicalSystem, ...
@@ -117,8 +121,15 @@ struct GraphProperties
 
 
 
+/* the graph implementation, see SiconosFlatGraph.hpp */
+#ifdef SICONOS_USE_FLAT_GRAPH
+#define SICONOS_GRAPH_BACKEND SiconosFlatGraph
+#else
+#define SICONOS_GRAPH_BACKEND SiconosGraph
+#endif
+
 class _DynamicalSystemsGraph :
-  public SiconosGraph < std::shared_ptr<DynamicalSystem>,
+  public SICONOS_GRAPH_BACKEND < std::shared_ptr<DynamicalSystem>,
                         std::shared_ptr<Interaction>,
                         DynamicalSystemProperties, InteractionProperties,
                         GraphProperties >
@@ -128,7 +139,7 @@ class _DynamicalSystemsGraph :
 
 
 class _InteractionsGraph :
-  public SiconosGraph < std::shared_ptr<Interaction>,
+  public SICONOS_GRAPH_BACKEND < std::shared_ptr<Interaction>,
                         std::shared_ptr<DynamicalSystem>,
                         InteractionProperties, DynamicalSystemProperties,
                         GraphProperties >
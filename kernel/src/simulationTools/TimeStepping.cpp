@@ -35,9 +35,11 @@
 #include "BlockVector.hpp"
 #include "NewtonEulerR.hpp"
 #include "FirstOrderR.hpp"
+#include "SiconosProfiler.hpp"
 
 #include <SiconosConfig.h>
 #include <functional>
+#include <limits>
 using namespace std::placeholders;
 
 // #define DEBUG_BEGIN_END_ONLY
@@ -70,7 +72,10 @@ TimeStepping::TimeStepping(SP::NonSmoothDynamicalSystem nsds,
     _resetAllLambda(true),
     _skip_last_updateOutput(false),
     _skip_last_updateInput(false),
-    _skip_resetLambdas(false)
+    _skip_resetLambdas(false),
+    _incrementalIndexSetUpdate(false),
+    _maxApproachVelocity(0.0),
+    _activationQueueValid(false)
 {
 
   if(osi) insertIntegrator(osi);
@@ -96,7 +101,10 @@ TimeStepping::TimeStepping(SP::NonSmoothDynamicalSystem nsds, SP::TimeDiscretisa
     _resetAllLambda(true),
     _skip_last_updateOutput(false),
     _skip_last_updateInput(false),
-    _skip_resetLambdas(false)
+    _skip_resetLambdas(false),
+    _incrementalIndexSetUpdate(false),
+    _maxApproachVelocity(0.0),
+    _activationQueueValid(false)
 {
   (*_allNSProblems).resize(nb);
 }
@@ -169,6 +177,9 @@ void TimeStepping::updateIndexSet(unsigned int i)
   DEBUG_PRINTF("TimeStepping::updateIndexSet(unsigned int i). update indexSets start : indexSet0 size : %ld\n", indexSet0->size());
   DEBUG_PRINTF("TimeStepping::updateIndexSet(unsigned int i). update IndexSets start : indexSet1 size : %ld\n", indexSet1->size());
 
+  // Interactions removed from indexSet1, for the incremental update
+  std::vector<SP::Interaction> deactivated;
+
   // Check indexSet1
   InteractionsGraph::VIterator ui1, ui1end, v1next;
   std::tie(ui1, ui1end) = indexSet1->vertices();
@@ -222,8 +233,12 @@ void TimeStepping::updateIndexSet(unsigned int i)
           /* \warning V.A. 25/05/2012 : Multiplier lambda are only set to zero if they are removed from the IndexSet*/
           inter1->lambda(1)->zero();
           topo->setHasChanged(true);
+          if(_incrementalIndexSetUpdate)
+            deactivated.push_back(inter1);
         }
       }
+      if(_incrementalIndexSetUpdate)
+        indexSet0->color(inter1_descr0) = boost::white_color;
     }
     else
     {
@@ -252,53 +267,61 @@ void TimeStepping::updateIndexSet(unsigned int i)
     }
   }
 
-  // indexSet0\indexSet1 scan
-  InteractionsGraph::VIterator ui0, ui0end;
-  //Add interaction in indexSet1
-  for(std::tie(ui0, ui0end) = indexSet0->vertices(); ui0 != ui0end; ++ui0)
+  if(_incrementalIndexSetUpdate)
   {
-    if(indexSet0->color(*ui0) == boost::black_color)
-    {
-      // reset
-      indexSet0->color(*ui0) = boost::white_color ;
-    }
-    else
+    // Only the Interactions whose activation test is due are visited
+    updateIndexSetIncremental(i, deactivated);
+  }
+  else
+  {
+    // indexSet0\indexSet1 scan
+    InteractionsGraph::VIterator ui0, ui0end;
+    //Add interaction in indexSet1
+    for(std::tie(ui0, ui0end) = indexSet0->vertices(); ui0 != ui0end; ++ui0)
     {
-      if(indexSet0->color(*ui0) == boost::gray_color)
+      if(indexSet0->color(*ui0) == boost::black_color)
       {
         // reset
-        indexSet0->color(*ui0) = boost::white_color;
-
-        assert(indexSet1->is_vertex(indexSet0->bundle(*ui0)));
-        /*assert( { !predictorDeactivate(indexSet0->bundle(*ui0),i) ||
-          Type::value(*(indexSet0->bundle(*ui0)->nonSmoothLaw())) == Type::EqualityConditionNSL ;
-          });*/
+        indexSet0->color(*ui0) = boost::white_color ;
       }
       else
       {
-        assert(indexSet0->color(*ui0) == boost::white_color);
-
-        SP::Interaction inter0 = indexSet0->bundle(*ui0);
-        assert(!indexSet1->is_vertex(inter0));
-        bool activate = true;
-        if(Type::value(*(inter0->nonSmoothLaw())) != Type::EqualityConditionNSL
-            && Type::value(*(inter0->nonSmoothLaw())) != Type::RelayNSL)
+        if(indexSet0->color(*ui0) == boost::gray_color)
         {
-          //SP::OneStepIntegrator Osi = indexSet0->properties(*ui0).osi;
-          // We assume that the integrator of the ds1 drive the update of the index set
-          SP::DynamicalSystem ds1 = indexSet1->properties(*ui0).source;
-          OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
+          // reset
+          indexSet0->color(*ui0) = boost::white_color;
 
-          activate = osi.addInteractionInIndexSet(inter0, i);
+          assert(indexSet1->is_vertex(indexSet0->bundle(*ui0)));
+          /*assert( { !predictorDeactivate(indexSet0->bundle(*ui0),i) ||
+            Type::value(*(indexSet0->bundle(*ui0)->nonSmoothLaw())) == Type::EqualityConditionNSL ;
+            });*/
         }
-        if(activate)
+        else
         {
+          assert(indexSet0->color(*ui0) == boost::white_color);
+
+          SP::Interaction inter0 = indexSet0->bundle(*ui0);
           assert(!indexSet1->is_vertex(inter0));
+          bool activate = true;
+          if(Type::value(*(inter0->nonSmoothLaw())) != Type::EqualityConditionNSL
+              && Type::value(*(inter0->nonSmoothLaw())) != Type::RelayNSL)
+          {
+            //SP::OneStepIntegrator Osi = indexSet0->properties(*ui0).osi;
+            // We assume that the integrator of the ds1 drive the update of the index set
+            SP::DynamicalSystem ds1 = indexSet1->properties(*ui0).source;
+            OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
 
-          // vertex and edges insertion in indexSet1
-          indexSet1->copy_vertex(inter0, *indexSet0);
-          topo->setHasChanged(true);
-          assert(indexSet1->is_vertex(inter0));
+            activate = osi.addInteractionInIndexSet(inter0, i);
+          }
+          if(activate)
+          {
+            assert(!indexSet1->is_vertex(inter0));
+
+            // vertex and edges insertion in indexSet1
+            indexSet1->copy_vertex(inter0, *indexSet0);
+            topo->setHasChanged(true);
+            assert(indexSet1->is_vertex(inter0));
+          }
         }
       }
     }
@@ -310,6 +333,104 @@ void TimeStepping::updateIndexSet(unsigned int i)
   DEBUG_PRINTF("TimeStepping::updateIndexSet(unsigned int i). update IndexSets end : indexSet1 size : %ld\n", indexSet1->size());
 }
 
+void TimeStepping::scheduleActivationTest(SP::Interaction inter, double time)
+{
+  _activationTime[inter->number()] = time;
+  _activationQueue.push({time, inter->number(), inter});
+}
+
+void TimeStepping::updateIndexSetIncremental(unsigned int i,
+    std::vector<SP::Interaction>& deactivated)
+{
+  SP::Topology topo = _nsds->topology();
+  SP::InteractionsGraph indexSet0 = topo->indexSet(0);
+  SP::InteractionsGraph indexSet1 = topo->indexSet(1);
+  DynamicalSystemsGraph& DSG0= *nonSmoothDynamicalSystem()->dynamicalSystems();
+  double time = startingTime();
+
+  if(!_activationQueueValid)
+  {
+    // All the Interactions are tested once, the new ones are then
+    // scheduled by initializeInteraction
+    _activationQueue = decltype(_activationQueue)();
+    _activationTime.clear();
+    InteractionsGraph::VIterator ui0, ui0end;
+    for(std::tie(ui0, ui0end) = indexSet0->vertices(); ui0 != ui0end; ++ui0)
+      if(!indexSet1->is_vertex(indexSet0->bundle(*ui0)))
+        scheduleActivationTest(indexSet0->bundle(*ui0), -std::numeric_limits<double>::infinity());
+    _activationQueueValid = true;
+  }
+
+  // the Interactions still out of indexSet1, to be scheduled again
+  std::vector<SP::Interaction>& inactive = deactivated;
+  while(!_activationQueue.empty() && _activationQueue.top().time <= time)
+  {
+    ActivationTest test = _activationQueue.top();
+    _activationQueue.pop();
+    std::unordered_map<size_t, double>::iterator it = _activationTime.find(test.number);
+    if(it == _activationTime.end() || it->second != test.time)
+      continue; // outdated, the Interaction has been scheduled again
+    _activationTime.erase(it);
+
+    SP::Interaction inter0 = test.inter.lock();
+    if(!inter0 || !indexSet0->is_vertex(inter0) || indexSet1->is_vertex(inter0))
+      continue;
+
+    bool activate = true;
+    if(Type::value(*(inter0->nonSmoothLaw())) != Type::EqualityConditionNSL
+        && Type::value(*(inter0->nonSmoothLaw())) != Type::RelayNSL)
+    {
+      // We assume that the integrator of the ds1 drive the update of the index set
+      SP::DynamicalSystem ds1 = indexSet0->properties(indexSet0->descriptor(inter0)).source;
+      OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
+      activate = osi.addInteractionInIndexSet(inter0, i);
+    }
+    if(activate)
+    {
+      // vertex and edges insertion in indexSet1
+      indexSet1->copy_vertex(inter0, *indexSet0);
+      topo->setHasChanged(true);
+    }
+    else
+      inactive.push_back(inter0);
+  }
+
+  for(SP::Interaction& inter : inactive)
+  {
+    // without a bound of the approach velocity, an Interaction may be
+    // accelerated towards its activation at any step: it is tested again
+    // at the next step
+    double delay = 0.0;
+    if(_maxApproachVelocity > 0.0)
+    {
+      SP::DynamicalSystem ds1 = indexSet0->properties(indexSet0->descriptor(inter)).source;
+      OneStepIntegrator& osi = *DSG0.properties(DSG0.descriptor(ds1)).osi;
+      delay = osi.timeBeforeActivation(inter, i, _maxApproachVelocity);
+    }
+    scheduleActivationTest(inter, time + delay);
+  }
+}
+
+void TimeStepping::initializeInteraction(double time, SP::Interaction inter)
+{
+  Simulation::initializeInteraction(time, inter);
+  if(_incrementalIndexSetUpdate && _activationQueueValid)
+    scheduleActivationTest(inter, -std::numeric_limits<double>::infinity());
+}
+
+void TimeStepping::releaseInteraction(SP::Interaction inter)
+{
+  // the entries of the Interaction in _activationQueue are now outdated
+  _activationTime.erase(inter->number());
+}
+
+void TimeStepping::setIncrementalIndexSetUpdate(bool incremental, double maxApproachVelocity)
+{
+  _incrementalIndexSetUpdate = incremental;
+  _maxApproachVelocity = maxApproachVelocity;
+  _activationQueueValid = false;
+}
+
 // void TimeStepping::insertNonSmoothProblem(SP::OneStepNSProblem osns)
 // {
 //   // A the time, a time stepping simulation can only have one non
@@ -373,6 +494,7 @@ void TimeStepping::nextStep()
 void TimeStepping::computeFreeState()
 {
   DEBUG_BEGIN("TimeStepping::computeFreeState()\n");
+  SiconosProfiler::Timer timer("computeFreeState");
   std::for_each(_allOSI->begin(), _allOSI->end(), std::bind(&OneStepIntegrator::computeFreeState, _1));
   DEBUG_END("TimeStepping::computeFreeState()\n");
 }
@@ -694,6 +816,7 @@ void TimeStepping::newtonSolve(double criterion, unsigned int maxStep)
   }
   else
     THROW_EXCEPTION("TimeStepping::NewtonSolve failed. Unknown newtonOptions: " + std::to_string(_newtonOptions));
+  SiconosProfiler::count("newtonIterations", _newtonNbIterations);
   DEBUG_END("TimeStepping::newtonSolve(double criterion, unsigned int maxStep)\n");
 }
 
@@ -23,6 +23,9 @@
 
 #include "Simulation.hpp"
 
+#include <queue>
+#include <unordered_map>
+
 /** type of function used to post-treat output info from solver. */
 typedef void (*CheckSolverFPtr)(int, Simulation *);
 
@@ -124,11 +127,62 @@ protected:
    */
   bool _skip_resetLambdas;
 
+  /** boolean variable to update indexSet1 incrementally (default false):
+   * an Interaction out of indexSet1 is tested again only when it may have
+   * reached the activation threshold (see
+   * OneStepIntegrator::timeBeforeActivation)
+   */
+  bool _incrementalIndexSetUpdate;
+
+  /** bound of the approach velocity of the Interactions, used to predict
+   * their activation in the incremental update of indexSet1
+   */
+  double _maxApproachVelocity;
+
+  /** next activation test of an Interaction out of indexSet1 */
+  struct ActivationTest
+  {
+    double time;
+    size_t number;
+    std::weak_ptr<Interaction> inter;
+    bool operator>(const ActivationTest& other) const
+    {
+      return time > other.time;
+    }
+  };
+
+  /** the activation tests, the earliest first */
+  std::priority_queue<ActivationTest, std::vector<ActivationTest>,
+                      std::greater<ActivationTest>> _activationQueue;
+
+  /** time of the pending activation test of each Interaction, by number.
+   * The entries of _activationQueue with another time are outdated.
+   */
+  std::unordered_map<size_t, double> _activationTime;
+
+  /** false if the Interactions of indexSet0 have not all been scheduled */
+  bool _activationQueueValid;
+
   /** Default Constructor
    */
   TimeStepping()
       : _computeResiduY(false), _computeResiduR(false),
-        _isNewtonConverge(false){};
+        _isNewtonConverge(false), _incrementalIndexSetUpdate(false),
+        _maxApproachVelocity(0.0), _activationQueueValid(false){};
+
+  /** schedule the activation test of an Interaction out of indexSet1
+   * \param inter the Interaction
+   * \param time time of the test
+   */
+  void scheduleActivationTest(SP::Interaction inter, double time);
+
+  /** add in indexSet1 the Interactions whose activation test is due, and
+   * schedule the next test of the others
+   * \param i the number of the set to be updated
+   * \param deactivated the Interactions removed from indexSet1 in this update
+   */
+  void updateIndexSetIncremental(unsigned int i,
+                                 std::vector<SP::Interaction>& deactivated);
 
   /** newton algorithm
    * \param criterion convergence criterion
@@ -172,6 +226,37 @@ public:
    */
   void updateIndexSet(unsigned int i) override;
 
+  /** initialize a new Interaction, and schedule its activation test if
+   * indexSet1 is updated incrementally
+   * \param time the time of initialization
+   * \param inter the Interaction
+   */
+  void initializeInteraction(double time, SP::Interaction inter) override;
+
+  /** forget the pending activation test of a removed Interaction
+   * \param inter the Interaction
+   */
+  void releaseInteraction(SP::Interaction inter) override;
+
+  /** update indexSet1 incrementally: the Interactions out of indexSet1 are
+   * tested again only when their gap may have reached the activation
+   * threshold, given a bound of their approach velocity. No activation is
+   * missed if maxApproachVelocity bounds the velocity at which the gap of any
+   * Interaction decreases; with 0, there is no bound and the Interactions out
+   * of indexSet1 are tested at each step.
+   * \param incremental true to update indexSet1 incrementally
+   * \param maxApproachVelocity bound of the approach velocity
+   */
+  virtual void setIncrementalIndexSetUpdate(bool incremental,
+                                            double maxApproachVelocity = 0.0);
+
+  /** \return true if indexSet1 is updated incrementally */
+  bool incrementalIndexSetUpdate() { return _incrementalIndexSetUpdate; };
+
+  /** \return the bound of the approach velocity used by the incremental
+   * update of indexSet1 */
+  double maxApproachVelocity() { return _maxApproachVelocity; };
+
   // /** Used by the updateIndexSet function in order to deactivate
   // SP::Interaction.
   //  */
@@ -78,6 +78,13 @@ TimeSteppingCombinedProjection::~TimeSteppingCombinedProjection()
 {
 }
 
+void TimeSteppingCombinedProjection::setIncrementalIndexSetUpdate(bool incremental,
+    double maxApproachVelocity)
+{
+  if(incremental)
+    THROW_EXCEPTION("TimeSteppingCombinedProjection::setIncrementalIndexSetUpdate, the incremental update of indexSet1 is not implemented.");
+}
+
 
 
 struct TimeSteppingCombinedProjection::_SimulationEffectOnOSNSP : public SiconosVisitor
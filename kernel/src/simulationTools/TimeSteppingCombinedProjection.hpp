@@ -123,6 +123,14 @@ public:
   virtual ~TimeSteppingCombinedProjection();
 
   void updateWorldFromDS() override { ; }
+
+  /** the incremental update of indexSet1 is not implemented for the
+   * combined projection, whose updateIndexSet scans all the Interactions
+   * \param incremental must be false
+   * \param maxApproachVelocity not used
+   */
+  void setIncrementalIndexSetUpdate(bool incremental,
+                                    double maxApproachVelocity = 0.0) override;
   /** get the Number of iteration of projection
    * \return unsigned int nbProjectionIteration
    */
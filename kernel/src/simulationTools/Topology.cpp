@@ -129,8 +129,7 @@ Topology::__addInteractionInIndexSet0(SP::Interaction inter, SP::DynamicalSystem
   assert(_DSG[0]->is_edge(dsgv1, dsgv2, inter));
   assert(_DSG[0]->edges_number() == _IG[0]->size());
 
-
-
+  __updateEqualityInteractions(inter, ds1, ds2, true);
 
   return std::pair<DynamicalSystemsGraph::EDescriptor, InteractionsGraph::VDescriptor>(new_ed, ig_new_ve);
 }
@@ -218,12 +217,39 @@ void Topology::__removeInteractionFromIndexSet(SP::Interaction inter)
 
   SP::DynamicalSystem ds1 = _IG[0]->properties(_IG[0]->descriptor(inter)).source;
   SP::DynamicalSystem ds2 = _IG[0]->properties(_IG[0]->descriptor(inter)).target;
+  __updateEqualityInteractions(inter, ds1, ds2, false);
   _DSG[0]->remove_out_edge_if(_DSG[0]->descriptor(ds1), VertexIsRemoved(inter, _DSG[0], _IG[0]));
   if(ds1 != ds2)
     _DSG[0]->remove_out_edge_if(_DSG[0]->descriptor(ds2), VertexIsRemoved(inter, _DSG[0], _IG[0]));
 }
 
 
+void Topology::__updateEqualityInteractions(SP::Interaction inter,
+    SP::DynamicalSystem ds1,
+    SP::DynamicalSystem ds2,
+    bool insert)
+{
+  if(!ds2 || ds1 == ds2
+      || !std::dynamic_pointer_cast<EqualityConditionNSL>(inter->nonSmoothLaw()))
+    return;
+
+  DSPair key = __sortedPair(&*ds1, &*ds2);
+  if(insert)
+  {
+    _equalityInteractions[key].push_back(inter);
+  }
+  else
+  {
+    EqualityInteractionsMap::iterator it = _equalityInteractions.find(key);
+    if(it == _equalityInteractions.end())
+      return;
+    std::vector<SP::Interaction>& inters = it->second;
+    inters.erase(std::remove(inters.begin(), inters.end(), inter), inters.end());
+    if(inters.empty())
+      _equalityInteractions.erase(it);
+  }
+}
+
 void Topology::insertDynamicalSystem(SP::DynamicalSystem ds)
 {
   _DSG[0]->add_vertex(ds);
@@ -234,6 +260,18 @@ void Topology::insertDynamicalSystem(SP::DynamicalSystem ds)
    corresponding vertices are removed from _DSG */
 void Topology::__removeDynamicalSystemFromIndexSet(SP::DynamicalSystem ds)
 {
+  DynamicalSystemsGraph::OEIterator oei, oeiend;
+  for(std::tie(oei, oeiend) = _DSG[0]->out_edges(_DSG[0]->descriptor(ds));
+      oei != oeiend; ++oei)
+  {
+    SP::Interaction inter = _DSG[0]->bundle(*oei);
+    if(_IG[0]->is_vertex(inter))
+    {
+      InteractionProperties& prop = _IG[0]->properties(_IG[0]->descriptor(inter));
+      __updateEqualityInteractions(inter, prop.source, prop.target, false);
+    }
+  }
+
   _DSG[0]->remove_edge_if(_DSG[0]->descriptor(ds),
                           VertexIsRemovedDS(ds, _DSG[0], _IG[0]));
 
@@ -391,6 +429,7 @@ void Topology::clear()
 {
   _IG.clear();
   _DSG.clear();
+  _equalityInteractions.clear();
 }
 
 SP::DynamicalSystem Topology::getDynamicalSystem(unsigned int requiredNumber) const
@@ -566,6 +605,19 @@ std::vector<SP::Interaction> Topology::interactionsForPairOfDS(
   return result;
 }
 
+std::vector<SP::Interaction> Topology::equalityInteractionsForPairOfDS(
+  SP::DynamicalSystem ds1,
+  SP::DynamicalSystem ds2) const
+{
+  if(!ds1 || !ds2)
+    return std::vector<SP::Interaction>();
+  EqualityInteractionsMap::const_iterator it =
+    _equalityInteractions.find(__sortedPair(&*ds1, &*ds2));
+  if(it == _equalityInteractions.end())
+    return std::vector<SP::Interaction>();
+  return it->second;
+}
+
 std::vector<SP::DynamicalSystem>
 Topology::dynamicalSystemsForInteraction(
   SP::Interaction inter) const
@@ -26,6 +26,10 @@
 #include "SimulationTypeDef.hpp"
 #include "SimulationGraphs.hpp"
 
+#include <functional>
+#include <unordered_map>
+#include <utility>
+
 /**  This class describes the topology of the non-smooth dynamical
  *  system. It holds all the "potential" Interactions".
  *
@@ -79,6 +83,30 @@ private:
   /** symmetry in the blocks computation */
   bool _symmetric = false;
 
+  /** a pair of dynamical systems, sorted */
+  typedef std::pair<DynamicalSystem*, DynamicalSystem*> DSPair;
+
+  struct DSPairHash
+  {
+    size_t operator()(const DSPair& p) const
+    {
+      size_t h1 = std::hash<DynamicalSystem*>()(p.first);
+      size_t h2 = std::hash<DynamicalSystem*>()(p.second);
+      return h1 ^ (h2 + 0x9e3779b9 + (h1 << 6) + (h1 >> 2));
+    }
+  };
+
+  static DSPair __sortedPair(DynamicalSystem* ds1, DynamicalSystem* ds2)
+  {
+    return std::less<DynamicalSystem*>()(ds1, ds2) ? DSPair(ds1, ds2) : DSPair(ds2, ds1);
+  }
+
+  typedef std::unordered_map<DSPair, std::vector<SP::Interaction>, DSPairHash> EqualityInteractionsMap;
+
+  /** Interactions with an EqualityConditionNSL (e.g. joints) linking
+      two different dynamical systems, updated by link and removal */
+  EqualityInteractionsMap _equalityInteractions;
+
   /** initializations ( time invariance) from non
       smooth laws kind */
   struct SetupFromNslaw;
@@ -102,6 +130,18 @@ private:
    */
   void __removeInteractionFromIndexSet(SP::Interaction inter);
 
+  /** insert or remove an Interaction in _equalityInteractions if its
+   *  nonsmooth law is an EqualityConditionNSL
+   * \param inter the Interaction
+   * \param ds1 the first dynamical system of the Interaction
+   * \param ds2 the second dynamical system of the Interaction
+   * \param insert true to insert, false to remove
+   */
+  void __updateEqualityInteractions(SP::Interaction inter,
+                                    SP::DynamicalSystem ds1,
+                                    SP::DynamicalSystem ds2,
+                                    bool insert);
+
   /** remove a DynamicalSystem from _IG and _DSG
    * \param ds a pointer to the Dynamical System to be removed
    */
@@ -371,6 +411,16 @@ public:
     SP::DynamicalSystem ds1,
     SP::DynamicalSystem ds2=SP::DynamicalSystem()) const;
 
+  /** get the Interactions with an EqualityConditionNSL (e.g. joints)
+   *  between two different DSs. Contrary to interactionsForPairOfDS,
+   *  the complexity does not depend on the number of Interactions.
+   * \param ds1 a DynamicalSystem
+   * \param ds2 another DynamicalSystem
+   * \return a vector of pointers to Interaction
+   */
+  std::vector<SP::Interaction> equalityInteractionsForPairOfDS(
+    SP::DynamicalSystem ds1, SP::DynamicalSystem ds2) const;
+
   /** get DynamicalSystems for a given Interaction
    * \return a vector of pointers to DynamicalSystem
    */
@@ -143,3 +143,56 @@ void LsodarTest::testCstGradNLDS()
   std::cout <<std::endl <<std::endl;
 }
 
+void LsodarTest::testBandedJacobian()
+{
+  std::cout << "------- Integrate uncoupled stiff systems with a banded jacobian -------" <<std::endl;
+  // x' = A x with A = [-100 1; 0 -1] for each system,
+  // x(t) = [(x1 - c) exp(-100 t) + c exp(-t), x2 exp(-t)], c = x2 / 99
+  unsigned int nDS = 3;
+  double T = 1.0;
+  SP::SiconosMatrix A(new SimpleMatrix(_n, _n));
+  A->setValue(0, 0, -100.);
+  A->setValue(0, 1, 1.);
+  A->setValue(1, 1, -1.);
+
+  // full and banded jacobians computed by the systems
+  for(integer jt : {1, 4})
+  {
+    SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(_t0, T));
+    SP::TimeDiscretisation td(new TimeDiscretisation(_t0, _h));
+    SP::EventDriven sim(new EventDriven(nsds, td, 0));
+    SP::LsodarOSI lsodar(new LsodarOSI());
+    lsodar->setJT(jt);
+    std::vector<SP::DynamicalSystem> allDS;
+    for(unsigned int i = 0; i < nDS; i++)
+    {
+      SP::SiconosVector x0(new SiconosVector(_n));
+      x0->setValue(0, 1. + i);
+      x0->setValue(1, 2. - i);
+      SP::DynamicalSystem ds(new FirstOrderLinearTIDS(x0, A));
+      nsds->insertDynamicalSystem(ds);
+      sim->associate(lsodar, ds);
+      allDS.push_back(ds);
+    }
+    sim->initialize();
+    double tol = 1e-9;
+    lsodar->setTol(1, tol, tol);
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : ", lsodar->halfBandwidth(), (integer)(_n - 1));
+
+    while(sim->hasNextEvent())
+    {
+      sim->advanceToEvent();
+      sim->processEvents();
+    }
+
+    for(unsigned int i = 0; i < nDS; i++)
+    {
+      double x1 = 1. + i, x2 = 2. - i, c = x2 / 99.;
+      double x1T = (x1 - c) * exp(-100. * T) + c * exp(-T);
+      double x2T = x2 * exp(-T);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : ", fabs(allDS[i]->x()->getValue(0) - x1T) < 1e-6, true);
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("testBandedJacobian : ", fabs(allDS[i]->x()->getValue(1) - x2T) < 1e-6, true);
+    }
+  }
+  std::cout <<std::endl <<std::endl;
+}
@@ -47,6 +47,7 @@ private:
   CPPUNIT_TEST(testCstGradTIDS);
   CPPUNIT_TEST(testCstGradDS);
   CPPUNIT_TEST(testCstGradNLDS);
+  CPPUNIT_TEST(testBandedJacobian);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -55,6 +56,7 @@ private:
   void testCstGradTIDS();
   void testCstGradDS();
   void testCstGradNLDS();
+  void testBandedJacobian();
   // Members
 
   unsigned int _n;
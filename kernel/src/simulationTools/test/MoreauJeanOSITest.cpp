@@ -0,0 +1,188 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "MoreauJeanOSITest.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "TimeStepping.hpp"
+#include "TimeDiscretisation.hpp"
+#include "LCP.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonEulerDS.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "Interaction.hpp"
+#include "SimpleMatrix.hpp"
+#include "SiconosVector.hpp"
+
+#include <cmath>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(MoreauJeanOSITest);
+
+namespace
+{
+/* Balls bouncing on the ground and free rigid bodies, integrated with
+ * the given loop policy. */
+struct BodiesProblem
+{
+  SP::NonSmoothDynamicalSystem nsds;
+  SP::TimeStepping simulation;
+  std::vector<SP::DynamicalSystem> ds;
+};
+
+BodiesProblem buildBodies(unsigned int size, MoreauJeanOSI::MoreauJeanOSI_loop_policy policy,
+                          bool useStore = false)
+{
+  BodiesProblem pb;
+  pb.nsds.reset(new NonSmoothDynamicalSystem(0.0, 1.0));
+  for(unsigned int i = 0; i < size; i++)
+  {
+    SP::SiconosVector q0(new SiconosVector(3));
+    (*q0)(0) = 0.2 + 0.05 * i;
+    SP::SiconosVector v0(new SiconosVector(3));
+    (*v0)(1) = 0.1 * i;
+    SP::SimpleMatrix mass(new SimpleMatrix(3, 3));
+    mass->eye();
+    SP::LagrangianLinearTIDS ball(new LagrangianLinearTIDS(q0, v0, mass));
+    SP::SiconosVector weight(new SiconosVector(3));
+    (*weight)(0) = -9.81;
+    ball->setFExtPtr(weight);
+    pb.nsds->insertDynamicalSystem(ball);
+    pb.ds.push_back(ball);
+
+    SP::SimpleMatrix H(new SimpleMatrix(1, 3));
+    (*H)(0, 0) = 1.0;
+    SP::Relation relation(new LagrangianLinearTIR(H));
+    SP::NonSmoothLaw nslaw(new NewtonImpactNSL(0.8));
+    pb.nsds->link(SP::Interaction(new Interaction(nslaw, relation)), ball);
+
+    SP::SiconosVector position(new SiconosVector(7));
+    (*position)(2) = 1.0 * i;
+    (*position)(3) = 1.0;
+    SP::SiconosVector twist(new SiconosVector(6));
+    (*twist)(0) = 0.5;
+    (*twist)(3) = 1.0 + i;
+    (*twist)(4) = 0.2 * i;
+    (*twist)(5) = -0.5;
+    SP::SimpleMatrix inertia(new SimpleMatrix(3, 3));
+    inertia->eye();
+    (*inertia)(0, 0) = 2.0;
+    SP::NewtonEulerDS body(new NewtonEulerDS(position, twist, 1.0, inertia));
+    SP::SiconosVector force(new SiconosVector(3));
+    (*force)(2) = -9.81;
+    body->setFExtPtr(force);
+    pb.nsds->insertDynamicalSystem(body);
+    pb.ds.push_back(body);
+  }
+  SP::TimeDiscretisation td(new TimeDiscretisation(0.0, 0.005));
+  SP::MoreauJeanOSI osi(new MoreauJeanOSI(0.5));
+  osi->setLoopPolicy(policy);
+  osi->setUseRigidBodyStateStore(useStore);
+  SP::OneStepNSProblem osnspb(new LCP());
+  pb.simulation.reset(new TimeStepping(pb.nsds, td, osi, osnspb));
+  return pb;
+}
+
+bool sameVector(SiconosVector& a, SiconosVector& b)
+{
+  if(a.size() != b.size())
+    return false;
+  for(unsigned int i = 0; i < a.size(); i++)
+    if(a(i) != b(i))
+      return false;
+  return true;
+}
+
+bool closeVector(SiconosVector& a, SiconosVector& b, double tol)
+{
+  if(a.size() != b.size())
+    return false;
+  for(unsigned int i = 0; i < a.size(); i++)
+    if(std::abs(a(i) - b(i)) > tol)
+      return false;
+  return true;
+}
+}
+
+void MoreauJeanOSITest::setUp()
+{}
+
+void MoreauJeanOSITest::tearDown()
+{}
+
+void MoreauJeanOSITest::testLoopPolicy()
+{
+  SP::MoreauJeanOSI osi(new MoreauJeanOSI());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("test loop policy : ", osi->loopPolicy() == MoreauJeanOSI::SEQUENTIAL_LOOP, true);
+
+  // the dynamical systems are integrated independently: the parallel
+  // loops give exactly the states of the sequential ones.
+  BodiesProblem sequential = buildBodies(40, MoreauJeanOSI::SEQUENTIAL_LOOP);
+  BodiesProblem parallel = buildBodies(40, MoreauJeanOSI::PARALLEL_LOOP);
+  for(unsigned int step = 0; step < 100; step++)
+  {
+    for(BodiesProblem* pb : {&sequential, &parallel})
+    {
+      pb->simulation->computeOneStep();
+      pb->simulation->nextStep();
+    }
+  }
+  for(unsigned int i = 0; i < sequential.ds.size(); i++)
+  {
+    SP::SecondOrderDS ds1 = std::static_pointer_cast<SecondOrderDS>(sequential.ds[i]);
+    SP::SecondOrderDS ds2 = std::static_pointer_cast<SecondOrderDS>(parallel.ds[i]);
+    CPPUNIT_ASSERT_MESSAGE("test loop policy : ", sameVector(*ds1->q(), *ds2->q()));
+    CPPUNIT_ASSERT_MESSAGE("test loop policy : ", sameVector(*ds1->velocity(), *ds2->velocity()));
+  }
+  // the balls have bounced
+  SP::SecondOrderDS ball = std::static_pointer_cast<SecondOrderDS>(parallel.ds[0]);
+  CPPUNIT_ASSERT_MESSAGE("test loop policy : ", ball->q()->getValue(0) >= -1e-3);
+}
+
+void MoreauJeanOSITest::testRigidBodyStateStore()
+{
+  SP::MoreauJeanOSI osi(new MoreauJeanOSI());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("test rigid body state store : ", osi->useRigidBodyStateStore(), false);
+
+  // the batched update of the positions of the NewtonEulerDS follows
+  // updatePosition, up to the rounding of the quaternion operations.
+  BodiesProblem reference = buildBodies(40, MoreauJeanOSI::SEQUENTIAL_LOOP);
+  BodiesProblem store = buildBodies(40, MoreauJeanOSI::SEQUENTIAL_LOOP, true);
+  BodiesProblem parallelStore = buildBodies(40, MoreauJeanOSI::PARALLEL_LOOP, true);
+  for(unsigned int step = 0; step < 100; step++)
+  {
+    for(BodiesProblem* pb : {&reference, &store, &parallelStore})
+    {
+      pb->simulation->computeOneStep();
+      pb->simulation->nextStep();
+    }
+  }
+  for(unsigned int i = 0; i < reference.ds.size(); i++)
+  {
+    SP::SecondOrderDS ds0 = std::static_pointer_cast<SecondOrderDS>(reference.ds[i]);
+    SP::SecondOrderDS ds1 = std::static_pointer_cast<SecondOrderDS>(store.ds[i]);
+    SP::SecondOrderDS ds2 = std::static_pointer_cast<SecondOrderDS>(parallelStore.ds[i]);
+    CPPUNIT_ASSERT_MESSAGE("test rigid body state store : ", closeVector(*ds0->q(), *ds1->q(), 1e-12));
+    CPPUNIT_ASSERT_MESSAGE("test rigid body state store : ", closeVector(*ds0->velocity(), *ds1->velocity(), 1e-12));
+    CPPUNIT_ASSERT_MESSAGE("test rigid body state store : ", sameVector(*ds1->q(), *ds2->q()));
+    CPPUNIT_ASSERT_MESSAGE("test rigid body state store : ", sameVector(*ds1->velocity(), *ds2->velocity()));
+  }
+  // the bodies have moved
+  SP::SecondOrderDS body = std::static_pointer_cast<SecondOrderDS>(store.ds[1]);
+  CPPUNIT_ASSERT_MESSAGE("test rigid body state store : ", body->q()->getValue(0) > 0.2);
+}
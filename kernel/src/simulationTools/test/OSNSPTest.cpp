@@ -18,11 +18,439 @@
 #include "OSNSPTest.hpp"
 #include "SolverOptions.h"
 #include "FrictionContact.hpp"
+#include "LCP.hpp"
+#include "MLCP.hpp"
+#include "GenericMechanical.hpp"
+#include "OSNSMatrix.hpp"
+#include "BlockCSRMatrix.hpp"
+#include "NumericsMatrix.h"
+#include "SparseBlockMatrix.h"
+#include "lcp_cst.h"
+#include "TimeStepping.hpp"
+#include "TimeDiscretisation.hpp"
+#include "MoreauJeanOSI.hpp"
+#include "NonSmoothDynamicalSystem.hpp"
+#include "LagrangianLinearTIDS.hpp"
+#include "LagrangianLinearTIR.hpp"
+#include "NewtonImpactNSL.hpp"
+#include "Interaction.hpp"
+#include "SimpleMatrix.hpp"
+#include "SiconosVector.hpp"
+#include "BlockVector.hpp"
+#include "NewtonEulerDS.hpp"
+#include "NewtonEuler1DR.hpp"
+#include "NewtonEuler3DR.hpp"
+#include "NewtonEuler5DR.hpp"
+#include "NewtonImpactFrictionNSL.hpp"
+#include "NewtonImpactRollingFrictionNSL.hpp"
+#include "RollingFrictionContact.hpp"
+#include "RotationQuaternion.hpp"
+#include "SiconosAlgebraProd.hpp"
+#include "op3x3.h"
+#include <functional>
+#include "SiconosConfig.h"
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 // test suite registration
 CPPUNIT_TEST_SUITE_REGISTRATION(OSNSPTest);
 
 
+namespace
+{
+/* A chain of masses with one contact on each mass and one contact
+ * between two consecutive masses. The contacts are always active and
+ * share the masses, so that the index set has edges. */
+struct ChainProblem
+{
+  SP::NonSmoothDynamicalSystem nsds;
+  SP::TimeStepping simulation;
+  SP::LinearOSNS osnspb;
+  std::vector<SP::DynamicalSystem> ds;
+  std::vector<SP::Interaction> inters;
+};
+
+/* a contact on one or two masses, with a friction law in dimension 3 */
+SP::Interaction chainContact(unsigned int nbDS, unsigned int dim = 1)
+{
+  SP::SimpleMatrix C(new SimpleMatrix(dim, dim * nbDS));
+  for(unsigned int k = 0; k < dim; k++)
+  {
+    (*C)(k, k) = 1.0;
+    if(nbDS > 1)
+      (*C)(k, dim + k) = -1.0;
+  }
+  SP::SiconosVector e(new SiconosVector(dim));
+  (*e)(0) = -1.0;
+  SP::Relation relation(new LagrangianLinearTIR(C, e));
+  SP::NonSmoothLaw nslaw;
+  if(dim == 1)
+    nslaw.reset(new NewtonImpactNSL(0.0));
+  else
+    nslaw.reset(new NewtonImpactFrictionNSL(0.0, 0.0, 0.5, dim));
+  return SP::Interaction(new Interaction(nslaw, relation));
+}
+
+ChainProblem buildChain(unsigned int size, bool symmetric,
+                        SP::LinearOSNS osnspb = SP::LinearOSNS(),
+                        unsigned int dim = 1)
+{
+  ChainProblem chain;
+  chain.nsds.reset(new NonSmoothDynamicalSystem(0.0, 1.0));
+  chain.nsds->setSymmetric(symmetric);
+  for(unsigned int i = 0; i < size; i++)
+  {
+    SP::SiconosVector q0(new SiconosVector(dim));
+    SP::SiconosVector v0(new SiconosVector(dim));
+    (*v0)(0) = -0.1 * (i + 1);
+    if(dim > 1)
+      (*v0)(1) = 0.05 * i;
+    SP::SimpleMatrix mass(new SimpleMatrix(dim, dim));
+    for(unsigned int k = 0; k < dim; k++)
+      (*mass)(k, k) = 1.0 + i;
+    SP::DynamicalSystem ds(new LagrangianLinearTIDS(q0, v0, mass));
+    chain.nsds->insertDynamicalSystem(ds);
+    chain.ds.push_back(ds);
+  }
+  for(unsigned int i = 0; i < size; i++)
+  {
+    chain.inters.push_back(chainContact(1, dim));
+    chain.nsds->link(chain.inters.back(), chain.ds[i]);
+    if(i + 1 < size)
+    {
+      chain.inters.push_back(chainContact(2, dim));
+      chain.nsds->link(chain.inters.back(), chain.ds[i], chain.ds[i + 1]);
+    }
+  }
+  SP::TimeDiscretisation td(new TimeDiscretisation(0.0, 0.01));
+  SP::OneStepIntegrator osi(new MoreauJeanOSI(0.5));
+  chain.osnspb = osnspb ? osnspb : SP::LinearOSNS(new LCP());
+  chain.simulation.reset(new TimeStepping(chain.nsds, td, osi, chain.osnspb));
+  return chain;
+}
+
+bool sameMatrix(SiconosMatrix& A, SiconosMatrix& B)
+{
+  if(A.size(0) != B.size(0) || A.size(1) != B.size(1))
+    return false;
+  for(unsigned int i = 0; i < A.size(0); i++)
+    for(unsigned int j = 0; j < A.size(1); j++)
+      if(A(i, j) != B(i, j))
+        return false;
+  return true;
+}
+
+bool sameVector(SiconosVector& a, SiconosVector& b)
+{
+  if(a.size() != b.size())
+    return false;
+  for(unsigned int i = 0; i < a.size(); i++)
+    if(a(i) != b(i))
+      return false;
+  return true;
+}
+
+bool sameNumericsMatrix(NumericsMatrix& A, NumericsMatrix& B)
+{
+  if(A.size0 != B.size0 || A.size1 != B.size1)
+    return false;
+  for(int i = 0; i < A.size0; i++)
+    for(int j = 0; j < A.size1; j++)
+      if(NM_get_value(&A, i, j) != NM_get_value(&B, i, j))
+        return false;
+  return true;
+}
+
+/* The parallel computation of the blocks (symmetric index set) gives
+ * exactly the matrix, the vector and thus the solution of the serial one. */
+void checkParallelAssembly(std::function<SP::LinearOSNS()> newProblem,
+                           unsigned int dim)
+{
+  ChainProblem serial = buildChain(8, true, newProblem(), dim);
+  ChainProblem parallel = buildChain(8, true, newProblem(), dim);
+  parallel.osnspb->setParallelAssembly(true);
+  for(unsigned int step = 0; step < 3; step++)
+  {
+    for(ChainProblem* chain : {&serial, &parallel})
+    {
+      chain->simulation->computeOneStep();
+      chain->simulation->nextStep();
+    }
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("test parallel assembly : ",
+                                 serial.osnspb->getSizeOutput(), 15 * dim);
+    CPPUNIT_ASSERT_MESSAGE("test parallel assembly : ",
+                           sameNumericsMatrix(*serial.osnspb->M()->numericsMatrix(),
+                                              *parallel.osnspb->M()->numericsMatrix()));
+    CPPUNIT_ASSERT_MESSAGE("test parallel assembly : ",
+                           sameVector(*serial.osnspb->q(), *parallel.osnspb->q()));
+    CPPUNIT_ASSERT_MESSAGE("test parallel assembly : ",
+                           sameVector(*serial.osnspb->z(), *parallel.osnspb->z()));
+  }
+}
+
+/* An interaction is added at the end of the index set, another one is
+ * removed in the middle, then the added one is removed. The problem
+ * assembled incrementally must be the one of a full reassembly and give
+ * the same solution. */
+void checkIncrementalAssembly(std::function<SP::LinearOSNS()> newProblem)
+{
+  for(bool symmetric : {false, true})
+  {
+    ChainProblem full = buildChain(4, symmetric, newProblem());
+    ChainProblem incremental = buildChain(4, symmetric, newProblem());
+    incremental.osnspb->setIncrementalAssembly(true);
+    SP::Interaction added[2];
+
+    for(unsigned int step = 0; step < 6; step++)
+    {
+      if(step == 2)
+      {
+        // a contact between the two ends of the chain
+        for(ChainProblem* chain : {&full, &incremental})
+        {
+          SP::Interaction inter = chainContact(2);
+          chain->nsds->link(inter, chain->ds.front(), chain->ds.back());
+          added[chain == &full ? 0 : 1] = inter;
+        }
+      }
+      if(step == 3)
+      {
+        full.nsds->removeInteraction(full.inters[3]);
+        incremental.nsds->removeInteraction(incremental.inters[3]);
+      }
+      if(step == 4)
+      {
+        full.nsds->removeInteraction(added[0]);
+        incremental.nsds->removeInteraction(added[1]);
+      }
+      for(ChainProblem* chain : {&full, &incremental})
+      {
+        chain->simulation->computeOneStep();
+        chain->simulation->nextStep();
+      }
+      CPPUNIT_ASSERT_EQUAL_MESSAGE("test incremental assembly : ",
+                                   full.osnspb->getSizeOutput(),
+                                   incremental.osnspb->getSizeOutput());
+      CPPUNIT_ASSERT_MESSAGE("test incremental assembly : ",
+                             sameNumericsMatrix(*full.osnspb->M()->numericsMatrix(),
+                                                *incremental.osnspb->M()->numericsMatrix()));
+      CPPUNIT_ASSERT_MESSAGE("test incremental assembly : ",
+                             sameVector(*full.osnspb->q(), *incremental.osnspb->q()));
+      CPPUNIT_ASSERT_MESSAGE("test incremental assembly : ",
+                             sameVector(*full.osnspb->z(), *incremental.osnspb->z()));
+    }
+    // 4 + 3 - 1 contacts once the added one has been removed
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("test incremental assembly : ",
+                                 incremental.osnspb->getSizeOutput(), 6u);
+  }
+}
+
+/* A NewtonEuler contact relation with a fixed contact point and normal,
+ * always active */
+template<class ContactR>
+class FixedContactR : public ContactR
+{
+public:
+  FixedContactR(const SiconosVector& P, const SiconosVector& N)
+  {
+    *this->_Pc1 = P;
+    *this->_Pc2 = P;
+    *this->_Nc = N;
+  }
+
+  void computeh(double time, const BlockVector& q0, SiconosVector& y) override
+  {
+    y.zero();
+    y(0) = -0.1;
+  }
+};
+
+SP::NewtonEulerDS rigidBody(double x, double y, double z, double angle)
+{
+  SP::SiconosVector q(new SiconosVector(7));
+  SP::SiconosVector axis(new SiconosVector(3));
+  (*axis)(0) = 1.0;
+  (*axis)(1) = 2.0 * angle;
+  (*axis)(2) = -1.0;
+  ::quaternionFromAxisAngle(axis, angle, q);
+  (*q)(0) = x;
+  (*q)(1) = y;
+  (*q)(2) = z;
+  SP::SiconosVector v(new SiconosVector(6));
+  (*v)(2) = -0.1;
+  (*v)(3) = 0.5;
+  (*v)(4) = -1.0;
+  (*v)(5) = 2.0;
+  SP::SimpleMatrix inertia(new SimpleMatrix(3, 3));
+  (*inertia)(0, 0) = 2.0;
+  (*inertia)(1, 1) = 3.0;
+  (*inertia)(2, 2) = 4.0;
+  (*inertia)(0, 1) = (*inertia)(1, 0) = 0.1;
+  (*inertia)(1, 2) = (*inertia)(2, 1) = 0.2;
+  return SP::NewtonEulerDS(new NewtonEulerDS(q, v, 1.5, inertia));
+}
+
+SP::SiconosVector vector3(double x, double y, double z)
+{
+  SP::SiconosVector v(new SiconosVector(3));
+  (*v)(0) = x;
+  (*v)(1) = y;
+  (*v)(2) = z;
+  return v;
+}
+
+/* The Jacobian of a contact with N rows for one body, computed with
+ * SimpleMatrix products: R, R [G - P]x Rb and the rolling rows (R Rb)(1:2, :) */
+SimpleMatrix referenceContactJacobian(unsigned int N, const SiconosVector& P,
+                                      const SiconosVector& normal,
+                                      SP::SiconosVector q, double sign)
+{
+  double n[3] = { normal(0), normal(1), normal(2) };
+  double t[6];
+  orthoBaseFromVector(n, n + 1, n + 2, t, t + 1, t + 2, t + 3, t + 4, t + 5);
+  SimpleMatrix R(3, 3), lever(3, 3), aux(3, 3), rot(3, 3), rolling(3, 3);
+  for(unsigned int j = 0; j < 3; j++)
+  {
+    R(0, j) = n[j];
+    R(1, j) = t[j];
+    R(2, j) = t[j + 3];
+  }
+  lever.zero();
+  lever(0, 1) = -((*q)(2) - P(2));
+  lever(0, 2) = (*q)(1) - P(1);
+  lever(1, 0) = (*q)(2) - P(2);
+  lever(1, 2) = -((*q)(0) - P(0));
+  lever(2, 0) = -((*q)(1) - P(1));
+  lever(2, 1) = (*q)(0) - P(0);
+  SP::SimpleMatrix body(new SimpleMatrix(3, 3));
+  ::computeRotationMatrix(q, body);
+  prod(lever, *body, aux, true);
+  prod(R, aux, rot, true);
+  prod(R, *body, rolling, true);
+
+  SimpleMatrix J(N, 6);
+  J.zero();
+  for(unsigned int i = 0; i < std::min(N, 3u); i++)
+    for(unsigned int j = 0; j < 3; j++)
+    {
+      J(i, j) = sign * R(i, j);
+      J(i, j + 3) = sign * rot(i, j);
+    }
+  for(unsigned int i = 3; i < N; i++)
+    for(unsigned int j = 0; j < 3; j++)
+      J(i, j + 3) = sign * rolling(i - 2, j);
+  return J;
+}
+
+/* the columns of a DS in a Jacobian */
+SimpleMatrix jacobianBlock(SiconosMatrix& jachqT, unsigned int pos)
+{
+  SimpleMatrix H(jachqT.size(0), 6);
+  for(unsigned int i = 0; i < jachqT.size(0); i++)
+    for(unsigned int j = 0; j < 6; j++)
+      H(i, j) = jachqT(i, pos + j);
+  return H;
+}
+
+/* a contact problem with N rows on a NewtonEulerDS: an interaction
+ * between b1 and b2 (or b1 alone) and an interaction on b1 */
+template<class ContactR>
+void checkDelassusBlocks(unsigned int N, bool twoBodies,
+                         SP::NonSmoothLaw nslaw, SP::LinearOSNS osnspb)
+{
+  SP::NonSmoothDynamicalSystem nsds(new NonSmoothDynamicalSystem(0.0, 1.0));
+  SP::NewtonEulerDS b1 = rigidBody(0.0, 0.0, 1.0, 0.3);
+  SP::NewtonEulerDS b2 = rigidBody(0.5, 0.2, 2.0, -0.7);
+  nsds->insertDynamicalSystem(b1);
+  nsds->insertDynamicalSystem(b2);
+
+  SP::SiconosVector n1 = vector3(0.1, 0.2, 1.0);
+  SP::SiconosVector n2 = vector3(0.2, -0.1, 1.0);
+  *n1 *= 1.0 / n1->norm2();
+  *n2 *= 1.0 / n2->norm2();
+  SP::SiconosVector p1 = vector3(0.1, 0.2, 1.5);
+  SP::SiconosVector p2 = vector3(0.3, -0.1, 0.4);
+  SP::NewtonEulerR r1(new FixedContactR<ContactR>(*p1, *n1));
+  SP::NewtonEulerR r2(new FixedContactR<ContactR>(*p2, *n2));
+  SP::Interaction inter1(new Interaction(nslaw, r1));
+  SP::Interaction inter2(new Interaction(nslaw, r2));
+  if(twoBodies)
+    nsds->link(inter1, b1, b2);
+  else
+    nsds->link(inter1, b1);
+  nsds->link(inter2, b1);
+
+  SP::TimeDiscretisation td(new TimeDiscretisation(0.0, 0.01));
+  SP::MoreauJeanOSI osi(new MoreauJeanOSI(0.5));
+  SP::TimeStepping simulation(new TimeStepping(nsds, td, osi, osnspb));
+  simulation->computeOneStep();
+
+  std::vector<SP::SiconosVector> contactPoints = { p1, p2 };
+  std::vector<SP::SiconosVector> normals = { n1, n2 };
+  std::vector<SP::NewtonEulerR> relations = { r1, r2 };
+  std::vector<SP::Interaction> inters = { inter1, inter2 };
+  std::vector<std::vector<SP::NewtonEulerDS> > bodies = { { b1 }, { b1 } };
+  if(twoBodies)
+    bodies[0].push_back(b2);
+
+  // H_a W^{-1} H_b^T on the common DS with the generic SimpleMatrix
+  // products, as in the generic path of LinearOSNS, with the Jacobians of
+  // the last Newton iteration
+  SP::InteractionsGraph indexSet = simulation->indexSet(1);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("test fixed-size Delassus blocks : ",
+                               (size_t) 2, indexSet->size());
+  SiconosMatrix& M = *osnspb->M()->defaultMatrix();
+  double norm = 0.0, error = 0.0;
+  for(unsigned int a = 0; a < 2; a++)
+    for(unsigned int b = 0; b < 2; b++)
+    {
+      unsigned int posA = indexSet->properties(indexSet->descriptor(inters[a])).absolute_position;
+      unsigned int posB = indexSet->properties(indexSet->descriptor(inters[b])).absolute_position;
+      SimpleMatrix block(N, N);
+      block.zero();
+      for(unsigned int da = 0; da < bodies[a].size(); da++)
+        for(unsigned int db = 0; db < bodies[b].size(); db++)
+        {
+          if(bodies[a][da] != bodies[b][db])
+            continue;
+          SimpleMatrix Ha = jacobianBlock(*relations[a]->jachqT(), 6 * da);
+          SimpleMatrix Hb = jacobianBlock(*relations[b]->jachqT(), 6 * db);
+          SimpleMatrix work(6, N);
+          work.trans(Hb);
+          osi->W(bodies[a][da])->Solve(work);
+          SimpleMatrix contribution(N, N);
+          prod(Ha, work, contribution, true);
+          block += contribution;
+        }
+      for(unsigned int i = 0; i < N; i++)
+        for(unsigned int j = 0; j < N; j++)
+        {
+          norm = std::max(norm, std::abs(block(i, j)));
+          error = std::max(error, std::abs(M(posA + i, posB + j) - block(i, j)));
+        }
+    }
+  CPPUNIT_ASSERT_MESSAGE("test fixed-size Delassus blocks : ", norm > 0.0);
+  CPPUNIT_ASSERT_MESSAGE("test fixed-size Delassus blocks : ", error <= 1e-12 * norm);
+
+  // the Jacobians, computed again at the current positions
+  for(unsigned int k = 0; k < 2; k++)
+    relations[k]->computeJach(simulation->nextTime(), *inters[k]);
+  error = 0.0;
+  for(unsigned int k = 0; k < 2; k++)
+    for(unsigned int d = 0; d < bodies[k].size(); d++)
+    {
+      SimpleMatrix H = jacobianBlock(*relations[k]->jachqT(), 6 * d);
+      SimpleMatrix J = referenceContactJacobian(N, *contactPoints[k], *normals[k],
+                                                bodies[k][d]->q(), d ? -1.0 : 1.0);
+      for(unsigned int i = 0; i < N; i++)
+        for(unsigned int j = 0; j < 6; j++)
+          error = std::max(error, std::abs(H(i, j) - J(i, j)));
+    }
+  CPPUNIT_ASSERT_MESSAGE("test fixed-size Delassus blocks : Jacobian", error <= 1e-14);
+}
+}
+
 void OSNSPTest::setUp()
 {}
 
@@ -58,3 +486,92 @@ void OSNSPTest::testOSNSBuild_options()
   auto options_link = problem->numericsSolverOptions();
   CPPUNIT_ASSERT_EQUAL_MESSAGE("test solver options : ",  options_link->solverId == SICONOS_FRICTION_3D_ADMM, true);
 }
+
+void OSNSPTest::testOSNSIncrementalAssembly()
+{
+  SP::FrictionContact problem = std::make_shared<FrictionContact>();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("test incremental assembly : ", problem->incrementalAssembly(), false);
+  problem->setIncrementalAssembly(true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("test incremental assembly : ", problem->incrementalAssembly(), true);
+
+  checkIncrementalAssembly([]() { return SP::LinearOSNS(new LCP()); });
+  // blocks of M kept in the block-sparse storage
+  checkIncrementalAssembly([]()
+  {
+    SP::LinearOSNS osnspb(new LCP(SICONOS_LCP_NSGS_SBM));
+    osnspb->setMStorageType(NM_SPARSE_BLOCK);
+    return osnspb;
+  });
+  // problems whose description is built with the blocks
+  checkIncrementalAssembly([]() { return SP::LinearOSNS(new MLCP()); });
+  checkIncrementalAssembly([]() { return SP::LinearOSNS(new GenericMechanical()); });
+}
+
+void OSNSPTest::testOSNSParallelAssembly()
+{
+  SP::FrictionContact problem = std::make_shared<FrictionContact>();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("test parallel assembly : ", problem->parallelAssembly(), false);
+  problem->setParallelAssembly(true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("test parallel assembly : ", problem->parallelAssembly(), true);
+
+#ifdef WITH_OPENMP
+  omp_set_num_threads(4);
+#endif
+  checkParallelAssembly([]() { return SP::LinearOSNS(new LCP()); }, 1);
+  checkParallelAssembly([]() { return SP::LinearOSNS(new FrictionContact(3)); }, 3);
+  // the description of the problem is built sequentially
+  checkParallelAssembly([]() { return SP::LinearOSNS(new MLCP()); }, 1);
+}
+
+void OSNSPTest::testPackedMBlocks()
+{
+  // M stored by blocks: the solver gets the same matrix, and thus the
+  // same solution, whether the blocks are linked or copied into the
+  // contiguous storage of the numerics structure.
+  ChainProblem linked = buildChain(6, true, SP::LinearOSNS(new LCP(SICONOS_LCP_NSGS_SBM)));
+  ChainProblem packed = buildChain(6, true, SP::LinearOSNS(new LCP(SICONOS_LCP_NSGS_SBM)));
+  linked.osnspb->setMStorageType(NM_SPARSE_BLOCK);
+  packed.osnspb->setMStorageType(NM_SPARSE_BLOCK);
+  packed.osnspb->setPackedMBlocks(true);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("test packed M blocks : ", packed.osnspb->packedMBlocks(), true);
+  for(unsigned int step = 0; step < 3; step++)
+  {
+    for(ChainProblem* chain : {&linked, &packed})
+    {
+      chain->simulation->computeOneStep();
+      chain->simulation->nextStep();
+    }
+    CPPUNIT_ASSERT_EQUAL_MESSAGE("test packed M blocks : ",
+                                 linked.osnspb->getSizeOutput(), 11u);
+    SparseBlockStructuredMatrix* M = packed.osnspb->M()->numericsMatrix()->matrix1;
+    CPPUNIT_ASSERT_MESSAGE("test packed M blocks : ", M->arena);
+    CPPUNIT_ASSERT_MESSAGE("test packed M blocks : ",
+                           M->block[0] != linked.osnspb->M()->numericsMatrix()->matrix1->block[0]);
+    CPPUNIT_ASSERT_MESSAGE("test packed M blocks : ",
+                           sameVector(*linked.osnspb->z(), *packed.osnspb->z()));
+  }
+  CPPUNIT_ASSERT_MESSAGE("test packed M blocks : ",
+                         !linked.osnspb->M()->numericsMatrix()->matrix1->arena);
+  packed.osnspb->setPackedMBlocks(false);
+  CPPUNIT_ASSERT_MESSAGE("test packed M blocks : ",
+                         !packed.osnspb->M()->numericsMatrix()->matrix1->arena);
+}
+
+void OSNSPTest::testFixedSizeDelassusBlocks()
+{
+  // 1, 3 and 5 rows (NewtonEuler1DR, 3DR and 5DR) on one and two bodies:
+  // the diagonal blocks and the extra-diagonal blocks through b1 use the
+  // fixed-size path
+  for(bool twoBodies : {false, true})
+  {
+    checkDelassusBlocks<NewtonEuler1DR>(1, twoBodies,
+                                        SP::NonSmoothLaw(new NewtonImpactNSL(0.0)),
+                                        SP::LinearOSNS(new LCP()));
+    checkDelassusBlocks<NewtonEuler3DR>(3, twoBodies,
+                                        SP::NonSmoothLaw(new NewtonImpactFrictionNSL(0.0, 0.0, 0.5, 3)),
+                                        SP::LinearOSNS(new FrictionContact(3)));
+    checkDelassusBlocks<NewtonEuler5DR>(5, twoBodies,
+                                        SP::NonSmoothLaw(new NewtonImpactRollingFrictionNSL(0.0, 0.0, 0.5, 0.1, 5)),
+                                        SP::LinearOSNS(new RollingFrictionContact(5)));
+  }
+}
@@ -31,11 +31,19 @@ private:
   CPPUNIT_TEST(testOSNSBuild_default);
   CPPUNIT_TEST(testOSNSBuild_solverid);
   CPPUNIT_TEST(testOSNSBuild_options);
+  CPPUNIT_TEST(testOSNSIncrementalAssembly);
+  CPPUNIT_TEST(testOSNSParallelAssembly);
+  CPPUNIT_TEST(testPackedMBlocks);
+  CPPUNIT_TEST(testFixedSizeDelassusBlocks);
   CPPUNIT_TEST_SUITE_END();
 
   void testOSNSBuild_default();
   void testOSNSBuild_solverid();
   void testOSNSBuild_options();
+  void testOSNSIncrementalAssembly();
+  void testOSNSParallelAssembly();
+  void testPackedMBlocks();
+  void testFixedSizeDelassusBlocks();
 
 
 public:
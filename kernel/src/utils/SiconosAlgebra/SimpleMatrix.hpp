@@ -718,6 +718,14 @@ public:
   void PLUForwardBackwardInPlace(SiconosVector& B) override;
   void Solve(SiconosVector& B) override;
 
+  /** solves a system of linear equations A * X = B  (A=this) for the
+   *  right-hand sides stored in a column-major array, A being factorized
+   *  if needed
+   *  \param[in,out] B on input the RHS b; on output the result x
+   *  \param nrhs the number of right-hand sides (columns of B)
+   */
+  void Solve(double* B, unsigned int nrhs);
+
   /** solves a system of linear equations A * X = B  (A=this)
       with a general N-by-N matrix A using the Least squares method
    *  \param[in,out] B on input the RHS matrix b; on output the result x
@@ -581,3 +581,43 @@ void SimpleMatrix::Solve(SiconosVector &B)
   // }
   DEBUG_END("SimpleMatrix::Solve(SiconosVector &B)\n");
 }
+
+void SimpleMatrix::Solve(double* B, unsigned int nrhs)
+{
+  DEBUG_BEGIN("SimpleMatrix::Solve(double* B, unsigned int nrhs)\n");
+
+  if(!isFactorized())
+  {
+    Factorize();
+  }
+
+  int info = 1;
+  NumericsMatrix * NM = _numericsMatrix.get();
+
+  if (isSymmetric())
+  {
+    if (isPositiveDefinite()) // Cholesky Factorization
+    {
+      info  = NM_Cholesky_solve(NM, B, nrhs);
+
+      if(info != 0)
+      {
+        THROW_EXCEPTION("SimpleMatrix::Solve failed (Cholesky)");
+      }
+    }
+    else  //  LDLT Factorization
+    {
+      THROW_EXCEPTION("SimpleMatrix::Solve failed: LDL^T not yet implemented.");
+    }
+  }
+  else //  LU Factorization  by default
+  {
+    info  = NM_LU_solve(NM, B, nrhs);
+
+    if(info != 0)
+    {
+      THROW_EXCEPTION("SimpleMatrix::Solve failed (LU)");
+    }
+  }
+  DEBUG_END("SimpleMatrix::Solve(double* B, unsigned int nrhs)\n");
+}
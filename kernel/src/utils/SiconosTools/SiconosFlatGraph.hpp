@@ -0,0 +1,1055 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file SiconosFlatGraph.hpp
+  Graph of Siconos objects with contiguous storage.
+
+  SiconosFlatGraph has the same interface as SiconosGraph, but the
+  vertices and the edges are stored in slot arrays instead of the
+  linked lists of boost::adjacency_list<listS, listS>:
+
+  - a descriptor is the index of a slot. It remains valid until the
+    vertex or the edge is removed, as with listS,
+  - a removed slot is marked as free and reused by the next insertion,
+  - the bundles, colors, indices and properties are stored in separate
+    arrays, so that a traversal reads contiguous memory,
+  - the incident edges of a vertex are stored in a small inline array.
+
+  The iteration order is the order of the slots: the order of insertion
+  as long as no element has been removed.
+
+  It is used for the DynamicalSystemsGraph and InteractionsGraph when
+  Siconos is configured with SICONOS_USE_FLAT_GRAPH=ON.
+*/
+
+#ifndef SICONOS_FLAT_GRAPH_HPP
+#define SICONOS_FLAT_GRAPH_HPP
+
+#include <SiconosConfig.h>
+#if !defined(SICONOS_USE_MAP_FOR_HASH)
+#include <unordered_map>
+#else
+#include <map>
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <limits>
+#include <vector>
+#include <boost/container/small_vector.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include "SiconosException.hpp"
+
+/** vertex descriptor of a SiconosFlatGraph : index of the vertex slot */
+struct FlatGraphVDescriptor
+{
+  size_t id;
+
+  FlatGraphVDescriptor() : id(std::numeric_limits<size_t>::max()) {};
+  explicit FlatGraphVDescriptor(size_t i) : id(i) {};
+
+  bool operator==(const FlatGraphVDescriptor& o) const { return id == o.id; };
+  bool operator!=(const FlatGraphVDescriptor& o) const { return id != o.id; };
+  bool operator<(const FlatGraphVDescriptor& o) const { return id < o.id; };
+
+  /** false for a default descriptor, as a null listS descriptor */
+  explicit operator bool() const { return id != std::numeric_limits<size_t>::max(); };
+};
+
+/** edge descriptor of a SiconosFlatGraph : index of the edge slot, with
+ *  the source and the target as seen from the traversal, as for the
+ *  undirected edges of boost
+ */
+struct FlatGraphEDescriptor
+{
+  size_t id;
+  size_t s;
+  size_t t;
+
+  FlatGraphEDescriptor() :
+    id(std::numeric_limits<size_t>::max()),
+    s(std::numeric_limits<size_t>::max()),
+    t(std::numeric_limits<size_t>::max()) {};
+  FlatGraphEDescriptor(size_t i, size_t source, size_t target) :
+    id(i), s(source), t(target) {};
+
+  bool operator==(const FlatGraphEDescriptor& o) const { return id == o.id; };
+  bool operator!=(const FlatGraphEDescriptor& o) const { return id != o.id; };
+  bool operator<(const FlatGraphEDescriptor& o) const { return id < o.id; };
+};
+
+inline std::ostream& operator<<(std::ostream& os, const FlatGraphVDescriptor& vd)
+{
+  return os << vd.id;
+}
+
+inline std::ostream& operator<<(std::ostream& os, const FlatGraphEDescriptor& ed)
+{
+  return os << ed.id << "(" << ed.s << "," << ed.t << ")";
+}
+
+/** index map tag, only its key_type is used (see SiconosProperties.hpp) */
+template<class Descriptor>
+struct FlatGraphIndexMap
+{
+  typedef Descriptor key_type;
+  typedef size_t value_type;
+  typedef size_t& reference;
+  typedef boost::lvalue_property_map_tag category;
+};
+
+/** incident edges of a vertex of a SiconosFlatGraph */
+typedef boost::container::small_vector<size_t, 4> FlatGraphIncidenceList;
+
+/* The iterators of SiconosFlatGraph do not depend on the graph type:
+   as with listS, the iterators of the DynamicalSystemsGraph and of the
+   InteractionsGraph have the same type. They return a reference on a
+   descriptor they hold, which is valid until the next increment. */
+
+/** iterator on the vertices of a SiconosFlatGraph */
+class FlatGraphVIterator : public boost::iterator_facade <
+  FlatGraphVIterator, FlatGraphVDescriptor, boost::forward_traversal_tag >
+{
+public:
+  FlatGraphVIterator() : _alive(nullptr), _end(0) {};
+  FlatGraphVIterator(const std::vector<char>* alive, size_t pos, size_t end) :
+    _alive(alive), _end(end)
+  {
+    _current.id = pos;
+    skip();
+  };
+
+private:
+  friend class boost::iterator_core_access;
+  const std::vector<char>* _alive;
+  size_t _end;
+  mutable FlatGraphVDescriptor _current;
+
+  void skip()
+  {
+    while(_current.id < _end && !(*_alive)[_current.id]) ++_current.id;
+  };
+  void increment()
+  {
+    ++_current.id;
+    skip();
+  };
+  bool equal(const FlatGraphVIterator& o) const
+  {
+    return _current.id == o._current.id;
+  };
+  FlatGraphVDescriptor& dereference() const
+  {
+    return _current;
+  };
+};
+
+/** iterator on the edges of a SiconosFlatGraph */
+class FlatGraphEIterator : public boost::iterator_facade <
+  FlatGraphEIterator, FlatGraphEDescriptor, boost::forward_traversal_tag >
+{
+public:
+  FlatGraphEIterator() : _alive(nullptr), _source(nullptr), _target(nullptr),
+    _pos(0), _end(0) {};
+  FlatGraphEIterator(const std::vector<char>* alive,
+                     const std::vector<size_t>* source,
+                     const std::vector<size_t>* target,
+                     size_t pos, size_t end) :
+    _alive(alive), _source(source), _target(target), _pos(pos), _end(end)
+  {
+    skip();
+  };
+
+private:
+  friend class boost::iterator_core_access;
+  const std::vector<char>* _alive;
+  const std::vector<size_t>* _source;
+  const std::vector<size_t>* _target;
+  size_t _pos;
+  size_t _end;
+  mutable FlatGraphEDescriptor _current;
+
+  void skip()
+  {
+    while(_pos < _end && !(*_alive)[_pos]) ++_pos;
+  };
+  void increment()
+  {
+    ++_pos;
+    skip();
+  };
+  bool equal(const FlatGraphEIterator& o) const
+  {
+    return _pos == o._pos;
+  };
+  FlatGraphEDescriptor& dereference() const
+  {
+    _current = FlatGraphEDescriptor(_pos, (*_source)[_pos], (*_target)[_pos]);
+    return _current;
+  };
+};
+
+/** iterator on the edges incident to a vertex of a SiconosFlatGraph, the
+ * vertex is the source of the edges */
+class FlatGraphOEIterator : public boost::iterator_facade <
+  FlatGraphOEIterator, FlatGraphEDescriptor, boost::forward_traversal_tag >
+{
+public:
+  FlatGraphOEIterator() : _out(nullptr), _source(nullptr), _target(nullptr),
+    _v(0), _pos(0) {};
+  FlatGraphOEIterator(const std::vector<FlatGraphIncidenceList>* out,
+                      const std::vector<size_t>* source,
+                      const std::vector<size_t>* target,
+                      size_t v, size_t pos) :
+    _out(out), _source(source), _target(target), _v(v), _pos(pos) {};
+
+private:
+  friend class boost::iterator_core_access;
+  const std::vector<FlatGraphIncidenceList>* _out;
+  const std::vector<size_t>* _source;
+  const std::vector<size_t>* _target;
+  size_t _v;
+  size_t _pos;
+  mutable FlatGraphEDescriptor _current;
+
+  void increment()
+  {
+    ++_pos;
+  };
+  bool equal(const FlatGraphOEIterator& o) const
+  {
+    return _pos == o._pos && _v == o._v;
+  };
+  FlatGraphEDescriptor& dereference() const
+  {
+    size_t id = (*_out)[_v][_pos];
+    size_t other = ((*_source)[id] == _v) ? (*_target)[id] : (*_source)[id];
+    _current = FlatGraphEDescriptor(id, _v, other);
+    return _current;
+  };
+};
+
+/** iterator on the vertices adjacent to a vertex of a SiconosFlatGraph */
+class FlatGraphAVIterator : public boost::iterator_facade <
+  FlatGraphAVIterator, FlatGraphVDescriptor, boost::forward_traversal_tag >
+{
+public:
+  FlatGraphAVIterator() {};
+  FlatGraphAVIterator(const FlatGraphOEIterator& oei) : _oei(oei) {};
+
+private:
+  friend class boost::iterator_core_access;
+  FlatGraphOEIterator _oei;
+  mutable FlatGraphVDescriptor _current;
+
+  void increment()
+  {
+    ++_oei;
+  };
+  bool equal(const FlatGraphAVIterator& o) const
+  {
+    return _oei == o._oei;
+  };
+  FlatGraphVDescriptor& dereference() const
+  {
+    _current.id = _oei->t;
+    return _current;
+  };
+};
+
+template < class V, class E, class VProperties,
+         class EProperties, class GProperties >
+class SiconosFlatGraph
+{
+public:
+
+  typedef FlatGraphVDescriptor VDescriptor;
+
+  typedef FlatGraphEDescriptor EDescriptor;
+
+  typedef V vertex_t;
+
+  typedef E edge_t;
+
+  typedef FlatGraphIndexMap<VDescriptor> VIndexAccess;
+
+  typedef FlatGraphIndexMap<EDescriptor> EIndexAccess;
+
+#if !defined(SICONOS_USE_MAP_FOR_HASH)
+  typedef typename std::unordered_map<V, VDescriptor> VMap;
+#else
+  typedef typename std::map<V, VDescriptor> VMap;
+#endif
+
+  typedef FlatGraphIncidenceList IncidenceList;
+
+  typedef FlatGraphVIterator VIterator;
+
+  typedef FlatGraphEIterator EIterator;
+
+  typedef FlatGraphOEIterator OEIterator;
+
+  typedef FlatGraphAVIterator AVIterator;
+
+  int _stamp;
+  VMap vertex_descriptor;
+
+protected:
+
+  /* vertex slots */
+  std::vector<V> _vbundle;
+  std::vector<boost::default_color_type> _vcolor;
+  std::vector<size_t> _vindex;
+  std::vector<VProperties> _vproperties;
+  std::vector<IncidenceList> _vout;
+  std::vector<char> _valive;
+  std::vector<size_t> _vfree;
+  size_t _nv;
+
+  /* edge slots */
+  std::vector<E> _ebundle;
+  std::vector<boost::default_color_type> _ecolor;
+  std::vector<size_t> _eindex;
+  std::vector<EProperties> _eproperties;
+  std::vector<size_t> _esource;
+  std::vector<size_t> _etarget;
+  std::vector<char> _ealive;
+  std::vector<size_t> _efree;
+  size_t _ne;
+
+  GProperties _gproperties;
+
+  /** the other end of the edge id */
+  inline size_t opposite(size_t id, size_t v) const
+  {
+    return (_esource[id] == v) ? _etarget[id] : _esource[id];
+  };
+
+  size_t new_vertex_slot()
+  {
+    size_t id;
+    if(!_vfree.empty())
+    {
+      id = _vfree.back();
+      _vfree.pop_back();
+    }
+    else
+    {
+      id = _valive.size();
+      _vbundle.emplace_back();
+      _vcolor.push_back(boost::default_color_type());
+      _vindex.push_back(0);
+      _vproperties.emplace_back();
+      _vout.emplace_back();
+      _valive.push_back(0);
+    }
+    _valive[id] = 1;
+    _vcolor[id] = boost::default_color_type();
+    _nv++;
+    return id;
+  };
+
+  size_t new_edge_slot()
+  {
+    size_t id;
+    if(!_efree.empty())
+    {
+      id = _efree.back();
+      _efree.pop_back();
+    }
+    else
+    {
+      id = _ealive.size();
+      _ebundle.emplace_back();
+      _ecolor.push_back(boost::default_color_type());
+      _eindex.push_back(0);
+      _eproperties.emplace_back();
+      _esource.push_back(0);
+      _etarget.push_back(0);
+      _ealive.push_back(0);
+    }
+    _ealive[id] = 1;
+    _ecolor[id] = boost::default_color_type();
+    _ne++;
+    return id;
+  };
+
+  /** detach the edge id from its ends and free its slot */
+  void remove_edge_slot(size_t id)
+  {
+    assert(_ealive[id]);
+    size_t ends[2] = {_esource[id], _etarget[id]};
+    for(unsigned int k = 0; k < (ends[0] == ends[1] ? 1u : 2u); ++k)
+    {
+      IncidenceList& out = _vout[ends[k]];
+      out.erase(std::find(out.begin(), out.end(), id));
+    }
+    // release the bundle and the properties now, as listS does
+    _ebundle[id] = E();
+    _eproperties[id] = EProperties();
+    _ealive[id] = 0;
+    _efree.push_back(id);
+    _ne--;
+  };
+
+private:
+
+  SiconosFlatGraph(const SiconosFlatGraph&);
+
+public:
+
+  /** default constructor
+   */
+  SiconosFlatGraph() : _stamp(0), _nv(0), _ne(0)
+  {
+  };
+
+  ~SiconosFlatGraph()
+  {
+    clear();
+  };
+
+  std::pair<EDescriptor, bool>
+  edge(VDescriptor u, VDescriptor v) const
+  {
+    const IncidenceList& out = _vout[u.id];
+    for(typename IncidenceList::const_iterator it = out.begin(); it != out.end(); ++it)
+    {
+      if(opposite(*it, u.id) == v.id)
+        return std::pair<EDescriptor, bool>(EDescriptor(*it, u.id, v.id), true);
+    }
+    return std::pair<EDescriptor, bool>(EDescriptor(), false);
+  }
+
+  bool edge_exists(const VDescriptor& vd1, const VDescriptor& vd2) const
+  {
+    return edge(vd1, vd2).second;
+  }
+
+  /* parallel edges, see SiconosGraph::edges */
+  std::pair<EDescriptor, EDescriptor>
+  edges(VDescriptor u, VDescriptor v) const
+  {
+    OEIterator oei, oeiend;
+    bool ifirst = false;
+    bool isecond = false;
+    EDescriptor first, second;
+    for (std::tie(oei, oeiend) = out_edges(u); oei != oeiend; ++oei)
+    {
+      if (target(*oei) == v)
+      {
+        if (!ifirst)
+        {
+          ifirst = true;
+          first = *oei;
+        }
+        else
+        {
+          isecond = true;
+          second = *oei;
+          break;
+        }
+      }
+    }
+
+    if (ifirst && isecond)
+    {
+      if (index(first) < index(second))
+      {
+        return std::pair<EDescriptor, EDescriptor>(first, second);
+      }
+      else
+      {
+        return std::pair<EDescriptor, EDescriptor>(second, first);
+      }
+    }
+    else if (ifirst)
+    {
+      return std::pair<EDescriptor, EDescriptor>(first, first);
+    }
+    else
+    {
+      THROW_EXCEPTION("SiconosFlatGraph::edges, no edge between the two vertices.");
+    }
+  }
+
+  bool is_edge(const VDescriptor& vd1, const VDescriptor& vd2,
+               const E& e_bundle) const
+  {
+    const IncidenceList& out = _vout[vd1.id];
+    for(typename IncidenceList::const_iterator it = out.begin(); it != out.end(); ++it)
+    {
+      if(opposite(*it, vd1.id) == vd2.id && _ebundle[*it] == e_bundle)
+        return true;
+    }
+    return false;
+  }
+
+  bool adjacent_vertex_exists(const VDescriptor& vd) const
+  {
+    return !_vout[vd.id].empty();
+  }
+
+  size_t size() const
+  {
+    return _nv;
+  };
+
+  size_t vertices_number() const
+  {
+    return _nv;
+  };
+
+  size_t edges_number() const
+  {
+    return _ne;
+  };
+
+  inline V& bundle(const VDescriptor& vd)
+  {
+    return _vbundle[vd.id];
+  };
+
+  inline const V& bundle(const VDescriptor& vd) const
+  {
+    return _vbundle[vd.id];
+  };
+
+  inline E& bundle(const EDescriptor& ed)
+  {
+    return _ebundle[ed.id];
+  };
+
+  inline const E& bundle(const EDescriptor& ed) const
+  {
+    return _ebundle[ed.id];
+  };
+
+  inline boost::default_color_type& color(const VDescriptor& vd)
+  {
+    return _vcolor[vd.id];
+  };
+
+  inline const boost::default_color_type& color(const VDescriptor& vd) const
+  {
+    return _vcolor[vd.id];
+  };
+
+  inline boost::default_color_type& color(const EDescriptor& ed)
+  {
+    return _ecolor[ed.id];
+  };
+
+  inline const boost::default_color_type& color(const EDescriptor& ed) const
+  {
+    return _ecolor[ed.id];
+  };
+
+  inline GProperties& properties()
+  {
+    return _gproperties;
+  };
+
+  inline size_t& index(const VDescriptor& vd)
+  {
+    return _vindex[vd.id];
+  };
+
+  inline const size_t& index(const VDescriptor& vd) const
+  {
+    return _vindex[vd.id];
+  };
+
+  inline size_t& index(const EDescriptor& ed)
+  {
+    return _eindex[ed.id];
+  };
+
+  inline const size_t& index(const EDescriptor& ed) const
+  {
+    return _eindex[ed.id];
+  };
+
+  inline VProperties& properties(const VDescriptor& vd)
+  {
+    return _vproperties[vd.id];
+  };
+
+  inline EProperties& properties(const EDescriptor& ed)
+  {
+    return _eproperties[ed.id];
+  };
+
+  inline bool is_vertex(const V& vertex) const
+  {
+    return (vertex_descriptor.find(vertex) != vertex_descriptor.end());
+  }
+
+  inline const VDescriptor& descriptor(const V& vertex) const
+  {
+    assert(size() == vertex_descriptor.size());
+    assert(vertex_descriptor.find(vertex) != vertex_descriptor.end());
+    return (*vertex_descriptor.find(vertex)).second;
+  }
+
+  inline std::pair<VIterator, VIterator> vertices() const
+  {
+    size_t n = _valive.size();
+    return std::pair<VIterator, VIterator>(VIterator(&_valive, 0, n),
+                                           VIterator(&_valive, n, n));
+  };
+
+  inline VIterator begin() const
+  {
+    return VIterator(&_valive, 0, _valive.size());
+  }
+
+  inline VIterator end() const
+  {
+    return VIterator(&_valive, _valive.size(), _valive.size());
+  }
+
+  inline std::pair<AVIterator, AVIterator> adjacent_vertices(const VDescriptor& vd) const
+  {
+    std::pair<OEIterator, OEIterator> oe = out_edges(vd);
+    return std::pair<AVIterator, AVIterator>(AVIterator(oe.first),
+                                             AVIterator(oe.second));
+  };
+
+  inline std::pair<EIterator, EIterator> edges() const
+  {
+    size_t n = _ealive.size();
+    return std::pair<EIterator, EIterator>(
+             EIterator(&_ealive, &_esource, &_etarget, 0, n),
+             EIterator(&_ealive, &_esource, &_etarget, n, n));
+  };
+
+  inline std::pair<OEIterator, OEIterator> out_edges(const VDescriptor& vd) const
+  {
+    return std::pair<OEIterator, OEIterator>(
+             OEIterator(&_vout, &_esource, &_etarget, vd.id, 0),
+             OEIterator(&_vout, &_esource, &_etarget, vd.id, _vout[vd.id].size()));
+  };
+
+  inline VDescriptor target(const EDescriptor& ed) const
+  {
+    return VDescriptor(ed.t);
+  };
+
+  inline VDescriptor source(const EDescriptor& ed) const
+  {
+    return VDescriptor(ed.s);
+  };
+
+
+  VDescriptor add_vertex(const V& vertex_bundle)
+  {
+    assert(vertex_descriptor.size() == size()) ;
+
+    typename VMap::iterator current_vertex_iterator =
+      vertex_descriptor.find(vertex_bundle);
+
+    if (current_vertex_iterator == vertex_descriptor.end())
+    {
+      VDescriptor new_vertex_descriptor(new_vertex_slot());
+      vertex_descriptor[vertex_bundle] = new_vertex_descriptor;
+      assert(size() == vertex_descriptor.size());
+
+      bundle(new_vertex_descriptor) = vertex_bundle;
+      index(new_vertex_descriptor) = std::numeric_limits<size_t>::max() ;
+      return new_vertex_descriptor;
+    }
+    else
+    {
+      assert(bundle(descriptor(vertex_bundle)) == vertex_bundle);
+      return current_vertex_iterator->second;
+    }
+  }
+
+  template<class G> void copy_vertex(const V& vertex_bundle, G& og)
+  {
+
+    // is G similar ?
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename G::vertex_t, vertex_t>::value));
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename G::edge_t, edge_t>::value));
+
+    assert(og.is_vertex(vertex_bundle));
+
+    VDescriptor descr = add_vertex(vertex_bundle);
+    properties(descr) = og.properties(og.descriptor(vertex_bundle));
+
+    assert(bundle(descr) == vertex_bundle);
+
+    typename G::OEIterator ogoei, ogoeiend;
+    for (std::tie(ogoei, ogoeiend) =
+           og.out_edges(og.descriptor(vertex_bundle));
+         ogoei != ogoeiend; ++ogoei)
+    {
+      typename G::VDescriptor ognext_descr = og.target(*ogoei);
+
+      assert(og.is_vertex(og.bundle(ognext_descr)));
+
+      // target in graph ?
+      if (is_vertex(og.bundle(ognext_descr)))
+      {
+        EDescriptor edescr =
+          add_edge(descr, descriptor(og.bundle(ognext_descr)),
+                   og.bundle(*ogoei));
+
+        properties(edescr) = og.properties(*ogoei);
+
+        assert(bundle(edescr) == og.bundle(*ogoei));
+      }
+    }
+  }
+
+  void remove_vertex(const V& vertex_bundle)
+  {
+    assert(is_vertex(vertex_bundle));
+    assert(vertex_descriptor.size() == size());
+
+    size_t vd = descriptor(vertex_bundle).id;
+
+    // clear_vertex
+    while(!_vout[vd].empty())
+      remove_edge_slot(_vout[vd].back());
+
+    _vbundle[vd] = V();
+    _vproperties[vd] = VProperties();
+    _valive[vd] = 0;
+    _vfree.push_back(vd);
+    _nv--;
+
+    vertex_descriptor.erase(vertex_bundle);
+
+#ifndef NDEBUG
+    assert(vertex_descriptor.size() == size());
+    assert(!is_vertex(vertex_bundle));
+    assert(state_assert());
+#endif
+  }
+
+
+  EDescriptor add_edge(const VDescriptor& vd1,
+                       const VDescriptor& vd2,
+                       const E& e_bundle)
+  {
+    assert(is_vertex(bundle(vd1)));
+    assert(is_vertex(bundle(vd2)));
+
+    assert(!is_edge(vd1, vd2, e_bundle));
+
+    size_t id = new_edge_slot();
+    _esource[id] = vd1.id;
+    _etarget[id] = vd2.id;
+    _ebundle[id] = e_bundle;
+    _eindex[id] = std::numeric_limits<size_t>::max();
+
+    // a self loop is stored once in the incidence list
+    _vout[vd1.id].push_back(id);
+    if(vd1.id != vd2.id)
+      _vout[vd2.id].push_back(id);
+
+    assert(is_edge(vd1, vd2, e_bundle));
+
+    return EDescriptor(id, vd1.id, vd2.id);
+  }
+
+  template<class AdjointG>
+  std::pair<EDescriptor, typename AdjointG::VDescriptor>
+  add_edge(const VDescriptor& vd1,
+           const VDescriptor& vd2,
+           const E& e_bundle,
+           AdjointG& ag)
+  {
+
+    // adjoint static assertions
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename AdjointG::vertex_t, edge_t>::value));
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename AdjointG::edge_t, vertex_t>::value));
+
+
+    EDescriptor new_ed = add_edge(vd1, vd2, e_bundle);
+
+    typename AdjointG::VDescriptor new_ve = ag.add_vertex(e_bundle);
+
+    assert(bundle(new_ed) == ag.bundle(new_ve));
+    assert(ag.size() == edges_number());
+
+    bool endl = false;
+    for (VDescriptor vdx = vd1; !endl; vdx = vd2)
+    {
+      assert(vdx == vd1 || vdx == vd2);
+
+      if (vdx == vd2) endl = true;
+
+#if !defined(SICONOS_USE_MAP_FOR_HASH)
+      std::unordered_map<E, EDescriptor> Edone;
+#else
+      std::map<E, EDescriptor> Edone;
+#endif
+
+      OEIterator ied, iedend;
+      for (std::tie(ied, iedend) = out_edges(vdx);
+           ied != iedend; ++ied)
+      {
+        if (Edone.find(bundle(*ied)) == Edone.end())
+        {
+          Edone[bundle(*ied)] = *ied;
+
+          assert(source(*ied) == vdx);
+
+          if (*ied != new_ed)
+            // so this is another edge
+          {
+            assert(bundle(*ied) != e_bundle);
+            assert(ag.is_vertex(bundle(*ied)));
+            assert(!ag.is_edge(new_ve, ag.descriptor(bundle(*ied)),
+                               bundle(vdx)));
+
+            ag.add_edge(new_ve, ag.descriptor(bundle(*ied)), bundle(vdx));
+          }
+        }
+      }
+    }
+    assert(ag.size() == edges_number());
+    return std::pair<EDescriptor, typename AdjointG::VDescriptor>(new_ed,
+           new_ve);
+  }
+
+  void remove_edge(const EDescriptor& ed)
+  {
+    remove_edge_slot(ed.id);
+#ifndef NDEBUG
+    assert(state_assert());
+#endif
+  }
+
+  template<class AdjointG>
+  void remove_edge(const EDescriptor& ed, AdjointG& ag)
+  {
+
+    // adjoint static assertions
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename AdjointG::vertex_t, edge_t>::value));
+    BOOST_STATIC_ASSERT((boost::is_same
+                         <typename AdjointG::edge_t, vertex_t>::value));
+
+
+    assert(ag.size() == edges_number());
+
+    assert(bundle(ed) == ag.bundle(ag.descriptor(bundle(ed))));
+
+    ag.remove_vertex(bundle(ed));
+    remove_edge(ed);
+
+    assert(ag.size() == edges_number());
+  }
+
+  /** Remove all the out-edges of vertex u for which the predicate p
+   * returns true.
+   */
+  template<class Predicate>
+  void remove_out_edge_if(const VDescriptor& vd,
+                          const Predicate& pred)
+  {
+    // the predicate may not be const (see SiconosGraph)
+    Predicate p(pred);
+    std::vector<size_t> removed;
+    const IncidenceList& out = _vout[vd.id];
+    for(size_t k = 0; k < out.size(); ++k)
+    {
+      if(p(EDescriptor(out[k], vd.id, opposite(out[k], vd.id))))
+        removed.push_back(out[k]);
+    }
+    for(size_t k = 0; k < removed.size(); ++k)
+      remove_edge_slot(removed[k]);
+#ifndef NDEBUG
+    assert(state_assert());
+#endif
+  }
+
+  /** Remove all the in-edges of vertex u for which the predicate p
+   * returns true. The graph is undirected: these are the out-edges.
+   */
+  template<class Predicate>
+  void remove_in_edge_if(const VDescriptor& vd,
+                         const Predicate& pred)
+  {
+    remove_out_edge_if(vd, pred);
+  }
+
+  /** Remove all the edges of the graph for which the predicate p
+   * returns true.
+   */
+  template<class Predicate>
+  void remove_edge_if(const VDescriptor& vd,
+                      const Predicate& pred)
+  {
+    Predicate p(pred);
+    std::vector<size_t> removed;
+    EIterator ei, eiend;
+    for (std::tie(ei, eiend) = edges(); ei != eiend; ++ei)
+    {
+      if(p(*ei))
+        removed.push_back((*ei).id);
+    }
+    for(size_t k = 0; k < removed.size(); ++k)
+      remove_edge_slot(removed[k]);
+#ifndef NDEBUG
+    assert(state_assert());
+#endif
+  }
+
+
+  int stamp() const
+  {
+    return _stamp;
+  }
+
+  void update_vertices_indices()
+  {
+    size_t i = 0;
+    for (size_t k = 0; k < _valive.size(); ++k)
+    {
+      if(_valive[k])
+        _vindex[k] = i++;
+    }
+    _stamp++;
+  };
+
+  void update_edges_indices()
+  {
+    size_t i = 0;
+    for (size_t k = 0; k < _ealive.size(); ++k)
+    {
+      if(_ealive[k])
+        _eindex[k] = i++;
+    }
+    _stamp++;
+  };
+
+  void clear()
+  {
+    _vbundle.clear();
+    _vcolor.clear();
+    _vindex.clear();
+    _vproperties.clear();
+    _vout.clear();
+    _valive.clear();
+    _vfree.clear();
+    _nv = 0;
+    _ebundle.clear();
+    _ecolor.clear();
+    _eindex.clear();
+    _eproperties.clear();
+    _esource.clear();
+    _etarget.clear();
+    _ealive.clear();
+    _efree.clear();
+    _ne = 0;
+    vertex_descriptor.clear();
+  };
+
+  VMap vertex_descriptor_map() const
+  {
+    return vertex_descriptor;
+  };
+
+  void display() const
+  {
+    std::cout << "vertices number :" << vertices_number() << std::endl;
+
+    std::cout << "edges number :" << edges_number() << std::endl;
+    VIterator vi, viend;
+    for (std::tie(vi, viend) = vertices();
+         vi != viend; ++vi)
+    {
+      std::cout << "vertex :"
+                << *vi
+                << ", bundle :"
+                << bundle(*vi)
+                << ", index : "
+                << index(*vi)
+                << ", color : "
+                << color(*vi);
+      OEIterator oei, oeiend;
+      for (std::tie(oei, oeiend) = out_edges(*vi);
+           oei != oeiend; ++oei)
+      {
+        std::cout << "---"
+                  << bundle(*oei)
+                  << "-->"
+                  << "bundle : "
+                  << bundle(target(*oei))
+                  << ", index : "
+                  << index(target(*oei))
+                  << ", color : "
+                  << color(target(*oei));
+      }
+      std::cout << std::endl;
+    }
+  }
+
+  /* debug */
+#ifndef SWIG
+#ifndef NDEBUG
+  bool state_assert() const
+  {
+    size_t nv = 0, ne = 0;
+    for (size_t k = 0; k < _valive.size(); ++k)
+    {
+      if(!_valive[k]) continue;
+      nv++;
+      assert(is_vertex(_vbundle[k]));
+      assert(descriptor(_vbundle[k]).id == k);
+      for(typename IncidenceList::const_iterator it = _vout[k].begin();
+          it != _vout[k].end(); ++it)
+      {
+        assert(_ealive[*it]);
+        assert(_esource[*it] == k || _etarget[*it] == k);
+        assert(_valive[opposite(*it, k)]);
+      }
+    }
+    for (size_t k = 0; k < _ealive.size(); ++k)
+    {
+      if(_ealive[k]) ne++;
+    }
+    assert(nv == _nv);
+    assert(ne == _ne);
+    return true;
+  }
+
+  bool adjacent_vertices_ok() const
+  {
+    return state_assert();
+  }
+#endif
+#endif
+
+};
+
+#endif
@@ -0,0 +1,259 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#include "SiconosProfiler.hpp"
+#include "SiconosException.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+bool SiconosProfiler::_enabled = false;
+
+namespace
+{
+/* a recorded call of a phase (ph "X") or the values of a counter at the
+ * end of a step (ph "C"), times in microseconds from the origin */
+struct TraceEvent
+{
+  bool isCounter;
+  std::string name;
+  double begin;
+  double duration;
+};
+
+struct ProfilerState
+{
+  std::map<std::string, ProfilerPhase> phases;
+  std::map<std::string, ProfilerCounter> counters;
+  /* paths of the phases being timed */
+  std::vector<std::string> stack;
+  unsigned int steps = 0;
+  bool trace = false;
+  SiconosProfiler::Clock::time_point origin = SiconosProfiler::Clock::now();
+  std::vector<TraceEvent> events;
+};
+
+ProfilerState& state()
+{
+  static ProfilerState s;
+  return s;
+}
+
+double microseconds(SiconosProfiler::Clock::duration d)
+{
+  return std::chrono::duration<double, std::micro>(d).count();
+}
+
+std::string jsonString(const std::string& s)
+{
+  std::string out = "\"";
+  for(char c : s)
+  {
+    if(c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  return out + "\"";
+}
+}
+
+void SiconosProfiler::setEnabled(bool enabled)
+{
+  if(enabled && !_enabled)
+    reset();
+  _enabled = enabled;
+}
+
+void SiconosProfiler::setTraceEnabled(bool trace)
+{
+  state().trace = trace;
+}
+
+bool SiconosProfiler::traceEnabled()
+{
+  return state().trace;
+}
+
+void SiconosProfiler::beginPhase(const char* name)
+{
+  std::vector<std::string>& stack = state().stack;
+  if(stack.empty())
+    stack.push_back(name);
+  else
+    stack.push_back(stack.back() + "/" + name);
+}
+
+void SiconosProfiler::endPhase(Clock::time_point start, Clock::time_point end)
+{
+  ProfilerState& s = state();
+  // the profiler has been reset while this phase was timed
+  if(s.stack.empty())
+    return;
+  double elapsed = std::chrono::duration<double>(end - start).count();
+  ProfilerPhase& p = s.phases[s.stack.back()];
+  p.calls++;
+  p.total += elapsed;
+  p.currentStep += elapsed;
+  if(s.trace)
+    s.events.push_back({false, s.stack.back(), microseconds(start - s.origin),
+                        microseconds(end - start)});
+  s.stack.pop_back();
+}
+
+void SiconosProfiler::addToCounter(const char* name, double value)
+{
+  ProfilerCounter& c = state().counters[name];
+  c.total += value;
+  c.currentStep += value;
+}
+
+void SiconosProfiler::endStep()
+{
+  if(!_enabled)
+    return;
+  ProfilerState& s = state();
+  for(auto& p : s.phases)
+  {
+    ProfilerPhase& phase = p.second;
+    phase.lastStep = phase.currentStep;
+    phase.maxStep = std::max(phase.maxStep, phase.currentStep);
+    phase.currentStep = 0.0;
+  }
+  double now = microseconds(Clock::now() - s.origin);
+  for(auto& c : s.counters)
+  {
+    ProfilerCounter& counter = c.second;
+    counter.lastStep = counter.currentStep;
+    counter.maxStep = std::max(counter.maxStep, counter.currentStep);
+    counter.currentStep = 0.0;
+    if(s.trace)
+      s.events.push_back({true, c.first, now, counter.lastStep});
+  }
+  s.steps++;
+}
+
+void SiconosProfiler::reset()
+{
+  ProfilerState& s = state();
+  s.phases.clear();
+  s.counters.clear();
+  s.stack.clear();
+  s.events.clear();
+  s.steps = 0;
+  s.origin = Clock::now();
+}
+
+unsigned int SiconosProfiler::numberOfSteps()
+{
+  return state().steps;
+}
+
+const std::map<std::string, ProfilerPhase>& SiconosProfiler::phases()
+{
+  return state().phases;
+}
+
+const std::map<std::string, ProfilerCounter>& SiconosProfiler::counters()
+{
+  return state().counters;
+}
+
+std::vector<std::string> SiconosProfiler::phaseNames()
+{
+  std::vector<std::string> names;
+  for(auto& p : state().phases)
+    names.push_back(p.first);
+  return names;
+}
+
+std::vector<std::string> SiconosProfiler::counterNames()
+{
+  std::vector<std::string> names;
+  for(auto& c : state().counters)
+    names.push_back(c.first);
+  return names;
+}
+
+ProfilerPhase SiconosProfiler::phase(const std::string& path)
+{
+  auto it = state().phases.find(path);
+  return (it == state().phases.end()) ? ProfilerPhase() : it->second;
+}
+
+ProfilerCounter SiconosProfiler::counter(const std::string& name)
+{
+  auto it = state().counters.find(name);
+  return (it == state().counters.end()) ? ProfilerCounter() : it->second;
+}
+
+void SiconosProfiler::display()
+{
+  ProfilerState& s = state();
+  unsigned int steps = std::max(s.steps, 1u);
+  std::cout << "====== SiconosProfiler: " << s.steps << " steps ======" << std::endl;
+  std::cout << std::left << std::setw(60) << "phase" << std::right
+            << std::setw(10) << "calls" << std::setw(14) << "total (s)"
+            << std::setw(14) << "mean/step" << std::setw(14) << "max/step" << std::endl;
+  for(auto& p : s.phases)
+  {
+    std::cout << std::left << std::setw(60) << p.first << std::right
+              << std::setw(10) << p.second.calls
+              << std::setw(14) << p.second.total
+              << std::setw(14) << p.second.total / steps
+              << std::setw(14) << p.second.maxStep << std::endl;
+  }
+  for(auto& c : s.counters)
+  {
+    std::cout << std::left << std::setw(60) << c.first << std::right
+              << std::setw(10) << "" << std::setw(14) << c.second.total
+              << std::setw(14) << c.second.total / steps
+              << std::setw(14) << c.second.maxStep << std::endl;
+  }
+  std::cout << "===============================" << std::endl;
+}
+
+void SiconosProfiler::writeChromeTrace(const std::string& filename)
+{
+  std::ofstream out(filename);
+  if(!out)
+    THROW_EXCEPTION("SiconosProfiler::writeChromeTrace, can not open " + filename);
+
+  out << std::setprecision(12);
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool first = true;
+  for(const TraceEvent& e : state().events)
+  {
+    out << (first ? "\n" : ",\n");
+    first = false;
+    if(e.isCounter)
+      out << "{\"name\": " << jsonString(e.name) << ", \"ph\": \"C\", \"ts\": " << e.begin
+          << ", \"pid\": 0, \"tid\": 0, \"args\": {\"value\": " << e.duration << "}}";
+    else
+    {
+      // the name is the last part of the path
+      std::string::size_type pos = e.name.rfind('/');
+      std::string name = (pos == std::string::npos) ? e.name : e.name.substr(pos + 1);
+      out << "{\"name\": " << jsonString(name) << ", \"ph\": \"X\", \"ts\": " << e.begin
+          << ", \"dur\": " << e.duration << ", \"pid\": 0, \"tid\": 0, \"args\": {\"path\": "
+          << jsonString(e.name) << "}}";
+    }
+  }
+  out << "\n]}\n";
+}
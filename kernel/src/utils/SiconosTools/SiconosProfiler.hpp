@@ -0,0 +1,194 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*! \file SiconosProfiler.hpp
+  \brief Timers and counters of the phases of a simulation
+*/
+
+#ifndef SiconosProfiler_H
+#define SiconosProfiler_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+/** Statistics of a phase of the simulation. Times are in seconds. */
+struct ProfilerPhase
+{
+  /** number of calls */
+  unsigned long calls = 0;
+  /** total time */
+  double total = 0.0;
+  /** time spent in the last completed step */
+  double lastStep = 0.0;
+  /** largest time spent in one step */
+  double maxStep = 0.0;
+  /** time spent in the current step */
+  double currentStep = 0.0;
+};
+
+/** Statistics of a counter (solver iterations, number of contacts ...) */
+struct ProfilerCounter
+{
+  /** sum of all the values */
+  double total = 0.0;
+  /** sum of the values of the last completed step */
+  double lastStep = 0.0;
+  /** largest sum of the values in one step */
+  double maxStep = 0.0;
+  /** sum of the values of the current step */
+  double currentStep = 0.0;
+};
+
+/** Profiler of the phases of a simulation
+ *
+ * A phase is timed by a SiconosProfiler::Timer living in its scope. The
+ * phases are nested: a phase is identified by its path, the names of the
+ * enclosing phases and its own name separated by '/', for instance
+ * "computeOneStepNSProblem/preCompute". Counters accumulate values given by
+ * count().
+ *
+ * The times and the counters are aggregated per step, a step being closed
+ * by endStep() (called by Simulation::processEvents). When the profiler is
+ * disabled (the default), a Timer only tests a boolean.
+ *
+ * With setTraceEnabled(true), each timed call is also recorded and can be
+ * written in the Chrome trace event format (chrome://tracing or Perfetto)
+ * with writeChromeTrace().
+ *
+ * The timers are meant for the main thread of the simulation, not for the
+ * inside of parallel loops.
+ */
+class SiconosProfiler
+{
+public:
+  typedef std::chrono::steady_clock Clock;
+
+  /** Scoped timer of a phase, from its construction to its destruction. */
+  class Timer
+  {
+    bool _active;
+    Clock::time_point _start;
+
+  public:
+    /** start the phase if the profiler is enabled
+     *  \param name the name of the phase, not a path
+     */
+    Timer(const char* name) : _active(SiconosProfiler::_enabled)
+    {
+      if(_active)
+      {
+        SiconosProfiler::beginPhase(name);
+        _start = Clock::now();
+      }
+    }
+
+    ~Timer()
+    {
+      if(_active)
+        SiconosProfiler::endPhase(_start, Clock::now());
+    }
+
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+  };
+
+  /** enable or disable the profiler. Enabling resets the statistics.
+   *  \param enabled the new state
+   */
+  static void setEnabled(bool enabled);
+
+  /** \return true if the profiler is enabled */
+  static bool enabled()
+  {
+    return _enabled;
+  }
+
+  /** record each call of the phases for writeChromeTrace
+   *  \param trace true to record the calls
+   */
+  static void setTraceEnabled(bool trace);
+
+  /** \return true if the calls are recorded */
+  static bool traceEnabled();
+
+  /** add a value to a counter, if the profiler is enabled
+   *  \param name name of the counter
+   *  \param value the value to add
+   */
+  static void count(const char* name, double value)
+  {
+    if(_enabled)
+      addToCounter(name, value);
+  }
+
+  /** close the current step: the times and counters of the step become the
+   *  ones of the last step */
+  static void endStep();
+
+  /** clear all the statistics and the recorded calls */
+  static void reset();
+
+  /** \return the number of completed steps */
+  static unsigned int numberOfSteps();
+
+  /** \return the statistics of all the phases, by path */
+  static const std::map<std::string, ProfilerPhase>& phases();
+
+  /** \return the statistics of all the counters, by name */
+  static const std::map<std::string, ProfilerCounter>& counters();
+
+  /** \return the paths of the phases */
+  static std::vector<std::string> phaseNames();
+
+  /** \return the names of the counters */
+  static std::vector<std::string> counterNames();
+
+  /** \param path the path of a phase
+   *  \return the statistics of the phase (zero if it has not been timed)
+   */
+  static ProfilerPhase phase(const std::string& path);
+
+  /** \param name the name of a counter
+   *  \return the statistics of the counter (zero if it has not been used)
+   */
+  static ProfilerCounter counter(const std::string& name);
+
+  /** print the statistics of the phases and counters
+   */
+  static void display();
+
+  /** write the recorded calls and the counters per step in the Chrome trace
+   *  event format (JSON)
+   *  \param filename the name of the file
+   */
+  static void writeChromeTrace(const std::string& filename);
+
+private:
+  /** true if the phases and counters are recorded */
+  static bool _enabled;
+
+  static void beginPhase(const char* name);
+
+  static void endPhase(Clock::time_point start, Clock::time_point end);
+
+  static void addToCounter(const char* name, double value);
+};
+
+#endif
@@ -0,0 +1,263 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "SiconosFlatGraphTest.hpp"
+#include <string>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(SiconosFlatGraphTest);
+
+typedef SiconosFlatGraph < std::string, int,
+        boost::no_property, boost::no_property, boost::no_property > G;
+typedef SiconosFlatGraph < int, std::string,
+        boost::no_property, boost::no_property, boost::no_property > AG;
+
+void SiconosFlatGraphTest::setUp()
+{
+}
+
+void SiconosFlatGraphTest::tearDown()
+{
+}
+
+// add and remove vertices
+void SiconosFlatGraphTest::t1()
+{
+  std::cout << "--> Test: t1." <<std::endl;
+  G g;
+
+  G::VDescriptor vd1, vd2;
+
+  vd1 = g.add_vertex("hello");
+  vd2 = g.add_vertex("goodbye");
+
+  CPPUNIT_ASSERT(g.size() == 2);
+  CPPUNIT_ASSERT(g.add_vertex("hello") == vd1);
+  CPPUNIT_ASSERT(g.bundle(g.descriptor("hello")) == "hello");
+  CPPUNIT_ASSERT(g.bundle(g.descriptor("goodbye")) == "goodbye");
+
+  g.remove_vertex("hello");
+  CPPUNIT_ASSERT(g.size() == 1);
+  CPPUNIT_ASSERT(!g.is_vertex("hello"));
+  CPPUNIT_ASSERT(g.bundle(vd2) == "goodbye");
+
+  g.remove_vertex("goodbye");
+  CPPUNIT_ASSERT(g.size() == 0);
+  std::cout << "--> t1 ended with success." <<std::endl;
+}
+
+// descriptors remain valid when other elements are removed
+void SiconosFlatGraphTest::t2()
+{
+  std::cout << "--> Test: t2." <<std::endl;
+  G g;
+  AG ag;
+
+  G::VDescriptor vd1 = g.add_vertex("one");
+  G::VDescriptor vd2 = g.add_vertex("two");
+  G::VDescriptor vd3 = g.add_vertex("three");
+
+  G::EDescriptor ed1 = g.add_edge(vd1, vd2, 1, ag).first;
+  G::EDescriptor ed2 = g.add_edge(vd2, vd3, 2, ag).first;
+  g.index(vd3) = 33;
+  g.index(ed2) = 22;
+
+  g.remove_edge(ed1, ag);
+  g.remove_vertex("one");
+
+  CPPUNIT_ASSERT(g.bundle(vd3) == "three");
+  CPPUNIT_ASSERT(g.index(vd3) == 33);
+  CPPUNIT_ASSERT(g.bundle(ed2) == 2);
+  CPPUNIT_ASSERT(g.index(ed2) == 22);
+  CPPUNIT_ASSERT(g.edges_number() == 1);
+  CPPUNIT_ASSERT(ag.size() == 1);
+
+  // the free slot is reused
+  G::VDescriptor vd4 = g.add_vertex("four");
+  CPPUNIT_ASSERT(vd4 == vd1);
+  CPPUNIT_ASSERT(g.bundle(vd4) == "four");
+  CPPUNIT_ASSERT(g.index(vd4) == std::numeric_limits<size_t>::max());
+  CPPUNIT_ASSERT(!g.adjacent_vertex_exists(vd4));
+
+  size_t n = 0;
+  G::VIterator vi, viend;
+  for(std::tie(vi, viend) = g.vertices(); vi != viend; ++vi, ++n)
+    CPPUNIT_ASSERT(g.is_vertex(g.bundle(*vi)));
+  CPPUNIT_ASSERT(n == 3);
+  std::cout << "--> t2 ended with success." <<std::endl;
+}
+
+// adjoint graph
+void SiconosFlatGraphTest::t3()
+{
+  std::cout << "--> Test: t3." <<std::endl;
+  G g;
+  AG ag;
+
+  G::VDescriptor vd1, vd2, vd3;
+
+  vd1 = g.add_vertex("hello");
+  vd2 = g.add_vertex("goodbye");
+  vd3 = g.add_vertex("bye");
+
+  g.add_edge(vd1, vd2, 1, ag);
+  g.add_edge(vd1, vd2, 2, ag);
+  g.add_edge(vd1, vd3, 3, ag);
+
+  CPPUNIT_ASSERT(ag.size() == 3);
+  CPPUNIT_ASSERT(ag.bundle(ag.descriptor(1)) == 1);
+  CPPUNIT_ASSERT(ag.bundle(ag.descriptor(2)) == 2);
+  CPPUNIT_ASSERT(ag.bundle(ag.descriptor(3)) == 3);
+
+  // parallel edges
+  G::EDescriptor e1, e2;
+  g.update_edges_indices();
+  std::tie(e1, e2) = g.edges(vd1, vd2);
+  CPPUNIT_ASSERT(g.bundle(e1) == 1);
+  CPPUNIT_ASSERT(g.bundle(e2) == 2);
+  CPPUNIT_ASSERT(g.source(e1) == vd1);
+  CPPUNIT_ASSERT(g.target(e1) == vd2);
+
+  // 1 and 2 share hello and goodbye, 3 shares hello with 1 and 2
+  CPPUNIT_ASSERT(ag.edges_number() == 4);
+  CPPUNIT_ASSERT(ag.edge_exists(ag.descriptor(1), ag.descriptor(2)));
+  std::cout << "--> t3 ended with success." <<std::endl;
+}
+
+template<class SicGraph, class AdjointSicGraph>
+struct num_inf
+{
+  num_inf(int n, SicGraph& sg, AdjointSicGraph& asg)
+    : _n(n), _sg(sg), _asg(asg) {}
+  bool operator()(typename SicGraph::EDescriptor e)
+  {
+    if((_sg.bundle(e) < _n) && _asg.is_vertex(_sg.bundle(e)))
+    {
+      _asg.remove_vertex(_sg.bundle(e));
+      return true;
+    }
+    else
+    {
+      return (_sg.bundle(e) < _n);
+    }
+  }
+  int _n;
+  SicGraph& _sg;
+  AdjointSicGraph& _asg;
+};
+
+// remove_out_edge_if, with self loops
+void SiconosFlatGraphTest::t4()
+{
+  std::cout << "--> Test: t4." <<std::endl;
+  G g;
+  AG ag;
+
+  G::VDescriptor vd1, vd2, vd3;
+
+  vd1 = g.add_vertex("hello");
+  vd2 = g.add_vertex("goodbye");
+  vd3 = g.add_vertex("bye");
+
+  g.add_edge(vd1, vd2, 1, ag);
+  g.add_edge(vd1, vd2, 2, ag);
+  g.add_edge(vd1, vd3, 3, ag);
+  for(int i = 4; i < 10; ++i)
+    g.add_edge(vd1, vd1, i, ag);
+
+  CPPUNIT_ASSERT(g.edges_number() == 9);
+  CPPUNIT_ASSERT(ag.size() == 9);
+
+  g.remove_out_edge_if(vd1, num_inf<G, AG>(6, g, ag));
+
+  CPPUNIT_ASSERT(g.edges_number() == 4);
+  CPPUNIT_ASSERT(ag.size() == g.edges_number());
+  CPPUNIT_ASSERT(!g.adjacent_vertex_exists(vd2));
+  CPPUNIT_ASSERT(!g.adjacent_vertex_exists(vd3));
+#ifndef NDEBUG
+  CPPUNIT_ASSERT(g.state_assert());
+  CPPUNIT_ASSERT(ag.state_assert());
+#endif
+  std::cout << "--> t4 ended with success." <<std::endl;
+}
+
+// adjacency order is the insertion order, as with SiconosGraph
+void SiconosFlatGraphTest::t5()
+{
+  std::cout << "--> Test: t5." <<std::endl;
+  G g;
+  AG ag;
+
+  G::VDescriptor vd1, vd2, vd3, vd4, vd5, vd6;
+
+  vd1 = g.add_vertex("hello");
+  vd2 = g.add_vertex("goodbye");
+  vd3 = g.add_vertex("bye");
+  vd4 = g.add_vertex("one");
+  vd5 = g.add_vertex("two");
+  vd6 = g.add_vertex("three");
+
+  g.add_edge(vd1, vd2, 1, ag);
+  g.add_edge(vd2, vd3, 2, ag);
+  g.add_edge(vd3, vd4, 3, ag);
+  g.add_edge(vd4, vd5, 4, ag);
+  g.add_edge(vd5, vd6, 5, ag);
+  g.add_edge(vd1, vd5, 100, ag);
+  g.add_edge(vd2, vd6, 200, ag);
+  g.add_edge(vd3, vd5, 300, ag);
+
+  AG::AVIterator ui, uiend;
+  int tot = 0, k = 1;
+  for(std::tie(ui, uiend) = ag.adjacent_vertices(ag.descriptor(100)); ui != uiend; ++ui, k *= 10)
+  {
+    tot += k * ag.bundle(*ui);
+  }
+  CPPUNIT_ASSERT(tot == 300541);
+  std::cout << "--> t5 ended with success." <<std::endl;
+}
+
+// indices
+void SiconosFlatGraphTest::t6()
+{
+  std::cout << "--> Test: t6." <<std::endl;
+  G g;
+  AG ag;
+
+  G::VDescriptor vd1 = g.add_vertex("one");
+  G::VDescriptor vd2 = g.add_vertex("two");
+  G::VDescriptor vd3 = g.add_vertex("three");
+  g.add_edge(vd1, vd2, 1, ag);
+  g.add_edge(vd2, vd3, 2, ag);
+  g.remove_vertex("one");
+
+  g.update_vertices_indices();
+  g.update_edges_indices();
+  CPPUNIT_ASSERT(g.stamp() == 2);
+  CPPUNIT_ASSERT(g.index(vd2) == 0);
+  CPPUNIT_ASSERT(g.index(vd3) == 1);
+
+  G::EIterator ei, eiend;
+  std::tie(ei, eiend) = g.edges();
+  CPPUNIT_ASSERT(g.bundle(*ei) == 2);
+  CPPUNIT_ASSERT(g.index(*ei) == 0);
+  CPPUNIT_ASSERT(++ei == eiend);
+
+  g.clear();
+  CPPUNIT_ASSERT(g.size() == 0);
+  CPPUNIT_ASSERT(g.edges_number() == 0);
+  std::cout << "--> t6 ended with success." <<std::endl;
+}
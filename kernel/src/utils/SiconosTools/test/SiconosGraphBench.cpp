@@ -0,0 +1,135 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Micro-benchmark of a full index-set traversal : SiconosGraph
+   (boost::adjacency_list<listS, listS>) versus SiconosFlatGraph.
+
+   The graph mimics an index set of contact interactions : each vertex
+   is an interaction between two bodies of a chain of bodies, an edge
+   links two interactions sharing a body. The traversal reads the index
+   and the properties of each vertex and of its neighbours, as the
+   assembly of the OSNS matrix does.
+
+   usage : SiconosGraphBench [number of interactions] [number of passes]
+*/
+
+#include "../SiconosGraph.hpp"
+#include "../SiconosFlatGraph.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+struct BenchInteractionProperties
+{
+  std::shared_ptr<double> block;
+  size_t absolute_position;
+  bool forControl;
+};
+
+struct BenchEdgeProperties
+{
+  std::shared_ptr<double> upper_block;
+  std::shared_ptr<double> lower_block;
+};
+
+template<class G>
+static double build(G& g, size_t n)
+{
+  auto start = std::chrono::steady_clock::now();
+  std::vector<typename G::VDescriptor> vds(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    vds[i] = g.add_vertex(i);
+    g.properties(vds[i]).absolute_position = 3 * i;
+  }
+  // interaction i involves the bodies i and i+1
+  for(size_t i = 1; i < n; ++i)
+    g.add_edge(vds[i - 1], vds[i], i);
+  // remove and insert some interactions to look like a running simulation
+  for(size_t i = 0; i < n; i += 7)
+    g.remove_vertex(i);
+  for(size_t i = 0; i < n; i += 7)
+    g.add_vertex(i);
+  g.update_vertices_indices();
+  g.update_edges_indices();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+template<class G>
+static size_t traverse(G& g)
+{
+  size_t sum = 0;
+  typename G::VIterator vi, viend;
+  for(std::tie(vi, viend) = g.vertices(); vi != viend; ++vi)
+  {
+    sum += g.index(*vi) + g.properties(*vi).absolute_position;
+    typename G::OEIterator oei, oeiend;
+    for(std::tie(oei, oeiend) = g.out_edges(*vi); oei != oeiend; ++oei)
+    {
+      sum += g.bundle(*oei) + g.properties(g.target(*oei)).absolute_position;
+    }
+  }
+  return sum;
+}
+
+template<class G>
+static size_t run(const char* name, size_t n, unsigned int passes)
+{
+  G g;
+  double tbuild = build(g, n);
+  size_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for(unsigned int p = 0; p < passes; ++p)
+    sum += traverse(g);
+  auto stop = std::chrono::steady_clock::now();
+  double t = std::chrono::duration<double>(stop - start).count();
+  std::cout << name << " : " << g.vertices_number() << " vertices, "
+            << g.edges_number() << " edges, build " << tbuild << " s, traversal "
+            << t / passes << " s per pass" << std::endl;
+  return sum;
+}
+
+int main(int argc, char* argv[])
+{
+#ifdef NDEBUG
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+#else
+  // the consistency checks of the graphs are quadratic
+  size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000;
+#endif
+  unsigned int passes = argc > 2 ? std::atoi(argv[2]) : 10;
+
+  typedef SiconosGraph < size_t, size_t, BenchInteractionProperties,
+          BenchEdgeProperties, boost::no_property > ListGraph;
+  typedef SiconosFlatGraph < size_t, size_t, BenchInteractionProperties,
+          BenchEdgeProperties, boost::no_property > FlatGraph;
+
+  size_t s1 = run<ListGraph>("SiconosGraph", n, passes);
+  size_t s2 = run<FlatGraph>("SiconosFlatGraph", n, passes);
+
+  // both traversals visit the same data, maybe in a different order
+  if(s1 != s2)
+  {
+    std::cout << "traversals differ : " << s1 << " != " << s2 << std::endl;
+    return 1;
+  }
+  return 0;
+}
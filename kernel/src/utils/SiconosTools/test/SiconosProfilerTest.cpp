@@ -0,0 +1,128 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#include "SiconosProfilerTest.hpp"
+#include "SiconosProfiler.hpp"
+
+#include <fstream>
+#include <sstream>
+
+// test suite registration
+CPPUNIT_TEST_SUITE_REGISTRATION(SiconosProfilerTest);
+
+
+void SiconosProfilerTest::setUp()
+{
+  SiconosProfiler::setEnabled(true);
+}
+
+void SiconosProfilerTest::tearDown()
+{
+  SiconosProfiler::setTraceEnabled(false);
+  SiconosProfiler::setEnabled(false);
+}
+
+/* nothing is recorded when the profiler is disabled */
+void SiconosProfilerTest::testDisabled()
+{
+  SiconosProfiler::setEnabled(false);
+  {
+    SiconosProfiler::Timer timer("phase");
+    SiconosProfiler::count("counter", 1.0);
+  }
+  SiconosProfiler::endStep();
+  CPPUNIT_ASSERT_MESSAGE("testDisabled : phases", SiconosProfiler::phaseNames().empty());
+  CPPUNIT_ASSERT_MESSAGE("testDisabled : counters", SiconosProfiler::counterNames().empty());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testDisabled : steps", 0u, SiconosProfiler::numberOfSteps());
+}
+
+/* the path of a phase contains the enclosing phases */
+void SiconosProfilerTest::testNestedPhases()
+{
+  {
+    SiconosProfiler::Timer outer("outer");
+    for(int i = 0; i < 3; i++)
+    {
+      SiconosProfiler::Timer inner("inner");
+    }
+  }
+  {
+    SiconosProfiler::Timer inner("inner");
+  }
+  std::vector<std::string> names = SiconosProfiler::phaseNames();
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testNestedPhases : number of phases", (size_t)3, names.size());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testNestedPhases : outer calls", 1ul,
+                               SiconosProfiler::phase("outer").calls);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testNestedPhases : outer/inner calls", 3ul,
+                               SiconosProfiler::phase("outer/inner").calls);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testNestedPhases : inner calls", 1ul,
+                               SiconosProfiler::phase("inner").calls);
+  CPPUNIT_ASSERT_MESSAGE("testNestedPhases : nested time",
+                         SiconosProfiler::phase("outer/inner").total
+                         <= SiconosProfiler::phase("outer").total);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testNestedPhases : unknown phase", 0ul,
+                               SiconosProfiler::phase("unknown").calls);
+}
+
+/* the counters and times are aggregated per step */
+void SiconosProfilerTest::testSteps()
+{
+  SiconosProfiler::count("iterations", 2.0);
+  SiconosProfiler::count("iterations", 3.0);
+  {
+    SiconosProfiler::Timer timer("phase");
+  }
+  SiconosProfiler::endStep();
+  SiconosProfiler::count("iterations", 1.0);
+  SiconosProfiler::endStep();
+
+  ProfilerCounter c = SiconosProfiler::counter("iterations");
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSteps : steps", 2u, SiconosProfiler::numberOfSteps());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSteps : total", 6.0, c.total);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSteps : lastStep", 1.0, c.lastStep);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSteps : maxStep", 5.0, c.maxStep);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSteps : currentStep", 0.0, c.currentStep);
+
+  ProfilerPhase p = SiconosProfiler::phase("phase");
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSteps : phase lastStep", 0.0, p.lastStep);
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSteps : phase maxStep", p.total, p.maxStep);
+
+  SiconosProfiler::reset();
+  CPPUNIT_ASSERT_MESSAGE("testSteps : reset", SiconosProfiler::counterNames().empty());
+  CPPUNIT_ASSERT_EQUAL_MESSAGE("testSteps : reset steps", 0u, SiconosProfiler::numberOfSteps());
+}
+
+/* the recorded calls are written in the Chrome trace format */
+void SiconosProfilerTest::testChromeTrace()
+{
+  SiconosProfiler::setTraceEnabled(true);
+  {
+    SiconosProfiler::Timer outer("outer");
+    SiconosProfiler::Timer inner("inner");
+    SiconosProfiler::count("iterations", 4.0);
+  }
+  SiconosProfiler::endStep();
+  SiconosProfiler::writeChromeTrace("SiconosProfilerTest.json");
+
+  std::ifstream in("SiconosProfilerTest.json");
+  std::stringstream content;
+  content << in.rdbuf();
+  std::string trace = content.str();
+  CPPUNIT_ASSERT_MESSAGE("testChromeTrace : events", trace.find("\"traceEvents\"") != std::string::npos);
+  CPPUNIT_ASSERT_MESSAGE("testChromeTrace : inner", trace.find("\"path\": \"outer/inner\"") != std::string::npos);
+  CPPUNIT_ASSERT_MESSAGE("testChromeTrace : counter", trace.find("\"ph\": \"C\"") != std::string::npos);
+}
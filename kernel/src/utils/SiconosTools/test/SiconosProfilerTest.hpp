@@ -0,0 +1,54 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+#ifndef SiconosProfilerTest_h
+#define SiconosProfilerTest_h
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class SiconosProfilerTest : public CppUnit::TestFixture
+{
+
+private:
+
+  // Name of the tests suite
+  CPPUNIT_TEST_SUITE(SiconosProfilerTest);
+
+  // tests to be done ...
+  CPPUNIT_TEST(testDisabled);
+
+  CPPUNIT_TEST(testNestedPhases);
+
+  CPPUNIT_TEST(testSteps);
+
+  CPPUNIT_TEST(testChromeTrace);
+
+  CPPUNIT_TEST_SUITE_END();
+
+  // Members
+  void testDisabled();
+  void testNestedPhases();
+  void testSteps();
+  void testChromeTrace();
+
+public:
+  void setUp();
+  void tearDown();
+
+};
+
+#endif
@@ -46,6 +46,7 @@
 #include <boost/mpl/eval_if.hpp>
 #include <boost/typeof/typeof.hpp>
 #include <RotationQuaternion.hpp>
+#include <SiconosProfiler.hpp>
 #include <SiconosVectorIterator.hpp>
 #include <vector>
 #include <cstddef>
@@ -282,6 +283,14 @@ typedef __mpz_struct mpz_t[1];
 %include std_vector.i
 %template (MemoryContainer) std::vector<SiconosVector>;
 
+// profiler of the simulations, queried by names
+%include std_string.i
+%template (StringVector) std::vector<std::string>;
+%ignore SiconosProfiler::Timer;
+%ignore SiconosProfiler::phases;
+%ignore SiconosProfiler::counters;
+%include "SiconosProfiler.hpp"
+
 // registered classes in KernelRegistration.i
 
 %include KernelRegistration.i
@@ -1,10 +1,14 @@
 import siconos.kernel as sk
 import numpy as np
+import pytest
 
 
-def test_bouncing_ball1(datafile):
+@pytest.mark.parametrize("incremental", [False, True])
+def test_bouncing_ball1(datafile, incremental):
     """Run a complete simulation (Bouncing ball example)
     LagrangianLinearTIDS,  no plugins.
+    With incremental, indexSet1 is updated incrementally, with a bound
+    of the ball velocity (sqrt(2 g) < 5): the results are the same.
     """
 
     t0 = 0.0  # start time
@@ -72,6 +76,8 @@ def test_bouncing_ball1(datafile):
 
     # (4) Simulation setup with (1) (2) (3)
     s = sk.TimeStepping(bouncing_ball, t, OSI, osnspb)
+    if incremental:
+        s.setIncrementalIndexSetUpdate(True, 5.0)
 
     # end of model definition
 
@@ -332,7 +338,74 @@ def test_bouncing_ball2():
     ball_d = Ball(x.copy(), v.copy(), mass)
     ball_d.computeFExt(t0)
 
+    # time the phases of the simulations
+    sk.SiconosProfiler.setEnabled(True)
     run_simulation_with_two_ds(ball, ball_d, t0)
+    sk.SiconosProfiler.setEnabled(False)
+
+    phases = sk.SiconosProfiler.phaseNames()
+    assert "computeFreeState" in phases
+    assert "computeOneStepNSProblem/preCompute" in phases
+    assert "computeOneStepNSProblem/solve" in phases
+    assert "solverIterations" in sk.SiconosProfiler.counterNames()
+    assert sk.SiconosProfiler.numberOfSteps() > 0
+    assert sk.SiconosProfiler.phase("computeFreeState").calls > 0
+
+
+def test_bouncing_ball_profiler_free_flight():
+    """The solver iterations are not counted on the free-flight steps,
+    where the LCP is empty and its solver is not called.
+    """
+
+    t0 = 0.0  # start time
+    T = 2.0  # end time
+    h = 0.005  # time step
+    r = 0.1  # ball radius
+    g = 9.81  # gravity
+    m = 1  # ball mass
+
+    x = np.zeros(3, dtype=np.float64)
+    x[0] = 1.0
+    v = np.zeros_like(x)
+    mass = np.eye(3, dtype=np.float64)
+    mass[2, 2] = 3.0 / 5 * r * r
+    ball = sk.LagrangianLinearTIDS(x, v, mass)
+    weight = np.zeros(ball.dimension())
+    weight[0] = -m * g
+    ball.setFExtPtr(weight)
+
+    H = np.zeros((1, 3), dtype=np.float64)
+    H[0, 0] = 1.0
+    inter = sk.Interaction(sk.NewtonImpactNSL(0.9), sk.LagrangianLinearTIR(H))
+
+    bouncing_ball = sk.NonSmoothDynamicalSystem(t0, T)
+    bouncing_ball.insertDynamicalSystem(ball)
+    bouncing_ball.link(inter, ball)
+
+    s = sk.TimeStepping(bouncing_ball, sk.TimeDiscretisation(t0, h),
+                        sk.MoreauJeanOSI(0.5), sk.LCP())
+
+    sk.SiconosProfiler.setEnabled(True)
+    contact = False
+    free_flight_after_contact = 0
+    while s.hasNextEvent():
+        s.computeOneStep()
+        # the interactions of the LCP of this step (its size is not reset
+        # when it is empty)
+        active = sk.size_graph(s.indexSet(1))
+        s.nextStep()
+        iterations = sk.SiconosProfiler.counter("solverIterations").lastStep
+        if active > 0:
+            contact = contact or iterations > 0
+        else:
+            assert iterations == 0
+            if contact:
+                free_flight_after_contact += 1
+    sk.SiconosProfiler.setEnabled(False)
+
+    # the ball has bounced and flown again
+    assert contact
+    assert free_flight_after_contact > 0
 
 
 def test_bouncing_ball3():
@@ -66,10 +66,14 @@ DEFINE_SPTR(UpdateShapeVisitor)
 #include "StaticBody.hpp"
 
 #include "BodyShapeRecord.hpp"
+#include "SiconosProfiler.hpp"
 
 
 #include <map>
+#include <vector>
 #include <limits>
+#include <tuple>
+#include <typeindex>
 #include <boost/format.hpp>
 
 #include <Relation.hpp>
@@ -84,6 +88,7 @@ DEFINE_SPTR(UpdateShapeVisitor)
 #include <SiconosMatrix.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <NewtonEulerJointR.hpp>
+#include <RotationQuaternion.hpp>
 
 #include <Question.hpp>
 
@@ -228,6 +233,8 @@ SiconosBulletOptions::SiconosBulletOptions()
   , enableSatConvex(false)
   , enablePolyhedralContactClipping(false)
   , Depth2D(0.04)
+  , warmStartContacts(false)
+  , recycleInteractions(false)
 {
 }
 
@@ -317,6 +324,45 @@ BodyShapeMap;
 
 class CollisionUpdater;
 
+/* The reactions of a destroyed contact point, kept to be the initial
+ * guess of a new contact point at the same place. The contact point, the
+ * normal and the reactions are given for the pair of collision objects in
+ * increasing address order (see orderedContact). */
+struct StoredContactReaction
+{
+  SiconosVector relPc1;
+  SiconosVector relNc;
+  unsigned int lowerLevel;
+  std::vector<SiconosVector> lambda;
+  unsigned int step;
+};
+
+typedef std::pair<const btCollisionObject*, const btCollisionObject*> CollisionObjectPair;
+typedef std::map<CollisionObjectPair, std::vector<StoredContactReaction> > StoredContactReactionMap;
+
+/* The interaction of a destroyed contact point, with the work vectors
+ * set by its integrator, kept to be reused by a new contact point. */
+struct RecycledInteraction
+{
+  SP::Interaction inter;
+  OneStepIntegrator* osi = nullptr;
+  SP::VectorOfVectors workVectors;
+  SP::VectorOfBlockVectors workBlockVectors;
+  unsigned int step = 0;
+};
+
+/* type of the relation, type and size of the nonsmooth law, interaction
+ * between two bodies */
+typedef std::tuple<std::type_index, std::type_index, unsigned int, bool> InteractionPoolKey;
+typedef std::map<InteractionPoolKey, std::vector<RecycledInteraction> > InteractionPool;
+
+static InteractionPoolKey interactionPoolKey(std::type_index relation,
+                                             const NonSmoothLaw& nslaw, bool twoBodies)
+{
+  return InteractionPoolKey(relation, std::type_index(typeid(nslaw)),
+                            nslaw.size(), twoBodies);
+}
+
 class SiconosBulletCollisionManager_impl
 {
 protected:
@@ -448,6 +494,56 @@ protected:
 
   std::vector<std::pair<SP::btCollisionObject,int>> _queuedCollisionObjects;
 
+  /* Reactions of the contact points destroyed during the last two calls
+   * of updateInteractions, by pair of collision objects. */
+  StoredContactReactionMap _storedReactions;
+
+  /* Reactions found for the new interactions, set once they are
+   * initialized. */
+  std::map<const Interaction*, StoredContactReaction> _pendingReactions;
+
+  /* Number of calls of updateInteractions */
+  unsigned int _step = 0;
+
+  void storeReaction(Interaction& inter);
+  bool findReaction(const Interaction& inter, const BulletR& rel);
+  void purgeStoredReactions();
+
+  /* Interactions of the destroyed contact points, moved to the pool
+   * when the simulation does not refer to them anymore. */
+  std::vector<RecycledInteraction> _releasedInteractions;
+
+  InteractionPool _interactionPool;
+  int _pooledInteractions = 0;
+
+  void releaseInteraction(Simulation& simulation, SP::Interaction inter);
+  void poolReleasedInteractions();
+  bool takeRecycledInteraction(const InteractionPoolKey& key,
+                               RecycledInteraction& recycled);
+  void restoreWorkVectors(Simulation& simulation, const RecycledInteraction& recycled);
+
+  /* The relation of an interaction taken from the pool, null if
+   * the pool has none for this nonsmooth law. */
+  template<typename R>
+  std::shared_ptr<R> recycledRelation(const NonSmoothLaw& nslaw, bool twoBodies,
+                                      RecycledInteraction& recycled)
+  {
+    if(!_options.recycleInteractions
+        || !takeRecycledInteraction(interactionPoolKey(typeid(R), nslaw, twoBodies),
+                                    recycled))
+      return std::shared_ptr<R>();
+    return std::static_pointer_cast<R>(recycled.inter->relation());
+  }
+
+  SP::Interaction makeInteraction(SP::NonSmoothLaw nslaw, SP::Relation rel,
+                                  const RecycledInteraction& recycled)
+  {
+    if(!recycled.inter)
+      return std::make_shared<Interaction>(nslaw, rel);
+    recycled.inter->recycle(nslaw);
+    return recycled.inter;
+  }
+
 public:
   SiconosBulletCollisionManager_impl(SiconosBulletOptions &op) : _options(op) {}
   ~SiconosBulletCollisionManager_impl() {}
@@ -600,7 +696,6 @@ SiconosBulletCollisionManager::~SiconosBulletCollisionManager()
 {
   // unlink() will be called on all remaining
   // contact points when world is destroyed
-
   // must be the first de-allocated, otherwise segfault
   _impl->_collisionWorld.reset();
 }
@@ -2167,15 +2262,276 @@ public:
   };
 };
 
+/* The data stored in a Bullet contact point: its interaction and the
+ * manager that created it, for bulletContactClear */
+struct ContactPointData
+{
+  SP::Interaction inter;
+  SiconosBulletCollisionManager_impl* impl;
+};
+
+/* The key of the contact of a relation in the stored reactions: the pair
+ * of collision objects in increasing address order, so that it does not
+ * depend on the order of the objects in the Bullet manifold. pc and nc
+ * are the contact point on the first object of the key, in the frame of
+ * its body, and the normal in the frame of the body of the second object,
+ * as relPc1 and relNc of BulletR. Return true if the objects of the
+ * relation are in the reverse order of the key. */
+static bool orderedContact(const BulletR& rel, CollisionObjectPair& key,
+                           SiconosVector& pc, SiconosVector& nc)
+{
+  const btCollisionObject* obj0 = &*rel.btObject[0];
+  const btCollisionObject* obj1 = &*rel.btObject[1];
+  // a static object is always the second one of the relation
+  bool reversed = rel.bodyShapeRecordA && rel.bodyShapeRecordB
+                  && rel.bodyShapeRecordB->ds
+                  && std::less<const btCollisionObject*>()(obj1, obj0);
+  nc = *rel.relNc();
+  if(!reversed)
+  {
+    key = CollisionObjectPair(obj0, obj1);
+    pc = *rel.relPc1();
+    return false;
+  }
+  key = CollisionObjectPair(obj1, obj0);
+  pc = *rel.relPc2();
+  // the normal seen from the other body, in the frame of the first one
+  changeFrameBodyToAbs(*rel.bodyShapeRecordB->ds->q(), nc);
+  changeFrameAbsToBody(*rel.bodyShapeRecordA->ds->q(), nc);
+  nc *= -1.0;
+  return true;
+}
+
+/* The reactions of a contact seen from the other body. The normal and the
+ * first tangent of the contact frame are reversed and the second tangent
+ * is kept (see orthoBaseFromVector): the components along the second
+ * tangent, of the impulse and of the rolling moment, change sign. */
+static void reverseContactReactions(std::vector<SiconosVector>& lambda)
+{
+  for(SiconosVector& l : lambda)
+  {
+    if(l.size() >= 3)
+      l(2) = -l(2);
+    if(l.size() >= 5)
+      l(4) = -l(4);
+  }
+}
+
+void SiconosBulletCollisionManager_impl::storeReaction(Interaction& inter)
+{
+  SP::BulletR rel(std::dynamic_pointer_cast<BulletR>(inter.relation()));
+  if(!rel || !rel->btObject[0] || !rel->btObject[1])
+    return;
+
+  unsigned int lower = inter.lowerLevelForInput();
+  unsigned int upper = inter.upperLevelForInput();
+  if(!inter.lambda(upper))
+    return;
+
+  StoredContactReaction r;
+  CollisionObjectPair key;
+  bool reversed = orderedContact(*rel, key, r.relPc1, r.relNc);
+  r.lowerLevel = lower;
+  for(unsigned int i = lower; i <= upper; i++)
+    r.lambda.push_back(*inter.lambda(i));
+  if(reversed)
+    reverseContactReactions(r.lambda);
+  r.step = _step;
+
+  _storedReactions[key].push_back(std::move(r));
+}
+
+bool SiconosBulletCollisionManager_impl::findReaction(const Interaction& inter,
+                                                      const BulletR& rel)
+{
+  CollisionObjectPair key;
+  SiconosVector pc1(3), nc(3);
+  bool reversed = orderedContact(rel, key, pc1, nc);
+  StoredContactReactionMap::iterator it = _storedReactions.find(key);
+  if(it == _storedReactions.end())
+    return false;
+
+  // the closest stored point on the first object, with the same normal
+  double tol = _options.contactBreakingThreshold / _options.worldScale;
+  double best = tol * tol;
+  std::vector<StoredContactReaction>& stored = it->second;
+  std::vector<StoredContactReaction>::iterator found = stored.end();
+  for(std::vector<StoredContactReaction>::iterator r = stored.begin();
+      r != stored.end(); ++r)
+  {
+    double d2 = 0., cosn = 0.;
+    for(unsigned int k = 0; k < 3; k++)
+    {
+      d2 += (pc1(k) - r->relPc1(k)) * (pc1(k) - r->relPc1(k));
+      cosn += nc(k) * r->relNc(k);
+    }
+    if(d2 <= best && cosn > 0.9)
+    {
+      best = d2;
+      found = r;
+    }
+  }
+  if(found == stored.end())
+    return false;
+
+  if(reversed)
+    reverseContactReactions(found->lambda);
+  _pendingReactions[&inter] = std::move(*found);
+  stored.erase(found);
+  if(stored.empty())
+    _storedReactions.erase(it);
+  return true;
+}
+
+void SiconosBulletCollisionManager_impl::purgeStoredReactions()
+{
+  // the reactions stored before the current call are forgotten
+  StoredContactReactionMap::iterator it = _storedReactions.begin();
+  while(it != _storedReactions.end())
+  {
+    std::vector<StoredContactReaction>& stored = it->second;
+    stored.erase(std::remove_if(stored.begin(), stored.end(),
+                                [this](const StoredContactReaction& r)
+                                { return r.step < _step; }),
+                 stored.end());
+    if(stored.empty())
+      it = _storedReactions.erase(it);
+    else
+      ++it;
+  }
+}
+
+/* The contact data of a relation that keep alive the objects of the
+ * destroyed contact point. Return false if it is not a relation created
+ * by the make* functions. */
+template<typename R>
+static bool releaseContactRelation(const SP::Relation& relation)
+{
+  std::shared_ptr<R> rel(std::dynamic_pointer_cast<R>(relation));
+  if(!rel)
+    return false;
+  rel->bodyShapeRecordA.reset();
+  rel->bodyShapeRecordB.reset();
+  rel->btObject[0].reset();
+  rel->btObject[1].reset();
+  return true;
+}
+
+void SiconosBulletCollisionManager_impl::releaseInteraction(Simulation& simulation,
+                                                            SP::Interaction inter)
+{
+  SP::Relation relation = inter->relation();
+  if(!releaseContactRelation<BulletR>(relation)
+      && !releaseContactRelation<Bullet5DR>(relation)
+      && !releaseContactRelation<Bullet2dR>(relation)
+      && !releaseContactRelation<Bullet2d3DR>(relation))
+    return;
+
+  Topology& topology = *simulation.nonSmoothDynamicalSystem()->topology();
+  InteractionsGraph& indexSet0 = *topology.indexSet0();
+  if(!indexSet0.is_vertex(inter))
+    return;
+  InteractionProperties& props = indexSet0.properties(indexSet0.descriptor(inter));
+  DynamicalSystemsGraph& DSG = *topology.dSG(0);
+
+  RecycledInteraction r;
+  r.inter = inter;
+  r.osi = DSG.properties(DSG.descriptor(props.source)).osi.get();
+  r.workVectors = props.workVectors;
+  r.workBlockVectors = props.workBlockVectors;
+  r.step = _step;
+  _releasedInteractions.push_back(std::move(r));
+}
+
+void SiconosBulletCollisionManager_impl::poolReleasedInteractions()
+{
+  // the change log of the nonsmooth dynamical system refers to the
+  // removed interactions until it is cleared, the interactions released
+  // before the last call are forgotten
+  std::vector<RecycledInteraction> kept;
+  for(RecycledInteraction& r : _releasedInteractions)
+  {
+    if(r.inter.use_count() == 1)
+    {
+      Relation& relation = *r.inter->relation();
+      InteractionPoolKey key(interactionPoolKey(typeid(relation), *r.inter->nonSmoothLaw(),
+                                                r.inter->has2Bodies()));
+      _interactionPool[key].push_back(std::move(r));
+      _pooledInteractions++;
+    }
+    else if(r.step + 1 >= _step)
+      kept.push_back(std::move(r));
+  }
+  _releasedInteractions.swap(kept);
+}
+
+bool SiconosBulletCollisionManager_impl::takeRecycledInteraction(const InteractionPoolKey& key,
+                                                                 RecycledInteraction& recycled)
+{
+  InteractionPool::iterator it = _interactionPool.find(key);
+  if(it == _interactionPool.end() || it->second.empty())
+    return false;
+  recycled = std::move(it->second.back());
+  it->second.pop_back();
+  _pooledInteractions--;
+  return true;
+}
+
+void SiconosBulletCollisionManager_impl::restoreWorkVectors(Simulation& simulation,
+                                                            const RecycledInteraction& recycled)
+{
+  Topology& topology = *simulation.nonSmoothDynamicalSystem()->topology();
+  InteractionsGraph& indexSet0 = *topology.indexSet0();
+  InteractionProperties& props = indexSet0.properties(indexSet0.descriptor(recycled.inter));
+  DynamicalSystemsGraph& DSG = *topology.dSG(0);
+
+  // the work vectors are set by the integrator of the bodies
+  if(DSG.properties(DSG.descriptor(props.source)).osi.get() != recycled.osi)
+    return;
+  props.workVectors = recycled.workVectors;
+  props.workBlockVectors = recycled.workBlockVectors;
+}
+
+void SiconosBulletCollisionManager::initializeInteraction(double time, SP::Interaction inter)
+{
+  std::map<const Interaction*, StoredContactReaction>::iterator it =
+    _impl->_pendingReactions.find(&*inter);
+  if(it == _impl->_pendingReactions.end())
+    return;
+
+  const StoredContactReaction& r = it->second;
+  for(unsigned int i = 0; i < r.lambda.size(); i++)
+  {
+    unsigned int level = r.lowerLevel + i;
+    if(level < inter->lowerLevelForInput() || level > inter->upperLevelForInput()
+        || r.lambda[i].size() != inter->lambda(level)->size())
+      continue;
+    // lambda_k is the initial guess of the one-step nonsmooth problem
+    *inter->lambda(level) = r.lambda[i];
+    inter->lambdaMemory(level).swap(r.lambda[i]);
+  }
+  _stats.interactions_warm_started++;
+  _impl->_pendingReactions.erase(it);
+}
+
 // called once for each contact point as it is destroyed
 Simulation* SiconosBulletCollisionManager::gSimulation;
 bool SiconosBulletCollisionManager::bulletContactClear(void* userPersistentData)
 {
-  /* note: stored pointer to shared_ptr! */
-  SP::Interaction *p_inter = (SP::Interaction*)userPersistentData;
-  assert(p_inter!=NULL && "Contact point's stored (SP::Interaction*) is null!");
+  /* note: stored pointer to ContactPointData! */
+  ContactPointData *data = (ContactPointData*)userPersistentData;
+  assert(data!=NULL && "Contact point's stored (ContactPointData*) is null!");
+  SP::Interaction *p_inter = &data->inter;
   DEBUG_PRINTF("unlinking interaction %p, number %zu \n", &**p_inter, (*p_inter)->number());
 
+  // the manager that created the contact point
+  SiconosBulletCollisionManager_impl* impl = data->impl;
+  if(impl->_options.warmStartContacts)
+    impl->storeReaction(**p_inter);
+
+  if(impl->_options.recycleInteractions)
+    impl->releaseInteraction(*gSimulation, *p_inter);
+
   // SP::BulletR rel_bulletR(std::dynamic_pointer_cast<BulletR>((*p_inter)->relation()));
   // SP::Bullet5DR rel_bullet5DR(std::dynamic_pointer_cast<Bullet5DR>((*p_inter)->relation()));
   // SP::Bullet2dR rel_bullet2dR(std::dynamic_pointer_cast<Bullet2dR>((*p_inter)->relation()));
@@ -2191,7 +2547,7 @@ bool SiconosBulletCollisionManager::bulletContactClear(void* userPersistentData)
   // std::static_pointer_cast<BulletR>((*p_inter)->relation())->preDelete();
   //_stats.interaction_destroyed++;
   gSimulation->unlink(*p_inter);
-  delete p_inter;
+  delete data;
   return false;
 }
 
@@ -2346,18 +2702,11 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
   CProfileManager::Reset();
 #endif
   // -2. update collision objects from all RigidBodyDS dynamical systems
-#ifdef BULLET_TIMER
-  std::chrono::time_point<std::chrono::system_clock> start, end, end_old;
-  start = std::chrono::system_clock::now();
-#endif
-
-  SP::SiconosVisitor updateVisitor(new CollisionUpdateVisitor(*_impl));
-  simulation->nonSmoothDynamicalSystem()->visitDynamicalSystems(updateVisitor);
-#ifdef BULLET_TIMER
-  end = std::chrono::system_clock::now();
-  int elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (end-start).count();
-  std::cout << "-2 : visit " << elapsed << " ms" << std::endl;
-#endif
+  {
+    SiconosProfiler::Timer timer("updateCollisionObjects");
+    SP::SiconosVisitor updateVisitor(new CollisionUpdateVisitor(*_impl));
+    simulation->nonSmoothDynamicalSystem()->visitDynamicalSystems(updateVisitor);
+  }
   // Clear cache automatically before collision detection if requested
   if(_options.clearOverlappingPairCache)
     clearOverlappingPairCache();
@@ -2382,15 +2731,12 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
   // -1. reset statistical counters
   resetStatistics();
 
-#ifdef BULLET_TIMER
-  end_old=end;
-  end = std::chrono::system_clock::now();
-  elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
-    (end-end_old).count();
-  std::cout << "-1 : addCollisionObject " << elapsed << " ms" << std::endl;
-#endif
+  if(_options.recycleInteractions)
+    _impl->poolReleasedInteractions();
+
   // 0. set up bullet callbacks
   gSimulation = &*simulation;
+  _impl->_pendingReactions.clear();
   gContactDestroyedCallback = this->bulletContactClear;
   gContactAddedCallback = this->bulletContactAddedCallback;
 
@@ -2398,14 +2744,10 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
   gContactBreakingThreshold = _options.contactBreakingThreshold;
 
   // 1. perform bullet collision detection
-  _impl->_collisionWorld->performDiscreteCollisionDetection();
-#ifdef BULLET_TIMER
-  end_old =end;
-  end = std::chrono::system_clock::now();
-  elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
-    (end-end_old).count();
-  std::cout << "1 : collisionDectection" << elapsed << " ms" << std::endl;
-#endif
+  {
+    SiconosProfiler::Timer timer("collisionDetection");
+    _impl->_collisionWorld->performDiscreteCollisionDetection();
+  }
 
 
 #ifdef BULLET_TIMER
@@ -2419,6 +2761,7 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
   //    bullet collision detection callbacks
 
   // 3. for each contact point, if there is no interaction, create one
+  SiconosProfiler::Timer timer("contactPoints");
   IterateContactPoints t(_impl->_collisionWorld);
   IterateContactPoints::iterator it, itend=t.end();
   DEBUG_EXPR_WE(
@@ -2477,41 +2820,28 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
 
     if(_with_equality_constraints && pairA->ds && pairB->ds)
     {
-      InteractionsGraph::VIterator ui, uiend;
-      SP::InteractionsGraph indexSet0 = simulation->nonSmoothDynamicalSystem()->topology()->indexSet0();
+      // the joints between the two bodies are found without scanning
+      // the interactions graph
+      std::vector<SP::Interaction> joints =
+        simulation->nonSmoothDynamicalSystem()->topology()
+        ->equalityInteractionsForPairOfDS(pairA->ds, pairB->ds);
       bool match = false;
-      for(std::tie(ui, uiend) = indexSet0->vertices(); ui != uiend; ++ui)
+      for(unsigned int i = 0; i < joints.size() && !match; ++i)
       {
-        SP::Interaction inter(indexSet0->bundle(*ui));
-        SP::SecondOrderDS ds1(std::dynamic_pointer_cast<SecondOrderDS>(
-                                indexSet0->properties(*ui).source));
-        SP::SecondOrderDS ds2(std::dynamic_pointer_cast<SecondOrderDS>(
-                                indexSet0->properties(*ui).target));
-        if(ds1 && ds2 && (((&*ds1==&*pairA->ds) && (&*ds2==&*pairB->ds))
-                          || ((&*ds1==&*pairB->ds) && (&*ds2==&*pairA->ds))))
-        {
-          SP::BulletR br(std::dynamic_pointer_cast<BulletR>(inter->relation()));
-          DEBUG_EXPR(std::cout << "br" << br << std::endl;);
-          if(!br)
-          {
-            DEBUG_PRINT("Only match on non-BulletR interactions, i.e. non-contact relations\n");
-            SP::NewtonEulerJointR jr(
-              std::dynamic_pointer_cast<NewtonEulerJointR>(inter->relation()));
-
-            /* If it is a joint, check the joint self-collide property */
-            if(jr && !jr->allowSelfCollide())
-              match = true;
-
-            /* If any non-contact relation is found, both bodies must
-             * allow self-collide */
-            // We need to check for other type of dynamical systems.
-            SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
-            SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
-            if(!rbdsA->allowSelfCollide() || !rbdsB->allowSelfCollide())
-              match = true;
-          }
-          if(match) break;
-        }
+        SP::NewtonEulerJointR jr(
+          std::dynamic_pointer_cast<NewtonEulerJointR>(joints[i]->relation()));
+
+        /* If it is a joint, check the joint self-collide property */
+        if(jr && !jr->allowSelfCollide())
+          match = true;
+
+        /* If any equality relation is found, both bodies must
+         * allow self-collide */
+        // We need to check for other type of dynamical systems.
+        SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
+        SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
+        if(!rbdsA->allowSelfCollide() || !rbdsB->allowSelfCollide())
+          match = true;
       }
       if(match)
         continue;
@@ -2522,7 +2852,7 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
       /* interaction already exists */
       DEBUG_PRINT("SiconosBulletCollisionManager :: interaction already exists \n");
       SP::Interaction *p_inter =
-        (SP::Interaction*)it->point->m_userPersistentData;
+        &((ContactPointData*)it->point->m_userPersistentData)->inter;
 
 
       SP::BulletR rel_bulletR(std::dynamic_pointer_cast<BulletR>((*p_inter)->relation()));
@@ -2587,6 +2917,7 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
       /* new interaction */
       DEBUG_PRINT("SiconosBulletCollisionManager :: New interaction\n");
       SP::Interaction inter;
+      RecycledInteraction recycled;
 
       int g1 = pairA->contactor->collision_group;
       int g2 = pairB->contactor->collision_group;
@@ -2609,9 +2940,9 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
           SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
           SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
 
-          SP::BulletR rel(makeBulletR(rbdsA, pairA->sshape,
-                                      rbdsB, pairB->sshape,
-                                      *it->point));
+          SP::BulletR rel(_impl->recycledRelation<BulletR>(*nslaw, (bool)pairB->ds, recycled));
+          if(!rel)
+            rel = makeBulletR(rbdsA, pairA->sshape, rbdsB, pairB->sshape, *it->point);
 
           if(!rel) continue;
 
@@ -2640,8 +2971,11 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
             _stats.interaction_warnings ++;
           }
 
-          inter = std::make_shared<Interaction>(nslaw, rel);
+          inter = _impl->makeInteraction(nslaw, rel, recycled);
           _stats.new_interactions_created ++;
+
+          if(_options.warmStartContacts)
+            _impl->findReaction(*inter, *rel);
         }
         else if(nslaw && nslaw->size() == 2)
         {
@@ -2649,9 +2983,9 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
           SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
           SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
 
-          SP::Bullet2dR rel(makeBullet2dR(rbdsA, pairA->sshape,
-                                          rbdsB, pairB->sshape,
-                                          *it->point));
+          SP::Bullet2dR rel(_impl->recycledRelation<Bullet2dR>(*nslaw, (bool)pairB->ds, recycled));
+          if(!rel)
+            rel = makeBullet2dR(rbdsA, pairA->sshape, rbdsB, pairB->sshape, *it->point);
 
           if(!rel) continue;
 
@@ -2680,7 +3014,7 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
             _stats.interaction_warnings ++;
           }
           DEBUG_PRINT("SiconosBulletCollisionManager :: create 2d interaction\n");
-          inter = std::make_shared<Interaction>(nslaw, rel);
+          inter = _impl->makeInteraction(nslaw, rel, recycled);
           _stats.new_interactions_created ++;
         }
 
@@ -2693,9 +3027,9 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
           SP::RigidBodyDS rbdsA =  std::static_pointer_cast<RigidBodyDS>(pairA->ds);
           SP::RigidBodyDS rbdsB =  std::static_pointer_cast<RigidBodyDS>(pairB->ds);
 
-          SP::Bullet5DR rel(makeBullet5DR(rbdsA, pairA->sshape,
-                                          rbdsB, pairB->sshape,
-                                          *it->point));
+          SP::Bullet5DR rel(_impl->recycledRelation<Bullet5DR>(*nslaw, (bool)pairB->ds, recycled));
+          if(!rel)
+            rel = makeBullet5DR(rbdsA, pairA->sshape, rbdsB, pairB->sshape, *it->point);
 
           if(!rel) continue;
 
@@ -2724,7 +3058,7 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
             _stats.interaction_warnings ++;
           }
 
-          inter = std::make_shared<Interaction>(nslaw, rel);
+          inter = _impl->makeInteraction(nslaw, rel, recycled);
           _stats.new_interactions_created ++;
         }
         else if(nslaw && nslaw->size() == 3)
@@ -2733,9 +3067,9 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
           SP::RigidBody2dDS rbdsA =  std::static_pointer_cast<RigidBody2dDS>(pairA->ds);
           SP::RigidBody2dDS rbdsB =  std::static_pointer_cast<RigidBody2dDS>(pairB->ds);
 
-          SP::Bullet2d3DR rel(makeBullet2d3DR(rbdsA, pairA->sshape,
-                                              rbdsB, pairB->sshape,
-                                              *it->point));
+          SP::Bullet2d3DR rel(_impl->recycledRelation<Bullet2d3DR>(*nslaw, (bool)pairB->ds, recycled));
+          if(!rel)
+            rel = makeBullet2d3DR(rbdsA, pairA->sshape, rbdsB, pairB->sshape, *it->point);
 
           if(!rel) continue;
 
@@ -2768,7 +3102,7 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
             _stats.interaction_warnings ++;
           }
           DEBUG_PRINT("SiconosBulletCollisionManager :: create 2d interaction\n");
-          inter = std::make_shared<Interaction>(nslaw, rel);
+          inter = _impl->makeInteraction(nslaw, rel, recycled);
           _stats.new_interactions_created ++;
         }
       }
@@ -2787,22 +3121,25 @@ void SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation
       {
         /* store interaction in the contact point data, it will be freed by the
          * Bullet callback gContactDestroyedCallback */
-        /* note: storing pointer to shared_ptr! */
-        it->point->m_userPersistentData = (void*)(new SP::Interaction(inter));
+        /* note: storing pointer to ContactPointData! */
+        it->point->m_userPersistentData = (void*)(new ContactPointData{inter, &*_impl});
         DEBUG_PRINT("SiconosBulletCollisionManager :: link the interaction\n");
         /* link bodies by the new interaction */
         simulation->link(inter, pairA->ds, pairB->ds);
+        if(recycled.inter)
+        {
+          _impl->restoreWorkVectors(*simulation, recycled);
+          _stats.interactions_recycled ++;
+        }
       }
     }
     //getchar();
   }
-#ifdef BULLET_TIMER
-  end_old =end;
-  end = std::chrono::system_clock::now();
-  elapsed = std::chrono::duration_cast<std::chrono::milliseconds>
-    (end-end_old).count();
-  std::cout << "2 : creation of interaction " << elapsed << " ms" << std::endl;
-#endif
+  if(_options.warmStartContacts)
+    _impl->purgeStoredReactions();
+  _impl->_step++;
+  _stats.interactions_pooled = _impl->_pooledInteractions;
+  SiconosProfiler::count("newInteractions", _stats.new_interactions_created);
   DEBUG_END("SiconosBulletCollisionManager::updateInteractions(SP::Simulation simulation)\n");
 }
 
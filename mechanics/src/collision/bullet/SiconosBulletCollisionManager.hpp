@@ -63,6 +63,22 @@ public:
   bool enableSatConvex;
   bool enablePolyhedralContactClipping;
   double Depth2D;
+
+  /** Use the last reaction of a contact point destroyed by Bullet as the
+   * initial guess of the reaction of a new contact point at the same
+   * place between the same objects (3D frictional contacts, see
+   * SiconosBulletCollisionManager::initializeInteraction). */
+  bool warmStartContacts;
+
+  /** Reuse the interactions of the contact points destroyed by Bullet,
+   * with their relations, memories and integrator work vectors, for the
+   * new contact points of the same kind (same type and size of
+   * nonsmooth law, same number of bodies) instead of allocating new
+   * ones. The relations are created once by the make* functions and
+   * then updated from the contact points only. An interaction is reused
+   * once the simulation does not refer to it anymore, i.e. after
+   * Simulation::clearNSDSChangeLog. */
+  bool recycleInteractions;
 };
 
 struct SiconosBulletStatistics
@@ -78,11 +94,20 @@ public:
     , existing_interactions_processed(0)
     , interaction_warnings(0)
     , interaction_destroyed(0)
+    , interactions_warm_started(0)
+    , interactions_recycled(0)
+    , interactions_pooled(0)
     {}
   int new_interactions_created;
   int existing_interactions_processed;
   int interaction_warnings;
   int interaction_destroyed;
+  int interactions_warm_started;
+  /** new interactions taken from the pool of destroyed ones, among
+   * new_interactions_created */
+  int interactions_recycled;
+  /** interactions available in the pool */
+  int interactions_pooled;
 };
 
 class SiconosBulletCollisionManager : public SiconosCollisionManager
@@ -158,6 +183,16 @@ public:
 
   void updateInteractions(SP::Simulation simulation);
 
+  /** Set the reactions stored for a new interaction, if
+   *  SiconosBulletOptions::warmStartContacts is set: the reactions of
+   *  the destroyed contact points are kept by pair of collision objects
+   *  during two calls of updateInteractions, and a new contact point
+   *  reuses the one found at less than contactBreakingThreshold.
+   * \param time the current time
+   * \param inter the new interaction
+   */
+  void initializeInteraction(double time, SP::Interaction inter) override;
+
   std::vector<SP::SiconosCollisionQueryResult>
   lineIntersectionQuery(const SiconosVector& start, const SiconosVector& end,
                         bool closestOnly=false, bool sorted=true);
@@ -168,10 +203,12 @@ public:
   const SiconosBulletStatistics &statistics() const { return _stats; }
   void resetStatistics() { _stats = SiconosBulletStatistics(); }
 
-  /** Set the usage of equality constraints. When the number
-      of objects is huge as in granular material, the usage
-      of equality constraint breaks scalability.
-      This have to be fixed.
+  /** Set the usage of equality constraints: no contact is created
+      between two bodies linked by an interaction with an
+      EqualityConditionNSL (e.g. a joint), unless both the joint and the
+      bodies allow self-collision. The lookup of the joints costs
+      O(1) per contact point (see
+      Topology::equalityInteractionsForPairOfDS).
    * \param choice a boolean, default is True.
    */
   void useEqualityConstraints(bool choice=true)
@@ -42,6 +42,7 @@ struct BounceParams
   double timestep;
   double insideMargin;
   double outsideMargin;
+  double slidingVelocity = 0.0;  // initial horizontal velocity
   SiconosBulletOptions options;
 
   void dump()
@@ -66,6 +67,9 @@ struct BounceResult
   double final_position;
   double final_position_std;
   int num_interactions;
+  int num_recycled_interactions;
+  int num_warm_started_interactions;
+  int solver_iterations;
   int num_interaction_warnings;
   int max_simultaneous_contacts;
   double avg_simultaneous_contacts;
@@ -97,6 +101,9 @@ BounceResult bounceTest(std::string moving,
   double actual_bounce_ratios[6]  = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
 
   int local_new_interaction_count=0;
+  int local_recycled_interaction_count=0;
+  int local_warm_started_interaction_count=0;
+  int solver_iterations=0;
   int max_simultaneous_contacts=0;
   double avg_simultaneous_contacts=0.0;
 
@@ -117,6 +124,7 @@ BounceResult bounceTest(std::string moving,
   (*q0)(2) = position_init;
   (*q0)(3) = 1.0;
   (*v0)(2) = velocity_init;
+  (*v0)(0) = params.slidingVelocity;
 
   SP::SiconosVector q1(new SiconosVector(7));
   SP::SiconosVector v1(new SiconosVector(6));
@@ -301,6 +309,9 @@ BounceResult bounceTest(std::string moving,
                        + collisionMan->statistics().existing_interactions_processed;
 
     local_new_interaction_count += collisionMan->statistics().new_interactions_created;
+    local_recycled_interaction_count += collisionMan->statistics().interactions_recycled;
+    local_warm_started_interaction_count += collisionMan->statistics().interactions_warm_started;
+    solver_iterations += osnspb->numericsSolverOptions()->iparam[SICONOS_IPARAM_ITER_DONE];
 
     if(interactions > max_simultaneous_contacts)
       max_simultaneous_contacts = interactions;
@@ -321,6 +332,9 @@ BounceResult bounceTest(std::string moving,
 
     // Advance simulation
     simulation->nextStep();
+    // the removed interactions are recycled once the change log is cleared
+    if(params.options.recycleInteractions)
+      simulation->clearNSDSChangeLog();
     k++;
   }
 
@@ -341,6 +355,9 @@ BounceResult bounceTest(std::string moving,
   r.final_position_std = sqrt(std/100);
 
   r.num_interactions = local_new_interaction_count;
+  r.num_recycled_interactions = local_recycled_interaction_count;
+  r.num_warm_started_interactions = local_warm_started_interaction_count;
+  r.solver_iterations = solver_iterations;
   r.num_interaction_warnings = collisionMan->statistics().interaction_warnings;
   r.max_simultaneous_contacts = max_simultaneous_contacts;
   r.avg_simultaneous_contacts = avg_simultaneous_contacts / (double)k;
@@ -525,3 +542,84 @@ void ContactTest::t4()
     CPPUNIT_ASSERT(1);
   }
 }
+
+void ContactTest::t5()
+{
+  try
+  {
+    printf("\n==== t5\n");
+
+    BounceParams params;
+    params.trace = false;
+    params.dynamic = false;
+    params.size = 1.0;
+    params.mass = 1.0;
+    params.position = 3.0;
+    params.timestep = 0.005;
+    params.insideMargin = 0.1;
+    params.outsideMargin = 0.1;
+
+    BounceResult r = bounceTest("box", "box", params);
+
+    // the box bounces, its contact points are destroyed and created again
+    params.options.recycleInteractions = true;
+    BounceResult rr = bounceTest("box", "box", params);
+
+    fprintf(stderr, "\nInteractions: %d, recycled: %d\n",
+            rr.num_interactions, rr.num_recycled_interactions);
+    fprintf(stderr, "Final position: %g  (without recycling: %g)\n\n",
+            rr.final_position, r.final_position);
+
+    CPPUNIT_ASSERT(rr.num_recycled_interactions > 0);
+    CPPUNIT_ASSERT(rr.num_recycled_interactions <= rr.num_interactions);
+    CPPUNIT_ASSERT(fabs(rr.final_position - r.final_position) < 1e-6);
+    CPPUNIT_ASSERT(fabs(rr.bounce_error_sum - r.bounce_error_sum) < 1e-6);
+  }
+  catch(...)
+  {
+    Siconos::exception::process();
+    CPPUNIT_ASSERT(0);
+  }
+}
+
+void ContactTest::t6()
+{
+  try
+  {
+    printf("\n==== t6\n");
+
+    BounceParams params;
+    params.trace = false;
+    params.dynamic = false;
+    params.size = 1.0;
+    params.mass = 1.0;
+    params.position = 3.0;
+    params.timestep = 0.005;
+    params.insideMargin = 0.1;
+    params.outsideMargin = 0.1;
+    // the box slides on the ground: the contact points at its corners
+    // drift and are replaced by Bullet while they carry the weight
+    params.slidingVelocity = 1.0;
+
+    BounceResult r = bounceTest("box", "box", params);
+
+    params.options.warmStartContacts = true;
+    BounceResult rw = bounceTest("box", "box", params);
+
+    fprintf(stderr, "\nInteractions: %d, warm started: %d\n",
+            rw.num_interactions, rw.num_warm_started_interactions);
+    fprintf(stderr, "Solver iterations: %d  (without warm start: %d)\n\n",
+            rw.solver_iterations, r.solver_iterations);
+
+    CPPUNIT_ASSERT(r.num_warm_started_interactions == 0);
+    CPPUNIT_ASSERT(rw.num_warm_started_interactions > 0);
+    CPPUNIT_ASSERT(rw.num_warm_started_interactions <= rw.num_interactions);
+    // the reactions of the replaced contact points are good initial guesses
+    CPPUNIT_ASSERT(rw.solver_iterations < r.solver_iterations);
+  }
+  catch(...)
+  {
+    Siconos::exception::process();
+    CPPUNIT_ASSERT(0);
+  }
+}
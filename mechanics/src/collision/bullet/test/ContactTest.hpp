@@ -32,6 +32,8 @@ private:
   CPPUNIT_TEST(t2);
   CPPUNIT_TEST(t3);
   CPPUNIT_TEST(t4);
+  CPPUNIT_TEST(t5);
+  CPPUNIT_TEST(t6);
 
   CPPUNIT_TEST_SUITE_END();
 
@@ -40,6 +42,8 @@ private:
   void t2();
   void t3();
   void t4();
+  void t5();
+  void t6();
 
 public:
   void setUp();
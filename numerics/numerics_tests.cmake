@@ -25,6 +25,8 @@ if(WITH_TESTING)
   
   new_test(NAME tools_projection SOURCES test_projection.c)
 
+  new_test(SOURCES test_projection_batch.c)
+
   new_test(SOURCES NumericsArrays.c)
 
   #  tests for NumericsMatrix
@@ -113,6 +115,7 @@ if(WITH_TESTING)
     new_test(NAME MLCPtest SOURCES main_mlcp.cpp)
   endif()
   new_test(SOURCES MixedLinearComplementarity_ReadWrite_test.c)
+  new_test(SOURCES mlcp_direct_cache_test.c)
 
   # ----------- MCP solvers tests -----------
   begin_tests(src/MCP/test)
@@ -161,6 +164,9 @@ if(WITH_TESTING)
   new_tests_collection(
     DRIVER fc_test_collection.c.in FORMULATION fc3d COLLECTION TEST_NSGS_COLLECTION_FREEZE_2
     EXTRA_SOURCES data_collection_2.c test_nsgs_freeze_1.c)
+  new_tests_collection(
+    DRIVER fc_test_collection.c.in FORMULATION fc3d COLLECTION TEST_NSGS_COLLECTION_PARALLEL_2
+    EXTRA_SOURCES data_collection_2.c test_nsgs_parallel_1.c)
 
   new_tests_collection(
     DRIVER fc_test_collection.c.in FORMULATION fc3d COLLECTION TEST_NSGS_COLLECTION_3
@@ -216,6 +222,25 @@ if(WITH_TESTING)
   new_test(SOURCES fc3d_LmgcDriver_test4.c)
   new_test(SOURCES fc3d_LmgcDriver_test5.c)
 
+  # --- SBM storage benchmark ---
+  # Not in the ctest suite: 'make sbm-arena-benchmark' runs it.
+  new_test(SOURCES fc3d_nsgs_sbm_arena_bench.c NO_TEST)
+  add_custom_target(sbm-arena-benchmark
+    COMMAND fc3d_nsgs_sbm_arena_bench
+    WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}/${CURRENT_TEST_DIR}
+    DEPENDS fc3d_nsgs_sbm_arena_bench
+    COMMENT "Time the NSGS sweeps with split and packed SBM blocks"
+    VERBATIM)
+
+  # --- colored (parallel) NSGS sweep against the serial sweep ---
+  new_test(SOURCES fc3d_nsgs_parallel_test.c)
+
+  # --- incremental error evaluation of NSGS against the full evaluation ---
+  new_test(SOURCES fc3d_nsgs_incremental_error_test.c)
+
+  # --- nonsmooth Newton with the reused pattern of the Newton matrix ---
+  new_test(SOURCES fc3d_nsn_refactorization_test.c)
+
   # ---------------------------------------------------
   # --- Global friction contact problem formulation ---
   # ---------------------------------------------------
@@ -253,6 +278,22 @@ if(WITH_TESTING)
 
     new_test(NAME FCLIB_test1 SOURCES fc3d_writefclib_local_test.c DEPS FCLIB::fclib)
 
+    # --- Solvers benchmark on fclib problems ---
+    # ctest runs the default solvers on ./data. 'make fclib-benchmark' runs
+    # FCLIB_BENCHMARK_ARGS (solvers, options, directories ...) and writes
+    # the reports into the build directory.
+    new_test(SOURCES fclib_solvers_bench.c DEPS FCLIB::fclib)
+    set(FCLIB_BENCHMARK_ARGS "" CACHE STRING "Arguments of fclib_solvers_bench for the fclib-benchmark target")
+    separate_arguments(_bench_args UNIX_COMMAND "${FCLIB_BENCHMARK_ARGS}")
+    add_custom_target(fclib-benchmark
+      COMMAND fclib_solvers_bench -l "${CMAKE_BUILD_TYPE}"
+      -j ${CMAKE_BINARY_DIR}/fclib_benchmark.json -c ${CMAKE_BINARY_DIR}/fclib_benchmark.csv
+      ${_bench_args}
+      WORKING_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR}/${CURRENT_TEST_DIR}
+      DEPENDS fclib_solvers_bench
+      COMMENT "Run the friction contact solvers on fclib problems"
+      VERBATIM)
+
     new_tests_collection(
       DRIVER fc_test_collection.c.in FORMULATION fc3d COLLECTION TEST_NSGS_COLLECTION_FCLIB
       EXTRA_SOURCES data_collection_fclib.c test_nsgs_1.c DEPS FCLIB::fclib
@@ -256,6 +256,8 @@ enum SICONOS_FRICTION_3D_NSGS_IPARAM
   SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT =19,
   /** index in iparam to store the  */
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION =14,
+  /** index in iparam to store the parallel sweep strategy */
+  SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY =15,
 };
 enum SICONOS_FRICTION_3D_NSGS_DPARAM
 {
@@ -289,6 +291,10 @@ enum SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ENUM
   /** Evaluation of the error with the expensive function fc3d_compute_error and
       an adaptive frequency for calling the error function  **/
   SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE =3,
+  /** Evaluation of the error with fc3d_compute_error at each iteration, the velocity
+      being updated with the columns of M as the local reactions change (the
+      convergence is confirmed by a full evaluation) **/
+  SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_INCREMENTAL = 4,
 };
 enum SICONOS_FRICTION_3D_NSGS_SHUFFLE_ENUM
 {
@@ -309,6 +315,16 @@ enum SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_ENUM
   SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE =1
 };
 
+enum SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_ENUM
+{
+  /** Serial Gauss-Seidel sweep over the contacts (reproducible order) **/
+  SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_SERIAL =0,
+  /** The contacts are colored such that two contacts coupled by an
+      off-diagonal block of M never share a color. The contacts of one color
+      are updated in parallel (OpenMP), the colors are swept one after the other **/
+  SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_COLORING =1
+};
+
 
 enum SICONOS_FRICTION_3D_NSN_IPARAM
 {
@@ -332,7 +348,10 @@ enum SICONOS_FRICTION_3D_NSN_IPARAM
   /** index in iparam used to check if memory allocation has already be done (if true/1) or not (if 0/false) for internal work array. */
   SICONOS_FRICTION_3D_NSN_MEMORY_ALLOCATED= 17,
   /** index in iparam to store the boolean to know if allocation of dwork is needed */
-  SICONOS_FRICTION_3D_NSN_MPI_COM= 18
+  SICONOS_FRICTION_3D_NSN_MPI_COM= 18,
+  /** index in iparam to reuse the pattern and the symbolic factorization
+   * of the Newton matrix along the iterations (sparse storages only) */
+  SICONOS_FRICTION_3D_NSN_REFACTORIZATION= 19
 
 };
 
@@ -342,6 +361,14 @@ enum SICONOS_FC3D_NSN_LINEAR_SOLVER
    SICONOS_FRICTION_3D_NSN_USE_MUMPS = 1
   };
 
+enum SICONOS_FRICTION_3D_NSN_REFACTORIZATION_ENUM
+{
+  /** the Newton matrix is built and factorized from scratch at each iteration */
+  SICONOS_FRICTION_3D_NSN_REFACTORIZATION_NO= 0,
+  /** only the numeric factorization is done at each iteration */
+  SICONOS_FRICTION_3D_NSN_REFACTORIZATION_YES= 1
+};
+
 enum SICONOS_FRICTION_3D_NSN_DPARAM
 {
   /** index in dparam to store the rho value for projection formulation */
@@ -535,7 +562,10 @@ enum SICONOS_FRICTION_3D_IPM_IPARAM_ENUM
   /** index in iparam to store the sparse storage parameter */
   SICONOS_FRICTION_3D_IPM_IPARAM_SPARSE_STORAGE= 12,
   /** index in iparam to get problem info */
-  SICONOS_FRICTION_3D_IPM_IPARAM_GET_PROBLEM_INFO= 13
+  SICONOS_FRICTION_3D_IPM_IPARAM_GET_PROBLEM_INFO= 13,
+  /** index in iparam to reuse the pattern and the symbolic factorization
+   * of the Jacobian along the iterations */
+  SICONOS_FRICTION_3D_IPM_IPARAM_REFACTORIZATION= 14
 
 };
 
@@ -564,5 +594,13 @@ enum SICONOS_FRICTION_3D_IPM_GET_PROBLEM_INFO_ENUM
   SICONOS_FRICTION_3D_IPM_GET_PROBLEM_INFO_YES= 1
 };
 
+enum SICONOS_FRICTION_3D_IPM_REFACTORIZATION_ENUM
+{
+  /** the Jacobian is built and factorized from scratch at each iteration */
+  SICONOS_FRICTION_3D_IPM_REFACTORIZATION_NO= 0,
+  /** only the numeric factorization is done at each iteration */
+  SICONOS_FRICTION_3D_IPM_REFACTORIZATION_YES= 1
+};
+
 
 #endif
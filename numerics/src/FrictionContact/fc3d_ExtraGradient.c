@@ -29,7 +29,7 @@
 #include "fc3d_Solvers.h"            // for fc3d_ExtraGradient, fc3d_ExtraGr...
 #include "fc3d_compute_error.h"      // for fc3d_compute_error
 #include "numerics_verbose.h"        // for verbose
-#include "projectionOnCone.h"        // for projectionOnCone
+#include "projectionOnCone.h"        // for projectionOnCone_batch
 #include "SiconosBlas.h"                   // for cblas_dcopy, cblas_dnrm2, cblas_...
 
 void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options)
@@ -128,8 +128,8 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
         reactiontmp[pos] -= rho * (velocitytmp[pos] + mu[contact] * normUT);
         reactiontmp[pos + 1] -= rho * velocitytmp[pos + 1];
         reactiontmp[pos + 2] -= rho * velocitytmp[pos + 2];
-        projectionOnCone(&reactiontmp[pos], mu[contact]);
       }
+      projectionOnCone_batch(nc, reactiontmp, mu);
       cblas_dcopy(n, q, 1, velocitytmp, 1);
       NM_gemv(alpha, M, reactiontmp, beta, velocitytmp);
       // projection for each contact
@@ -140,8 +140,8 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
         reaction[pos] -= rho * (velocitytmp[pos] + mu[contact] * normUT);
         reaction[pos + 1] -= rho * velocitytmp[pos + 1];
         reaction[pos + 2] -= rho * velocitytmp[pos + 2];
-        projectionOnCone(&reaction[pos], mu[contact]);
       }
+      projectionOnCone_batch(nc, reaction, mu);
 
       /* **** Criterium convergence **** */
       fc3d_compute_error(problem, reaction, velocity, tolerance, options, norm_q, &error);
@@ -201,8 +201,8 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
           reaction[pos] -= rho_k * (velocity_k[pos] + mu[contact] * normUT);
           reaction[pos + 1] -= rho_k * velocity_k[pos + 1];
           reaction[pos + 2] -= rho_k * velocity_k[pos + 2];
-          projectionOnCone(&reaction[pos], mu[contact]);
         }
+        projectionOnCone_batch(nc, reaction, mu);
 
 
         /* velocity <- q + M * reaction  */
@@ -277,8 +277,8 @@ void fc3d_ExtraGradient(FrictionContactProblem* problem, double *reaction, doubl
         /* reaction[pos] = reaction_k[pos] -  rho_k * (velocitytmp[pos] + mu[contact] * normUT); */
         /* reaction[pos + 1] = reaction_k[pos+1] - rho_k * velocitytmp[pos + 1]; */
         /* reaction[pos + 2] = reaction_k[pos+2] - rho_k * velocitytmp[pos + 2]; */
-        projectionOnCone(&reaction[pos], mu[contact]);
       }
+      projectionOnCone_batch(nc, reaction, mu);
       DEBUG_EXPR_WE(for(int i =0; i< 5 ; i++)
     {
       printf("reaction[%i]=%12.8e\t",i,reaction[i]);
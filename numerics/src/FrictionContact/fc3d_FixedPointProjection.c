@@ -30,7 +30,7 @@
 #include "fc3d_Solvers.h"            // for fc3d_fixedPointProjection, fc3d_...
 #include "fc3d_compute_error.h"      // for fc3d_compute_error
 #include "numerics_verbose.h"        // for verbose
-#include "projectionOnCone.h"        // for projectionOnCone
+#include "projectionOnCone.h"        // for projectionOnCone_batch
 #include "SiconosBlas.h"                   // for cblas_dcopy, cblas_dnrm2, cblas_...
 
 void fc3d_fixedPointProjection(FrictionContactProblem* problem, double *reaction, double *velocity, int* info, SolverOptions* options)
@@ -145,9 +145,8 @@ void fc3d_fixedPointProjection(FrictionContactProblem* problem, double *reaction
           reaction[pos] -= rho_k * (velocity_k[pos] + mu[contact] * normUT);
           reaction[pos + 1] -= rho_k * velocity_k[pos + 1];
           reaction[pos + 2] -= rho_k * velocity_k[pos + 2];
-
-          projectionOnCone(&reaction[pos], mu[contact]);
         }
+        projectionOnCone_batch(nc, reaction, mu);
 
 
         /* velocity <- q + M * reaction  */
@@ -92,6 +92,12 @@ extern "C"
 
       [in] iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE_SEED(6)] : seed for the random generator in shuffling  contacts
 
+      [in] iparam[SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY(15)] : order of the sweep over the contacts
+          SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_SERIAL (0) : serial Gauss-Seidel sweep
+          SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_COLORING (1) : contacts are colored from the off-diagonal
+          blocks of M (NM_SPARSE_BLOCK or NM_SPARSE storage) and the contacts of one color are solved in parallel (OpenMP).
+          Shuffle and freezing are not used in this mode.
+
       [out] iparam[SICONOS_IPARAM_ITER_DONE(1)] = iter number of performed iterations
 
       [in]  iparam[8] = error computation frequency
@@ -34,7 +34,7 @@
 #include "fc3d_Solvers.h"            // for fc3d_checkTrivialCase, fc3d_admm
 #include "fc3d_compute_error.h"      // for fc3d_compute_error
 #include "numerics_verbose.h"        // for numerics_printf_verbose, numeric...
-#include "projectionOnCone.h"        // for projectionOnCone, projectionOnDu...
+#include "projectionOnCone.h"        // for projectionOnCone_batch, projecti...
 #include "SiconosBlas.h"                   // for cblas_dcopy, cblas_daxpy, cblas_...
 
 const char* const   SICONOS_FRICTION_3D_ADMM_STR = "FC3D ADMM";
@@ -313,11 +313,7 @@ static void fc3d_admm_symmetric(FrictionContactProblem* restrict problem,
     DEBUG_PRINT("Before projection :");
     DEBUG_EXPR(NV_display(z,m));
 
-    /* Loop through the contact points */
-    for(contact = 0 ; contact < nc ; ++contact)
-    {
-      projectionOnCone(&z[contact * 3], mu[contact]);
-    }
+    projectionOnCone_batch(nc, z, mu);
     DEBUG_PRINT("After projection :");
     DEBUG_EXPR(NV_display(z,m));
 
@@ -731,15 +727,8 @@ static void fc3d_admm_asymmetric(FrictionContactProblem* restrict problem,
     DEBUG_PRINT("Before projection :");
     DEBUG_EXPR(NV_display(z,2*m));
 
-    /* Loop through the contact points */
-    for(contact = 0 ; contact < nc ; ++contact)
-    {
-      projectionOnDualCone(&z[contact * 3], mu[contact]);
-    }
-    for(contact = 0 ; contact < nc ; ++contact)
-    {
-      projectionOnCone(&z[contact * 3+m], mu[contact]);
-    }
+    projectionOnDualCone_batch(nc, z, mu);
+    projectionOnCone_batch(nc, z + m, mu);
 
     DEBUG_PRINT("After projection :");
     DEBUG_EXPR(NV_display(z,2*m));
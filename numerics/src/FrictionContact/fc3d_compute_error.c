@@ -22,6 +22,8 @@
 #include <float.h>                   // for DBL_EPSILON
 #include <math.h>                    // for sqrt, fabs
 #include <stddef.h>                  // for NULL
+#include <stdlib.h>                  // for malloc, free
+#include "CSparseMatrix_internal.h"  // for CSparseMatrix, CS_INT
 #include "FrictionContactProblem.h"  // for FrictionContactProblem
 #include "NumericsMatrix.h"          // for NM_prod_mv_3x3, NM_gemv
 #include "SolverOptions.h"           // for SolverOptions
@@ -36,6 +38,8 @@
 #include "NumericsVector.h"
 #endif
 #include "SiconosBlas.h"                   // for cblas_dcopy, cblas_dnrm2
+#include "simd_clones.h"             // for SIMD_CLONES, SIMD_BLOCK
+#include "projection_blocks.h"       // for projection_on_cone_block
 
 
 void fc3d_unitary_compute_and_add_error(double* restrict r, double* restrict u, double mu, double* restrict error, double * worktmp)
@@ -55,49 +59,97 @@ void fc3d_unitary_compute_and_add_error(double* restrict r, double* restrict u,
   *error +=  worktmp[0] * worktmp[0] + worktmp[1] * worktmp[1] + worktmp[2] * worktmp[2];
 }
 
-int fc3d_compute_error(
+SIMD_CLONES
+void fc3d_compute_and_add_error_batch(unsigned int nc, const double* restrict r,
+                                      const double* restrict u, const double* restrict mu,
+                                      double* restrict error)
+{
+  double r0[SIMD_BLOCK], r1[SIMD_BLOCK], r2[SIMD_BLOCK];
+  double u0[SIMD_BLOCK], u1[SIMD_BLOCK], u2[SIMD_BLOCK];
+  double w0[SIMD_BLOCK], w1[SIMD_BLOCK], w2[SIMD_BLOCK];
+  double m[SIMD_BLOCK], e[SIMD_BLOCK];
+  for(unsigned int k = 0; k < nc; k += SIMD_BLOCK)
+  {
+    unsigned int n = nc - k < SIMD_BLOCK ? nc - k : SIMD_BLOCK;
+    const double* rk = r + 3 * k;
+    const double* uk = u + 3 * k;
+    for(unsigned int i = 0; i < n; i++)
+    {
+      r0[i] = rk[3 * i];
+      r1[i] = rk[3 * i + 1];
+      r2[i] = rk[3 * i + 2];
+      u0[i] = uk[3 * i];
+      u1[i] = uk[3 * i + 1];
+      u2[i] = uk[3 * i + 2];
+      m[i] = mu[k + i];
+    }
+    for(unsigned int i = n; i < SIMD_BLOCK; i++)
+      r0[i] = r1[i] = r2[i] = u0[i] = u1[i] = u2[i] = m[i] = 0.0;
+
+    /* same operations as fc3d_unitary_compute_and_add_error */
+    for(unsigned int i = 0; i < SIMD_BLOCK; i++)
+    {
+      w0[i] = r0[i] - u0[i] - m[i] * sqrt(u1[i] * u1[i] + u2[i] * u2[i]);
+      w1[i] = r1[i] - u1[i];
+      w2[i] = r2[i] - u2[i];
+    }
+    projection_on_cone_block(w0, w1, w2, m);
+    for(unsigned int i = 0; i < SIMD_BLOCK; i++)
+    {
+      w0[i] = r0[i] - w0[i];
+      w1[i] = r1[i] - w1[i];
+      w2[i] = r2[i] - w2[i];
+      e[i] = w0[i] * w0[i] + w1[i] * w1[i] + w2[i] * w2[i];
+    }
+    /* the sum in the order of the contacts */
+    for(unsigned int i = 0; i < n; i++)
+      *error += e[i];
+  }
+}
+
+/* number of contacts of the blocks of the parallel sum of local errors,
+ * a multiple of SIMD_BLOCK */
+#define FC3D_ERROR_CHUNK (64 * SIMD_BLOCK)
+
+int fc3d_compute_error_with_velocity(
   FrictionContactProblem* problem,
   double *z, double *w, double tolerance,
-  SolverOptions * options, double norm, double * error)
+  double norm, double * error)
 {
-  DEBUG_BEGIN("fc3d_compute_error(...)\n");
+  DEBUG_BEGIN("fc3d_compute_error_with_velocity(...)\n");
   assert(problem);
   assert(z);
   assert(w);
   assert(error);
 
-  /* Computes w = Mz + q */
-  int incx = 1, incy = 1;
-  int nc = problem->numberOfContacts;
-  int n = nc * 3;
+  unsigned int nc = (unsigned int) problem->numberOfContacts;
+  int n = (int) nc * 3;
   double *mu = problem->mu;
 
-  /* Compute the current velocity */
-  cblas_dcopy(n, problem->q, incx, w, incy);     // w <-q
-  NM_prod_mv_3x3(n, n, problem->M, z, w); // w = Mz +q
-
   DEBUG_PRINTF("norm of the reaction %e\n", cblas_dnrm2(n, z, 1));
   DEBUG_PRINTF("norm of the velocity %e\n", cblas_dnrm2(n, w, 1));
   DEBUG_PRINTF("norm of q = %12.8e\n", norm);
-  /* DEBUG_EXPR(NV_display(problem->q,n);); */
-  /* DEBUG_EXPR(NV_display(w,n);); */
-  /* DEBUG_EXPR(NV_display(z,n);); */
 
-  *error = 0.;
-  int ic, ic3;
-  double worktmp[3];
-  for(ic = 0, ic3 = 0 ; ic < nc ; ic++, ic3 += 3)
+  /* with one thread, the local errors are summed in the order of the
+   * contacts */
+  double error2 = 0.;
+  unsigned int nchunks = (nc + FC3D_ERROR_CHUNK - 1) / FC3D_ERROR_CHUNK;
+#ifdef WITH_OPENMP
+  #pragma omp parallel for schedule(static) reduction(+:error2) if(nchunks > 1)
+#endif
+  for(unsigned int c = 0; c < nchunks; ++c)
   {
-    fc3d_unitary_compute_and_add_error(z + ic3, w + ic3, mu[ic], error, worktmp);
-    /*DEBUG_PRINTF("absolute error = %12.8e contact =%i nc= %i\n", *error, ic, nc);*/
+    unsigned int first = c * FC3D_ERROR_CHUNK;
+    unsigned int size = nc - first < FC3D_ERROR_CHUNK ? nc - first : FC3D_ERROR_CHUNK;
+    fc3d_compute_and_add_error_batch(size, &z[3 * first], &w[3 * first], &mu[first], &error2);
   }
-  *error = sqrt(*error);
+  *error = sqrt(error2);
   DEBUG_PRINTF("absolute error in complementarity = %12.8e\n", *error);
 
   /* Compute relative error */
   double norm_r =cblas_dnrm2(n, z, 1);
   double norm_u =cblas_dnrm2(n, w, 1);
-  double relative_scaling = fmax(norm, fmax(norm_r,norm_u)); 
+  double relative_scaling = fmax(norm, fmax(norm_r,norm_u));
   /* double relative_scaling = fmax(norm_r,norm_w); */
   /* double relative_scaling = norm; */
 
@@ -105,13 +157,103 @@ int fc3d_compute_error(
     *error /= relative_scaling;
 
   DEBUG_PRINTF("relative error in complementarity = %12.8e\n", *error);
-  DEBUG_END("fc3d_compute_error(...)\n");
+  DEBUG_END("fc3d_compute_error_with_velocity(...)\n");
   if(*error > tolerance)
     return 1;
 
   return 0;
 }
 
+int fc3d_compute_error(
+  FrictionContactProblem* problem,
+  double *z, double *w, double tolerance,
+  SolverOptions * options, double norm, double * error)
+{
+  assert(problem);
+  assert(z);
+  assert(w);
+  assert(error);
+
+  /* Computes w = Mz + q */
+  int incx = 1, incy = 1;
+  int n = problem->numberOfContacts * 3;
+
+  /* Compute the current velocity */
+  cblas_dcopy(n, problem->q, incx, w, incy);     // w <-q
+  NM_prod_mv_3x3(n, n, problem->M, z, w); // w = Mz +q
+
+  return fc3d_compute_error_with_velocity(problem, z, w, tolerance, norm, error);
+}
+
+struct fc3d_incremental_velocity
+{
+  NumericsMatrix* M;   /**< the matrix of the problem */
+  double* w;           /**< the velocity */
+};
+
+fc3d_incremental_velocity* fc3d_incremental_velocity_new(FrictionContactProblem* problem,
+                                                         double *z, double *w)
+{
+  fc3d_incremental_velocity* iv =
+    (fc3d_incremental_velocity*) malloc(sizeof(fc3d_incremental_velocity));
+  int n = problem->numberOfContacts * 3;
+  iv->M = problem->M;
+  iv->w = w;
+
+  /* the columns of a sparse block matrix are read in its csc storage, kept
+   * with the matrix as long as it is not modified */
+  if(problem->M->storageType != NM_DENSE)
+    NM_csc(problem->M);
+
+  cblas_dcopy(n, problem->q, 1, w, 1);
+  NM_prod_mv_3x3(n, n, problem->M, z, w);
+  return iv;
+}
+
+void fc3d_incremental_velocity_update(fc3d_incremental_velocity* iv, unsigned int contact,
+                                      const double old_reaction[3], const double reaction[3])
+{
+  double dr[3] = {reaction[0] - old_reaction[0],
+                  reaction[1] - old_reaction[1],
+                  reaction[2] - old_reaction[2]
+                 };
+  if(dr[0] == 0.0 && dr[1] == 0.0 && dr[2] == 0.0)
+    return;
+
+  NumericsMatrix* M = iv->M;
+  double* w = iv->w;
+  switch(M->storageType)
+  {
+  case NM_DENSE:
+  {
+    cblas_dgemv(CblasColMajor, CblasNoTrans, M->size0, 3, 1.0,
+                &M->matrix0[(size_t)3 * contact * M->size0], M->size0, dr, 1, 1.0, w, 1);
+    break;
+  }
+  case NM_SPARSE_BLOCK:
+  case NM_SPARSE:
+  {
+    CSparseMatrix* A = NM_csc(M);
+    for(int k = 0; k < 3; ++k)
+    {
+      if(dr[k] == 0.0)
+        continue;
+      CS_INT j = 3 * contact + k;
+      for(CS_INT p = A->p[j]; p < A->p[j + 1]; ++p)
+        w[A->i[p]] += A->x[p] * dr[k];
+    }
+    break;
+  }
+  default:
+    numerics_error("fc3d_incremental_velocity_update", "unknown storage type %d", M->storageType);
+  }
+}
+
+void fc3d_incremental_velocity_free(fc3d_incremental_velocity* iv)
+{
+  free(iv);
+}
+
 
 
 int fc3d_compute_error_velocity(FrictionContactProblem* problem, double *z, double *w, double tolerance,
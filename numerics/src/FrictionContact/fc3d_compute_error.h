@@ -53,6 +53,60 @@ extern "C"
    */
   void fc3d_unitary_compute_and_add_error(double r[3] , double u[3], double mu, double * error, double * worktmp);
 
+  /** Error computation (using the normal map residual) for nc contacts,
+      same result as fc3d_unitary_compute_and_add_error called for each
+      contact, computed by blocks of contacts with vector instructions
+      \param nc number of contacts
+      \param r the reactions (3 nc)
+      \param u the local velocities (3 nc)
+      \param mu coefficients of friction (nc)
+      \param[in,out] error the squared errors are added to this value
+   */
+  void fc3d_compute_and_add_error_batch(unsigned int nc, const double* r, const double* u,
+                                        const double* mu, double* error);
+
+  /** Error computation (using the normal map residual) for friction-contact
+      3D problem, the velocity w = Mz + q being given. The local errors are
+      summed in parallel for large problems.
+      \param problem the structure which defines the friction-contact problem
+      \param z vector
+      \param w vector, equal to Mz + q
+      \param tolerance value for error computation
+      \param norm norm of a vector (problem->q) for relative error
+      \param[in,out] error value
+      \return 0 if ok
+   */
+  int fc3d_compute_error_with_velocity(FrictionContactProblem* problem, double *z , double *w, double tolerance, double norm, double * error);
+
+  /** Velocity w = Mz + q of a friction-contact 3D problem kept up to date
+      with the columns of M while the reactions of single contacts change,
+      so that the error can be computed at each iteration of a Gauss-Seidel
+      solver without a product with M. The cost of an iteration is
+      proportional to the number of contacts whose reaction has changed. */
+  typedef struct fc3d_incremental_velocity fc3d_incremental_velocity;
+
+  /** Create the incremental velocity and compute w = Mz + q
+      \param problem the structure which defines the friction-contact problem
+      \param z vector
+      \param w vector, kept equal to Mz + q by fc3d_incremental_velocity_update
+      \return a pointer to the new structure
+   */
+  fc3d_incremental_velocity* fc3d_incremental_velocity_new(FrictionContactProblem* problem, double *z, double *w);
+
+  /** Update the velocity after a change of the reaction of one contact
+      \param iv the incremental velocity
+      \param contact the contact number
+      \param old_reaction the previous reaction of the contact
+      \param reaction the new reaction of the contact
+   */
+  void fc3d_incremental_velocity_update(fc3d_incremental_velocity* iv, unsigned int contact,
+                                        const double old_reaction[3], const double reaction[3]);
+
+  /** Free the incremental velocity
+      \param iv the incremental velocity
+   */
+  void fc3d_incremental_velocity_free(fc3d_incremental_velocity* iv);
+
   /** Error computation for a friction-contact 3D problem
       \param problem the structure which defines the friction-contact problem
       \param z vector
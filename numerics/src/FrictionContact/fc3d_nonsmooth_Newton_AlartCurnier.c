@@ -199,5 +199,6 @@ void fc3d_nsn_ac_set_default(SolverOptions* options)
 #else
   options->iparam[SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER] = SICONOS_FRICTION_3D_NSN_USE_CSLUSOL;
 #endif
+  options->iparam[SICONOS_FRICTION_3D_NSN_REFACTORIZATION] = SICONOS_FRICTION_3D_NSN_REFACTORIZATION_YES;
 
 }
@@ -151,6 +151,7 @@ void fc3d_nsn_nm_set_default(SolverOptions* options)
 #else
   options->iparam[SICONOS_FRICTION_3D_NSN_LINEAR_SOLVER ] = SICONOS_FRICTION_3D_NSN_USE_CSLUSOL;
 #endif
+  options->iparam[SICONOS_FRICTION_3D_NSN_REFACTORIZATION] = SICONOS_FRICTION_3D_NSN_REFACTORIZATION_YES;
 }
 
 
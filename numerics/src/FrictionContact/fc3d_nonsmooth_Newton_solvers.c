@@ -28,6 +28,8 @@
 #include "CSparseMatrix_internal.h"                            // for CSparseMatrix_z...
 #include "FrictionContactProblem.h"                   // for FrictionContact...
 #include "Friction_cst.h"                             // for SICONOS_FRICTIO...
+#include "NM_MPI.h"                                   // for NM_MPI_copy
+#include "NM_MUMPS.h"                                 // for NM_MUMPS_copy
 #include "NumericsMatrix.h"                           // for NumericsMatrix
 #include "NumericsSparseMatrix.h"                     // for NSM_linearSolve...
 #include "SolverOptions.h"                            // for SolverOptions
@@ -153,8 +155,8 @@ static void computeSparseBlockAWpB(
       cpy3x3(tmp, result->block[blockn]);
     }
   }
-  /* Invalidation of sparse storage, if any. */
-  NM_clearSparseStorage(AWpB);
+  /* the sparse storage, if any, is updated on next access */
+  NM_inc_version(AWpB, NM_SPARSE_BLOCK);
 }
 
 static void computeSparseAWpB(
@@ -220,6 +222,131 @@ void computeAWpB(
   }
 }
 
+static int compare_CS_INT(const void* a, const void* b)
+{
+  CS_INT ia = *(const CS_INT*)a, ib = *(const CS_INT*)b;
+  return (ia > ib) - (ia < ib);
+}
+
+/* The Newton matrix of the reuse mode (SICONOS_FRICTION_3D_NSN_REFACTORIZATION)
+ * has a fixed pattern: the 3x3 blocks (I, J) such that W has an entry in
+ * the block, plus the diagonal blocks, are stored as full blocks in a csc
+ * matrix. In the column c, the rows of a block are contiguous, so that for
+ * each entry of csc(W) in the block row I, W_pos keeps the position of the
+ * entry (3I, c) of AWpB and diag_pos[c] the one of (3(c/3), c). The values
+ * are then overwritten in place at each iteration. */
+static NumericsMatrix* AWpBPattern(NumericsMatrix* W, CS_INT** W_pos, CS_INT** diag_pos)
+{
+  CSparseMatrix* Wc = NM_csc(W);
+  CS_INT n = Wc->n;
+  CS_INT nb = n / 3;
+  assert(n % 3 == 0);
+
+  CS_INT* mark = (CS_INT*)malloc(nb * sizeof(CS_INT));
+  CS_INT* blocks = (CS_INT*)malloc(nb * sizeof(CS_INT));
+  CS_INT* block_pos = (CS_INT*)malloc(nb * sizeof(CS_INT));
+  for(CS_INT I = 0; I < nb; ++I) mark[I] = -1;
+
+  /* number of entries */
+  CS_INT nz = 0;
+  for(CS_INT c = 0; c < n; ++c)
+  {
+    mark[c / 3] = c;
+    nz += 3;
+    for(CS_INT k = Wc->p[c]; k < Wc->p[c + 1]; ++k)
+    {
+      CS_INT I = Wc->i[k] / 3;
+      if(mark[I] != c)
+      {
+        mark[I] = c;
+        nz += 3;
+      }
+    }
+  }
+
+  NumericsMatrix* AWpB = NM_create(NM_SPARSE, n, n);
+  NM_csc_alloc(AWpB, nz);
+  AWpB->matrix2->origin = NSM_CSC;
+  CSparseMatrix* C = AWpB->matrix2->csc;
+  *W_pos = (CS_INT*)malloc(Wc->p[n] * sizeof(CS_INT));
+  *diag_pos = (CS_INT*)malloc(n * sizeof(CS_INT));
+
+  for(CS_INT I = 0; I < nb; ++I) mark[I] = -1;
+  CS_INT pos = 0;
+  for(CS_INT c = 0; c < n; ++c)
+  {
+    CS_INT nblocks = 0;
+    mark[c / 3] = c;
+    blocks[nblocks++] = c / 3;
+    for(CS_INT k = Wc->p[c]; k < Wc->p[c + 1]; ++k)
+    {
+      CS_INT I = Wc->i[k] / 3;
+      if(mark[I] != c)
+      {
+        mark[I] = c;
+        blocks[nblocks++] = I;
+      }
+    }
+    qsort(blocks, nblocks, sizeof(CS_INT), compare_CS_INT);
+
+    C->p[c] = pos;
+    for(CS_INT b = 0; b < nblocks; ++b)
+    {
+      block_pos[blocks[b]] = pos;
+      for(CS_INT a = 0; a < 3; ++a, ++pos)
+      {
+        C->i[pos] = 3 * blocks[b] + a;
+        C->x[pos] = 0.;
+      }
+    }
+    for(CS_INT k = Wc->p[c]; k < Wc->p[c + 1]; ++k)
+      (*W_pos)[k] = block_pos[Wc->i[k] / 3];
+    (*diag_pos)[c] = block_pos[c / 3];
+  }
+  C->p[n] = pos;
+  assert(pos == nz);
+
+  free(mark);
+  free(blocks);
+  free(block_pos);
+  return AWpB;
+}
+
+/* AWpB = A W + B for the pattern of AWpBPattern. A and B are stored as
+ * 3x3 column major blocks: the entry (3I+a, c) receives
+ * sum_l A_I(a, l) W(3I+l, c), plus B_I(a, c - 3I) on the diagonal blocks. */
+static void AWpBUpdate(double *A, NumericsMatrix *W, double *B, NumericsMatrix *AWpB,
+                       const CS_INT * const W_pos, const CS_INT * const diag_pos)
+{
+  CSparseMatrix* Wc = NM_csc(W);
+  CSparseMatrix* C = NM_csc(AWpB);
+  CS_INT n = Wc->n;
+  double* x = C->x;
+  /* the cached transpose is built from the previous values */
+  NM_clearCSCTranspose(AWpB);
+
+  for(CS_INT k = 0; k < C->p[n]; ++k) x[k] = 0.;
+
+  for(CS_INT c = 0; c < n; ++c)
+  {
+    double* Bi = B + 9 * (c / 3) + 3 * (c % 3);
+    double* xd = x + diag_pos[c];
+    xd[0] += Bi[0];
+    xd[1] += Bi[1];
+    xd[2] += Bi[2];
+    for(CS_INT k = Wc->p[c]; k < Wc->p[c + 1]; ++k)
+    {
+      CS_INT r = Wc->i[k];
+      double* Ai = A + 9 * (r / 3) + 3 * (r % 3);
+      double v = Wc->x[k];
+      double* xk = x + W_pos[k];
+      xk[0] += Ai[0] * v;
+      xk[1] += Ai[1] * v;
+      xk[2] += Ai[2] * v;
+    }
+  }
+}
+
 int globalLineSearchGP(
   fc3d_nonsmooth_Newton_solvers* equation,
   double *reaction,
@@ -683,6 +810,26 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
 
   double linear_solver_residual=0.0;
 
+  /* reuse of the pattern and of the symbolic factorization of the Newton
+   * matrix, for the sparse storages */
+  int reuse_factorization = problem->M->storageType != NM_DENSE &&
+                            options->iparam[SICONOS_FRICTION_3D_NSN_REFACTORIZATION] ==
+                            SICONOS_FRICTION_3D_NSN_REFACTORIZATION_YES;
+  NumericsMatrix *J = AWpB;
+  NumericsMatrix *AWpB_reuse = NULL;
+  CS_INT *W_pos = NULL, *diag_pos = NULL;
+  if(reuse_factorization)
+  {
+    AWpB_reuse = AWpBPattern(problem->M, &W_pos, &diag_pos);
+    /* same linear solver settings as AWpB, as NM_copy does above */
+    NSM_linearSolverParams(AWpB_reuse)->solver = NSM_linearSolverParams(AWpB)->solver;
+    NSM_linearSolverParams(AWpB_reuse)->LDLT_solver = NSM_linearSolverParams(AWpB)->LDLT_solver;
+    NM_internalData_copy(AWpB, AWpB_reuse);
+    NM_MPI_copy(AWpB, AWpB_reuse);
+    NM_MUMPS_copy(AWpB, AWpB_reuse);
+    J = AWpB_reuse;
+  }
+
   while(iter++ < itermax)
   {
 
@@ -691,19 +838,31 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
                        reaction, velocity, equation->problem->mu,
                        rho,
                        F, Ax, Bx);
-    // AW + B
-    computeAWpB(Ax, problem->M, Bx, AWpB);
-
     cblas_dcopy_msan(problemSize, F, 1, tmp1, 1);
     cblas_dscal(problemSize, -1., tmp1, 1);
 
-    /* Solve: AWpB X = -F */
+    int lsi;
+    if(reuse_factorization)
+    {
+      /* AW + B, only the values change */
+      AWpBUpdate(Ax, problem->M, Bx, J, W_pos, diag_pos);
+      lsi = NM_LU_refactorize(J);
+      if(!lsi)
+        lsi = NM_LU_solve(J, tmp1, 1);
+    }
+    else
+    {
+      // AW + B
+      computeAWpB(Ax, problem->M, Bx, AWpB);
+
+      /* Solve: AWpB X = -F */
 //    NM_copy(AWpB, AWpB_backup);
-    // int lsi = NM_gesv(AWpB, tmp1, true);
-    NM_unpreserve(AWpB);
-    NM_preserve(AWpB);
-    NM_set_LU_factorized(AWpB, false);
-    int lsi = NM_LU_solve(AWpB, tmp1, 1);
+      // int lsi = NM_gesv(AWpB, tmp1, true);
+      NM_unpreserve(AWpB);
+      NM_preserve(AWpB);
+      NM_set_LU_factorized(AWpB, false);
+      lsi = NM_LU_solve(AWpB, tmp1, 1);
+    }
 
     /* NM_copy needed here */
 //    NM_copy(AWpB_backup, AWpB);
@@ -720,7 +879,7 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
     if(verbose > 0)
     {
       cblas_dcopy_msan(problemSize, F, 1, tmp3, 1);
-      NM_gemv(1., AWpB, tmp1, 1., tmp3);
+      NM_gemv(1., J, tmp1, 1., tmp3);
       linear_solver_residual = cblas_dnrm2(problemSize, tmp3, 1);
       /* fprintf(stderr, "fc3d esolve: linear equation residual = %g\n", */
       /*         cblas_dnrm2(problemSize, tmp3, 1)); */
@@ -742,12 +901,12 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
 
     case SICONOS_FRICTION_3D_NSN_LINESEARCH_GOLDSTEINPRICE:
       /* Goldstein Price */
-      info_ls = globalLineSearchGP(equation, reaction, velocity, problem->mu, rho, F, Ax, Bx, problem->M, problem->q, AWpB, tmp1, tmp2, &alpha, options->iparam[12]);
+      info_ls = globalLineSearchGP(equation, reaction, velocity, problem->mu, rho, F, Ax, Bx, problem->M, problem->q, J, tmp1, tmp2, &alpha, options->iparam[12]);
       break;
     case SICONOS_FRICTION_3D_NSN_LINESEARCH_ARMIJO:
       /* FBLSA */
       info_ls = frictionContactFBLSA(equation, reaction, velocity, problem->mu, rho, F, Ax, Bx,
-                                     problem->M, problem->q, AWpB, tmp1, tmp2, &alpha, options->iparam[12]);
+                                     problem->M, problem->q, J, tmp1, tmp2, &alpha, options->iparam[12]);
       break;
     default:
     {
@@ -838,6 +997,14 @@ void fc3d_nonsmooth_Newton_solvers_solve(fc3d_nonsmooth_Newton_solvers* equation
   }
   frictionContactProblem_free(localproblem);
 
+  if(AWpB_reuse)
+  {
+    NM_clear(AWpB_reuse);
+    free(AWpB_reuse);
+    free(W_pos);
+    free(diag_pos);
+  }
+
   if(!options->dWork)
   {
     assert(buffer);
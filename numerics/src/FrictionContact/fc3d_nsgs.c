@@ -21,11 +21,14 @@
 #include <stdio.h>                                     // for fclose, fopen
 #include <stdlib.h>                                    // for calloc, malloc
 #include <string.h>                                    // for NULL, memcpy
+#include "CSparseMatrix_internal.h"                    // for CSparseMatrix
 #include "FrictionContactProblem.h"                    // for FrictionContac...
 #include "Friction_cst.h"                              // for SICONOS_FRICTI...
 #include "NumericsArrays.h"                            // for uint_shuffle
 #include "NumericsFwd.h"                               // for SolverOptions
+#include "NumericsMatrix.h"                            // for NumericsMatrix
 #include "SolverOptions.h"                             // for SolverOptions
+#include "SparseBlockMatrix.h"                         // for SparseBlockStr...
 #include "fc3d_2NCP_Glocker.h"                         // for NCPGlocker_update
 #include "fc3d_NCPGlockerFixedPoint.h"                 // for fc3d_FixedP_in...
 #include "fc3d_Path.h"                                 // for fc3d_Path_init...
@@ -41,6 +44,9 @@
 /* #define DEBUG_MESSAGES */
 #include "siconos_debug.h"                                     // for DEBUG_EXPR
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 //#define FCLIB_OUTPUT
 
@@ -444,6 +450,22 @@ double calculateFullErrorAdaptiveInterval(FrictionContactProblem *problem,
   return error;
 }
 
+/* Full error with the velocity updated during the sweep. The velocity is
+ * recomputed from the reactions when the convergence is detected, so that
+ * the rounding errors of the updates cannot stop the iterations too early. */
+static
+double calculateFullErrorIncremental(FrictionContactProblem *problem,
+                                     ComputeErrorPtr computeError,
+                                     SolverOptions *options,
+                                     double *reaction, double *velocity,
+                                     double tolerance, double norm_q)
+{
+  double error=1e+24;
+  if(!fc3d_compute_error_with_velocity(problem, reaction, velocity, tolerance, norm_q, &error))
+    (*computeError)(problem, reaction, velocity, tolerance, options, norm_q, &error);
+  return error;
+}
+
 
 
 static
@@ -559,6 +581,311 @@ void statsIterationCallback(FrictionContactProblem *problem,
   }
 }
 
+/* Coloring of the contacts for the parallel sweep.
+ * Contacts with the same color are not coupled through M and can be
+ * updated simultaneously. contacts are stored color by color:
+ * contacts[color_ptr[c]] ... contacts[color_ptr[c+1]-1] have the color c.
+ */
+typedef struct
+{
+  unsigned int number_of_colors;
+  unsigned int * color_ptr;
+  unsigned int * contacts;
+} fc3d_nsgs_coloring;
+
+/* Adjacency (csr-like) of the coupling graph between contacts, given by the
+ * off-diagonal blocks of M. An edge may be stored twice, which is
+ * harmless for the coloring. Return 1 if the graph cannot be computed for the
+ * storage of M. */
+static
+int fc3d_nsgs_coupling_graph(FrictionContactProblem *problem,
+                             unsigned int ** adj_ptr, unsigned int ** adj)
+{
+  unsigned int nc = problem->numberOfContacts;
+  NumericsMatrix * M = problem->M;
+  unsigned int * ptr = (unsigned int *) calloc(nc + 1, sizeof(unsigned int));
+
+  if(M->storageType == NM_SPARSE_BLOCK)
+  {
+    SparseBlockStructuredMatrix * B = M->matrix1;
+    for(size_t row = 0; row < B->filled1 - 1; ++row)
+    {
+      for(size_t blk = B->index1_data[row]; blk < B->index1_data[row+1]; ++blk)
+      {
+        size_t col = B->index2_data[blk];
+        if(col != row)
+        {
+          ptr[row+1]++;
+          ptr[col+1]++;
+        }
+      }
+    }
+    for(unsigned int i = 0; i < nc; ++i)
+      ptr[i+1] += ptr[i];
+
+    unsigned int * pos = (unsigned int *) malloc(nc * sizeof(unsigned int));
+    memcpy(pos, ptr, nc * sizeof(unsigned int));
+    unsigned int * a = (unsigned int *) malloc((ptr[nc] + 1) * sizeof(unsigned int));
+    for(size_t row = 0; row < B->filled1 - 1; ++row)
+    {
+      for(size_t blk = B->index1_data[row]; blk < B->index1_data[row+1]; ++blk)
+      {
+        size_t col = B->index2_data[blk];
+        if(col != row)
+        {
+          a[pos[row]++] = (unsigned int) col;
+          a[pos[col]++] = (unsigned int) row;
+        }
+      }
+    }
+    free(pos);
+    *adj_ptr = ptr;
+    *adj = a;
+    return 0;
+  }
+  else if(M->storageType == NM_SPARSE)
+  {
+    CSparseMatrix * A = NM_csc(M);
+    for(CS_INT j = 0; j < A->n; ++j)
+    {
+      for(CS_INT p = A->p[j]; p < A->p[j+1]; ++p)
+      {
+        unsigned int row = (unsigned int)(A->i[p] / 3);
+        unsigned int col = (unsigned int)(j / 3);
+        if(col != row)
+        {
+          ptr[row+1]++;
+          ptr[col+1]++;
+        }
+      }
+    }
+    for(unsigned int i = 0; i < nc; ++i)
+      ptr[i+1] += ptr[i];
+
+    unsigned int * pos = (unsigned int *) malloc(nc * sizeof(unsigned int));
+    memcpy(pos, ptr, nc * sizeof(unsigned int));
+    unsigned int * a = (unsigned int *) malloc((ptr[nc] + 1) * sizeof(unsigned int));
+    for(CS_INT j = 0; j < A->n; ++j)
+    {
+      for(CS_INT p = A->p[j]; p < A->p[j+1]; ++p)
+      {
+        unsigned int row = (unsigned int)(A->i[p] / 3);
+        unsigned int col = (unsigned int)(j / 3);
+        if(col != row)
+        {
+          a[pos[row]++] = col;
+          a[pos[col]++] = row;
+        }
+      }
+    }
+    free(pos);
+    *adj_ptr = ptr;
+    *adj = a;
+    return 0;
+  }
+  free(ptr);
+  return 1;
+}
+
+/* Greedy (first fit) coloring of the coupling graph, contacts taken in their
+ * natural order. The result is deterministic. Return NULL if the coupling graph
+ * is not available for the storage of M. */
+static
+fc3d_nsgs_coloring * fc3d_nsgs_coloring_new(FrictionContactProblem *problem)
+{
+  unsigned int nc = problem->numberOfContacts;
+  unsigned int * adj_ptr = NULL;
+  unsigned int * adj = NULL;
+
+  if(fc3d_nsgs_coupling_graph(problem, &adj_ptr, &adj))
+    return NULL;
+
+  unsigned int * color = (unsigned int *) malloc(nc * sizeof(unsigned int));
+  /* mark[c] == i+1 means that the color c is used by a neighbour of i */
+  unsigned int * mark = (unsigned int *) calloc(nc + 1, sizeof(unsigned int));
+  unsigned int number_of_colors = 0;
+
+  for(unsigned int i = 0; i < nc; ++i)
+  {
+    for(unsigned int p = adj_ptr[i]; p < adj_ptr[i+1]; ++p)
+    {
+      unsigned int j = adj[p];
+      if(j < i)
+        mark[color[j]] = i + 1;
+    }
+    unsigned int c = 0;
+    while(mark[c] == i + 1) c++;
+    color[i] = c;
+    if(c + 1 > number_of_colors)
+      number_of_colors = c + 1;
+  }
+
+  fc3d_nsgs_coloring * coloring = (fc3d_nsgs_coloring *) malloc(sizeof(fc3d_nsgs_coloring));
+  coloring->number_of_colors = number_of_colors;
+  coloring->color_ptr = (unsigned int *) calloc(number_of_colors + 1, sizeof(unsigned int));
+  coloring->contacts = (unsigned int *) malloc(nc * sizeof(unsigned int));
+
+  for(unsigned int i = 0; i < nc; ++i)
+    coloring->color_ptr[color[i]+1]++;
+  for(unsigned int c = 0; c < number_of_colors; ++c)
+    coloring->color_ptr[c+1] += coloring->color_ptr[c];
+  memcpy(mark, coloring->color_ptr, number_of_colors * sizeof(unsigned int));
+  for(unsigned int i = 0; i < nc; ++i)
+    coloring->contacts[mark[color[i]]++] = i;
+
+  numerics_printf_verbose(1, "---- FC3D - NSGS - %i contacts split into %i colors",
+                          nc, number_of_colors);
+
+  free(color);
+  free(mark);
+  free(adj_ptr);
+  free(adj);
+  return coloring;
+}
+
+static
+void fc3d_nsgs_coloring_free(fc3d_nsgs_coloring * coloring)
+{
+  if(!coloring)
+    return;
+  free(coloring->color_ptr);
+  free(coloring->contacts);
+  free(coloring);
+}
+
+/* Local solvers that do not rely on a static state and whose per-contact data
+ * (if any) is stored in dWork, indexed by the contact number. */
+static
+int fc3d_nsgs_local_solver_is_reentrant(SolverOptions * localsolver_options)
+{
+  switch(localsolver_options->solverId)
+  {
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN:
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN_GP:
+  case SICONOS_FRICTION_3D_ONECONTACT_NSN_GP_HYBRID:
+  case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnCone:
+  case SICONOS_FRICTION_3D_ONECONTACT_ProjectionOnConeWithLocalIteration:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+static
+int fc3d_nsgs_max_threads(void)
+{
+#ifdef WITH_OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+static
+int fc3d_nsgs_thread_num(void)
+{
+#ifdef WITH_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+
+/* Shallow copy of the local solver options : iparam and dparam are owned by
+ * the copy, dWork is shared with the source. */
+static
+SolverOptions * fc3d_nsgs_thread_options_new(SolverOptions * source)
+{
+  SolverOptions * options = (SolverOptions *) malloc(sizeof(SolverOptions));
+  *options = *source;
+  options->iparam = (int *) malloc(source->iSize * sizeof(int));
+  options->dparam = (double *) malloc(source->dSize * sizeof(double));
+  memcpy(options->iparam, source->iparam, source->iSize * sizeof(int));
+  memcpy(options->dparam, source->dparam, source->dSize * sizeof(double));
+  return options;
+}
+
+static
+void fc3d_nsgs_thread_options_free(SolverOptions * options)
+{
+  free(options->iparam);
+  free(options->dparam);
+  free(options);
+}
+
+/* One NSGS sweep, color by color. The contacts of a color are solved in
+ * parallel, each thread working on its own local problem and local options.
+ * If iv is not NULL, the velocity is updated after each color from the
+ * previous reactions saved in old_reaction.
+ * Return the sum of the squared increments of the local reactions. */
+static
+double fc3d_nsgs_colored_sweep(UpdatePtr update_localproblem, SolverPtr local_solver,
+                               FrictionContactProblem *problem,
+                               FrictionContactProblem **localproblems,
+                               SolverOptions *localsolver_options,
+                               SolverOptions **thread_options, int nthreads,
+                               fc3d_nsgs_coloring *coloring,
+                               fc3d_incremental_velocity *iv, double *old_reaction,
+                               double *reaction, SolverOptions *options, int iter)
+{
+  int* iparam = options->iparam;
+  double omega = options->dparam[SICONOS_FRICTION_3D_NSGS_RELAXATION_VALUE];
+  double light_error_sum = 0.0;
+
+  /* the tolerance of the local solver may have been changed */
+  for(int t = 0; t < nthreads; ++t)
+  {
+    memcpy(thread_options[t]->iparam, localsolver_options->iparam, localsolver_options->iSize * sizeof(int));
+    memcpy(thread_options[t]->dparam, localsolver_options->dparam, localsolver_options->dSize * sizeof(double));
+  }
+
+  for(unsigned int c = 0; c < coloring->number_of_colors; ++c)
+  {
+    int start = (int) coloring->color_ptr[c];
+    int end = (int) coloring->color_ptr[c+1];
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) reduction(+:light_error_sum)
+#endif
+    for(int k = start; k < end; ++k)
+    {
+      int tid = fc3d_nsgs_thread_num();
+      unsigned int contact = coloring->contacts[k];
+      double localreaction[3];
+
+      if(iv)
+        memcpy(&old_reaction[contact*3], &reaction[contact*3], 3 * sizeof(double));
+
+      solveLocalReaction(update_localproblem, local_solver, contact,
+                         problem, localproblems[tid], reaction, thread_options[tid],
+                         localreaction);
+
+      if(iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] == SICONOS_FRICTION_3D_NSGS_RELAXATION_TRUE)
+        performRelaxation(localreaction, &reaction[contact*3], omega);
+
+      light_error_sum += light_error_squared(localreaction, &reaction[contact*3]);
+
+      if(iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] == SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE)
+        acceptLocalReactionFiltered(localproblems[tid], thread_options[tid],
+                                    contact, iter, reaction, localreaction);
+      else
+        acceptLocalReactionUnconditionally(contact, reaction, localreaction);
+    }
+
+    /* the velocities of the contacts of the next colors are changed: the
+     * updates are done serially */
+    if(iv)
+    {
+      for(int k = start; k < end; ++k)
+      {
+        unsigned int contact = coloring->contacts[k];
+        fc3d_incremental_velocity_update(iv, contact, &old_reaction[contact*3],
+                                         &reaction[contact*3]);
+      }
+    }
+  }
+  return light_error_sum;
+}
+
 
 
 
@@ -596,6 +923,7 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
 
   FrictionContactProblem* localproblem;
   double localreaction[3];
+  double oldreaction[3];
 
   /*****  NSGS Iterations *****/
   int iter = 0; /* Current iteration number */
@@ -633,22 +961,139 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
   if(!(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL
        || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL
        || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT
-       || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE))
+       || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE
+       || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_INCREMENTAL))
   {
     numerics_error(
       "fc3d_nsgs", "iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] must be equal to "
       "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL (0), "
-      "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL (1), "
-      "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT (2) or "
-      "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE (3)");
+      "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT (1), "
+      "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL (2), "
+      "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_ADAPTIVE (3) or "
+      "SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_INCREMENTAL (4)");
     return;
   }
 
+  /* The incremental update of the velocity gives the error of fc3d_compute_error
+   * only. Otherwise, the error is evaluated as with SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL */
+  fc3d_incremental_velocity * iv = NULL;
+  if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_INCREMENTAL)
+  {
+    if(computeError == (ComputeErrorPtr)&fc3d_compute_error)
+      iv = fc3d_incremental_velocity_new(problem, reaction, velocity);
+    else
+      numerics_warning("fc3d_nsgs", "the incremental error evaluation is not available for "
+                       "the internal solver %s. We use the full evaluation.",
+                       solver_options_id_to_name(localsolver_options->solverId));
+  }
+
+  fc3d_nsgs_coloring * coloring = NULL;
+  if(iparam[SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY] == SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_COLORING)
+  {
+    if(!fc3d_nsgs_local_solver_is_reentrant(localsolver_options))
+    {
+      numerics_warning("fc3d_nsgs", "the internal solver %s cannot be used in a parallel sweep. "
+                       "We use the serial sweep.", solver_options_id_to_name(localsolver_options->solverId));
+    }
+    else
+    {
+      coloring = fc3d_nsgs_coloring_new(problem);
+      if(!coloring)
+        numerics_warning("fc3d_nsgs", "the coloring of contacts is only available for "
+                         "NM_SPARSE_BLOCK and NM_SPARSE storage. We use the serial sweep.");
+    }
+    if(coloring && (iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] != SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE
+                    || iparam[SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT] > 0))
+      numerics_warning("fc3d_nsgs", "shuffle and freezing of contacts are ignored in the colored sweep.");
+  }
+
   /*****  NSGS Iterations *****/
 
+  /* Parallel sweep over colors of independent contacts */
+  if(coloring)
+  {
+    int nthreads = fc3d_nsgs_max_threads();
+    FrictionContactProblem ** localproblems =
+      (FrictionContactProblem **) malloc(nthreads * sizeof(FrictionContactProblem *));
+    SolverOptions ** thread_options = (SolverOptions **) malloc(nthreads * sizeof(SolverOptions *));
+    double * old_reactions = iv ? (double *) malloc(3 * nc * sizeof(double)) : NULL;
+    for(int t = 0; t < nthreads; ++t)
+    {
+      localproblems[t] = fc3d_local_problem_allocate(problem);
+      thread_options[t] = fc3d_nsgs_thread_options_new(localsolver_options);
+    }
+
+    /* lazy computations on M are done before entering parallel regions */
+    if(problem->M->storageType == NM_SPARSE_BLOCK)
+      SBM_diagonal_block_indices(problem->M->matrix1);
+    else if(problem->M->storageType == NM_SPARSE)
+    {
+      if(problem->M->matrix2->origin == NSM_CSR)
+        NM_csr(problem->M);
+      else
+        NM_csc_trans(problem->M);
+    }
+
+    while((iter < itermax) && (hasNotConverged > 0))
+    {
+      ++iter;
+      fc3d_set_internalsolver_tolerance(problem, options, localsolver_options, error);
+
+      double light_error_sum = fc3d_nsgs_colored_sweep(update_localproblem, local_solver,
+                               problem, localproblems,
+                               localsolver_options, thread_options, nthreads,
+                               coloring, iv, old_reactions, reaction, options, iter);
+
+      if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT)
+      {
+        error = calculateLightError(light_error_sum, nc, reaction, norm_r);
+        hasNotConverged = determine_convergence(error, tolerance, iter, options);
+      }
+      else if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT_WITH_FULL_FINAL)
+      {
+        error = calculateLightError(light_error_sum, nc, reaction, norm_r);
+        hasNotConverged = determine_convergence_with_full_final(problem,  options, computeError,
+                          reaction, velocity,
+                          &tolerance, norm_q, error,
+                          iter);
+        if(!(tolerance > 0.0))
+        {
+          numerics_warning("fc3d_nsgs", "tolerance has to be positive!!");
+          numerics_warning("fc3d_nsgs", "we stop the iterations");
+          break;
+        }
+      }
+      else if(iv)
+      {
+        error = calculateFullErrorIncremental(problem, computeError, options,
+                                              reaction, velocity, tolerance, norm_q);
+        hasNotConverged = determine_convergence(error, tolerance, iter, options);
+      }
+      else
+      {
+        error = calculateFullErrorAdaptiveInterval(problem, computeError, options,
+                iter, reaction, velocity,
+                tolerance, norm_q);
+        hasNotConverged = determine_convergence(error, tolerance, iter, options);
+      }
+
+      statsIterationCallback(problem, options, reaction, velocity, error);
+    }
+
+    for(int t = 0; t < nthreads; ++t)
+    {
+      fc3d_local_problem_free(localproblems[t], problem);
+      fc3d_nsgs_thread_options_free(thread_options[t]);
+    }
+    free(localproblems);
+    free(thread_options);
+    free(old_reactions);
+    fc3d_nsgs_coloring_free(coloring);
+  }
+
   /* A special case for the most common options (should correspond
    * with mechanics_run.py **/
-  if(iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE
+  else if(iparam[SICONOS_FRICTION_3D_NSGS_SHUFFLE] == SICONOS_FRICTION_3D_NSGS_SHUFFLE_FALSE
      && iparam[SICONOS_FRICTION_3D_NSGS_FREEZING_CONTACT] == 0
       && iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] == SICONOS_FRICTION_3D_NSGS_RELAXATION_FALSE
       && iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] == SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_TRUE
@@ -720,6 +1165,8 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
           }
         }
 
+        if(iv)
+          memcpy(oldreaction, &reaction[contact*3], 3 * sizeof(double));
 
         solveLocalReaction(update_localproblem, local_solver, contact,
                            problem, localproblem, reaction, localsolver_options,
@@ -764,7 +1211,8 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
         else
           acceptLocalReactionUnconditionally(contact, reaction, localreaction);
 
-
+        if(iv)
+          fc3d_incremental_velocity_update(iv, contact, oldreaction, &reaction[contact*3]);
 
       }
 
@@ -789,7 +1237,14 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
         }
 
       }
-      else if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL)
+      else if(iv)
+      {
+        error = calculateFullErrorIncremental(problem, computeError, options,
+                                              reaction, velocity, tolerance, norm_q);
+        hasNotConverged = determine_convergence(error, tolerance, iter, options);
+      }
+      else if(iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL
+              || iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] == SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_INCREMENTAL)
       {
         error = calculateFullErrorAdaptiveInterval(problem, computeError, options,
                 iter, reaction, velocity,
@@ -826,6 +1281,15 @@ void fc3d_nsgs(FrictionContactProblem* problem, double *reaction,
 
   }
 
+  if(iv)
+  {
+    /* the velocity is computed again from the reactions if the iterations
+     * stopped before the convergence */
+    if(hasNotConverged)
+      (*computeError)(problem, reaction, velocity, tolerance, options, norm_q, &error);
+    fc3d_incremental_velocity_free(iv);
+  }
+
   *info = hasNotConverged;
 
 
@@ -853,6 +1317,7 @@ void fc3d_nsgs_set_default(SolverOptions* options)
   options->iparam[SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION] = SICONOS_FRICTION_3D_NSGS_FILTER_LOCAL_SOLUTION_FALSE;
   options->iparam[SICONOS_FRICTION_3D_NSGS_RELAXATION] = SICONOS_FRICTION_3D_NSGS_RELAXATION_FALSE;
   options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION_FREQUENCY] = 0;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY] = SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_SERIAL;
   options->dparam[SICONOS_DPARAM_TOL] = 1e-4;
   options->dparam[SICONOS_FRICTION_3D_DPARAM_INTERNAL_ERROR_RATIO] = 10.0;
   // Internal solver
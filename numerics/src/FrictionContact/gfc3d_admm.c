@@ -29,7 +29,7 @@
 #include "gfc3d_Solvers.h"                 // for gfc3d_checkTrivialCaseGlobal
 #include "gfc3d_compute_error.h"           // for gfc3d_compute_error
 #include "numerics_verbose.h"              // for numerics_printf_verbose
-#include "projectionOnCone.h"              // for projectionOnDualCone
+#include "projectionOnCone.h"              // for projectionOnDualCone_batch
 #include "SiconosBlas.h"                         // for cblas_dcopy, cblas_dscal
 #include "NumericsSparseMatrix.h"                // for NSM_TRIPLET ...
 #include "gfc3d_balancing.h"
@@ -150,7 +150,7 @@ static double gfc3d_admm_select_rho(NumericsMatrix* M, NumericsMatrix* H, int *
            SICONOS_FRICTION_3D_ADMM_INITIAL_RHO_EIGENVALUES)
   {
     double lambda_max =  NM_iterated_power_method(M, 1e-08, 100);
-    double lambda_min =  1.0/NM_iterated_power_method(NM_LU_inv(M), 1e-08, 100);
+    double lambda_min =  NM_iterated_inverse_power_method(M, 1e-08, 100);
 
     numerics_printf_verbose(1,"---- GFC3D - ADMM - largest eigenvalue of M = %g ",lambda_max);
     numerics_printf_verbose(1,"---- GFC3D - ADMM - smallest eigenvalue of M = %g ",lambda_min);
@@ -286,7 +286,7 @@ static void gfc3d_print_problem_info(GlobalFrictionContactProblem* restrict prob
     numerics_printf_verbose(1,"---- GFC3D - ADMM - 1-norm of M = %g norm of q = %g ", NM_norm_1(M), norm_q);
     numerics_printf_verbose(1,"---- GFC3D - ADMM - inf-norm of M = %g ", NM_norm_inf(M));
     double eig_max = NM_iterated_power_method(M, 1e-08, 100);
-    double eig_min =  1./NM_iterated_power_method(NM_LU_inv(M), 1e-08, 100);
+    double eig_min =  NM_iterated_inverse_power_method(M, 1e-08, 100);
     numerics_printf_verbose(1,"---- GFC3D - ADMM - largest eigenvalue of M = %g ", eig_max);
     numerics_printf_verbose(1,"---- GFC3D - ADMM - smallest eigenvalue of M = %g ", eig_min);
     numerics_printf_verbose(1,"---- GFC3D - ADMM - conditioning of M = %g ", eig_max/eig_min);
@@ -721,11 +721,7 @@ void gfc3d_ADMM(GlobalFrictionContactProblem* restrict problem_original, double*
     DEBUG_EXPR(NV_display(u,m));
 
     /* projection. loop through the contact points */
-    for(size_t contact = 0 ; contact < nc ; ++contact)
-    {
-      int pos = contact * 3;
-      projectionOnDualCone(&u[pos], mu[contact]);
-    }
+    projectionOnDualCone_batch(nc, u, mu);
 
     double norm_u =  cblas_dnrm2(m, u, 1);
     DEBUG_EXPR(NV_display(u,m));
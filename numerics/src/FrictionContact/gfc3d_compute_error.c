@@ -119,12 +119,7 @@ int gfc3d_compute_error(GlobalFrictionContactProblem* problem,
   double norm_u = cblas_dnrm2(m,velocity,1);
   DEBUG_PRINTF("norm of velocity %e\n", norm_u);
 
-  double worktmp[3];
-  for(int ic = 0 ; ic < nc ; ic++)
-  {
-    fc3d_unitary_compute_and_add_error(&reaction[ic * 3], &velocity[ic * 3], mu[ic],
-                                       &error_complementarity,  worktmp);
-  }
+  fc3d_compute_and_add_error_batch(nc, reaction, velocity, mu, &error_complementarity);
 
   error_complementarity = sqrt(error_complementarity);
 
@@ -377,6 +377,109 @@ static void setErrorArray(double * error, const double pinfeas, const double din
 
 
 
+/* The Jacobian of the reuse mode (SICONOS_FRICTION_3D_IPM_IPARAM_REFACTORIZATION)
+ * has a fixed pattern: the blocks of the cone variables, Arw(r) or Q(p^2)
+ * in columns m..m+nd and Arw(u) or I in columns m+nd..m+2nd, are stored as
+ * full d x d blocks at the beginning of the triplet, so that their values
+ * are overwritten in place (in the triplet and the csc storage) at each
+ * iteration. */
+static NumericsMatrix* JacobianPattern(NumericsMatrix* M, NumericsMatrix* minus_H,
+                                       const unsigned int m, const unsigned int nd,
+                                       const unsigned int n, const unsigned int d,
+                                       const long H_nzmax, CS_INT** cone_pos)
+{
+  NumericsMatrix* J = NM_create(NM_SPARSE, m + nd + nd, m + nd + nd);
+  size_t cone_nz = 2 * n * d * d;
+  size_t J_nzmax = (d * d) * (m / d) + 2 * H_nzmax + cone_nz + nd;
+  NM_triplet_alloc(J, J_nzmax);
+  J->matrix2->origin = NSM_TRIPLET;
+
+  for(unsigned int offset = m; offset <= m + nd; offset += nd)
+    for(unsigned int i = 0; i < n; ++i)
+      for(unsigned int a = 0; a < d; ++a)
+        for(unsigned int b = 0; b < d; ++b)
+          NM_entry(J, m + i * d + a, offset + i * d + b, 0.);
+
+  NumericsMatrix* minus_HT = NM_transpose(minus_H);
+  NumericsMatrix* eye = NM_eye(nd);
+  NM_insert(J, M, 0, 0);
+  NM_insert(J, minus_HT, 0, m + nd);
+  NM_insert(J, minus_H, m + nd, 0);
+  NM_insert(J, eye, m + nd, m);
+  NM_clear(minus_HT);
+  free(minus_HT);
+  NM_clear(eye);
+  free(eye);
+
+  /* position in the csc storage of the entries of the cone blocks */
+  CSparseMatrix* T = NM_triplet(J);
+  CSparseMatrix* C = NM_csc(J);
+  *cone_pos = (CS_INT*)malloc(cone_nz * sizeof(CS_INT));
+  for(size_t k = 0; k < cone_nz; ++k)
+  {
+    CS_INT col = T->p[k];
+    CS_INT pos = C->p[col];
+    while(C->i[pos] != T->i[k]) pos++;
+    assert(pos < C->p[col + 1]);
+    (*cone_pos)[k] = pos;
+  }
+  return J;
+}
+
+/* value of the entry (a, b) of Arw(x) for the cone variable x */
+static inline double ArrowEntry(const double * const x, const unsigned int a, const unsigned int b)
+{
+  if(a == 0) return x[b];
+  if(b == 0) return x[a];
+  return (a == b) ? x[0] : 0.;
+}
+
+/* value of the entry (a, b) of Q(x) = 2 x x^T - det(x) R for the cone
+ * variable x, as in Quad_repr */
+static inline double QuadEntry(const double * const x, const double det,
+                               const unsigned int a, const unsigned int b)
+{
+  double value = 2. * x[a] * x[b];
+  if(a == b)
+    value -= (a == 0) ? det : -det;
+  return value;
+}
+
+static void JacobianUpdate(NumericsMatrix* J, const CS_INT * const cone_pos,
+                           const double * const reaction, const double * const velocity,
+                           const double * const p2, const unsigned int nd,
+                           const unsigned int n, const unsigned int d, const int NT_scaling)
+{
+  double* Tx = NM_triplet(J)->x;
+  double* Cx = NM_csc(J)->x;
+  /* the cached transpose is built from the previous values */
+  NM_clearCSCTranspose(J);
+  size_t k = 0;
+
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    const double * const r = reaction + i * d;
+    const double * const x = p2 + i * d;
+    double det = NT_scaling ? x[0] * x[0] - cblas_ddot(d - 1, x + 1, 1, x + 1, 1) : 0.;
+    for(unsigned int a = 0; a < d; ++a)
+      for(unsigned int b = 0; b < d; ++b, ++k)
+      {
+        Tx[k] = NT_scaling ? QuadEntry(x, det, a, b) : ArrowEntry(r, a, b);
+        Cx[cone_pos[k]] = Tx[k];
+      }
+  }
+  for(unsigned int i = 0; i < n; ++i)
+  {
+    const double * const u = velocity + i * d;
+    for(unsigned int a = 0; a < d; ++a)
+      for(unsigned int b = 0; b < d; ++b, ++k)
+      {
+        Tx[k] = NT_scaling ? (double)(a == b) : ArrowEntry(u, a, b);
+        Cx[cone_pos[k]] = Tx[k];
+      }
+  }
+}
+
 /* --------------------------- Interior-point method implementation ------------------------------ */
 /*
  * Implementation contains the following functions:
@@ -647,7 +750,11 @@ void gfc3d_IPM(GlobalFrictionContactProblem* restrict problem, double* restrict
   double *dvdr_jprod = data->tmp_vault_nd[7];
 
 
-  NumericsMatrix *J;
+  NumericsMatrix *J = NULL;
+  CS_INT *J_cone_pos = NULL;
+  int reuse_factorization = options->iparam[SICONOS_FRICTION_3D_IPM_IPARAM_REFACTORIZATION] ==
+                            SICONOS_FRICTION_3D_IPM_REFACTORIZATION_YES;
+  int NT_scaling = options->iparam[SICONOS_FRICTION_3D_IPM_IPARAM_NESTEROV_TODD_SCALING];
   long H_nzmax, J_nzmax;
   H_nzmax = NM_triplet(H)->nzmax;
   free(H->matrix2->triplet);
@@ -707,8 +814,23 @@ void gfc3d_IPM(GlobalFrictionContactProblem* restrict problem, double* restrict
     {
       NesterovToddVector(velocity, reaction, nd, n, p);
       JA_power2(p, nd, n, p2);
+      if(Qp)
+      {
+        NM_clear(Qp);
+        free(Qp);
+        NM_clear(Qpinv);
+        free(Qpinv);
+      }
       Qp = Quad_repr(p, nd, n);
-      Qp2 = Quad_repr(p2, nd, n);
+      if(!reuse_factorization)
+      {
+        if(Qp2)
+        {
+          NM_clear(Qp2);
+          free(Qp2);
+        }
+        Qp2 = Quad_repr(p2, nd, n);
+      }
       JA_inv(p, nd, n, pinv);
       Qpinv = Quad_repr(pinv, nd, n);
     }
@@ -740,26 +862,38 @@ void gfc3d_IPM(GlobalFrictionContactProblem* restrict problem, double* restrict
      *
      */
 
-    J = NM_create(NM_SPARSE, m + nd + nd, m + nd + nd);
-    J_nzmax = (d * d) * (m / d) + H_nzmax + 2 * (d * 3 - 2) * n + H_nzmax + nd;
-    NM_triplet_alloc(J, J_nzmax);
-    J->matrix2->origin = NSM_TRIPLET;
-
-
-    NM_insert(J, M, 0, 0);
-    NM_insert(J, NM_transpose(minus_H), 0, m + nd);
-    if(!options->iparam[SICONOS_FRICTION_3D_IPM_IPARAM_NESTEROV_TODD_SCALING])
+    if(reuse_factorization)
     {
-      NM_insert(J, Arrow_repr(reaction, nd, n), m, m);
-      NM_insert(J, Arrow_repr(velocity, nd, n), m, m + nd);
+      /* the pattern and its symbolic analysis are built once, then
+       * only the values of the cone blocks change */
+      if(!J)
+        J = JacobianPattern(M, minus_H, m, nd, n, d, H_nzmax, &J_cone_pos);
+      JacobianUpdate(J, J_cone_pos, reaction, velocity, p2, nd, n, d, NT_scaling);
+      NM_LU_refactorize(J);
     }
     else
     {
-      NM_insert(J, Qp2, m, m);
-      NM_insert(J, NM_eye(nd), m, m + nd);
+      J = NM_create(NM_SPARSE, m + nd + nd, m + nd + nd);
+      J_nzmax = (d * d) * (m / d) + H_nzmax + 2 * (d * 3 - 2) * n + H_nzmax + nd;
+      NM_triplet_alloc(J, J_nzmax);
+      J->matrix2->origin = NSM_TRIPLET;
+
+
+      NM_insert(J, M, 0, 0);
+      NM_insert(J, NM_transpose(minus_H), 0, m + nd);
+      if(!options->iparam[SICONOS_FRICTION_3D_IPM_IPARAM_NESTEROV_TODD_SCALING])
+      {
+        NM_insert(J, Arrow_repr(reaction, nd, n), m, m);
+        NM_insert(J, Arrow_repr(velocity, nd, n), m, m + nd);
+      }
+      else
+      {
+        NM_insert(J, Qp2, m, m);
+        NM_insert(J, NM_eye(nd), m, m + nd);
+      }
+      NM_insert(J, minus_H, m + nd, 0);
+      NM_insert(J, NM_eye(nd), m + nd, m);
     }
-    NM_insert(J, minus_H, m + nd, 0);
-    NM_insert(J, NM_eye(nd), m + nd, m);
 
     /* 2. ---- Predictor step of Mehrotra ---- */
 
@@ -862,8 +996,11 @@ void gfc3d_IPM(GlobalFrictionContactProblem* restrict problem, double* restrict
     // NM_gesv_expert(J, rhs, NM_KEEP_FACTORS);
     NM_LU_solve(J, rhs, 1);
 
-    NM_clear(J);
-    free(J);
+    if(!reuse_factorization)
+    {
+      NM_clear(J);
+      free(J);
+    }
 
     d_globalVelocity = rhs;
     d_velocity = rhs + m;
@@ -951,6 +1088,25 @@ void gfc3d_IPM(GlobalFrictionContactProblem* restrict problem, double* restrict
     gfc3d_IPM_free(problem,options);
   }
 
+  if(reuse_factorization && J)
+  {
+    NM_clear(J);
+    free(J);
+    free(J_cone_pos);
+  }
+  if(Qp)
+  {
+    NM_clear(Qp);
+    free(Qp);
+    NM_clear(Qpinv);
+    free(Qpinv);
+  }
+  if(Qp2)
+  {
+    NM_clear(Qp2);
+    free(Qp2);
+  }
+
   NM_clear(H_tilde);
   free(H_tilde);
   NM_clear(minus_H);
@@ -970,6 +1126,9 @@ void gfc3d_ipm_set_default(SolverOptions* options)
 
   options->iparam[SICONOS_FRICTION_3D_IPM_IPARAM_NESTEROV_TODD_SCALING] = 1;
 
+  options->iparam[SICONOS_FRICTION_3D_IPM_IPARAM_REFACTORIZATION] =
+    SICONOS_FRICTION_3D_IPM_REFACTORIZATION_YES;
+
   options->iparam[SICONOS_FRICTION_3D_ADMM_IPARAM_UPDATE_S]=
     SICONOS_FRICTION_3D_ADMM_UPDATE_S_NO;
 
@@ -0,0 +1,109 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+  Comparison of the INCREMENTAL error evaluation of NSGS with the FULL
+  evaluation on the same problems (the INCREMENTAL case of test_nsgs_1 only
+  checks the convergence): since a convergence is confirmed with the
+  velocity recomputed from the reactions, both must stop at the same
+  iteration with the same reactions and velocities.
+ */
+
+#include <stdio.h>                   // for printf, fprintf, stderr
+#include <stdlib.h>                  // for calloc, free
+#include <string.h>                  // for memcmp, memset, strcmp
+#include "FrictionContactProblem.h"  // for FrictionContactProblem, fricti...
+#include "Friction_cst.h"            // for SICONOS_FRICTION_3D_NSGS, SICON...
+#include "SolverOptions.h"           // for SolverOptions, solver_options_...
+#include "fc3d_Solvers.h"            // for fc3d_nsgs
+
+#define TOL 1e-8
+
+/* solve the problem with the given error evaluation, return the info of the solver */
+static int solve(FrictionContactProblem* problem, int evaluation,
+                 double* reaction, double* velocity, int n, int* iter)
+{
+  SolverOptions* options = solver_options_create(SICONOS_FRICTION_3D_NSGS);
+  options->dparam[SICONOS_DPARAM_TOL] = TOL;
+  options->iparam[SICONOS_IPARAM_MAX_ITER] = 10000;
+  options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] = evaluation;
+
+  int info = 1; /* fc3d_nsgs does nothing if info == 0 */
+  memset(reaction, 0, n * sizeof(double));
+  memset(velocity, 0, n * sizeof(double));
+  fc3d_nsgs(problem, reaction, velocity, &info, options);
+  *iter = options->iparam[SICONOS_IPARAM_ITER_DONE];
+  solver_options_delete(options);
+  return info;
+}
+
+static int test_problem(const char* filename)
+{
+  FrictionContactProblem* problem = frictionContact_new_from_filename(filename);
+  int n = problem->numberOfContacts * problem->dimension;
+  double* reaction_full = (double*)calloc(n, sizeof(double));
+  double* velocity_full = (double*)calloc(n, sizeof(double));
+  double* reaction = (double*)calloc(n, sizeof(double));
+  double* velocity = (double*)calloc(n, sizeof(double));
+  int iter_full, iter;
+  int info = 0;
+
+  int info_full = solve(problem, SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_FULL,
+                        reaction_full, velocity_full, n, &iter_full);
+  int info_incremental = solve(problem, SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_INCREMENTAL,
+                               reaction, velocity, n, &iter);
+  printf("%s: full %d iterations, incremental %d iterations\n", filename, iter_full, iter);
+
+  if(info_full || info_incremental)
+  {
+    fprintf(stderr, "%s: the full or the incremental evaluation did not converge\n", filename);
+    info = 1;
+  }
+  if(iter != iter_full ||
+      memcmp(reaction, reaction_full, n * sizeof(double)) ||
+      memcmp(velocity, velocity_full, n * sizeof(double)))
+  {
+    fprintf(stderr, "%s: the full and the incremental evaluations give different results\n",
+            filename);
+    info = 1;
+  }
+
+  free(reaction_full);
+  free(velocity_full);
+  free(reaction);
+  free(velocity);
+  frictionContactProblem_free(problem);
+  return info;
+}
+
+int main(void)
+{
+  const char* filetests[] = {"./data/FC3D_Example1_SBM.dat",
+                             "./data/Capsules-i100-1090.dat",
+                             "./data/Rover4493.dat",
+                             "./data/NESpheres_10_1.dat",
+                             "./data/Confeti-ex13-Fc3D-SBM.dat",
+                             "---"
+                            };
+
+  int info = 0;
+  for(int i = 0; strcmp(filetests[i], "---"); i++)
+    info += test_problem(filetests[i]);
+
+  return info;
+}
@@ -0,0 +1,159 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+  Comparison of the colored (parallel) NSGS sweep with the serial sweep on
+  the same problems: both must reach the tolerance and give the same
+  solution up to this tolerance. The colored sweep must also give exactly
+  the same result whatever the number of threads, since the contacts of a
+  color are not coupled.
+ */
+
+#include <math.h>                    // for fabs, sqrt
+#include <stdio.h>                   // for printf, fprintf, stderr
+#include <stdlib.h>                  // for calloc, free
+#include <string.h>                  // for memcmp, strcmp
+#include "FrictionContactProblem.h"  // for FrictionContactProblem, fricti...
+#include "Friction_cst.h"            // for SICONOS_FRICTION_3D_NSGS, SICON...
+#include "NumericsMatrix.h"          // for NumericsMatrix
+#include "SiconosBlas.h"             // for cblas_dnrm2
+#include "SiconosConfig.h"           // for WITH_OPENMP // IWYU pragma: keep
+#include "SolverOptions.h"           // for SolverOptions, solver_options_...
+#include "fc3d_Solvers.h"            // for fc3d_nsgs
+#include "fc3d_compute_error.h"      // for fc3d_compute_error
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
+#define TOL 1e-8
+
+/* solve the problem with the given sweep, return the info of the solver */
+static int solve(FrictionContactProblem* problem, int strategy,
+                 double* reaction, double* velocity, int n, double* error, int* iter)
+{
+  SolverOptions* options = solver_options_create(SICONOS_FRICTION_3D_NSGS);
+  options->dparam[SICONOS_DPARAM_TOL] = TOL;
+  options->iparam[SICONOS_IPARAM_MAX_ITER] = 10000;
+  options->iparam[SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY] = strategy;
+
+  int info = 1; /* fc3d_nsgs does nothing if info == 0 */
+  memset(reaction, 0, n * sizeof(double));
+  memset(velocity, 0, n * sizeof(double));
+  fc3d_nsgs(problem, reaction, velocity, &info, options);
+  *iter = options->iparam[SICONOS_IPARAM_ITER_DONE];
+
+  double norm_q = cblas_dnrm2(n, problem->q, 1);
+  fc3d_compute_error(problem, reaction, velocity, TOL, options, norm_q, error);
+  solver_options_delete(options);
+  return info;
+}
+
+/* relative distance between two vectors */
+static double distance(double* x, double* y, int n)
+{
+  double d = 0.0, nx = 0.0;
+  for(int i = 0; i < n; i++)
+  {
+    d += (x[i] - y[i]) * (x[i] - y[i]);
+    nx += x[i] * x[i];
+  }
+  return sqrt(d) / fmax(1.0, sqrt(nx));
+}
+
+static int test_problem(const char* filename)
+{
+  FrictionContactProblem* problem = frictionContact_new_from_filename(filename);
+  int n = problem->numberOfContacts * problem->dimension;
+  double* reaction_serial = (double*)calloc(n, sizeof(double));
+  double* velocity_serial = (double*)calloc(n, sizeof(double));
+  double* reaction = (double*)calloc(n, sizeof(double));
+  double* velocity = (double*)calloc(n, sizeof(double));
+  double error_serial, error;
+  int iter_serial, iter;
+  int info = 0;
+
+  int info_serial = solve(problem, SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_SERIAL,
+                          reaction_serial, velocity_serial, n, &error_serial, &iter_serial);
+  int info_colored = solve(problem, SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_COLORING,
+                           reaction, velocity, n, &error, &iter);
+
+  double dr = distance(reaction, reaction_serial, n);
+  double du = distance(velocity, velocity_serial, n);
+  printf("%s: serial %d iterations, error %e, colored %d iterations, error %e, "
+         "distance of the reactions %e, of the velocities %e\n",
+         filename, iter_serial, error_serial, iter, error, dr, du);
+
+  if(info_serial || info_colored || error_serial > TOL || error > TOL)
+  {
+    fprintf(stderr, "%s: the serial or the colored sweep did not converge\n", filename);
+    info = 1;
+  }
+  /* both are solutions at TOL, the distance between them is of the same
+   * order (with a safety factor for the conditioning of the problem) */
+  if(dr > 1e3 * TOL || du > 1e3 * TOL)
+  {
+    fprintf(stderr, "%s: the serial and the colored sweeps give different solutions\n", filename);
+    info = 1;
+  }
+
+#ifdef WITH_OPENMP
+  /* the colored sweep does not depend on the number of threads */
+  double* reaction_t = (double*)calloc(n, sizeof(double));
+  double* velocity_t = (double*)calloc(n, sizeof(double));
+  int nthreads = omp_get_max_threads();
+  int threads[2] = {1, 4};
+  for(int t = 0; t < 2; t++)
+  {
+    omp_set_num_threads(threads[t]);
+    solve(problem, SICONOS_FRICTION_3D_NSGS_PARALLEL_STRATEGY_COLORING,
+          reaction_t, velocity_t, n, &error, &iter);
+    if(memcmp(reaction, reaction_t, n * sizeof(double)) ||
+        memcmp(velocity, velocity_t, n * sizeof(double)))
+    {
+      fprintf(stderr, "%s: the colored sweep depends on the number of threads (%d)\n",
+              filename, threads[t]);
+      info = 1;
+    }
+  }
+  omp_set_num_threads(nthreads);
+  free(reaction_t);
+  free(velocity_t);
+#endif
+
+  free(reaction_serial);
+  free(velocity_serial);
+  free(reaction);
+  free(velocity);
+  frictionContactProblem_free(problem);
+  return info;
+}
+
+int main(void)
+{
+  /* problems with a unique solution, with several colors */
+  const char* filetests[] = {"./data/Confeti-ex03-Fc3D-SBM.dat",
+                             "./data/Confeti-ex13-Fc3D-SBM.dat",
+                             "---"
+                            };
+
+  int info = 0;
+  for(int i = 0; strcmp(filetests[i], "---"); i++)
+    info += test_problem(filetests[i]);
+
+  return info;
+}
@@ -0,0 +1,125 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+  Benchmark of the NSGS sweeps on SBM problems, with blocks allocated one
+  by one (as read from file) and with blocks packed in a contiguous storage
+  (SBM_pack_blocks). The number of sweeps is fixed and both layouts must
+  give exactly the same result.
+ */
+
+#include <stdio.h>                   // for printf, fprintf, stderr
+#include <stdlib.h>                  // for calloc, free, malloc
+#include <string.h>                  // for memcmp, memset
+#include <time.h>                    // for clock, clock_t, CLOCKS_PER_SEC
+#include "FrictionContactProblem.h"  // for FrictionContactProblem, fricti...
+#include "Friction_cst.h"            // for SICONOS_FRICTION_3D_NSGS, SICON...
+#include "NumericsMatrix.h"          // for NumericsMatrix, NM_SPARSE_BLOCK
+#include "SiconosConfig.h"           // for WITH_FCLIB // IWYU pragma: keep
+#include "SolverOptions.h"           // for SolverOptions, solver_options_...
+#include "SparseBlockMatrix.h"       // for SBM_pack_blocks
+#include "fc3d_Solvers.h"            // for fc3d_nsgs
+
+#define SWEEPS 50
+#define REPEATS 5
+
+static double run_nsgs(FrictionContactProblem* problem, SolverOptions* options,
+                       double* reaction, double* velocity, int n)
+{
+  clock_t t1 = clock();
+  for(int k = 0; k < REPEATS; k++)
+  {
+    int info = 1; /* fc3d_nsgs does nothing if info == 0 */
+    memset(reaction, 0, n * sizeof(double));
+    memset(velocity, 0, n * sizeof(double));
+    fc3d_nsgs(problem, reaction, velocity, &info, options);
+  }
+  clock_t t2 = clock();
+  return (double)(t2 - t1) / (double)CLOCKS_PER_SEC;
+}
+
+static int bench_problem(const char* filename)
+{
+  FrictionContactProblem* problem = frictionContact_new_from_filename(filename);
+  if(problem->M->storageType != NM_SPARSE_BLOCK)
+  {
+    printf("%s: not a sparse block matrix, skipped\n", filename);
+    frictionContactProblem_free(problem);
+    return 0;
+  }
+
+  int n = problem->numberOfContacts * problem->dimension;
+  double* reaction_ref = (double*)calloc(n, sizeof(double));
+  double* velocity_ref = (double*)calloc(n, sizeof(double));
+  double* reaction = (double*)calloc(n, sizeof(double));
+  double* velocity = (double*)calloc(n, sizeof(double));
+
+  /* fixed number of sweeps, the cheap error is used between them */
+  SolverOptions* options = solver_options_create(SICONOS_FRICTION_3D_NSGS);
+  options->iparam[SICONOS_IPARAM_MAX_ITER] = SWEEPS;
+  options->dparam[SICONOS_DPARAM_TOL] = 0.0;
+  options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] = SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_LIGHT;
+
+  double t_split = run_nsgs(problem, options, reaction_ref, velocity_ref, n);
+
+  int info = SBM_pack_blocks(problem->M->matrix1);
+  if(info)
+  {
+    fprintf(stderr, "%s: SBM_pack_blocks failed\n", filename);
+  }
+  else
+  {
+    double t_packed = run_nsgs(problem, options, reaction, velocity, n);
+
+    if(memcmp(reaction, reaction_ref, n * sizeof(double)) ||
+        memcmp(velocity, velocity_ref, n * sizeof(double)))
+    {
+      fprintf(stderr, "%s: packed and split blocks give different results\n", filename);
+      info = 1;
+    }
+    printf("%s: %d contacts, %u blocks, %d x %d sweeps, split blocks %g s, packed blocks %g s, speedup %g\n",
+           filename, problem->numberOfContacts, problem->M->matrix1->nbblocks,
+           REPEATS, SWEEPS, t_split, t_packed, t_packed > 0. ? t_split / t_packed : 0.);
+  }
+
+  solver_options_delete(options);
+  free(reaction_ref);
+  free(velocity_ref);
+  free(reaction);
+  free(velocity);
+  frictionContactProblem_free(problem);
+  return info;
+}
+
+int main(void)
+{
+  const char* filetests[] = {"./data/Capsules-i100-889.dat",
+                             "./data/Capsules-i100-1090.dat",
+                             "./data/Capsules-i122-1617.dat",
+#ifdef WITH_FCLIB
+                             "./data/Capsules-i125-1213.hdf5",
+#endif
+                             "---"
+                            };
+
+  int info = 0;
+  for(int i = 0; strcmp(filetests[i], "---"); i++)
+    info += bench_problem(filetests[i]);
+
+  return info;
+}
@@ -0,0 +1,668 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/*
+  Benchmark of friction contact solvers on fclib problems.
+
+  Each solver of the list is run on each fclib file (local or global
+  formulation, depending on the solver) found in the given files and
+  directories. The wall time of the driver call, the number of iterations,
+  the residual of the solver, the error recomputed with the error function
+  of the formulation and the peak resident memory are reported for each
+  run, in JSON and/or CSV, so that performance profiles of two builds can
+  be compared.
+
+  usage: fclib_solvers_bench [options] [file or directory ...]
+
+    -s solver     add a solver (name as in solver_options_id_to_name, with
+                  '_' for ' ', or id); the following -i/-d apply to it
+    -i k=v        iparam[k] = v for the last solver
+    -d k=v        dparam[k] = v for the last solver
+    -t tol        tolerance of all the solvers (dparam[SICONOS_DPARAM_TOL])
+    -m iter       maximum number of iterations of all the solvers
+    -r repeat     number of runs of each solver on each problem
+    -l label      label of the build, written in the reports
+    -j file       JSON report ('-' for stdout)
+    -c file       CSV report ('-' for stdout)
+
+  Without solver, FC3D_NSGS, FC3D_NSN_AC, GFC3D_ADMM and GFC3D_IPM are
+  run. Without file, the fclib files of ./data are used.
+*/
+
+#ifndef _DEFAULT_SOURCE
+#define _DEFAULT_SOURCE
+#endif
+
+#include <dirent.h>                        // for opendir, readdir, closedir
+#include <float.h>                         // for DBL_MAX
+#include <math.h>                          // for isfinite
+#include <stdio.h>                         // for fprintf, printf, FILE
+#include <stdlib.h>                        // for calloc, free, malloc, qsort
+#include <string.h>                        // for strcmp, strlen, strrchr
+#include <sys/resource.h>                  // for getrusage, rusage
+#include <sys/stat.h>                      // for stat, S_ISDIR
+#include <time.h>                          // for clock_gettime, timespec
+#include "FrictionContactProblem.h"        // for FrictionContactProblem
+#include "Friction_cst.h"                  // for SICONOS_FRICTION_3D_NSGS
+#include "GlobalFrictionContactProblem.h"  // for GlobalFrictionContactProblem
+#include "NonSmoothDrivers.h"              // for fc3d_driver, gfc3d_driver
+#include "NumericsMatrix.h"                // for NumericsMatrix
+#include "SiconosBlas.h"                   // for cblas_dnrm2
+#include "SiconosConfig.h"                 // for WITH_FCLIB // IWYU pragma: keep
+#include "SolverOptions.h"                 // for SolverOptions, solver_opt...
+#include "fc3d_compute_error.h"            // for fc3d_compute_error
+#include "gfc3d_compute_error.h"           // for gfc3d_compute_error
+
+// avoid a conflict with old csparse.h in case fclib includes it
+#define _CS_H
+#include "fclib_interface.h"               // for frictionContact_fclib_read
+
+#define MAX_SOLVERS 32
+#define MAX_PARAMS 16
+
+typedef struct
+{
+  int solverId;
+  int global;
+  int nbIparam;
+  int iparamIndex[MAX_PARAMS];
+  int iparamValue[MAX_PARAMS];
+  int nbDparam;
+  int dparamIndex[MAX_PARAMS];
+  double dparamValue[MAX_PARAMS];
+  char config[256];
+} BenchSolver;
+
+typedef struct
+{
+  int nbSolvers;
+  BenchSolver solvers[MAX_SOLVERS];
+  double tolerance;
+  int maxIter;
+  int repeat;
+  const char* label;
+  FILE* json;
+  FILE* csv;
+  int nbResults;
+} Bench;
+
+typedef struct
+{
+  const char* problem;
+  const BenchSolver* solver;
+  int contacts;
+  int dimension;
+  int info;
+  int iterations;
+  double residual;
+  double error;
+  double time;
+  double timeMean;
+  long peakMemory;
+} BenchResult;
+
+/* --- peak resident memory ---
+   On Linux, the high water mark of the process is reset before each run,
+   so that the peak of one run is measured. Elsewhere, the peak of the
+   process since its start is reported. */
+
+static void peak_memory_reset(void)
+{
+  FILE* f = fopen("/proc/self/clear_refs", "w");
+  if(f)
+  {
+    fputs("5", f);
+    fclose(f);
+  }
+}
+
+/* in kB */
+static long peak_memory(void)
+{
+  long peak = -1;
+  FILE* f = fopen("/proc/self/status", "r");
+  if(f)
+  {
+    char line[256];
+    while(fgets(line, sizeof(line), f))
+    {
+      if(!strncmp(line, "VmHWM:", 6))
+      {
+        peak = strtol(line + 6, NULL, 10);
+        break;
+      }
+    }
+    fclose(f);
+  }
+  if(peak < 0)
+  {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    peak = usage.ru_maxrss;
+#ifdef __APPLE__
+    peak /= 1024; /* bytes on macOS */
+#endif
+  }
+  return peak;
+}
+
+static double wall_time(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (double)t.tv_sec + 1e-9 * (double)t.tv_nsec;
+}
+
+/* --- solvers --- */
+
+static int solver_id_from_string(const char* s)
+{
+  char* end;
+  long id = strtol(s, &end, 10);
+  if(*end == '\0')
+    return (int)id;
+  id = solver_options_name_to_id(s);
+  if(!id)
+  {
+    /* names like "GFC3D IPM" may be given as GFC3D_IPM */
+    char name[128];
+    strncpy(name, s, sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    for(char* c = name; *c; c++)
+      if(*c == '_') *c = ' ';
+    id = solver_options_name_to_id(name);
+  }
+  return (int)id;
+}
+
+static int add_solver(Bench* bench, const char* s)
+{
+  int id = solver_id_from_string(s);
+  if(id < SICONOS_FRICTION_3D_NSGS || id > SICONOS_GLOBAL_FRICTION_3D_IPM)
+  {
+    fprintf(stderr, "fclib_solvers_bench: %s is not a 3D friction contact solver\n", s);
+    return 1;
+  }
+  if(bench->nbSolvers == MAX_SOLVERS)
+  {
+    fprintf(stderr, "fclib_solvers_bench: too many solvers\n");
+    return 1;
+  }
+  BenchSolver* solver = &bench->solvers[bench->nbSolvers++];
+  memset(solver, 0, sizeof(BenchSolver));
+  solver->solverId = id;
+  solver->global = id >= SICONOS_GLOBAL_FRICTION_3D_NSGS_WR;
+  return 0;
+}
+
+static int add_param(Bench* bench, char kind, const char* s)
+{
+  int index;
+  double value;
+  if(!bench->nbSolvers)
+  {
+    fprintf(stderr, "fclib_solvers_bench: -%c before any -s\n", kind);
+    return 1;
+  }
+  if(sscanf(s, "%d=%lf", &index, &value) != 2 || index < 0)
+  {
+    fprintf(stderr, "fclib_solvers_bench: -%c %s, k=v expected\n", kind, s);
+    return 1;
+  }
+  BenchSolver* solver = &bench->solvers[bench->nbSolvers - 1];
+  if(kind == 'i' && solver->nbIparam < MAX_PARAMS)
+  {
+    solver->iparamIndex[solver->nbIparam] = index;
+    solver->iparamValue[solver->nbIparam++] = (int)value;
+  }
+  else if(kind == 'd' && solver->nbDparam < MAX_PARAMS)
+  {
+    solver->dparamIndex[solver->nbDparam] = index;
+    solver->dparamValue[solver->nbDparam++] = value;
+  }
+  else
+  {
+    fprintf(stderr, "fclib_solvers_bench: too many parameters\n");
+    return 1;
+  }
+  return 0;
+}
+
+/* the name of the configuration in the reports, e.g. GFC3D IPM[i11=1] */
+static void set_config_names(Bench* bench)
+{
+  for(int s = 0; s < bench->nbSolvers; s++)
+  {
+    BenchSolver* solver = &bench->solvers[s];
+    size_t size = sizeof(solver->config);
+    int n = snprintf(solver->config, size, "%s",
+                     solver_options_id_to_name(solver->solverId));
+    const char* sep = "[";
+    for(int k = 0; k < solver->nbIparam && n < (int)size; k++, sep = ",")
+      n += snprintf(solver->config + n, size - n, "%si%d=%d", sep,
+                    solver->iparamIndex[k], solver->iparamValue[k]);
+    for(int k = 0; k < solver->nbDparam && n < (int)size; k++, sep = ",")
+      n += snprintf(solver->config + n, size - n, "%sd%d=%g", sep,
+                    solver->dparamIndex[k], solver->dparamValue[k]);
+    if(sep[0] == ',' && n < (int)size)
+      snprintf(solver->config + n, size - n, "]");
+  }
+}
+
+static SolverOptions* create_options(Bench* bench, const BenchSolver* solver)
+{
+  SolverOptions* options = solver_options_create(solver->solverId);
+  if(bench->tolerance > 0.)
+    options->dparam[SICONOS_DPARAM_TOL] = bench->tolerance;
+  if(bench->maxIter > 0)
+    options->iparam[SICONOS_IPARAM_MAX_ITER] = bench->maxIter;
+  for(int k = 0; k < solver->nbIparam; k++)
+    if(solver->iparamIndex[k] < (int)options->iSize)
+      options->iparam[solver->iparamIndex[k]] = solver->iparamValue[k];
+  for(int k = 0; k < solver->nbDparam; k++)
+    if(solver->dparamIndex[k] < (int)options->dSize)
+      options->dparam[solver->dparamIndex[k]] = solver->dparamValue[k];
+  return options;
+}
+
+static void delete_options(SolverOptions* options)
+{
+  solver_options_delete(options);
+  free(options);
+}
+
+/* --- reports --- */
+
+static void json_string(FILE* f, const char* s)
+{
+  fputc('"', f);
+  for(; *s; s++)
+  {
+    if(*s == '"' || *s == '\\')
+      fprintf(f, "\\%c", *s);
+    else if((unsigned char)*s < 0x20)
+      fprintf(f, "\\u%04x", *s);
+    else
+      fputc(*s, f);
+  }
+  fputc('"', f);
+}
+
+/* JSON has no inf or nan */
+static void json_double(FILE* f, double x)
+{
+  if(isfinite(x))
+    fprintf(f, "%.17g", x);
+  else
+    fprintf(f, "null");
+}
+
+static void csv_string(FILE* f, const char* s)
+{
+  fputc('"', f);
+  for(; *s; s++)
+  {
+    if(*s == '"')
+      fputc('"', f);
+    fputc(*s, f);
+  }
+  fputc('"', f);
+}
+
+static void report_begin(Bench* bench)
+{
+  if(bench->json)
+  {
+    fprintf(bench->json, "{\n  \"label\": ");
+    json_string(bench->json, bench->label);
+    fprintf(bench->json, ",\n  \"tolerance\": ");
+    json_double(bench->json, bench->tolerance);
+    fprintf(bench->json, ",\n  \"max_iter\": %d,\n  \"repeat\": %d,\n  \"results\": [",
+            bench->maxIter, bench->repeat);
+  }
+  if(bench->csv)
+    fprintf(bench->csv, "label,problem,formulation,solver,solver_id,config,contacts,dimension,"
+            "info,iterations,residual,error,time,time_mean,peak_memory_kb\n");
+}
+
+static void report(Bench* bench, const BenchResult* r)
+{
+  const char* formulation = r->solver->global ? "gfc3d" : "fc3d";
+  const char* name = solver_options_id_to_name(r->solver->solverId);
+  if(bench->json)
+  {
+    FILE* f = bench->json;
+    fprintf(f, "%s\n    {\"problem\": ", bench->nbResults ? "," : "");
+    json_string(f, r->problem);
+    fprintf(f, ", \"formulation\": \"%s\", \"solver\": ", formulation);
+    json_string(f, name);
+    fprintf(f, ", \"solver_id\": %d, \"config\": ", r->solver->solverId);
+    json_string(f, r->solver->config);
+    fprintf(f, ", \"contacts\": %d, \"dimension\": %d, \"info\": %d, \"iterations\": %d, \"residual\": ",
+            r->contacts, r->dimension, r->info, r->iterations);
+    json_double(f, r->residual);
+    fprintf(f, ", \"error\": ");
+    json_double(f, r->error);
+    fprintf(f, ", \"time\": ");
+    json_double(f, r->time);
+    fprintf(f, ", \"time_mean\": ");
+    json_double(f, r->timeMean);
+    fprintf(f, ", \"peak_memory_kb\": %ld}", r->peakMemory);
+  }
+  if(bench->csv)
+  {
+    FILE* f = bench->csv;
+    csv_string(f, bench->label);
+    fputc(',', f);
+    csv_string(f, r->problem);
+    fprintf(f, ",%s,", formulation);
+    csv_string(f, name);
+    fprintf(f, ",%d,", r->solver->solverId);
+    csv_string(f, r->solver->config);
+    fprintf(f, ",%d,%d,%d,%d,%.17g,%.17g,%.17g,%.17g,%ld\n",
+            r->contacts, r->dimension, r->info, r->iterations, r->residual,
+            r->error, r->time, r->timeMean, r->peakMemory);
+  }
+  bench->nbResults++;
+  printf("%-40s %-30s info %d, %6d iterations, error %10.3e, %10.4f s, %8ld kB\n",
+         r->problem, r->solver->config, r->info, r->iterations, r->error,
+         r->time, r->peakMemory);
+}
+
+static void report_end(Bench* bench)
+{
+  if(bench->json)
+    fprintf(bench->json, "\n  ]\n}\n");
+}
+
+/* --- runs --- */
+
+static void run_local(Bench* bench, const BenchSolver* solver,
+                      FrictionContactProblem* problem, BenchResult* r)
+{
+  int n = problem->numberOfContacts * problem->dimension;
+  double* reaction = (double*)calloc(n, sizeof(double));
+  double* velocity = (double*)calloc(n, sizeof(double));
+  double total = 0.;
+  r->time = DBL_MAX;
+  r->peakMemory = 0;
+  for(int k = 0; k < bench->repeat; k++)
+  {
+    SolverOptions* options = create_options(bench, solver);
+    memset(reaction, 0, n * sizeof(double));
+    memset(velocity, 0, n * sizeof(double));
+    peak_memory_reset();
+    double t = wall_time();
+    r->info = fc3d_driver(problem, reaction, velocity, options);
+    t = wall_time() - t;
+    long peak = peak_memory();
+    total += t;
+    if(t < r->time) r->time = t;
+    if(peak > r->peakMemory) r->peakMemory = peak;
+    r->iterations = options->iparam[SICONOS_IPARAM_ITER_DONE];
+    r->residual = options->dparam[SICONOS_DPARAM_RESIDU];
+    delete_options(options);
+  }
+  r->timeMean = total / bench->repeat;
+  double norm_q = cblas_dnrm2(n, problem->q, 1);
+  fc3d_compute_error(problem, reaction, velocity, 0., NULL, norm_q, &r->error);
+  free(reaction);
+  free(velocity);
+}
+
+static void run_global(Bench* bench, const BenchSolver* solver,
+                       GlobalFrictionContactProblem* problem, BenchResult* r)
+{
+  int m = problem->numberOfContacts * problem->dimension;
+  int n = problem->M->size0;
+  double* reaction = (double*)calloc(m, sizeof(double));
+  double* velocity = (double*)calloc(m, sizeof(double));
+  double* globalVelocity = (double*)calloc(n, sizeof(double));
+  double total = 0.;
+  r->time = DBL_MAX;
+  r->peakMemory = 0;
+  for(int k = 0; k < bench->repeat; k++)
+  {
+    SolverOptions* options = create_options(bench, solver);
+    memset(reaction, 0, m * sizeof(double));
+    memset(velocity, 0, m * sizeof(double));
+    memset(globalVelocity, 0, n * sizeof(double));
+    peak_memory_reset();
+    double t = wall_time();
+    r->info = gfc3d_driver(problem, reaction, velocity, globalVelocity, options);
+    t = wall_time() - t;
+    long peak = peak_memory();
+    total += t;
+    if(t < r->time) r->time = t;
+    if(peak > r->peakMemory) r->peakMemory = peak;
+    r->iterations = options->iparam[SICONOS_IPARAM_ITER_DONE];
+    r->residual = options->dparam[SICONOS_DPARAM_RESIDU];
+    delete_options(options);
+  }
+  r->timeMean = total / bench->repeat;
+
+  /* the work array of the error is the only member used in the options */
+  SolverOptions check;
+  memset(&check, 0, sizeof(SolverOptions));
+  double norm_q = cblas_dnrm2(n, problem->q, 1);
+  double norm_b = cblas_dnrm2(m, problem->b, 1);
+  gfc3d_compute_error(problem, reaction, velocity, globalVelocity, 0., &check,
+                      norm_q, norm_b, &r->error);
+  free(check.dWork);
+  free(reaction);
+  free(velocity);
+  free(globalVelocity);
+}
+
+static int bench_file(Bench* bench, const char* filename)
+{
+  FrictionContactProblem* local = NULL;
+  GlobalFrictionContactProblem* global = NULL;
+  int done = 0;
+  for(int s = 0; s < bench->nbSolvers; s++)
+  {
+    const BenchSolver* solver = &bench->solvers[s];
+    BenchResult r;
+    memset(&r, 0, sizeof(BenchResult));
+    r.problem = filename;
+    r.solver = solver;
+    if(solver->global)
+    {
+      if(!global && !(global = globalFrictionContact_fclib_read(filename)))
+        continue;
+      r.contacts = global->numberOfContacts;
+      r.dimension = global->dimension;
+      if(r.dimension != 3)
+        continue;
+      run_global(bench, solver, global, &r);
+    }
+    else
+    {
+      if(!local && !(local = frictionContact_fclib_read(filename)))
+        continue;
+      r.contacts = local->numberOfContacts;
+      r.dimension = local->dimension;
+      if(r.dimension != 3)
+        continue;
+      run_local(bench, solver, local, &r);
+    }
+    report(bench, &r);
+    done++;
+  }
+  if(local)
+    frictionContactProblem_free(local);
+  if(global)
+    globalFrictionContact_free(global);
+  return done;
+}
+
+static int compare_names(const void* a, const void* b)
+{
+  return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+/* the *.hdf5 files of a directory, in alphabetical order */
+static int bench_directory(Bench* bench, const char* dirname)
+{
+  DIR* dir = opendir(dirname);
+  if(!dir)
+  {
+    fprintf(stderr, "fclib_solvers_bench: cannot open %s\n", dirname);
+    return 0;
+  }
+  size_t nbFiles = 0, capacity = 16;
+  char** files = (char**)malloc(capacity * sizeof(char*));
+  struct dirent* entry;
+  while((entry = readdir(dir)))
+  {
+    const char* ext = strrchr(entry->d_name, '.');
+    if(!ext || strcmp(ext, ".hdf5"))
+      continue;
+    if(nbFiles == capacity)
+    {
+      capacity *= 2;
+      files = (char**)realloc(files, capacity * sizeof(char*));
+    }
+    size_t size = strlen(dirname) + strlen(entry->d_name) + 2;
+    files[nbFiles] = (char*)malloc(size);
+    snprintf(files[nbFiles++], size, "%s/%s", dirname, entry->d_name);
+  }
+  closedir(dir);
+  qsort(files, nbFiles, sizeof(char*), compare_names);
+
+  int done = 0;
+  for(size_t i = 0; i < nbFiles; i++)
+  {
+    done += bench_file(bench, files[i]);
+    free(files[i]);
+  }
+  free(files);
+  return done;
+}
+
+static int bench_path(Bench* bench, const char* path)
+{
+  struct stat st;
+  if(stat(path, &st))
+  {
+    fprintf(stderr, "fclib_solvers_bench: %s not found\n", path);
+    return 0;
+  }
+  return S_ISDIR(st.st_mode) ? bench_directory(bench, path) : bench_file(bench, path);
+}
+
+static FILE* open_report(const char* filename)
+{
+  if(!strcmp(filename, "-"))
+    return stdout;
+  FILE* f = fopen(filename, "w");
+  if(!f)
+    fprintf(stderr, "fclib_solvers_bench: cannot open %s\n", filename);
+  return f;
+}
+
+int main(int argc, char* argv[])
+{
+  Bench bench;
+  memset(&bench, 0, sizeof(Bench));
+  bench.repeat = 1;
+  bench.label = "";
+  const char* json = NULL;
+  const char* csv = NULL;
+  int nbPaths = 0;
+  int info = 0;
+
+  for(int i = 1; i < argc && !info; i++)
+  {
+    const char* arg = argv[i];
+    if(arg[0] != '-' || !arg[1] || arg[2])
+    {
+      argv[1 + nbPaths++] = argv[i];
+      continue;
+    }
+    if(i + 1 == argc)
+    {
+      fprintf(stderr, "fclib_solvers_bench: missing value after %s\n", arg);
+      return 1;
+    }
+    const char* value = argv[++i];
+    switch(arg[1])
+    {
+    case 's':
+      info = add_solver(&bench, value);
+      break;
+    case 'i':
+    case 'd':
+      info = add_param(&bench, arg[1], value);
+      break;
+    case 't':
+      bench.tolerance = atof(value);
+      break;
+    case 'm':
+      bench.maxIter = atoi(value);
+      break;
+    case 'r':
+      bench.repeat = atoi(value) > 0 ? atoi(value) : 1;
+      break;
+    case 'l':
+      bench.label = value;
+      break;
+    case 'j':
+      json = value;
+      break;
+    case 'c':
+      csv = value;
+      break;
+    default:
+      fprintf(stderr, "fclib_solvers_bench: unknown option %s\n", arg);
+      info = 1;
+    }
+  }
+  if(info)
+    return info;
+
+  if(!bench.nbSolvers)
+  {
+    add_solver(&bench, SICONOS_FRICTION_3D_NSGS_STR);
+    add_solver(&bench, SICONOS_FRICTION_3D_NSN_AC_STR);
+    add_solver(&bench, SICONOS_GLOBAL_FRICTION_3D_ADMM_STR);
+    add_solver(&bench, SICONOS_GLOBAL_FRICTION_3D_IPM_STR);
+  }
+  set_config_names(&bench);
+
+  if(json && !(bench.json = open_report(json)))
+    return 1;
+  if(csv && !(bench.csv = open_report(csv)))
+    return 1;
+
+  report_begin(&bench);
+  int done = 0;
+  if(!nbPaths)
+    done = bench_path(&bench, "./data");
+  for(int p = 0; p < nbPaths; p++)
+    done += bench_path(&bench, argv[1 + p]);
+  report_end(&bench);
+
+  if(bench.json && bench.json != stdout)
+    fclose(bench.json);
+  if(bench.csv && bench.csv != stdout)
+    fclose(bench.csv);
+
+  printf("%d runs\n", done);
+  return done ? 0 : 1;
+}
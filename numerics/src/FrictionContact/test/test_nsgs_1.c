@@ -25,7 +25,7 @@
 
 TestCase * build_test_collection(int n_data, const char ** data_collection, int* number_of_tests)
 {
-  int n_solvers = 5;
+  int n_solvers = 6;
   *number_of_tests = n_data * n_solvers;
   TestCase * collection = malloc((*number_of_tests) * sizeof(TestCase));
 
@@ -103,6 +103,18 @@ TestCase * build_test_collection(int n_data, const char ** data_collection, int*
     current++;
   }
 
+  // nsgs + full error with the velocity updated during the sweep
+  // (compared with the FULL evaluation in fc3d_nsgs_incremental_error_test.c)
+  for(int d =0; d <n_data; d++)
+  {
+    collection[current].filename = data_collection[d];
+    collection[current].options = solver_options_create(topsolver);
+    collection[current].options->dparam[SICONOS_DPARAM_TOL] = 1e-5;
+    collection[current].options->iparam[SICONOS_FRICTION_3D_IPARAM_ERROR_EVALUATION] =
+      SICONOS_FRICTION_3D_NSGS_ERROR_EVALUATION_INCREMENTAL;
+    current++;
+  }
+
   return collection;
 
 }
@@ -31,6 +31,11 @@ dim(v)=nn
 * 1) The complementarity constraints hold --> Success.
 * 2) The complementarity constraints don't hold --> Failed.
 *
+* The configurations are stored in a cache attached to the SolverOptions
+* (options->solverData): a hash table on the zw pattern and a list of the
+* configurations sorted from the most recently used one. When the cache is
+* full, the least recently used configuration is replaced.
+*
 **************************************************************************/
 
 #include "mlcp_direct.h"
@@ -38,7 +43,8 @@ dim(v)=nn
 #include <stdbool.h>                       // for false
 #endif
 #include <stdio.h>                              // for printf
-#include <stdlib.h>                             // for malloc, exit, free
+#include <stdlib.h>                             // for malloc, free
+#include <string.h>                             // for memcmp, memcpy
 #include "MLCP_Solvers.h"                       // for mlcp_direct, mlcp_dir...
 #include "MixedLinearComplementarityProblem.h"  // for MixedLinearComplement...
 #include "NumericsMatrix.h"                     // for NM_dense_display, Num...
@@ -56,157 +62,285 @@ dim(v)=nn
 
 
 #define DIRECT_SOLVER_USE_DGETRI
-double * sVBuf;
 
-struct dataComplementarityConf
+typedef struct
 {
   int * zw; /*zw[i] == 0 means w null and z >=0*/
   double * M;
-  struct dataComplementarityConf * next;
-  struct dataComplementarityConf * prev;
-  int Usable;
-  int used;
   lapack_int* IPV;
-};
-
-static double * sp_curDouble = 0;
-static int * sp_curInt = 0;
-static double * sQ = 0;
-static int s_numberOfCC = 0;
-static int s_maxNumberOfCC = 0;
-static struct dataComplementarityConf * spFirstCC = 0;
-static struct dataComplementarityConf * sp_curCC = 0;
-static double sTolneg = 0;
-static double sTolpos = 0;
-static int s_n;
-static int s_m;
-static int s_nbLines;
-static int s_npM;
-static int* spIntBuf;
-static int sProblemChanged = 0;
-
-static double * mydMalloc(int n);
-static int * myiMalloc(int n);
-static int internalPrecompute(MixedLinearComplementarityProblem* problem);
-static int internalAddConfig(MixedLinearComplementarityProblem* problem, int * zw, int init);
-static int solveWithCurConfig(MixedLinearComplementarityProblem* problem);
-//static int nbConfig(struct dataComplementarityConf * pC);
-
-double * mydMalloc(int n)
+  unsigned int hash;
+  int Usable;
+  int outdated; /* M must be recomputed, the problem has changed */
+  int prev; /* list from the most recently used configuration */
+  int next;
+  int nextInBucket;
+} dataComplementarityConf;
+
+/* All the data of the cache are stored in a single block, so that
+ * solver_options_delete releases it with solverData. */
+typedef struct
+{
+  int n;
+  int m;
+  int npM;
+  int maxNumberOfCC;
+  int numberOfCC;
+  int first;
+  int last;
+  int numberOfBuckets;
+  int * buckets;
+  dataComplementarityConf * CC;
+  double * Q;
+  double * VBuf;
+  int * intBuf;
+  double tolneg;
+  double tolpos;
+  size_t hits;
+  size_t misses;
+} mlcp_direct_cache;
+
+static mlcp_direct_cache * getCache(SolverOptions* options)
+{
+  return (mlcp_direct_cache *) options->solverData;
+}
+
+static mlcp_direct_cache * newCache(int n, int m, int maxNumberOfCC)
+{
+  int npM = n + m;
+  int numberOfBuckets = 1;
+  while(numberOfBuckets < 2 * maxNumberOfCC)
+    numberOfBuckets *= 2;
+
+  size_t size = sizeof(mlcp_direct_cache)
+                + maxNumberOfCC * sizeof(dataComplementarityConf)
+                + ((size_t)maxNumberOfCC * npM * npM + 2 * npM) * sizeof(double)
+                + (size_t)maxNumberOfCC * npM * sizeof(lapack_int)
+                + ((size_t)(maxNumberOfCC + 1) * m + numberOfBuckets) * sizeof(int);
+  mlcp_direct_cache * cache = (mlcp_direct_cache *) malloc(size);
+  if(!cache)
+    numerics_error("mlcp_direct_init", "memory allocation failed for %d configurations.", maxNumberOfCC);
+
+  cache->n = n;
+  cache->m = m;
+  cache->npM = npM;
+  cache->maxNumberOfCC = maxNumberOfCC;
+  cache->numberOfBuckets = numberOfBuckets;
+  cache->CC = (dataComplementarityConf *)(cache + 1);
+
+  double * curDouble = (double *)(cache->CC + maxNumberOfCC);
+  cache->Q = curDouble;
+  curDouble += npM;
+  cache->VBuf = curDouble;
+  curDouble += npM;
+  for(int i = 0; i < maxNumberOfCC; i++)
+  {
+    cache->CC[i].M = curDouble;
+    curDouble += npM * npM;
+  }
+  lapack_int * curLapackInt = (lapack_int *) curDouble;
+  for(int i = 0; i < maxNumberOfCC; i++)
+  {
+    cache->CC[i].IPV = curLapackInt;
+    curLapackInt += npM;
+  }
+  int * curInt = (int *) curLapackInt;
+  cache->buckets = curInt;
+  curInt += numberOfBuckets;
+  cache->intBuf = curInt;
+  curInt += m;
+  for(int i = 0; i < maxNumberOfCC; i++)
+  {
+    cache->CC[i].zw = curInt;
+    curInt += m;
+  }
+  return cache;
+}
+
+static void clearCache(mlcp_direct_cache * cache)
+{
+  cache->numberOfCC = 0;
+  cache->first = -1;
+  cache->last = -1;
+  cache->hits = 0;
+  cache->misses = 0;
+  for(int i = 0; i < cache->numberOfBuckets; i++)
+    cache->buckets[i] = -1;
+}
+
+/* FNV-1a on the zw pattern */
+static unsigned int hashConfig(int * zw, int m)
+{
+  unsigned int h = 2166136261u;
+  for(int i = 0; i < m; i++)
+  {
+    h ^= (unsigned int)(zw[i] != 0);
+    h *= 16777619u;
+  }
+  return h;
+}
+
+static int findConfig(mlcp_direct_cache * cache, int * zw, unsigned int hash)
+{
+  int i = cache->buckets[hash & (cache->numberOfBuckets - 1)];
+  while(i >= 0)
+  {
+    if(cache->CC[i].hash == hash && !memcmp(cache->CC[i].zw, zw, cache->m * sizeof(int)))
+      return i;
+    i = cache->CC[i].nextInBucket;
+  }
+  return -1;
+}
+
+static void removeFromBucket(mlcp_direct_cache * cache, int i)
 {
-  double * aux = sp_curDouble;
-  sp_curDouble = sp_curDouble + n;
-  return aux;
+  int * cur = &cache->buckets[cache->CC[i].hash & (cache->numberOfBuckets - 1)];
+  while(*cur != i)
+    cur = &cache->CC[*cur].nextInBucket;
+  *cur = cache->CC[i].nextInBucket;
 }
-int * myiMalloc(int n)
+
+static void unlinkConfig(mlcp_direct_cache * cache, int i)
 {
-  int * aux = sp_curInt;
-  sp_curInt = sp_curInt + n;
-  return aux;
+  dataComplementarityConf * pC = &cache->CC[i];
+  if(pC->prev >= 0)
+    cache->CC[pC->prev].next = pC->next;
+  else
+    cache->first = pC->next;
+  if(pC->next >= 0)
+    cache->CC[pC->next].prev = pC->prev;
+  else
+    cache->last = pC->prev;
 }
-// XXX this is going to fail
-static lapack_int * myiMalloc2(int n)
+
+static void pushFront(mlcp_direct_cache * cache, int i)
 {
-  lapack_int * aux = (lapack_int*)sp_curInt;
-  sp_curInt = (int*)&aux[n];
-  return aux;
+  cache->CC[i].prev = -1;
+  cache->CC[i].next = cache->first;
+  if(cache->first >= 0)
+    cache->CC[cache->first].prev = i;
+  else
+    cache->last = i;
+  cache->first = i;
 }
 
+static int internalPrecompute(mlcp_direct_cache * cache, MixedLinearComplementarityProblem* problem, int i);
+static int solveWithConfig(mlcp_direct_cache * cache, MixedLinearComplementarityProblem* problem, int i);
+
 int mlcp_direct_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  return (problem->n + problem->m) * (options->iparam[SICONOS_IPARAM_MLCP_NUMBER_OF_CONFIGURATIONS] + 1)
-    + options->iparam[SICONOS_IPARAM_MLCP_NUMBER_OF_CONFIGURATIONS] * problem->m;
+  /* the configurations are stored in the cache of options->solverData */
+  return 0;
 }
 
 int mlcp_direct_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  return  problem->n + problem->m
-    + (options->iparam[SICONOS_IPARAM_MLCP_NUMBER_OF_CONFIGURATIONS]) * ((problem->n + problem->m) * (problem->n + problem->m))
-    + (problem->n + problem->m);
+  return 0;
 }
 
 void mlcp_direct_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sp_curDouble = options->dWork;
-  sp_curInt = options->iWork;
-  s_maxNumberOfCC = options->iparam[SICONOS_IPARAM_MLCP_NUMBER_OF_CONFIGURATIONS];
-  sTolneg = options->dparam[SICONOS_DPARAM_MLCP_SIGN_TOL_NEG];
-  sTolpos = options->dparam[SICONOS_DPARAM_MLCP_SIGN_TOL_POS];
+  int n = problem->n;
+  int m = problem->m;
+  int maxNumberOfCC = options->iparam[SICONOS_IPARAM_MLCP_NUMBER_OF_CONFIGURATIONS];
   options->iparam[7] = 0;
-  sProblemChanged = options->iparam[SICONOS_IPARAM_MLCP_UPDATE_REQUIRED];
-  s_n = problem->n;
-  s_m = problem->m;
-  s_nbLines = problem->n + problem->m;
-  if(problem->M->size0 != s_nbLines)
+  if(problem->M->size0 != n + m)
   {
-    printf("mlcp_direct_init : M rectangular, not yet managed\n");
-    exit(1);
+    numerics_error("mlcp_direct_init", "M rectangular, not yet managed");
   }
+  if(maxNumberOfCC < 1)
+    maxNumberOfCC = 1;
 
-  if(verbose)
-    printf("n= %d  m= %d /n sTolneg= %lf sTolpos= %lf \n", s_n, s_m, sTolneg, sTolpos);
-
-  s_npM = s_n + s_m;
-
+  mlcp_direct_cache * cache = getCache(options);
+  if(cache && (cache->n != n || cache->m != m || cache->maxNumberOfCC != maxNumberOfCC))
+  {
+    free(cache);
+    cache = NULL;
+  }
   // If the problem comes from the kernel (dynamical systems)
-  // Then update is needed but no reset of the previous solutions
-  // (This avoids some memory loss by the way)
-  if(options->iparam[SICONOS_IPARAM_MLCP_UPDATE_REQUIRED]==0)
+  // Then update is needed but no reset of the previous solutions:
+  // the configurations are kept and refactorized when they are used.
+  if(!cache)
+  {
+    cache = newCache(n, m, maxNumberOfCC);
+    clearCache(cache);
+    options->solverData = cache;
+  }
+  else if(options->iparam[SICONOS_IPARAM_MLCP_UPDATE_REQUIRED] == 0)
+  {
+    clearCache(cache);
+  }
+  else
   {
-    sp_curCC = 0;
-    spFirstCC = 0;
-    s_numberOfCC = 0;
+    for(int i = cache->first; i >= 0; i = cache->CC[i].next)
+      cache->CC[i].outdated = 1;
   }
+  cache->tolneg = options->dparam[SICONOS_DPARAM_MLCP_SIGN_TOL_NEG];
+  cache->tolpos = options->dparam[SICONOS_DPARAM_MLCP_SIGN_TOL_POS];
 
-  sQ = mydMalloc(s_npM);
-  sVBuf = mydMalloc(s_npM);
-  spIntBuf = myiMalloc(s_npM);
+  if(verbose)
+    printf("n= %d  m= %d /n sTolneg= %lf sTolpos= %lf \n", n, m, cache->tolneg, cache->tolpos);
+}
+
+void mlcp_direct_reset(SolverOptions* options)
+{
+  if(options->solverData)
+  {
+    free(options->solverData);
+    options->solverData = NULL;
+  }
 }
 
-void mlcp_direct_reset()
+int mlcp_direct_cache_statistics(SolverOptions* options, size_t * hits, size_t * misses)
 {
-  struct dataComplementarityConf * aux;
-  while(spFirstCC)
+  mlcp_direct_cache * cache = getCache(options);
+  if(!cache)
   {
-    aux = spFirstCC;
-    spFirstCC = spFirstCC->next;
-    free(aux);
+    *hits = 0;
+    *misses = 0;
+    return 0;
   }
+  *hits = cache->hits;
+  *misses = cache->misses;
+  return cache->numberOfCC;
 }
 
-int internalPrecompute(MixedLinearComplementarityProblem* problem)
+int internalPrecompute(mlcp_direct_cache * cache, MixedLinearComplementarityProblem* problem, int i)
 {
   lapack_int INFO = 0;
-  mlcp_enum_build_M(spFirstCC->zw, spFirstCC->M, problem->M->matrix0, s_n, s_m, s_nbLines);
+  int npM = cache->npM;
+  dataComplementarityConf * pC = &cache->CC[i];
+  pC->outdated = 0;
+  pC->Usable = 0;
+  mlcp_enum_build_M(pC->zw, pC->M, problem->M->matrix0, cache->n, cache->m, npM);
   if(verbose)
   {
     printf("mlcp_direct, precomputed M :\n");
-    NM_dense_display(spFirstCC->M, s_npM, s_npM, 0);
+    NM_dense_display(pC->M, npM, npM, 0);
   }
-  if(!(spFirstCC->Usable))
-    return 0;
-  DGETRF(s_npM, s_npM, spFirstCC->M, s_npM, spFirstCC->IPV, &INFO);
+  DGETRF(npM, npM, pC->M, npM, pC->IPV, &INFO);
   if(INFO)
   {
-    spFirstCC->Usable = 0;
     printf("mlcp_direct, internalPrecompute  error, LU impossible\n");
     return 0;
   }
 #ifdef DIRECT_SOLVER_USE_DGETRI
-  DGETRI(s_npM, spFirstCC->M, s_npM, spFirstCC->IPV, &INFO);
+  DGETRI(npM, pC->M, npM, pC->IPV, &INFO);
   if(INFO)
   {
-    spFirstCC->Usable = 1;
     printf("mlcp_direct error, internalPrecompute  DGETRI impossible\n");
     return 0;
   }
 #endif
+  pC->Usable = 1;
   return 1;
 }
 
-/*memory management about floatWorkingMem and intWorkingMem*/
-int internalAddConfig(MixedLinearComplementarityProblem* problem, int * zw, int init)
+void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, SolverOptions* options, int * zw)
 {
+  mlcp_direct_cache * cache = getCache(options);
+  if(!cache)
+    numerics_error("mlcp_direct_addConfig", "call a non initialised method, use mlcp_direct_init first.");
+
   if(verbose)
   {
     printf("mlcp_direct internalAddConfig\n");
@@ -215,106 +349,77 @@ int internalAddConfig(MixedLinearComplementarityProblem* problem, int * zw, int
       printf("zw[%d]=%d\t", i, zw[i]);
     printf("\n");
   }
-  if(init)
-  {
-    spFirstCC->zw = myiMalloc(s_m);
-    spFirstCC->IPV = myiMalloc2(s_npM);
-    spFirstCC->M = mydMalloc(s_npM * s_npM);
-  }
-  for(int i = 0; i < s_m; i++)
+  unsigned int hash = hashConfig(zw, cache->m);
+  int i = findConfig(cache, zw, hash);
+  if(i >= 0)  /*Already known, refresh it*/
   {
-    spFirstCC->zw[i] = zw[i];
+    unlinkConfig(cache, i);
   }
-  return internalPrecompute(problem);
-}
-/*memory management about dataComplementarityConf*/
-void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, int * zw)
-{
-  if(s_numberOfCC < s_maxNumberOfCC)  /*Add a configuration*/
+  else
   {
-    s_numberOfCC++;
-    if(spFirstCC == 0)  /*first add*/
+    if(cache->numberOfCC < cache->maxNumberOfCC)  /*Add a configuration*/
     {
-      spFirstCC = (struct dataComplementarityConf *) malloc(sizeof(struct dataComplementarityConf));
-      spFirstCC->Usable = 1;
-      sp_curCC = spFirstCC;
-      spFirstCC->prev = 0;
-      spFirstCC->next = 0;
+      i = cache->numberOfCC++;
     }
-    else
+    else /*Replace the least recently used one*/
     {
-      spFirstCC->prev = (struct dataComplementarityConf *) malloc(sizeof(struct dataComplementarityConf));
-      spFirstCC->prev->Usable = 1;
-      spFirstCC->prev->next = spFirstCC;
-      spFirstCC = spFirstCC->prev;
-      spFirstCC->prev = 0;
+      i = cache->last;
+      unlinkConfig(cache, i);
+      removeFromBucket(cache, i);
     }
-    internalAddConfig(problem, zw, 1);
-  }
-  else /*Replace an old one*/
-  {
-    struct dataComplementarityConf * aux = spFirstCC;
-    while(aux->next) aux = aux->next;
-    if(aux->prev)
-    {
-      aux->prev->next = 0;
-      spFirstCC->prev = aux;
-      aux->prev = 0;
-      aux->next = spFirstCC;
-      spFirstCC = aux;
-      spFirstCC->Usable = 1;
-    }
-    internalAddConfig(problem, zw, 0);
+    dataComplementarityConf * pC = &cache->CC[i];
+    for(int k = 0; k < cache->m; k++)
+      pC->zw[k] = zw[k] ? 1 : 0;
+    pC->hash = hash;
+    int * bucket = &cache->buckets[hash & (cache->numberOfBuckets - 1)];
+    pC->nextInBucket = *bucket;
+    *bucket = i;
   }
+  pushFront(cache, i);
+  internalPrecompute(cache, problem, i);
 }
-void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, double * wSol)
+
+void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, SolverOptions* options, double * wSol)
 {
-  int i;
+  mlcp_direct_cache * cache = getCache(options);
+  if(!cache)
+    numerics_error("mlcp_direct_addConfigFromWSolution", "call a non initialised method, use mlcp_direct_init first.");
 
-  for(i = 0; i < s_m; i++)
+  for(int i = 0; i < cache->m; i++)
   {
-    if(wSol[i] > sTolpos)
-      spIntBuf[i] = 1;
+    if(wSol[i] > cache->tolpos)
+      cache->intBuf[i] = 1;
     else
-      spIntBuf[i] = 0;
+      cache->intBuf[i] = 0;
   }
-  mlcp_direct_addConfig(problem, spIntBuf);
+  mlcp_direct_addConfig(problem, options, cache->intBuf);
 }
 
 
 
-int solveWithCurConfig(MixedLinearComplementarityProblem* problem)
+int solveWithConfig(mlcp_direct_cache * cache, MixedLinearComplementarityProblem* problem, int i)
 {
   int lin;
   lapack_int INFO = 0;
-  double ALPHA = 1;
-  double BETA = 0;
-  int INCX = 1;
-  int INCY = 1;
+  int npM = cache->npM;
   double * solTest = 0;
-  /*  printf("cur config ");
-  for (int i=0;i<s_m;i++)
-    if (sp_curCC->zw[i])
-      printf("1");
-    else
-      printf("0");
-      printf("\n");*/
-  if(sProblemChanged)
-    internalPrecompute(problem);
-  if(!sp_curCC->Usable)
+  dataComplementarityConf * pC = &cache->CC[i];
+  if(pC->outdated)
+    internalPrecompute(cache, problem, i);
+  if(!pC->Usable)
   {
     if(verbose)
       printf("solveWithCurConfig not usable\n");
     return 0;
   }
 #ifdef DIRECT_SOLVER_USE_DGETRI
-  cblas_dgemv(CblasColMajor,CblasNoTrans, s_npM, s_npM, ALPHA, sp_curCC->M, s_npM, sQ, INCX, BETA, sVBuf, INCY);
-  solTest = sVBuf;
+  cblas_dgemv(CblasColMajor,CblasNoTrans, npM, npM, 1.0, pC->M, npM, cache->Q, 1, 0.0, cache->VBuf, 1);
+  solTest = cache->VBuf;
 #else
-  for(lin = 0; lin < s_npM; lin++)
-    sQ[lin] =  - problem->q[lin];
-  DGETRS(LA_NOTRANS, s_npM, one, sp_curCC->M, s_npM, sp_curCC->IPV, sQ, s_npM, &INFO);
-  solTest = sQ;
+  for(lin = 0; lin < npM; lin++)
+    cache->VBuf[lin] =  - problem->q[lin];
+  DGETRS(LA_NOTRANS, npM, 1, pC->M, npM, pC->IPV, cache->VBuf, npM, &INFO);
+  solTest = cache->VBuf;
 #endif
   if(INFO)
   {
@@ -324,79 +429,53 @@ int solveWithCurConfig(MixedLinearComplementarityProblem* problem)
   }
   else
   {
-    for(lin = 0 ; lin < s_m; lin++)
+    for(lin = 0 ; lin < cache->m; lin++)
     {
-      if(solTest[s_n + lin] < - sTolneg)
+      if(solTest[cache->n + lin] < - cache->tolneg)
       {
         if(verbose)
-          printf("solveWithCurConfig Sol not in the positive cone because %lf\n", solTest[s_n + lin]);
+          printf("solveWithCurConfig Sol not in the positive cone because %lf\n", solTest[cache->n + lin]);
         return 0;
       }
     }
   }
-  /*  if (verbose)
-      printf("solveWithCurConfig Success\n");*/
   return 1;
 }
 
 void mlcp_direct(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
-  int find = 0;
-  int lin = 0;
-  if(!spFirstCC)
+  mlcp_direct_cache * cache = getCache(options);
+  if(!cache || !cache->numberOfCC)
   {
+    if(cache)
+      cache->misses++;
     (*info) = 1;
+    return;
   }
-  else
+
+  int n = cache->n;
+  for(int lin = 0; lin < cache->npM; lin++)
+    cache->Q[lin] =  - problem->q[lin];
+
+  for(int i = cache->first; i >= 0; i = cache->CC[i].next)
   {
-    sp_curCC = spFirstCC;
-#ifdef DIRECT_SOLVER_USE_DGETRI
-    for(lin = 0; lin < s_npM; lin++)
-      sQ[lin] =  - problem->q[lin];
-#endif
-    do
+    if(solveWithConfig(cache, problem, i))
     {
-      find = solveWithCurConfig(problem);
-      if(find)
+      mlcp_enum_fill_solution(z, z + n, w, w + n, n, cache->m, cache->npM, cache->CC[i].zw, cache->VBuf);
+      /*Current becomes first for the next step.*/
+      if(i != cache->first)
       {
-#ifdef DIRECT_SOLVER_USE_DGETRI
-        mlcp_enum_fill_solution(z, z + s_n, w, w + s_n, s_n, s_m, s_nbLines, sp_curCC->zw, sVBuf);
-#else
-        mlcp_enum_fill_solution(z, z + s_n, w, w + s_n, s_n, s_m, s_nbLines, sp_curCC->zw, sQ);
-#endif
-        /*Current becomes first for the next step.*/
-        if(sp_curCC != spFirstCC)
-        {
-          /*    nbConfig(spFirstCC);
-          nbConfig(sp_curCC);
-          printf("bidouille pour devenir 1\n");*/
-          sp_curCC->prev->next = sp_curCC->next;
-          if(sp_curCC->next)
-            sp_curCC->next->prev = sp_curCC->prev;
-          spFirstCC->prev = sp_curCC;
-          sp_curCC->next = spFirstCC;
-          spFirstCC = sp_curCC;
-          spFirstCC->prev = 0;
-          /*    nbConfig(spFirstCC);*/
-        }
+        unlinkConfig(cache, i);
+        pushFront(cache, i);
       }
-      else
-      {
-        sp_curCC = sp_curCC->next;
-      }
-    }
-    while(sp_curCC && !find);
-
-    if(find)
-    {
+      cache->hits++;
       *info = 0;
-    }
-    else
-    {
-      options->iparam[7]++;
-      *info = 1;
+      return;
     }
   }
+  cache->misses++;
+  options->iparam[7]++;
+  *info = 1;
 }
 
 void mlcp_direct_set_default(SolverOptions* options)
@@ -8,14 +8,31 @@
  * add configuration with mlcp_direct_addConfigFromWSolution to add configuration.
  * mlcp_direct_reset
  *
+ * The configurations are cached in options->solverData, so that several
+ * problems can be solved at the same time with different SolverOptions.
+ * When the matrix of the problem changes, call mlcp_direct_init again with
+ * options->iparam[SICONOS_IPARAM_MLCP_UPDATE_REQUIRED] = 1 to keep the
+ * configurations: they are refactorized when they are tried.
+ *
  */
 
+#include <stddef.h>       // for size_t
+
 #include "NumericsFwd.h"  // for MixedLinearComplementarityProblem, SolverOp...
 
-void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, int * zw);
-void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, double * wSol);
+void mlcp_direct_addConfig(MixedLinearComplementarityProblem* problem, SolverOptions* options, int * zw);
+void mlcp_direct_addConfigFromWSolution(MixedLinearComplementarityProblem* problem, SolverOptions* options, double * wSol);
 void mlcp_direct_init(MixedLinearComplementarityProblem* problem, SolverOptions* options);
-void mlcp_direct_reset(void);
+void mlcp_direct_reset(SolverOptions* options);
+
+/** number of solves of mlcp_direct with a cached configuration (hits) or
+ *  without (misses) since the last reset of the configurations
+ *  \param options the options used by mlcp_direct_init
+ *  \param[out] hits number of successful solves
+ *  \param[out] misses number of failed solves
+ *  \return the number of cached configurations
+ */
+int mlcp_direct_cache_statistics(SolverOptions* options, size_t * hits, size_t * misses);
 
 int mlcp_direct_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 int mlcp_direct_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
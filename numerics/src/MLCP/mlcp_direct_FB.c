@@ -33,13 +33,6 @@ dim(v)=nn
 #include "mlcp_FB.h"                            // for mlcp_FB_getNbDWork
 #include "mlcp_direct.h"                        // for mlcp_direct_getNbDWork
 
-static int sN;
-static int sM;
-
-static int * siWorkFB = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkFB = 0;
-static double * sdWorkDirect = 0;
 
 int mlcp_direct_FB_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
@@ -55,28 +48,14 @@ int mlcp_direct_FB_getNbDWork(MixedLinearComplementarityProblem* problem, Solver
 
 void mlcp_direct_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = mlcp_direct_getNbIWork(problem, options);
-  int dOffset = mlcp_direct_getNbDWork(problem, options);
-  siWorkFB = options->iWork + iOffset;
-  siWorkDirect = options->iWork;
-  sdWorkFB = options->dWork + dOffset;
-  sdWorkDirect = options->dWork;
-
+  /* the configurations of mlcp_direct are stored in options->solverData,
+   * the work arrays are only used by mlcp_FB. */
   mlcp_direct_init(problem, options);
-  options->dWork = sdWorkFB;
-  options->iWork = siWorkFB;
-
   mlcp_FB_init(problem, options);
-  options->dWork = sdWorkDirect;
-  options->iWork = siWorkDirect;
-
-
 }
-void mlcp_direct_FB_reset()
+void mlcp_direct_FB_reset(SolverOptions* options)
 {
-  mlcp_direct_reset();
+  mlcp_direct_reset(options);
   mlcp_FB_reset();
 }
 
@@ -93,7 +72,7 @@ void mlcp_direct_FB(MixedLinearComplementarityProblem* problem, double *z, doubl
       /*       for (i=0;i<problem->n+problem->m;i++){ */
       /*  printf("w[%d]=%f z[%d]=%f\t",i,w[i],i,z[i]);  */
       /*       } */
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
   }
 }
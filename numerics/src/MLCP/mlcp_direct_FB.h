@@ -14,7 +14,7 @@
 
 #include "NumericsFwd.h"  // for MixedLinearComplementarityProblem, SolverOp...
 void mlcp_direct_FB_init(MixedLinearComplementarityProblem* problem, SolverOptions* options);
-void mlcp_direct_FB_reset(void);
+void mlcp_direct_FB_reset(SolverOptions* options);
 
 int mlcp_direct_FB_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 int mlcp_direct_FB_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
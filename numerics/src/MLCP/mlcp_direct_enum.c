@@ -41,63 +41,39 @@ dim(v)=nn
 /* #define DEBUG_MESSAGES */
 #include "siconos_debug.h"
 
-static int sN;
-static int sM;
 
-static int * siWorkEnum = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkEnum = 0;
-static double * sdWorkDirect = 0;
+/* The configurations of mlcp_direct are stored in options->solverData,
+ * the work arrays are only used by mlcp_enum. */
 
 void mlcp_direct_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = mlcp_direct_getNbIWork(problem, options);
-  int dOffset = mlcp_direct_getNbDWork(problem, options);
-  siWorkEnum = options->iWork + iOffset;
-  siWorkDirect = options->iWork;
-  sdWorkEnum = options->dWork + dOffset;
-  sdWorkDirect = options->dWork;
   mlcp_direct_init(problem, options);
-
 }
-void mlcp_direct_enum_reset()
+void mlcp_direct_enum_reset(SolverOptions* options)
 {
-  mlcp_direct_reset();
-  siWorkEnum = 0;
-  siWorkDirect = 0;
-  sdWorkEnum = 0;
-  sdWorkDirect = 0;
+  mlcp_direct_reset(options);
 }
 
 void mlcp_direct_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
   DEBUG_BEGIN("mlcp_direct_enum(...)\n");
   DEBUG_PRINTF("options->iWork = %p\n",  options->iWork);
-  if(!siWorkEnum)
+  if(!options->solverData)
   {
     *info = 1;
     numerics_printf_verbose(0,"MLCP_DIRECT_ENUM error, call a non initialised method!!!!!!!!!!!!!!!!!!!!!\n");
     return;
   }
   /*First, try direct solver*/
-  options->dWork = sdWorkDirect;
-  options->iWork = siWorkDirect;
   mlcp_direct(problem, z, w, info, options);
   if(*info)
   {
     DEBUG_PRINT("Solver direct failed, so run the enum solver\n");
-    options->dWork = sdWorkEnum;
-    options->iWork = siWorkEnum;
     mlcp_enum(problem, z, w, info, options);
     if(!(*info))
     {
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
-    /* Come back to previous memory adress to ensure correct freeing */
-    options->dWork = sdWorkDirect;
-    options->iWork = siWorkDirect;
   }
   DEBUG_PRINTF("options->iWork = %p\n",  options->iWork);
   DEBUG_END("mlcp_direct_enum(...)\n");
@@ -18,6 +18,6 @@ int mlcp_direct_path_getNbIWork(MixedLinearComplementarityProblem* problem, Solv
 int mlcp_direct_path_getNbDWork(MixedLinearComplementarityProblem* problem, SolverOptions* options);
 
 void mlcp_direct_path_init(MixedLinearComplementarityProblem* problem, SolverOptions* options);
-void mlcp_direct_path_reset(void);
+void mlcp_direct_path_reset(SolverOptions* options);
 
 #endif //MLCP_DIRECT_PATH_H
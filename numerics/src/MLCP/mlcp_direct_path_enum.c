@@ -33,61 +33,37 @@ dim(v)=nn
 #include "mlcp_direct.h"                        // for mlcp_direct_getNbDWork
 #include "mlcp_path_enum.h"                     // for mlcp_path_enum, mlcp_...
 
-static int sN;
-static int sM;
-
-static int * siWorkPathEnum = 0;
-static int * siWorkDirect = 0;
-static double * sdWorkPathEnum = 0;
-static double * sdWorkDirect = 0;
 
 void mlcp_direct_path_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = mlcp_direct_getNbIWork(problem, options);
-  int dOffset = mlcp_direct_getNbDWork(problem, options);
-  siWorkPathEnum = options->iWork + iOffset;
-  siWorkDirect = options->iWork;
-  sdWorkPathEnum = options->dWork + dOffset;
-  sdWorkDirect = options->dWork;
+  /* the configurations of mlcp_direct are stored in options->solverData,
+   * the work arrays are only used by mlcp_path_enum. */
   mlcp_direct_init(problem, options);
-  options->dWork = sdWorkPathEnum;
-  options->iWork = siWorkPathEnum;
   mlcp_path_enum_init(problem, options);
-
 }
-void mlcp_direct_path_enum_reset()
+void mlcp_direct_path_enum_reset(SolverOptions* options)
 {
-  mlcp_direct_reset();
+  mlcp_direct_reset(options);
   mlcp_path_enum_reset();
-  siWorkPathEnum = 0;
-  siWorkDirect = 0;
-  sdWorkPathEnum = 0;
-  sdWorkDirect = 0;
 }
 
 void mlcp_direct_path_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
-  if(!siWorkPathEnum)
+  if(!options->solverData)
   {
     *info = 1;
     printf("MLCP_DIRECT_PATH_ENUM error, call a non initialised method!!!!!!!!!!!!!!!!!!!!!\n");
     return;
   }
   /*First, try direct solver*/
-  options->dWork = sdWorkDirect;
-  options->iWork = siWorkDirect;
   mlcp_direct(problem, z, w, info, options);
   if(*info)
   {
-    options->dWork = sdWorkPathEnum;
-    options->iWork = siWorkPathEnum;
     /*solver direct failed, so run the enum solver.*/
     mlcp_path_enum(problem, z, w, info, options);
     if(!(*info))
     {
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
   }
 }
@@ -22,20 +22,16 @@
 #include "mlcp_direct.h"                        // for mlcp_direct_addConfig...
 #include "mlcp_simplex.h"                       // for mlcp_simplex_init
 
-static int sN;
-static int sM;
 
 void mlcp_direct_simplex_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
   mlcp_direct_init(problem, options);
   mlcp_simplex_init(problem, options);
 
 }
-void mlcp_direct_simplex_reset()
+void mlcp_direct_simplex_reset(SolverOptions* options)
 {
-  mlcp_direct_reset();
+  mlcp_direct_reset(options);
   mlcp_simplex_reset();
 }
 
@@ -59,7 +55,7 @@ void mlcp_direct_simplex(MixedLinearComplementarityProblem* problem, double *z,
       /*       for (i=0;i<problem->n+problem->m;i++){ */
       /*  printf("w[%d]=%f z[%d]=%f\t",i,w[i],i,z[i]);  */
       /*       } */
-      mlcp_direct_addConfigFromWSolution(problem, w + sN);
+      mlcp_direct_addConfigFromWSolution(problem, options, w + problem->n);
     }
   }
 }
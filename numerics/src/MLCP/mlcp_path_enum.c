@@ -33,14 +33,6 @@ dim(v)=nn
 #include "SolverOptions.h"                      // for SolverOptions
 #include "mlcp_enum.h"                          // for mlcp_enum_getNbDWork
 
-static int sN;
-static int sM;
-
-static int * siWorkEnum = 0;
-static int * siWorkPath = 0;
-static double * sdWorkEnum = 0;
-static double * sdWorkPath = 0;
-
 int mlcp_path_enum_getNbIWork(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
   return mlcp_enum_getNbIWork(problem, options);
@@ -53,45 +45,27 @@ int mlcp_path_enum_getNbDWork(MixedLinearComplementarityProblem* problem, Solver
 
 void mlcp_path_enum_init(MixedLinearComplementarityProblem* problem, SolverOptions* options)
 {
-  sN = problem->n;
-  sM = problem->m;
-  int iOffset = 0;/* mlcp_path_getNbIWork(problem,options);*/
-  int dOffset = 0;/*mlcp_path_getNbDWork(problem,options);*/
-  siWorkEnum = options->iWork + iOffset;
-  siWorkPath = options->iWork;
-  sdWorkEnum = options->dWork + dOffset;
-  sdWorkPath = options->dWork;
+  /* the work arrays of options are only used by mlcp_enum */
   /*  mlcp_path_init(problem, options);*/
-
 }
 void mlcp_path_enum_reset()
 {
   /*mlcp_path_reset();*/
-  siWorkEnum = 0;
-  siWorkPath = 0;
-  sdWorkEnum = 0;
-  sdWorkPath = 0;
 }
 
 void mlcp_path_enum(MixedLinearComplementarityProblem* problem, double *z, double *w, int *info, SolverOptions* options)
 {
-  if(!siWorkEnum)
+  if(!options->dWork)
   {
     *info = 1;
     printf("MLCP_PATH_ENUM error, call a non initialised method!!!!!!!!!!!!!!!!!!!!!\n");
     return;
   }
-  /*First, try direct solver*/
-  //  options->dWork = sdWorkDirect;
-  //  options->iWork = siWorkDirect;
   mlcp_path(problem, z, w, info, options);
   if(*info)
   {
     printf("MLCP_PATH_ENUM: path failed, call enum\n");
-    options->dWork = sdWorkEnum;
-    options->iWork = siWorkEnum;
     /*solver direct failed, so run the enum solver.*/
     mlcp_enum(problem, z, w, info, options);
   }
 }
-
@@ -0,0 +1,134 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* Configurations cache of mlcp_direct: two SolverOptions are used
+ * alternately on the same problem, each one with its own cache. */
+
+#include <math.h>                               // for fabs
+#include <stdio.h>                              // for printf
+#include <stdlib.h>                             // for malloc, free
+#include "MLCP_Solvers.h"                       // for mlcp_driver_init, mlc...
+#include "MixedLinearComplementarityProblem.h"  // for MixedLinearComplement...
+#include "NonSmoothDrivers.h"                   // for mlcp_driver
+#include "NumericsMatrix.h"                     // for NM_create, NM_DENSE
+#include "SolverOptions.h"                      // for solver_options_create
+#include "mlcp_cst.h"                           // for SICONOS_MLCP_DIRECT_ENUM
+#include "mlcp_direct.h"                        // for mlcp_direct_cache_sta...
+
+/* the solution satisfies the equality and the complementarity */
+static int check_solution(MixedLinearComplementarityProblem* problem, double* z)
+{
+  int npm = problem->n + problem->m;
+  double* M = problem->M->matrix0;
+  for(int i = 0; i < npm; i++)
+  {
+    double r = problem->q[i];
+    for(int j = 0; j < npm; j++)
+      r += M[i + j * npm] * z[j];
+    if(i < problem->n && fabs(r) > 1e-10)
+      return 1;
+    if(i >= problem->n && (r < -1e-10 || z[i] < -1e-10 || fabs(r * z[i]) > 1e-10))
+      return 1;
+  }
+  return 0;
+}
+
+static int solve(MixedLinearComplementarityProblem* problem, SolverOptions* options,
+                 double q1, double q2)
+{
+  double z[3] = {0., 0., 0.};
+  double w[3] = {0., 0., 0.};
+  problem->q[1] = q1;
+  problem->q[2] = q2;
+  int info = mlcp_driver(problem, z, w, options);
+  return info || check_solution(problem, z);
+}
+
+static int check_statistics(SolverOptions* options, int size, size_t hits, size_t misses)
+{
+  size_t h, m;
+  int s = mlcp_direct_cache_statistics(options, &h, &m);
+  printf("configurations %i, hits %zu, misses %zu\n", s, h, m);
+  return s != size || h != hits || m != misses;
+}
+
+int main(void)
+{
+  int info = 0;
+  MixedLinearComplementarityProblem* problem = mixedLinearComplementarity_new();
+  problem->isStorageType1 = 1;
+  problem->n = 1;
+  problem->m = 2;
+  problem->M = NM_create(NM_DENSE, 3, 3);
+  problem->q = (double*)calloc(3, sizeof(double));
+  double M[9] = {2., 1., 1., -1., 2., 0., -1., 0., 2.};
+  for(int i = 0; i < 9; i++)
+    problem->M->matrix0[i] = M[i];
+
+  /* one configuration only, least recently used is replaced */
+  SolverOptions* small = solver_options_create(SICONOS_MLCP_DIRECT_ENUM);
+  small->iparam[SICONOS_IPARAM_MLCP_NUMBER_OF_CONFIGURATIONS] = 1;
+  SolverOptions* large = solver_options_create(SICONOS_MLCP_DIRECT_ENUM);
+  large->iparam[SICONOS_IPARAM_MLCP_NUMBER_OF_CONFIGURATIONS] = 4;
+  mlcp_driver_init(problem, small);
+  mlcp_driver_init(problem, large);
+
+  for(int k = 0; k < 2; k++)
+  {
+    info += solve(problem, small, -1., -1.);
+    info += solve(problem, large, -1., -1.);
+    info += solve(problem, small, 1., 1.);
+    info += solve(problem, large, 1., 1.);
+  }
+  info += check_statistics(small, 1, 0, 4);
+  info += check_statistics(large, 2, 2, 2);
+
+  /* the configurations are kept by a new init with an update of M */
+  problem->M->matrix0[4] = 3.;
+  large->iparam[SICONOS_IPARAM_MLCP_UPDATE_REQUIRED] = 1;
+  mlcp_driver_init(problem, large);
+  info += solve(problem, large, -1., -1.);
+  info += check_statistics(large, 2, 3, 2);
+
+  /* and reset otherwise */
+  large->iparam[SICONOS_IPARAM_MLCP_UPDATE_REQUIRED] = 0;
+  mlcp_driver_init(problem, large);
+  info += check_statistics(large, 0, 0, 0);
+
+  /* a copy of the options has its own cache */
+  SolverOptions* copy = solver_options_copy(large);
+  if(copy->solverData)
+    info++;
+  mlcp_driver_init(problem, copy);
+  info += solve(problem, copy, 1., 1.);
+  info += check_statistics(copy, 1, 0, 1);
+  info += check_statistics(large, 0, 0, 0);
+
+  mlcp_driver_reset(problem, copy);
+  mlcp_driver_reset(problem, small);
+  mlcp_driver_reset(problem, large);
+  solver_options_delete(copy);
+  free(copy);
+  solver_options_delete(small);
+  solver_options_delete(large);
+  free(small);
+  free(large);
+  mixedLinearComplementarity_free(problem);
+  printf("End of test, info = %i\n", info);
+  return info;
+}
@@ -113,6 +113,121 @@ int CSparseMatrix_aaxpby(const double alpha, const CSparseMatrix *A,
   return 1;
 
 }
+int CSparseMatrix_aTxpby(const double alpha, const CSparseMatrix *A,
+                         const double *restrict x,
+                         const double beta, double *restrict y)
+{
+  if(!CS_CSC(A) || !x || !y) return (0);	     /* check inputs */
+
+  CS_INT n = A->n;
+  const CS_INT *Ap = A->p;
+  const CS_INT *Ai = A->i;
+  const double *Ax = A->x;
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for(CS_INT j = 0 ; j < n ; j++)
+  {
+    double yj = 0.0;
+    for(CS_INT p = Ap [j] ; p < Ap [j+1] ; p++)
+    {
+      yj += Ax [p] * x [Ai [p]];
+    }
+    y[j] = beta * y[j] + alpha * yj;
+  }
+  return 1;
+}
+
+CSparseMatrix* CSparseMatrix_multiply(const CSparseMatrix *A, const CSparseMatrix *B)
+{
+  if(!CS_CSC(A) || !CS_CSC(B)) return NULL;
+  if(A->n != B->m) return NULL;
+
+  CS_INT m = A->m, n = B->n;
+  const CS_INT *Ap = A->p, *Ai = A->i, *Bp = B->p, *Bi = B->i;
+  const double *Ax = A->x, *Bx = B->x;
+
+  CSparseMatrix* C = cs_spalloc(m, n, 0, 1, 0);
+  if(!C) return NULL;
+  CS_INT *Cp = C->p;
+
+  /* phase 1: number of entries of each column of C */
+#ifdef WITH_OPENMP
+#pragma omp parallel
+#endif
+  {
+    CS_INT *w = (CS_INT*)malloc(m * sizeof(CS_INT));
+    for(CS_INT i = 0; i < m; i++) w[i] = -1;
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+    for(CS_INT j = 0; j < n; j++)
+    {
+      CS_INT nz = 0;
+      for(CS_INT p = Bp[j]; p < Bp[j+1]; p++)
+      {
+        CS_INT k = Bi[p];
+        for(CS_INT q = Ap[k]; q < Ap[k+1]; q++)
+        {
+          if(w[Ai[q]] != j)
+          {
+            w[Ai[q]] = j;
+            nz++;
+          }
+        }
+      }
+      Cp[j+1] = nz;
+    }
+    free(w);
+  }
+
+  Cp[0] = 0;
+  for(CS_INT j = 0; j < n; j++) Cp[j+1] += Cp[j];
+
+  if(!cs_sprealloc(C, Cp[n] > 0 ? Cp[n] : 1))
+    return cs_spfree(C);
+  CS_INT *Ci = C->i;
+  double *Cx = C->x;
+
+  /* phase 2: rows and values, in the order of cs_multiply */
+#ifdef WITH_OPENMP
+#pragma omp parallel
+#endif
+  {
+    CS_INT *w = (CS_INT*)malloc(m * sizeof(CS_INT));
+    double *xw = (double*)malloc(m * sizeof(double));
+    for(CS_INT i = 0; i < m; i++) w[i] = -1;
+#ifdef WITH_OPENMP
+#pragma omp for schedule(dynamic, 64)
+#endif
+    for(CS_INT j = 0; j < n; j++)
+    {
+      CS_INT nz = Cp[j];
+      for(CS_INT p = Bp[j]; p < Bp[j+1]; p++)
+      {
+        CS_INT k = Bi[p];
+        double beta = Bx[p];
+        for(CS_INT q = Ap[k]; q < Ap[k+1]; q++)
+        {
+          CS_INT i = Ai[q];
+          if(w[i] != j)
+          {
+            w[i] = j;
+            Ci[nz++] = i;
+            xw[i] = beta * Ax[q];
+          }
+          else xw[i] += beta * Ax[q];
+        }
+      }
+      for(CS_INT p = Cp[j]; p < nz; p++) Cx[p] = xw[Ci[p]];
+    }
+    free(w);
+    free(xw);
+  }
+  return C;
+}
+
 /* A <-- alpha*A */
 int CSparseMatrix_scal(const double alpha, const CSparseMatrix *A)
 {
@@ -252,6 +367,17 @@ int CSparseMatrix_lu_factorization(CS_INT order, const cs *A, double tol, CSpars
 
   return (S && cs_lu_A->N);
 }
+int CSparseMatrix_lu_refactorization(const cs *A, double tol, CSparseMatrix_factors * cs_lu_A)
+{
+  assert(A);
+  assert(cs_lu_A->S);
+  assert(cs_lu_A->n == A->n);
+  /* the symbolic analysis depends only on the pattern of A */
+  cs_nfree(cs_lu_A->N);
+  cs_lu_A->N = cs_lu(A, cs_lu_A->S, tol);
+
+  return (cs_lu_A->N != NULL);
+}
 int CSparseMatrix_chol_factorization(CS_INT order, const cs *A,  CSparseMatrix_factors * cs_chol_A)
 {
   assert(A);
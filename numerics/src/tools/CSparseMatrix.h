@@ -142,6 +142,16 @@ extern "C"
    */
   int CSparseMatrix_lu_factorization(CS_INT order, const CSparseMatrix *A, double tol, CSparseMatrix_factors * cs_lu_A);
 
+  /** compute a new LU factorization of A, reusing the symbolic analysis
+   * stored in cs_lu_A by a previous call to CSparseMatrix_lu_factorization
+   * with a matrix of the same sparsity pattern.
+   * \param A the sparse matrix
+   * \param tol the tolerance
+   * \param cs_lu_A the parameter structure that holds the factors
+   * \return 1 if the factorization was successful, 0 otherwise
+   */
+  int CSparseMatrix_lu_refactorization(const CSparseMatrix *A, double tol, CSparseMatrix_factors * cs_lu_A);
+
   /** compute a Cholesky factorization of A and store it in a workspace
    * \param order control if ordering is used
    * \param A the sparse matrix
@@ -210,6 +220,32 @@ extern "C"
   int CSparseMatrix_aaxpby(const double alpha, const CSparseMatrix *A, const double *x,
                            const double beta, double *y);
 
+  /** Transposed matrix vector multiplication : y = alpha*A^T*x+beta*y.
+   * Each entry of y is the product of a column of A with x, so that the
+   * columns are shared between the threads (OpenMP).
+   * The product A*x is obtained with the csc storage of A^T.
+   * \param[in] alpha matrix coefficient
+   * \param[in] A the sparse matrix (csc)
+   * \param[in] x pointer on a dense vector of size A->m
+   * \param[in] beta vector coefficient
+   * \param[in, out] y pointer on a dense vector of size A->n
+   * \return 0 if A x or y is NULL else 1
+   */
+  int CSparseMatrix_aTxpby(const double alpha, const CSparseMatrix *A, const double *x,
+                           const double beta, double *y);
+
+  /** Sparse matrix product C = A*B in two phases: the number of entries
+   * of each column of C is computed first, then the columns are filled,
+   * the columns being shared between the threads (OpenMP) in both phases.
+   * The entries are in the same order and have the same values as with
+   * cs_multiply.
+   * \param[in] A the sparse matrix (csc)
+   * \param[in] B the sparse matrix (csc)
+   * \return the product, NULL if A or B is not a csc matrix or if sizes
+   * mismatch
+   */
+  CSparseMatrix* CSparseMatrix_multiply(const CSparseMatrix *A, const CSparseMatrix *B);
+
   /** Allocate a CSparse matrix for future copy (as in NSM_copy)
    * \param m the matrix used as model
    * \return an newly allocated matrix
@@ -48,4 +48,10 @@
 
 #include "CSparseMatrix.h"
 
+/** Number of nonzero entries above which the products with a sparse
+ * matrix are shared between the OpenMP threads */
+#ifndef SICONOS_PARALLEL_NNZ_THRESHOLD
+#define SICONOS_PARALLEL_NNZ_THRESHOLD 20000
+#endif
+
 #endif // SparseMatrix_internal_H
@@ -84,6 +84,33 @@ NM_UMFPACK_WS* NM_UMFPACK_factorize(NumericsMatrix* A)
 }
 
 
+NM_UMFPACK_WS* NM_UMFPACK_refactorize(NumericsMatrix* A)
+{
+  NSM_linear_solver_params* params = NSM_linearSolverParams(A);
+  NM_UMFPACK_WS* umfpack_ws = (NM_UMFPACK_WS*) params->linear_solver_data;
+
+  if(!umfpack_ws || !umfpack_ws->symbolic)
+  {
+    return NM_UMFPACK_factorize(A);
+  }
+
+  /* the symbolic analysis is kept, only the numeric factors are computed */
+  CSparseMatrix* C = NM_csc(A);
+
+  UMFPACK_FN(free_numeric)(&(umfpack_ws->numeric));
+
+  CS_INT status = UMFPACK_FN(numeric)(C->p, C->i, C->x, umfpack_ws->symbolic, &(umfpack_ws->numeric), umfpack_ws->control, umfpack_ws->info);
+
+  if(status)
+  {
+    umfpack_ws->control[UMFPACK_PRL] = 1;
+    UMFPACK_FN(report_status)(umfpack_ws->control, status);
+    return NULL;
+  }
+
+  return umfpack_ws;
+}
+
 
 void NM_UMFPACK_free(void* p)
 {
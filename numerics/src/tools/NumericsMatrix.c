@@ -57,6 +57,9 @@
 #include "NM_MA57.h"
 #endif
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
 
 #ifdef __cplusplus
 #undef restrict
@@ -64,6 +67,18 @@
 #define restrict __restrict
 #endif
 
+/* The products with a sparse matrix are shared between the threads when
+ * it has at least SICONOS_PARALLEL_NNZ_THRESHOLD nonzero entries. */
+static int NM_parallel_product(size_t nnz)
+{
+#ifdef WITH_OPENMP
+  return omp_get_max_threads() > 1 && nnz >= SICONOS_PARALLEL_NNZ_THRESHOLD;
+#else
+  (void)nnz;
+  return 0;
+#endif
+}
+
 void NM_null(NumericsMatrix* A)
 {
 
@@ -212,7 +227,7 @@ static version_t NM_max_version(const NumericsMatrix* M)
   return NM_version(M, NM_latest_id(M));
 }
 
-static void NM_inc_version(NumericsMatrix* M, NM_types id)
+void NM_inc_version(NumericsMatrix* M, NM_types id)
 {
   version_t new_version = NM_max_version(M) + 1;
 
@@ -234,6 +249,89 @@ static void NM_inc_version(NumericsMatrix* M, NM_types id)
   }
 }
 
+/* counters of the sparse storages computed on demand */
+static size_t NM_conversions[NM_CONVERSION_NUMBER];
+static size_t NM_conversions_hits[NM_CONVERSION_NUMBER];
+
+static inline void NM_count_conversion(NM_conversion_t type, bool cached)
+{
+  size_t* counter = cached ? &NM_conversions_hits[type] : &NM_conversions[type];
+#pragma omp atomic
+  (*counter)++;
+}
+
+size_t NM_conversions_performed(NM_conversion_t type)
+{
+  return NM_conversions[type];
+}
+
+size_t NM_conversions_cached(NM_conversion_t type)
+{
+  return NM_conversions_hits[type];
+}
+
+void NM_conversions_reset(void)
+{
+  memset(NM_conversions, 0, sizeof(NM_conversions));
+  memset(NM_conversions_hits, 0, sizeof(NM_conversions_hits));
+}
+
+void NM_conversions_display(void)
+{
+  const char* names[NM_CONVERSION_NUMBER] =
+  {"triplet", "half triplet", "csc", "csc transpose", "csr"};
+  printf("NumericsMatrix conversions (performed / served from cache):\n");
+  for(int k = 0; k < NM_CONVERSION_NUMBER; ++k)
+    printf("  %-14s %zu / %zu\n", names[k], NM_conversions[k], NM_conversions_hits[k]);
+}
+
+/* version of the storage the sparse storages of A are computed from */
+static version_t NM_source_version(const NumericsMatrix* A)
+{
+  switch(A->storageType)
+  {
+  case NM_DENSE:
+  case NM_SPARSE_BLOCK:
+    return A->matrix1 ? NM_version(A, NM_SPARSE_BLOCK) : NM_version(A, NM_DENSE);
+  default:
+    return NSM_version(A->matrix2, A->matrix2->origin);
+  }
+}
+
+/* Check whether an existing sparse storage of A, computed from another
+ * storage, may be returned: true if it has been computed from the current
+ * version of the original storage, otherwise it is cleared. The original
+ * storage itself is always up to date. */
+static bool NM_sparse_storage_is_current(NumericsMatrix* A, NSM_t type,
+                                         NM_conversion_t conversion)
+{
+  if(A->storageType == NM_SPARSE && A->matrix2->origin == type)
+    return true;
+  if(NSM_version(A->matrix2, type) >= NM_source_version(A))
+  {
+    NM_count_conversion(conversion, true);
+    return true;
+  }
+  switch(type)
+  {
+  case NSM_TRIPLET:
+    NM_clearTriplet(A);
+    break;
+  case NSM_HALF_TRIPLET:
+    NM_clearHalfTriplet(A);
+    break;
+  case NSM_CSC:
+    NM_clearCSC(A);
+    break;
+  case NSM_CSR:
+    NM_clearCSR(A);
+    break;
+  default:
+    break;
+  }
+  return false;
+}
+
 
 void NM_prod_mv_3x3(int sizeX, int sizeY, NumericsMatrix* A,
                     double* const x, double* y)
@@ -264,7 +362,11 @@ void NM_prod_mv_3x3(int sizeX, int sizeY, NumericsMatrix* A,
     break;
   /* coordinate */
   case NM_SPARSE:
-    CSparseMatrix_aaxpby(alpha, NM_csc(A), x, beta, y);
+    if(NM_parallel_product(NSM_nnz(NM_csc(A))))
+      /* rows of A = columns of its transpose */
+      CSparseMatrix_aTxpby(alpha, NM_csc_trans(A), x, beta, y);
+    else
+      CSparseMatrix_aaxpby(alpha, NM_csc(A), x, beta, y);
     break;
 
   default:
@@ -1058,10 +1160,12 @@ void NM_entry(NumericsMatrix* M, int i, int j, double val)
   {
     // column major
     M->matrix0[i+j*M->size0] = val;
+    NM_inc_version(M, NM_DENSE);
     break;
   }
   case NM_SPARSE_BLOCK:
   {
+    /* version is incremented in SBM_entry */
     CHECK_RETURN(SBM_entry(M->matrix1, i, j, val));
     break;
   }
@@ -1074,18 +1178,21 @@ void NM_entry(NumericsMatrix* M, int i, int j, double val)
     {
       assert(M->matrix2->triplet);
       CHECK_RETURN(CSparseMatrix_entry(M->matrix2->triplet, i, j, val));
+      NSM_inc_version(M->matrix2, NSM_TRIPLET);
       break;
     }
     case NSM_HALF_TRIPLET:
     {
       assert(M->matrix2->half_triplet);
       CHECK_RETURN(CSparseMatrix_symmetric_entry(M->matrix2->triplet, i, j, val));
+      NSM_inc_version(M->matrix2, NSM_HALF_TRIPLET);
       break;
     }
     case NSM_CSC:
     {
       assert(M->matrix2->csc);
       CHECK_RETURN(CSparseMatrix_entry(NM_triplet(M), i, j, val));
+      NSM_inc_version(M->matrix2, NSM_TRIPLET);
       M->matrix2->origin= NSM_TRIPLET;
       NM_clearCSC(M);
       NM_csc(M);
@@ -2533,8 +2640,8 @@ void NM_clearCSCTranspose(NumericsMatrix* A)
       cs_spfree(A->matrix2->trans_csc);
     }
     A->matrix2->trans_csc = NULL;
+    NDV_reset(&(A->matrix2->trans_csc_version));
   }
-  /* no version for csc transpose as it is a terminal format */
 }
 
 void NM_clearCSR(NumericsMatrix* A)
@@ -2688,8 +2795,23 @@ void NM_copy_to_sparse(const NumericsMatrix* const A, NumericsMatrix* B, double
   }
   case NM_SPARSE_BLOCK:
   {
-    // XXX this is suboptimal since the matrix A might have already been converted
-    // to csc or triplet --xhub
+    const NumericsSparseMatrix* Asparse = A->matrix2;
+    if(A != B && Asparse && Asparse->triplet &&
+       NSM_version(Asparse, NSM_TRIPLET) >= NM_version(A, NM_SPARSE_BLOCK))
+    {
+      /* A has already been converted: copy its triplet storage */
+      NM_count_conversion(NM_CONVERSION_TRIPLET, true);
+      NM_clearTriplet(B);
+      NM_clearHalfTriplet(B);
+      NM_clearCSC(B);
+      NM_clearCSCTranspose(B);
+      NM_clearCSR(B);
+      B->matrix2->triplet = CSparseMatrix_alloc_for_copy(Asparse->triplet);
+      CSparseMatrix_copy(Asparse->triplet, B->matrix2->triplet);
+      B->matrix2->origin = NSM_TRIPLET;
+      NSM_inc_version(B->matrix2, NSM_TRIPLET);
+      break;
+    }
 
     B->matrix1 = A->matrix1;
     B->storageType = NM_SPARSE_BLOCK;
@@ -2881,8 +3003,10 @@ NumericsSparseMatrix* numericsSparseMatrix(NumericsMatrix* A)
 
 CSparseMatrix* NM_triplet(NumericsMatrix* A)
 {
-  if(!numericsSparseMatrix(A)->triplet)
+  if(!numericsSparseMatrix(A)->triplet ||
+     !NM_sparse_storage_is_current(A, NSM_TRIPLET, NM_CONVERSION_TRIPLET))
   {
+    NM_count_conversion(NM_CONVERSION_TRIPLET, false);
     switch(A->storageType)
     {
     case NM_DENSE:
@@ -2996,8 +3120,10 @@ CSparseMatrix* NM_triplet(NumericsMatrix* A)
 
 CSparseMatrix* NM_half_triplet(NumericsMatrix* A)
 {
-  if(!numericsSparseMatrix(A)->half_triplet)
+  if(!numericsSparseMatrix(A)->half_triplet ||
+     !NM_sparse_storage_is_current(A, NSM_HALF_TRIPLET, NM_CONVERSION_HALF_TRIPLET))
   {
+    NM_count_conversion(NM_CONVERSION_HALF_TRIPLET, false);
     switch(A->storageType)
     {
     case NM_DENSE:
@@ -3113,8 +3239,10 @@ CSparseMatrix* NM_csc(NumericsMatrix *A)
   DEBUG_BEGIN("NM_csc(NumericsMatrix *A)\n");
   assert(A);
 
-  if(!numericsSparseMatrix(A)->csc)
+  if(!numericsSparseMatrix(A)->csc ||
+     !NM_sparse_storage_is_current(A, NSM_CSC, NM_CONVERSION_CSC))
   {
+    NM_count_conversion(NM_CONVERSION_CSC, false);
     assert(A->matrix2);
     switch(A->matrix2->origin)
     {
@@ -3169,23 +3297,33 @@ CSparseMatrix* NM_csc(NumericsMatrix *A)
 
 CSparseMatrix* NM_csc_trans(NumericsMatrix* A)
 {
-  if(!numericsSparseMatrix(A)->trans_csc)
+  CSparseMatrix* csc = NM_csc(A);
+  NumericsSparseMatrix* nsm = A->matrix2;
+  if(nsm->trans_csc)
   {
-    assert(A->matrix2);
-    A->matrix2->trans_csc = cs_transpose(NM_csc(A), 1); /* value = 1
-                                                         * ->
-                                                         * allocation */
+    if(NDV_value(&(nsm->trans_csc_version)) == NSM_version(nsm, NSM_CSC))
+    {
+      NM_count_conversion(NM_CONVERSION_CSC_TRANS, true);
+      return nsm->trans_csc;
+    }
+    NM_clearCSCTranspose(A);
   }
 
-  return A->matrix2->trans_csc;
+  NM_count_conversion(NM_CONVERSION_CSC_TRANS, false);
+  nsm->trans_csc = cs_transpose(csc, 1); /* value = 1 -> allocation */
+  NDV_set_value(&(nsm->trans_csc_version), NSM_version(nsm, NSM_CSC));
+
+  return nsm->trans_csc;
 }
 
 CSparseMatrix* NM_csr(NumericsMatrix *A)
 {
   assert(A);
 
-  if(!numericsSparseMatrix(A)->csr)
+  if(!numericsSparseMatrix(A)->csr ||
+     !NM_sparse_storage_is_current(A, NSM_CSR, NM_CONVERSION_CSR))
   {
+    NM_count_conversion(NM_CONVERSION_CSR, false);
     assert(A->matrix2);
     switch(A->matrix2->origin)
     {
@@ -3198,12 +3336,10 @@ CSparseMatrix* NM_csr(NumericsMatrix *A)
                       NSM_version(A->matrix2, NSM_TRIPLET));
       break;
     }
-/* MB: there was a bug here */
-/*    case NSM_CSR:*/
     case NSM_CSC:
     {
-      A->matrix2->csr = NM_csc_to_csr(NM_csr(A));
-      NSM_set_version(A->matrix2, NSM_CSC,
+      A->matrix2->csr = NM_csc_to_csr(NM_csc(A));
+      NSM_set_version(A->matrix2, NSM_CSR,
                       NSM_version(A->matrix2, NSM_CSC));
       break;
     }
@@ -3259,7 +3395,15 @@ void NM_gemv(const double alpha, NumericsMatrix* A, const double *x,
   case NM_SPARSE:
   {
     assert(A->storageType == NM_SPARSE);
-    CHECK_RETURN(CSparseMatrix_aaxpby(alpha, NM_csc(A), x, beta, y));
+    if(NM_parallel_product(NSM_nnz(NM_csc(A))))
+    {
+      /* rows of A = columns of its transpose */
+      CHECK_RETURN(CSparseMatrix_aTxpby(alpha, NM_csc_trans(A), x, beta, y));
+    }
+    else
+    {
+      CHECK_RETURN(CSparseMatrix_aaxpby(alpha, NM_csc(A), x, beta, y));
+    }
     break;
   }
   default:
@@ -3284,7 +3428,15 @@ void NM_tgemv(const double alpha, NumericsMatrix* A, const double *x,
   case NM_SPARSE_BLOCK:
   case NM_SPARSE:
   {
-    CHECK_RETURN(CSparseMatrix_aaxpby(alpha, NM_csc_trans(A), x, beta, y));
+    if(NM_parallel_product(NSM_nnz(NM_csc(A))))
+    {
+      /* rows of A^T = columns of A, no transpose needed */
+      CHECK_RETURN(CSparseMatrix_aTxpby(alpha, NM_csc(A), x, beta, y));
+    }
+    else
+    {
+      CHECK_RETURN(CSparseMatrix_aaxpby(alpha, NM_csc_trans(A), x, beta, y));
+    }
     break;
   }
   default:
@@ -3520,7 +3672,8 @@ NumericsMatrix * NM_multiply(NumericsMatrix* A, NumericsMatrix* B)
     DEBUG_EXPR(cs_print((const cs *) NM_csc(A),0););
     DEBUG_EXPR(cs_print((const cs *) NM_csc(B),0););
     assert(A->size1 == B->size0 && "NM_gemm :: A->size1 != B->size0 ");
-    CSparseMatrix* C_csc = cs_multiply(NM_csc(A), NM_csc(B));
+    CSparseMatrix* C_csc = NM_parallel_product(NSM_nnz(NM_csc(A)) + NSM_nnz(NM_csc(B))) ?
+      CSparseMatrix_multiply(NM_csc(A), NM_csc(B)) : cs_multiply(NM_csc(A), NM_csc(B));
     DEBUG_EXPR(cs_print((const cs *) C_csc,0););
     assert(C_csc && "NM_gemm :: cs_multiply failed");
     NSM_fix_csc(C_csc);
@@ -3553,6 +3706,11 @@ NumericsMatrix * NM_multiply(NumericsMatrix* A, NumericsMatrix* B)
   {
     NM_version_copy(A, C);
   }
+  if(C->storageType == NM_SPARSE)
+  {
+    /* the other sparse storages are computed from the product */
+    NSM_set_version(C->matrix2, C->matrix2->origin, NSM_max_version(C->matrix2));
+  }
   return C;
   DEBUG_END("NM_multiply(...) \n")
 }
@@ -3638,7 +3796,8 @@ void NM_gemm(const double alpha, NumericsMatrix* A, NumericsMatrix* B,
     DEBUG_EXPR(cs_print((const cs *) NM_csc(A),0););
     DEBUG_EXPR(cs_print((const cs *) NM_csc(B),0););
     assert(A->size1 == B->size0 && "NM_gemm :: A->size1 != B->size0 ");
-    CSparseMatrix* tmp_matrix = cs_multiply(NM_csc(A), NM_csc(B));
+    CSparseMatrix* tmp_matrix = NM_parallel_product(NSM_nnz(NM_csc(A)) + NSM_nnz(NM_csc(B))) ?
+      CSparseMatrix_multiply(NM_csc(A), NM_csc(B)) : cs_multiply(NM_csc(A), NM_csc(B));
     DEBUG_EXPR(cs_print((const cs *) tmp_matrix,0););
     assert(tmp_matrix && "NM_gemm :: cs_multiply failed");
     NSM_fix_csc(tmp_matrix);
@@ -3874,6 +4033,30 @@ int NM_LU_factorize(NumericsMatrix* Ao)
         break;
       }
 #endif /* WITH_MUMPS */
+#ifdef WITH_UMFPACK
+      case NSM_UMFPACK:
+      {
+        numerics_printf_verbose(2, "NM_LU_factorize, using UMFPACK");
+
+        /* former factors of other values of the matrix */
+        if(p->linear_solver_data)
+        {
+          NM_UMFPACK_free(p);
+        }
+
+        if(!NM_UMFPACK_factorize(A))
+        {
+          numerics_printf_verbose(2, "NM_LU_factorize: UMFPACK factorization failed.");
+          NM_UMFPACK_free(p);
+          info = 1;
+        }
+        else if(!p->solver_free_hook)
+        {
+          p->solver_free_hook = &NM_UMFPACK_free;
+        }
+        break;
+      }
+#endif /* WITH_UMFPACK */
       default:
       {
         numerics_printf_verbose(0,"NM_LU_factorize, Unknown solver in NM_SPARSE case." );
@@ -3901,6 +4084,82 @@ int NM_LU_factorize(NumericsMatrix* Ao)
   return info;
 }
 
+int NM_LU_refactorize(NumericsMatrix* Ao)
+{
+  DEBUG_BEGIN(" NM_LU_refactorize(NumericsMatrix* Ao)\n");
+  int info = 0;
+  NumericsMatrix* A = Ao->destructible;
+
+  if(A->storageType != NM_SPARSE || !NSM_linearSolverParams(A)->linear_solver_data)
+  {
+    /* nothing to reuse */
+    NM_set_LU_factorized(Ao, false);
+    info = NM_LU_factorize(Ao);
+    DEBUG_END(" NM_LU_refactorize(NumericsMatrix* Ao)\n");
+    return info;
+  }
+
+  NSM_linear_solver_params* p = NSM_linearSolverParams(A);
+  switch (p->solver)
+  {
+  case NSM_CSPARSE:
+  {
+    numerics_printf_verbose(2, "NM_LU_refactorize, using CSparse");
+    info = !CSparseMatrix_lu_refactorization(NM_csc(A), DBL_EPSILON,
+                                             (CSparseMatrix_factors*) NSM_linear_solver_data(p));
+    if(info)
+    {
+      /* a further NM_LU_factorize starts from scratch */
+      NSM_clear_p(p);
+      p->solver_free_hook = NULL;
+    }
+    break;
+  }
+#ifdef WITH_MUMPS
+  case NSM_MUMPS:
+  {
+    numerics_printf_verbose(2, "NM_LU_refactorize, using MUMPS");
+    if(!NM_MUMPS_id(A)->job || NM_MUMPS_id(A)->job == -2)
+    {
+      /* no analysis to reuse */
+      NM_set_LU_factorized(Ao, false);
+      info = NM_LU_factorize(Ao);
+      DEBUG_END(" NM_LU_refactorize(NumericsMatrix* Ao)\n");
+      return info;
+    }
+    /* the values may have been reallocated */
+    NM_MUMPS_set_matrix(A);
+    NM_MUMPS(A, 2); /* factorization, the analysis is kept */
+    info = NM_MUMPS_id(A)->info[0];
+    if(info && verbose > 0)
+    {
+      fprintf(stderr,"NM_LU_refactorize: MUMPS fails : info(1)=%d, info(2)=%d\n", info, NM_MUMPS_id(A)->info[1]);
+    }
+    break;
+  }
+#endif /* WITH_MUMPS */
+#ifdef WITH_UMFPACK
+  case NSM_UMFPACK:
+  {
+    numerics_printf_verbose(2, "NM_LU_refactorize, using UMFPACK");
+    info = !NM_UMFPACK_refactorize(A);
+    break;
+  }
+#endif /* WITH_UMFPACK */
+  default:
+  {
+    NM_set_LU_factorized(Ao, false);
+    info = NM_LU_factorize(Ao);
+    DEBUG_END(" NM_LU_refactorize(NumericsMatrix* Ao)\n");
+    return info;
+  }
+  }
+
+  NM_set_LU_factorized(Ao, !info);
+  DEBUG_END(" NM_LU_refactorize(NumericsMatrix* Ao)\n");
+  return info;
+}
+
 int NM_LU_solve(NumericsMatrix* Ao, double *b, unsigned int nrhs)
 {
 
@@ -4007,6 +4266,26 @@ int NM_LU_solve(NumericsMatrix* Ao, double *b, unsigned int nrhs)
         break;
       }
 #endif /* WITH_MUMPS */
+#ifdef WITH_UMFPACK
+      case NSM_UMFPACK:
+      {
+        numerics_printf_verbose(2,"NM_LU_solve, using UMFPACK" );
+
+        NM_UMFPACK_WS* umfpack_ws = (NM_UMFPACK_WS*) NSM_linear_solver_data(p);
+        CSparseMatrix* C = NM_csc(A);
+        for(unsigned int j=0; j < nrhs ; j++ )
+        {
+          info = (int)UMFPACK_FN(wsolve)(UMFPACK_A, C->p, C->i, C->x, umfpack_ws->x, &b[j*A->size1], umfpack_ws->numeric, umfpack_ws->control, umfpack_ws->info, umfpack_ws->wi, umfpack_ws->wd);
+          if(info)
+          {
+            UMFPACK_FN(report_status)(umfpack_ws->control, (CS_INT)info);
+            break;
+          }
+          cblas_dcopy(C->n, umfpack_ws->x, 1, &b[j*A->size1], 1);
+        }
+        break;
+      }
+#endif /* WITH_UMFPACK */
       default:
       {
         fprintf(stderr, "NM_LU_solve: unknown sparse linearsolver %d\n", p->solver);
@@ -5260,6 +5539,66 @@ double NM_iterated_power_method(NumericsMatrix* A, double tol, int itermax)
   return eig;
 }
 
+double NM_iterated_inverse_power_method(NumericsMatrix* A, double tol, int itermax)
+{
+  int n = A->size0;
+  assert(A->size0 == A->size1);
+
+  /* the factors are kept in a copy of A and reused by all the solves,
+   * A itself is not modified */
+  NumericsMatrix* Atmp = NM_new();
+  NM_copy(A, Atmp);
+
+  double eig = 0.0, eig_old = 2*tol;
+
+  double * q = (double *) malloc(n*sizeof(double));
+  double * z = (double *) malloc(n*sizeof(double));
+
+  srand(time(NULL));
+  for(int i = 0; i < n ; i++)
+  {
+    q[i] = (rand()/(double)RAND_MAX);
+  }
+  double norm = cblas_dnrm2(n, q, 1);
+  cblas_dscal(n, 1.0/norm, q, 1);
+
+  int k =0;
+  double criteria = 1.0;
+
+  while((criteria > tol) && k < itermax)
+  {
+    /* z = A^{-1} q */
+    cblas_dcopy(n, q, 1, z, 1);
+    if(NM_LU_solve(Atmp, z, 1))
+    {
+      numerics_warning("NM_iterated_inverse_power_method", "problem in NM_LU_solve");
+      eig = 0.0;
+      break;
+    }
+
+    eig_old=eig;
+    eig = cblas_ddot(n, q, 1, z, 1);
+
+    norm = cblas_dnrm2(n, z, 1);
+    cblas_dscal(n, 1.0/norm, z, 1);
+    cblas_dcopy(n, z, 1, q, 1);
+
+    k++;
+    if(fabs(eig_old) > DBL_EPSILON)
+      criteria = fabs((eig-eig_old)/eig_old);
+    else
+      criteria = fabs((eig-eig_old));
+  }
+
+  free(q);
+  free(z);
+  NM_clear(Atmp);
+  free(Atmp);
+
+  /* eig is the largest eigenvalue of A^{-1} */
+  return (eig != 0.0) ? 1.0/eig : 0.0;
+}
+
 int NM_max_by_columns(NumericsMatrix *A, double * max)
 {
 
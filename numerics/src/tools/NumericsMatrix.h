@@ -119,6 +119,17 @@ typedef enum {
   NM_PRESERVE       /**< keep the matrix as-is (useful for the dense case) */
 } NM_gesv_opts;
 
+/*! Sparse storages computed on demand from the storage of a NumericsMatrix,
+ * see NM_conversions_performed and NM_conversions_cached */
+typedef enum {
+  NM_CONVERSION_TRIPLET,      /**< NM_triplet */
+  NM_CONVERSION_HALF_TRIPLET, /**< NM_half_triplet */
+  NM_CONVERSION_CSC,          /**< NM_csc */
+  NM_CONVERSION_CSC_TRANS,    /**< NM_csc_trans */
+  NM_CONVERSION_CSR,          /**< NM_csr */
+  NM_CONVERSION_NUMBER        /**< number of computed storages */
+} NM_conversion_t;
+
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 extern "C"
 {
@@ -222,6 +233,26 @@ extern "C"
    */
   CSparseMatrix* NM_csr(NumericsMatrix *A);
 
+  /** Number of conversions computed by NM_triplet, NM_half_triplet,
+   * NM_csc, NM_csc_trans and NM_csr since the last reset. A storage is
+   * computed again only if the storage it comes from has a newer version.
+   * \param type the computed storage
+   * \return the number of conversions
+   */
+  size_t NM_conversions_performed(NM_conversion_t type);
+
+  /** Number of requests served by an up to date storage since the last reset.
+   * \param type the computed storage
+   * \return the number of requests
+   */
+  size_t NM_conversions_cached(NM_conversion_t type);
+
+  /** Reset the counters of conversions. */
+  void NM_conversions_reset(void);
+
+  /** Print the counters of conversions. */
+  void NM_conversions_display(void);
+
   /** fill an existing NumericsMatrix struct
    * \param[in,out] M the struct to fill
    * \param storageType the type of storage
@@ -755,6 +786,16 @@ extern "C"
    * \param[in] A the NumericsMatrix
    * \return an int, 0 means the matrix has been factorized. */
   int NM_LU_factorize(NumericsMatrix* A);
+
+  /** LU factorization of a sparse matrix whose values have changed
+   * since the last factorization, but not its sparsity pattern: the
+   * symbolic analysis (ordering, structure of the factors) of the
+   * previous factorization is reused and only the numeric factors are
+   * computed (CSparse, MUMPS and UMFPACK). Without a previous
+   * factorization, this is NM_LU_factorize.
+   * \param[in] A the NumericsMatrix
+   * \return an int, 0 means the matrix has been factorized. */
+  int NM_LU_refactorize(NumericsMatrix* A);
   int NM_Cholesky_factorize(NumericsMatrix* A);
   int NM_LDLT_factorize(NumericsMatrix* A);
 
@@ -939,6 +980,15 @@ extern "C"
    * \return the maximum eigenvalue*/
   double NM_iterated_power_method(NumericsMatrix* A, double tol, int itermax);
 
+  /** Compute the eigenvalue of smallest magnitude with the inverse iterated
+   * power method. A is factorized once (LU on a copy) and each iteration
+   * is a solve, the inverse of A is never formed.
+   * \param A the matrix
+   * \param tol relative tolerance on the eigenvalue
+   * \param itermax maximum number of iterations
+   * \return the eigenvalue of smallest magnitude, 0 if A is singular*/
+  double NM_iterated_inverse_power_method(NumericsMatrix* A, double tol, int itermax);
+
   /* Compute the maximum values by columns
    *  \param A the matrix
    *  \param max the vector of max that must be preallocated
@@ -997,6 +1047,13 @@ extern "C"
    */
   void NM_reset_versions(NumericsMatrix* M);
 
+  /* Increment the version of a storage whose values have been modified in
+   * place. The sparse storages computed from it are updated on next access.
+   *\param M the NumericsMatrix,
+   *\param id NM_DENSE or NM_SPARSE_BLOCK (see NSM_inc_version for NM_SPARSE)
+   */
+  void NM_inc_version(NumericsMatrix* M, NM_types id);
+
 
 #ifdef WITH_OPENSSL
   /* Compute sha1 hash of matrix values. Matrices of differents size and same
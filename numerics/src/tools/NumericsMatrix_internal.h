@@ -82,6 +82,14 @@ typedef struct {
    */
   NM_UMFPACK_WS* NM_UMFPACK_factorize(NumericsMatrix* A);
 
+  /** Compute the numeric factors of a matrix whose sparsity pattern is
+   * the one of the previous factorization: the symbolic analysis is kept.
+   * Without a previous factorization, NM_UMFPACK_factorize is called.
+   * \param A the matrix to factorize
+   * \return the workspace containing the factorized form and other info
+   */
+  NM_UMFPACK_WS* NM_UMFPACK_refactorize(NumericsMatrix* A);
+
 #endif
 
 #ifdef WITH_SUPERLU
@@ -138,6 +138,7 @@ void NSM_reset_versions(NumericsSparseMatrix* M)
   NSM_reset_version(M, NSM_HALF_TRIPLET);
   NSM_reset_version(M, NSM_CSC);
   NSM_reset_version(M, NSM_CSR);
+  NDV_reset(&(M->trans_csc_version));
 }
 
 
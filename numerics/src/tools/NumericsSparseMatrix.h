@@ -99,6 +99,8 @@ extern "C"
                                     /**< solver-specific parameters */
 
     NumericsDataVersion versions[5];
+    NumericsDataVersion trans_csc_version; /**< version of the csc matrix
+                                            * trans_csc is computed from */
   };
 
 
@@ -277,8 +277,9 @@ SolverOptions * solver_options_copy(SolverOptions* source)
   if(source->callback)
     options->callback = source->callback; // Note FP: is it really safe to create pointer link here?
 
-  if(source->solverData)
-    options->solverData =source->solverData;
+  // solverData is released by solver_options_delete: it is not shared,
+  // the copy gets its own one when its solver is initialized.
+  options->solverData = NULL;
 
   if(source->solverParameters)
     options->solverParameters =source->solverParameters;
@@ -143,8 +143,9 @@ extern "C"
 
   /** Copy an existing set of options, to create a new one.
 
-      Warning : callback, solverData and solverParameters of
+      Warning : callback and solverParameters of
       the new structure are pointer links to those of the original one!
+      solverData is not copied (NULL).
 
       \param source an existing solver options structure
       \return a pointer to options set, ready to use by a driver.
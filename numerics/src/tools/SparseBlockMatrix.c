@@ -57,6 +57,9 @@ static void SBM_inc_version(SparseBlockStructuredMatrix* M)
   NDV_inc(&(M->version));
 }
 
+/* release of the (aligned) contiguous storage of the blocks */
+static void SBM_arena_release(double * arena);
+
 void SBM_null(SparseBlockStructuredMatrix* sbm)
 {
   sbm->nbblocks = 0;
@@ -70,6 +73,8 @@ void SBM_null(SparseBlockStructuredMatrix* sbm)
   sbm->index1_data = NULL;
   sbm->index2_data = NULL;
   sbm->diagonal_blocks = NULL;
+  sbm->arena = NULL;
+  sbm->arena_size = 0;
 
   NDV_reset(&(sbm->version));
 }
@@ -112,19 +117,26 @@ void SBM_clear(SparseBlockStructuredMatrix *sbm)
     sbm->blocksize1 = NULL;
   }
 
-  for(unsigned int i = 0 ; i < sbm->nbblocks ; i++)
+  if(sbm->arena)
+  {
+    SBM_arena_free(sbm);
+  }
+  else
   {
-    if(sbm->block[i])
+    for(unsigned int i = 0 ; i < sbm->nbblocks ; i++)
     {
-      free(sbm->block[i]);
-      sbm->block[i] = NULL;
+      if(sbm->block[i])
+      {
+        free(sbm->block[i]);
+        sbm->block[i] = NULL;
+      }
     }
-  }
 
-  if(sbm->block)
-  {
-    free(sbm->block);
-    sbm->block = NULL;
+    if(sbm->block)
+    {
+      free(sbm->block);
+      sbm->block = NULL;
+    }
   }
 
 
@@ -322,50 +334,47 @@ void SBM_gemv(unsigned int sizeX, unsigned int sizeY, double alpha, const Sparse
   assert(sizeX == A->blocksize1[A->blocknumber1 - 1]);
   assert(sizeY == A->blocksize0[A->blocknumber0 - 1]);
 
-  /* Column (block) position of the current block*/
-  size_t colNumber;
-  /* Number of rows/columns of the current block */
-  unsigned int nbRows, nbColumns;
-  /* Position of the sub-block of x multiplied by the sub-block of A */
-  unsigned int posInX = 0;
-  /* Position of the sub-block of y, result of the product */
-  unsigned int posInY = 0;
-
   /* Loop over all non-null blocks
      Works whatever the ordering order of the block is, in A->block
   */
   cblas_dscal(sizeY, beta, y, 1);
 
+  /* the block rows write in distinct parts of y and are shared between
+   * the threads for large matrices (the blocks are mostly 3x3) */
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) if(9 * A->nbblocks >= SICONOS_PARALLEL_NNZ_THRESHOLD)
+#endif
   for(unsigned int currentRowNumber = 0 ; currentRowNumber < A->filled1 - 1; ++currentRowNumber)
   {
     /* Get dim. of the current block */
-    nbRows = A->blocksize0[currentRowNumber];
+    unsigned int nbRows = A->blocksize0[currentRowNumber];
     if(currentRowNumber != 0)
       nbRows -= A->blocksize0[currentRowNumber - 1];
     assert((nbRows <= sizeY));
+    /* Position of the sub-block of y, result of the product */
+    unsigned int posInY = 0;
+    if(currentRowNumber != 0)
+      posInY += A->blocksize0[currentRowNumber - 1];
     for(size_t blockNum = A->index1_data[currentRowNumber];
         blockNum < A->index1_data[currentRowNumber + 1]; ++blockNum)
     {
       assert(blockNum < A->filled2);
 
-      colNumber = A->index2_data[blockNum];
+      /* Column (block) position of the current block*/
+      size_t colNumber = A->index2_data[blockNum];
 
       assert(colNumber < sizeX);
 
-      nbColumns = A->blocksize1[colNumber];
+      unsigned int nbColumns = A->blocksize1[colNumber];
       if(colNumber != 0)
         nbColumns -= A->blocksize1[colNumber - 1];
 
       assert((nbColumns <= sizeX));
 
       /* Get position in x of the sub-block multiplied by A sub-block */
-      posInX = 0;
+      unsigned int posInX = 0;
       if(colNumber != 0)
         posInX += A->blocksize1[colNumber - 1];
-      /* Get position in y for the ouput sub-block, result of the product */
-      posInY = 0;
-      if(currentRowNumber != 0)
-        posInY += A->blocksize0[currentRowNumber - 1];
       /* Computes y[] += currentBlock*x[] */
       if(nbRows == 3 && nbColumns == 3)
       {
@@ -399,6 +408,9 @@ void SBM_gemv_3x3(unsigned int sizeX, unsigned int sizeY, const SparseBlockStruc
      Works whatever the ordering order of the block is, in A->block
   */
 
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static) if(9 * A->nbblocks >= SICONOS_PARALLEL_NNZ_THRESHOLD)
+#endif
   for(unsigned int currentRowNumber = 0 ; currentRowNumber < A->filled1 - 1; ++currentRowNumber)
   {
     /* Get dim. of the current block */
@@ -2302,13 +2314,35 @@ int SBM_copy(const SparseBlockStructuredMatrix* const A, SparseBlockStructuredMa
   if(B->nbblocks < A->nbblocks)
   {
     need_blocks = 1;
-    for(unsigned i=0; i<B->nbblocks; ++i)
+    if(B->arena)
     {
-      free(B->block [i]);
-      B->block [i] = NULL;
+      SBM_arena_free(B);
+    }
+    else
+    {
+      for(unsigned i=0; i<B->nbblocks; ++i)
+      {
+        free(B->block [i]);
+        B->block [i] = NULL;
+      }
     }
     B->block = (double **) realloc(B->block, A->nbblocks * sizeof(double *));
   }
+  else if(B->arena && copyBlock)
+  {
+    /* the blocks of B are views into its arena, whose layout depends on
+       the pattern that is going to be overwritten. */
+    need_blocks = 1;
+    SBM_arena_free(B);
+    B->block = (double **) malloc(A->nbblocks * sizeof(double *));
+  }
+  else if(B->arena)
+  {
+    /* B will only store pointers on the blocks of A */
+    SBM_arena_release(B->arena);
+    B->arena = NULL;
+    B->arena_size = 0;
+  }
   B->nbblocks = A->nbblocks;
 
   if(B->blocknumber0 < A->blocknumber0)
@@ -3288,10 +3322,22 @@ void SBMfree(SparseBlockStructuredMatrix* A, unsigned int level)
 
   if(level & NUMERICS_SBM_FREE_BLOCK)
   {
-    for(unsigned int i = 0; i < A->nbblocks; i++)
-      free(A->block[i]);
+    if(A->arena)
+    {
+      SBM_arena_release(A->arena);
+      A->arena = NULL;
+      A->arena_size = 0;
+    }
+    else
+    {
+      for(unsigned int i = 0; i < A->nbblocks; i++)
+        free(A->block[i]);
+    }
   }
+  /* without NUMERICS_SBM_FREE_BLOCK, the blocks are kept, and so is the
+     contiguous storage they are views into (A->arena). */
   free(A->block);
+  A->block = NULL;
   free(A->blocksize0);
   free(A->blocksize1);
   free(A->index1_data);
@@ -3304,6 +3350,158 @@ void SBMfree(SparseBlockStructuredMatrix* A, unsigned int level)
   }
 }
 
+/* alignment of the contiguous storage of the blocks: one cache line */
+#define SBM_ARENA_ALIGNMENT 64
+
+static double * SBM_arena_malloc(size_t size)
+{
+  void * p = NULL;
+  size_t nbytes = (size ? size : 1) * sizeof(double);
+#if defined(_WIN32)
+  p = _aligned_malloc(nbytes, SBM_ARENA_ALIGNMENT);
+#else
+  if(posix_memalign(&p, SBM_ARENA_ALIGNMENT, nbytes))
+    p = NULL;
+#endif
+  return (double *) p;
+}
+
+static void SBM_arena_release(double * arena)
+{
+#if defined(_WIN32)
+  _aligned_free(arena);
+#else
+  free(arena);
+#endif
+}
+
+int SBM_arena_alloc(SparseBlockStructuredMatrix* M)
+{
+  assert(M);
+  DEBUG_BEGIN("SBM_arena_alloc(...)\n");
+
+  /* Total size and offsets of the blocks, in the block number order */
+  size_t size = 0;
+  for(size_t row = 0; row + 1 < M->filled1; ++row)
+  {
+    unsigned int nbRows = M->blocksize0[row];
+    if(row != 0)
+      nbRows -= M->blocksize0[row - 1];
+    for(size_t blockNum = M->index1_data[row];
+        blockNum < M->index1_data[row + 1]; ++blockNum)
+    {
+      size_t colNumber = M->index2_data[blockNum];
+      unsigned int nbColumns = M->blocksize1[colNumber];
+      if(colNumber != 0)
+        nbColumns -= M->blocksize1[colNumber - 1];
+      size += (size_t)nbRows * nbColumns;
+    }
+  }
+
+  if(!M->arena || M->arena_size < size)
+  {
+    if(M->arena)
+      SBM_arena_release(M->arena);
+    M->arena = SBM_arena_malloc(size);
+    if(!M->arena)
+    {
+      M->arena_size = 0;
+      numerics_warning("SBM_arena_alloc", "allocation of %zu doubles failed", size);
+      DEBUG_END("SBM_arena_alloc(...)\n");
+      return 1;
+    }
+    M->arena_size = size;
+  }
+
+  M->block = (double **) realloc(M->block, (M->nbblocks ? M->nbblocks : 1) * sizeof(double *));
+
+  size_t offset = 0;
+  for(size_t row = 0; row + 1 < M->filled1; ++row)
+  {
+    unsigned int nbRows = M->blocksize0[row];
+    if(row != 0)
+      nbRows -= M->blocksize0[row - 1];
+    for(size_t blockNum = M->index1_data[row];
+        blockNum < M->index1_data[row + 1]; ++blockNum)
+    {
+      size_t colNumber = M->index2_data[blockNum];
+      unsigned int nbColumns = M->blocksize1[colNumber];
+      if(colNumber != 0)
+        nbColumns -= M->blocksize1[colNumber - 1];
+      M->block[blockNum] = &M->arena[offset];
+      offset += (size_t)nbRows * nbColumns;
+    }
+  }
+  assert(offset == size);
+  DEBUG_PRINTF("arena of %zu doubles for %u blocks\n", size, M->nbblocks);
+  DEBUG_END("SBM_arena_alloc(...)\n");
+  return 0;
+}
+
+int SBM_pack_blocks_from(SparseBlockStructuredMatrix* M, double ** src)
+{
+  assert(M);
+  assert(src);
+  assert(src != M->block);
+
+  int info = SBM_arena_alloc(M);
+  if(info)
+    return info;
+
+  for(size_t row = 0; row + 1 < M->filled1; ++row)
+  {
+    unsigned int nbRows = M->blocksize0[row];
+    if(row != 0)
+      nbRows -= M->blocksize0[row - 1];
+    for(size_t blockNum = M->index1_data[row];
+        blockNum < M->index1_data[row + 1]; ++blockNum)
+    {
+      size_t colNumber = M->index2_data[blockNum];
+      unsigned int nbColumns = M->blocksize1[colNumber];
+      if(colNumber != 0)
+        nbColumns -= M->blocksize1[colNumber - 1];
+      memcpy(M->block[blockNum], src[blockNum], (size_t)nbRows * nbColumns * sizeof(double));
+    }
+  }
+  SBM_inc_version(M);
+  return 0;
+}
+
+int SBM_pack_blocks(SparseBlockStructuredMatrix* M)
+{
+  assert(M);
+  if(M->arena)
+    return 0;
+
+  double ** old_blocks = M->block;
+  M->block = NULL;
+  int info = SBM_pack_blocks_from(M, old_blocks);
+  if(info)
+  {
+    free(M->block);
+    M->block = old_blocks;
+    return info;
+  }
+
+  for(unsigned int i = 0; i < M->nbblocks; ++i)
+    free(old_blocks[i]);
+  free(old_blocks);
+  return 0;
+}
+
+void SBM_arena_free(SparseBlockStructuredMatrix* M)
+{
+  assert(M);
+  if(!M->arena)
+    return;
+
+  SBM_arena_release(M->arena);
+  M->arena = NULL;
+  M->arena_size = 0;
+  free(M->block);
+  M->block = NULL;
+}
+
 //#define SBM_DEBUG_SBM_row_to_dense
 void SBM_row_to_dense(const SparseBlockStructuredMatrix* const A, int row, double *denseMat, int rowPos, int rowNb)
 {
@@ -3371,6 +3569,8 @@ void SBM_row_permutation(unsigned int *rowIndex, SparseBlockStructuredMatrix* A,
   int nbCol = A->blocknumber1;
   C->nbblocks = A->nbblocks;
   C->block = (double**)malloc(A->nbblocks * sizeof(double*));
+  C->arena = NULL;
+  C->arena_size = 0;
   C->blocknumber0 = A->blocknumber0;
   C->blocknumber1 = A->blocknumber1;
   C->blocksize0 = (unsigned int*)malloc(nbRow * sizeof(unsigned int));
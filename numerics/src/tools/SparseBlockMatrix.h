@@ -130,6 +130,12 @@ struct SparseBlockStructuredMatrix
   /* the indices of the diagonal blocks */
   unsigned int * diagonal_blocks;
 
+  /* contiguous storage of all the blocks (see SBM_pack_blocks). When
+     not NULL, block[i] are views into arena and arena owns the values */
+  double * arena;
+  /* the capacity of arena (number of doubles) */
+  size_t arena_size;
+
   NumericsDataVersion version; /**< version of storage */
 };
 
@@ -340,11 +346,47 @@ extern "C"
   void SBM_clear(SparseBlockStructuredMatrix * blmat);
 
   /** To free a SBM matrix (for example allocated by NM_new_from_file).
+   * If the blocks are packed (SBM_arena_alloc()) and NUMERICS_SBM_FREE_BLOCK
+   * is not set, the contiguous storage A->arena is not released either.
    * \param[in] A the SparseBlockStructuredMatrix that mus be de-allocated.
    * \param[in] level use NUMERICS_SBM_FREE_BLOCK | NUMERICS_SBM_FREE_SBM
    */
   void SBMfree(SparseBlockStructuredMatrix* A, unsigned int level);
 
+  /** Allocate (or reuse) a contiguous, 64-bytes aligned storage for all the
+   *  blocks of M and make M->block[i] point into it. The blocks are laid out
+   *  in the order of their block number, i.e. row by row as they are
+   *  traversed by SBM_gemv() or the Gauss-Seidel solvers. The values are
+   *  not initialized. The sparsity pattern (index1_data, index2_data,
+   *  blocksize0, blocksize1) must be set.
+   *  M->block is (re)allocated and becomes owned by M.
+   * \param[in,out] M the matrix
+   * \return 0 if ok
+   */
+  int SBM_arena_alloc(SparseBlockStructuredMatrix* M);
+
+  /** Copy the blocks src[i] into the contiguous storage of M (allocated with
+   *  SBM_arena_alloc() if needed). src must follow the sparsity pattern of M
+   *  and must not alias M->block.
+   * \param[in,out] M the matrix
+   * \param[in] src the list of M->nbblocks blocks to be copied
+   * \return 0 if ok
+   */
+  int SBM_pack_blocks_from(SparseBlockStructuredMatrix* M, double ** src);
+
+  /** Move the blocks of M, allocated one by one, into a contiguous storage.
+   *  The former blocks are freed. Nothing is done if M is already packed.
+   * \param[in,out] M the matrix
+   * \return 0 if ok
+   */
+  int SBM_pack_blocks(SparseBlockStructuredMatrix* M);
+
+  /** Release the contiguous storage of M and the array of block pointers.
+   *  Nothing is done if M is not packed.
+   * \param[in,out] M the matrix
+   */
+  void SBM_arena_free(SparseBlockStructuredMatrix* M);
+
   /** Screen display of the matrix content
       \param m the matrix to be displayed
    */
@@ -0,0 +1,72 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef PROJECTION_BLOCKS_H
+#define PROJECTION_BLOCKS_H
+
+/*! \file projection_blocks.h
+ *  \brief cone projections of a block of SIMD_BLOCK vectors, inlined in
+ *  the batched kernels (see simd_clones.h)
+ */
+
+#include <math.h>          // for sqrt
+#include "simd_clones.h"   // for SIMD_BLOCK
+
+/* Projection of a block of SIMD_BLOCK vectors in SoA layout, without
+   branch. The operations of projectionOnCone are kept in the same order
+   so that both give the same results. The denominator normT is replaced by
+   1 where the projection is not on the boundary (normT > 0 otherwise). */
+static inline void projection_on_cone_block(double* restrict r0, double* restrict r1,
+                                            double* restrict r2, const double* restrict mu)
+{
+  for(unsigned int i = 0; i < SIMD_BLOCK; i++)
+  {
+    double m = mu[i];
+    double normT = sqrt(r1[i] * r1[i] + r2[i] * r2[i]);
+    int dual = m * normT <= - r0[i];
+    int inside = normT <= m * r0[i];
+    double a = (m * normT + r0[i]) / (m * m + 1.0);
+    double d = normT > 0.0 ? normT : 1.0;
+    double a1 = m * a * r1[i] / d;
+    double a2 = m * a * r2[i] / d;
+    r0[i] = dual ? 0.0 : (inside ? r0[i] : a);
+    r1[i] = dual ? 0.0 : (inside ? r1[i] : a1);
+    r2[i] = dual ? 0.0 : (inside ? r2[i] : a2);
+  }
+}
+
+static inline void projection_on_dual_cone_block(double* restrict u0, double* restrict u1,
+                                                 double* restrict u2, const double* restrict mu)
+{
+  for(unsigned int i = 0; i < SIMD_BLOCK; i++)
+  {
+    double m = mu[i];
+    double normT = sqrt(u1[i] * u1[i] + u2[i] * u2[i]);
+    int dual = normT <= - m * u0[i];
+    int inside = m * normT <= u0[i];
+    double a = (normT + m * u0[i]) / (m * m + 1.0);
+    double d = normT > 0.0 ? normT : 1.0;
+    double a1 = a * u1[i] / d;
+    double a2 = a * u2[i] / d;
+    u0[i] = dual ? 0.0 : (inside ? u0[i] : m * a);
+    u1[i] = dual ? 0.0 : (inside ? u1[i] : a1);
+    u2[i] = dual ? 0.0 : (inside ? u2[i] : a2);
+  }
+}
+
+#endif
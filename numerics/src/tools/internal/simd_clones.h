@@ -0,0 +1,43 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+#ifndef SIMD_CLONES_H
+#define SIMD_CLONES_H
+
+/*! \file simd_clones.h
+ *  \brief runtime selection of the instruction set of the batched kernels
+ *
+ *  A function declared with SIMD_CLONES is compiled for AVX-512, AVX2 and
+ *  the default target; the version used is chosen by the loader from the
+ *  processor (GNU ifunc). Elsewhere only the default version exists.
+ *
+ *  The batched kernels work on blocks of SIMD_BLOCK contacts stored in
+ *  SoA layout, the loops over a block have a fixed length and no branch
+ *  so that the compiler vectorizes them.
+ */
+
+#if defined(__GNUC__) && !defined(__clang__) && !defined(__INTEL_COMPILER) \
+  && (__GNUC__ >= 6) && defined(__x86_64__) && defined(__linux__)
+#define SIMD_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define SIMD_CLONES
+#endif
+
+#define SIMD_BLOCK 16
+
+#endif
@@ -19,6 +19,8 @@
 #include <math.h>    // for sqrt
 #include <stdio.h>   // for fprintf, stderr
 #include <stdlib.h>  // for exit, EXIT_FAILURE
+#include "simd_clones.h"  // for SIMD_CLONES, SIMD_BLOCK
+#include "projection_blocks.h"  // for projection_on_cone_block, projec...
 
 unsigned projectionOnCone(double* r, double  mu)
 {
@@ -91,3 +93,88 @@ void projectionOnSecondOrderCone(double* r, double  mu, int size)
   }
 
 }
+
+/* copy n <= SIMD_BLOCK vectors of an array in AoS layout into a block,
+   the unused entries of the block are set to zero */
+static inline void aos_to_block(unsigned int n, const double* restrict r, const double* restrict mu,
+                                double* restrict r0, double* restrict r1, double* restrict r2,
+                                double* restrict m)
+{
+  for(unsigned int i = 0; i < n; i++)
+  {
+    r0[i] = r[3 * i];
+    r1[i] = r[3 * i + 1];
+    r2[i] = r[3 * i + 2];
+    m[i] = mu[i];
+  }
+  for(unsigned int i = n; i < SIMD_BLOCK; i++)
+  {
+    r0[i] = r1[i] = r2[i] = m[i] = 0.0;
+  }
+}
+
+static inline void block_to_aos(unsigned int n, const double* restrict r0, const double* restrict r1,
+                                const double* restrict r2, double* restrict r)
+{
+  for(unsigned int i = 0; i < n; i++)
+  {
+    r[3 * i] = r0[i];
+    r[3 * i + 1] = r1[i];
+    r[3 * i + 2] = r2[i];
+  }
+}
+
+SIMD_CLONES
+void projectionOnCone_soa(unsigned int nc, double* r0, double* r1, double* r2,
+                          const double* mu)
+{
+  unsigned int k = 0;
+  for(; k + SIMD_BLOCK <= nc; k += SIMD_BLOCK)
+    projection_on_cone_block(r0 + k, r1 + k, r2 + k, mu + k);
+  if(k < nc)
+  {
+    double t0[SIMD_BLOCK] = {0.0}, t1[SIMD_BLOCK] = {0.0}, t2[SIMD_BLOCK] = {0.0};
+    double m[SIMD_BLOCK] = {0.0};
+    unsigned int n = nc - k;
+    for(unsigned int i = 0; i < n; i++)
+    {
+      t0[i] = r0[k + i];
+      t1[i] = r1[k + i];
+      t2[i] = r2[k + i];
+      m[i] = mu[k + i];
+    }
+    projection_on_cone_block(t0, t1, t2, m);
+    for(unsigned int i = 0; i < n; i++)
+    {
+      r0[k + i] = t0[i];
+      r1[k + i] = t1[i];
+      r2[k + i] = t2[i];
+    }
+  }
+}
+
+SIMD_CLONES
+void projectionOnCone_batch(unsigned int nc, double* r, const double* mu)
+{
+  double r0[SIMD_BLOCK], r1[SIMD_BLOCK], r2[SIMD_BLOCK], m[SIMD_BLOCK];
+  for(unsigned int k = 0; k < nc; k += SIMD_BLOCK)
+  {
+    unsigned int n = nc - k < SIMD_BLOCK ? nc - k : SIMD_BLOCK;
+    aos_to_block(n, r + 3 * k, mu + k, r0, r1, r2, m);
+    projection_on_cone_block(r0, r1, r2, m);
+    block_to_aos(n, r0, r1, r2, r + 3 * k);
+  }
+}
+
+SIMD_CLONES
+void projectionOnDualCone_batch(unsigned int nc, double* u, const double* mu)
+{
+  double u0[SIMD_BLOCK], u1[SIMD_BLOCK], u2[SIMD_BLOCK], m[SIMD_BLOCK];
+  for(unsigned int k = 0; k < nc; k += SIMD_BLOCK)
+  {
+    unsigned int n = nc - k < SIMD_BLOCK ? nc - k : SIMD_BLOCK;
+    aos_to_block(n, u + 3 * k, mu + k, u0, u1, u2, m);
+    projection_on_dual_cone_block(u0, u1, u2, m);
+    block_to_aos(n, u0, u1, u2, u + 3 * k);
+  }
+}
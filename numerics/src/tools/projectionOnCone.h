@@ -53,6 +53,31 @@ extern "C"
   */
   void projectionOnSecondOrderCone(double* r, double  mu, int size);
 
+  /** projectionOnCone of nc vectors in SoA layout, computed by blocks with
+      vector instructions, same results as projectionOnCone
+      \param nc number of vectors
+      \param[in,out] r0 the normal components
+      \param[in,out] r1 the first tangent components
+      \param[in,out] r2 the second tangent components
+      \param[in] mu the angles of the cones
+  */
+  void projectionOnCone_soa(unsigned int nc, double* r0, double* r1, double* r2,
+                            const double* mu);
+
+  /** projectionOnCone of the nc vectors r[3i], r[3i+1], r[3i+2]
+      \param nc number of vectors
+      \param[in,out] r the vectors to be projected (3 nc)
+      \param[in] mu the angles of the cones
+  */
+  void projectionOnCone_batch(unsigned int nc, double* r, const double* mu);
+
+  /** projectionOnDualCone of the nc vectors u[3i], u[3i+1], u[3i+2]
+      \param nc number of vectors
+      \param[in,out] u the vectors to be projected (3 nc)
+      \param[in] mu the angles of the cones
+  */
+  void projectionOnDualCone_batch(unsigned int nc, double* u, const double* mu);
+
 #if defined(__cplusplus) && !defined(BUILD_AS_CPP)
 }
 #endif
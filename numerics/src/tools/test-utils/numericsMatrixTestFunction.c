@@ -523,6 +523,7 @@ int test_SBM_row_to_dense(SparseBlockStructuredMatrix *M)
 int test_SBM_row_permutation(SparseBlockStructuredMatrix *M)
 {
   SparseBlockStructuredMatrix MRes;
+  SBM_null(&MRes);
   unsigned int nbRow = M->blocknumber0;
   unsigned int * rowBlockIndex = (unsigned int*) malloc(nbRow * sizeof(unsigned int));
   unsigned int * mark = (unsigned int*) malloc(nbRow * sizeof(unsigned int));
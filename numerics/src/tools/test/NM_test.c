@@ -2275,6 +2275,30 @@ static int test_NM_iterated_power_method(void)
     info =1;
   if(info != 0) return info;
 
+  /* smallest eigenvalue, without and with the inverse of the matrix */
+  NumericsMatrix * AATcopy = NM_create(NM_DENSE, AAT->size0, AAT->size1);
+  NM_copy(AAT, AATcopy);
+  NumericsMatrix * AATinv = NM_LU_inv(AAT);
+  double eig_ref = 1.0/NM_iterated_power_method(AATinv, 1e-14, 100);
+  eig = NM_iterated_inverse_power_method(AAT, 1e-14, 100);
+  printf("smallest eigenvalue = %e (with the inverse: %e)\n", eig, eig_ref);
+  printf("End of inverse iterated power method...\n");
+  if(fabs(eig - eig_ref) > 1e-08 * fabs(eig_ref))
+    info =1;
+  /* the matrix is not modified */
+  if(!NM_equal(AAT, AATcopy))
+    info =1;
+  NM_clear(AATcopy);
+  free(AATcopy);
+  NM_clear(AATinv);
+  free(AATinv);
+  if(info != 0) return info;
+
+  eig = NM_iterated_inverse_power_method(BBT, 1e-14, 100);
+  printf("smallest eigenvalue = %e\n", eig);
+  if(fabs(eig - eig_ref) > 1e-08 * fabs(eig_ref))
+    info =1;
+  if(info != 0) return info;
 
   /* free memory */
 
@@ -2295,6 +2319,117 @@ static int test_NM_iterated_power_method(void)
   printf("========= End Numerics tests for NumericsMatrix ========= \n");
   return info;
 }
+/* Products with sparse matrices large enough to be shared between the
+ * threads: same results as the sequential CSparse products */
+static int test_NM_parallel_products(void)
+{
+  printf("========= Starts Numerics tests for NumericsMatrix parallel products ========= \n");
+  int info = 0;
+  int n = 3000, m = 2400, nz_col = 12;
+  NumericsMatrix * A = NM_create(NM_SPARSE, m, n);
+  NM_triplet_alloc(A, n * nz_col);
+  srand(1);
+  for(int j = 0; j < n; j++)
+    for(int k = 0; k < nz_col; k++)
+      NM_entry(A, rand() % m, j, (double)rand() / RAND_MAX - 0.5);
+  NumericsMatrix * B = NM_transpose(A);
+
+  double * x = (double *)malloc(n * sizeof(double));
+  double * y = (double *)malloc(n * sizeof(double));
+  double * yref = (double *)malloc(n * sizeof(double));
+  for(int i = 0; i < n; i++)
+  {
+    x[i] = (double)rand() / RAND_MAX;
+    y[i] = yref[i] = (double)rand() / RAND_MAX;
+  }
+
+  /* y = 2 A x + 0.5 y */
+  CSparseMatrix_aaxpby(2.0, NM_csc(A), x, 0.5, yref);
+  NM_gemv(2.0, A, x, 0.5, y);
+  for(int i = 0; i < m; i++)
+    if(fabs(y[i] - yref[i]) > 1e-12 * (1.0 + fabs(yref[i]))) info = 1;
+  printf("NM_gemv : info = %i\n", info);
+
+  /* y = 2 A^T x + 0.5 y */
+  for(int i = 0; i < n; i++) y[i] = yref[i] = (double)rand() / RAND_MAX;
+  CSparseMatrix_aaxpby(2.0, NM_csc(B), x, 0.5, yref);
+  NM_tgemv(2.0, A, x, 0.5, y);
+  for(int i = 0; i < n; i++)
+    if(fabs(y[i] - yref[i]) > 1e-12 * (1.0 + fabs(yref[i]))) info = 1;
+  printf("NM_tgemv : info = %i\n", info);
+
+  /* A B, with the same entries in the same (sorted) order */
+  CSparseMatrix * Cref = cs_multiply(NM_csc(A), NM_csc(B));
+  NSM_fix_csc(Cref);
+  NumericsMatrix * C = NM_multiply(A, B);
+  CSparseMatrix * Cc = NM_csc(C);
+  if(Cc->p[Cc->n] != Cref->p[Cref->n]) info = 1;
+  else
+    for(CS_INT k = 0; k < Cref->p[Cref->n]; k++)
+      if(Cc->i[k] != Cref->i[k] || Cc->x[k] != Cref->x[k]) info = 1;
+  printf("NM_multiply : info = %i\n", info);
+
+  cs_spfree(Cref);
+  NM_clear(A);
+  NM_clear(B);
+  NM_clear(C);
+  free(A);
+  free(B);
+  free(C);
+  free(x);
+  free(y);
+  free(yref);
+  printf("========= End Numerics tests for NumericsMatrix parallel products ========= \n");
+  return info;
+}
+
+static int test_NM_conversions_cache(void)
+{
+  printf("========= Starts Numerics tests for NumericsMatrix conversions cache ========= \n");
+  int info = 0;
+  NumericsMatrix * A = NM_create(NM_SPARSE, 4, 4);
+  NM_triplet_alloc(A, 0);
+  for(int i = 0; i < 4; i++)
+  {
+    NM_entry(A, i, i, 1.0 + i);
+    NM_entry(A, i, (i + 2) % 4, -1.0);
+  }
+
+  NM_conversions_reset();
+  CS_INT nnz = NM_csc(A)->p[4];
+  NM_csc(A);
+  NM_csc_trans(A);
+  NM_csc_trans(A);
+  if(NM_conversions_performed(NM_CONVERSION_CSC) != 1 ||
+     NM_conversions_cached(NM_CONVERSION_CSC) != 3 ||
+     NM_conversions_performed(NM_CONVERSION_CSC_TRANS) != 1 ||
+     NM_conversions_cached(NM_CONVERSION_CSC_TRANS) != 1) info = 1;
+  printf("cached conversions : info = %i\n", info);
+
+  /* a new entry in the triplet storage: csc and transpose are outdated */
+  NM_entry(A, 0, 1, 3.0);
+  if(NM_csc_trans(A)->p[4] != nnz + 1 ||
+     NM_conversions_performed(NM_CONVERSION_CSC) != 2 ||
+     NM_conversions_performed(NM_CONVERSION_CSC_TRANS) != 2) info = 1;
+  printf("conversions after NM_entry : info = %i\n", info);
+
+  /* in place modification of the csc storage: only the transpose is outdated */
+  NM_scal(2.0, A);
+  CSparseMatrix * At = NM_csc_trans(A);
+  for(CS_INT j = 0; j < 4; j++)
+    for(CS_INT p = At->p[j]; p < At->p[j + 1]; p++)
+      if(At->i[p] == j && At->x[p] != 2.0 * (1.0 + j)) info = 1;
+  if(NM_conversions_performed(NM_CONVERSION_CSC) != 2 ||
+     NM_conversions_performed(NM_CONVERSION_CSC_TRANS) != 3) info = 1;
+  printf("conversions after NM_scal : info = %i\n", info);
+
+  NM_conversions_display();
+  NM_clear(A);
+  free(A);
+  printf("========= End Numerics tests for NumericsMatrix conversions cache ========= \n");
+  return info;
+}
+
 static int test_NM_scal(void)
 {
 
@@ -3789,6 +3924,10 @@ int main(int argc, char *argv[])
 
   info +=    test_NM_scal();
 
+  info +=    test_NM_parallel_products();
+
+  info +=    test_NM_conversions_cache();
+
   info += test_NM_compute_balancing_matrices();
   info += test_NM_compute_balancing_matrices_sym();
   info += test_NM_compute_balancing_matrices_rectangle();
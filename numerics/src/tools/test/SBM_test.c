@@ -305,6 +305,135 @@ int SBM_extract_component_3x3_all(void)
 }
 
 
+static int SBM_pack_blocks_test(const char * filename)
+{
+  FILE *file = fopen(filename, "r");
+  SparseBlockStructuredMatrix * M = SBM_new_from_file(file);
+  fclose(file);
+
+  int n = M->blocksize0[M->blocknumber0 - 1];
+  int m = M->blocksize1[M->blocknumber1 - 1];
+  double * dense_ref = (double *)malloc(n * m * sizeof(double));
+  double * dense = (double *)malloc(n * m * sizeof(double));
+  double * x = (double *)malloc(m * sizeof(double));
+  double * y_ref = (double *)calloc(n, sizeof(double));
+  double * y = (double *)calloc(n, sizeof(double));
+  for(int i = 0; i < m; i++) x[i] = 1.0 + i;
+
+  SBM_to_dense(M, dense_ref);
+  SBM_gemv(m, n, 1.0, M, x, 0.0, y_ref);
+
+  int info = SBM_pack_blocks(M);
+  if(info || !M->arena)
+    return 1;
+
+  /* the arena is aligned and the blocks are contiguous in index order */
+  if(((size_t)M->arena) % 64)
+    return 1;
+  if(M->block[0] != M->arena)
+    return 1;
+  size_t offset = 0;
+  for(unsigned int row = 0; row + 1 < M->filled1; row++)
+  {
+    unsigned int nbRows = M->blocksize0[row] - (row ? M->blocksize0[row - 1] : 0);
+    for(size_t blockNum = M->index1_data[row]; blockNum < M->index1_data[row + 1]; blockNum++)
+    {
+      size_t col = M->index2_data[blockNum];
+      unsigned int nbColumns = M->blocksize1[col] - (col ? M->blocksize1[col - 1] : 0);
+      if(M->block[blockNum] != M->arena + offset)
+        return 1;
+      offset += nbRows * nbColumns;
+    }
+  }
+
+  SBM_to_dense(M, dense);
+  SBM_gemv(m, n, 1.0, M, x, 0.0, y);
+  for(int i = 0; i < n * m; i++)
+    if(dense[i] != dense_ref[i])
+      return 1;
+  for(int i = 0; i < n; i++)
+    if(y[i] != y_ref[i])
+      return 1;
+
+  /* packing twice is harmless */
+  info = SBM_pack_blocks(M);
+
+  /* copy of a packed matrix into a matrix with enough blocks */
+  SparseBlockStructuredMatrix * C = SBM_new();
+  SBM_copy(M, C, 1);
+  SBM_to_dense(C, dense);
+  for(int i = 0; i < n * m; i++)
+    if(dense[i] != dense_ref[i])
+      return 1;
+
+  info += SBM_pack_blocks(C);
+  SBM_to_dense(C, dense);
+  for(int i = 0; i < n * m; i++)
+    if(dense[i] != dense_ref[i])
+      return 1;
+
+  /* pointer links on the blocks of M, then packed by copy, as done by the
+     kernel in BlockCSRMatrix::convert() */
+  SparseBlockStructuredMatrix * D = SBM_new();
+  SBM_copy(M, D, 0);
+  info += SBM_pack_blocks_from(D, M->block);
+  if(D->block[0] == M->block[0])
+    return 1;
+  SBM_to_dense(D, dense);
+  for(int i = 0; i < n * m; i++)
+    if(dense[i] != dense_ref[i])
+      return 1;
+
+  /* a packed matrix turned into pointer links on the blocks of M: its
+     contiguous storage is released */
+  SparseBlockStructuredMatrix * E = SBM_new();
+  SBM_copy(M, E, 1);
+  info += SBM_pack_blocks(E);
+  SBM_copy(M, E, 0);
+  if(E->arena || E->block[0] != M->block[0])
+    return 1;
+  SBM_to_dense(E, dense);
+  for(int i = 0; i < n * m; i++)
+    if(dense[i] != dense_ref[i])
+      return 1;
+  SBMfree(E, 0);
+  free(E);
+
+  /* without NUMERICS_SBM_FREE_BLOCK, the blocks of a packed matrix are kept */
+  double * arena = D->arena;
+  SBMfree(D, 0);
+  if(D->arena != arena)
+    return 1;
+  for(size_t i = 0; i < offset; i++)
+    if(arena[i] != M->arena[i])
+      return 1;
+  SBM_arena_free(D);
+  free(D);
+
+  SBM_clear(C);
+  free(C);
+  SBM_clear(M);
+  free(M);
+  free(dense_ref);
+  free(dense);
+  free(x);
+  free(y_ref);
+  free(y);
+  return info;
+}
+
+int SBM_pack_blocks_all(void)
+{
+  printf("========= Starts SBM tests for SBM_pack_blocks ========= \n");
+  int info = SBM_pack_blocks_test("data/SBM1.dat");
+  info += SBM_pack_blocks_test("data/SBM2.dat");
+  if(info)
+    printf("========= Ends SBM tests for SBM_pack_blocks :  Unsuccessfull ========= \n");
+  else
+    printf("========= Ends SBM tests for SBM_pack_blocks :  successfull ========= \n");
+  return info;
+}
+
 /* ============================================================================================================================== */
 
 static void add_initial_value_square_1(NumericsMatrix * M)
@@ -1286,5 +1415,7 @@ int main()
 
   info += SBM_extract_component_3x3_all();
 
+  info += SBM_pack_blocks_all();
+
   return info;
 }
@@ -46,3 +46,5 @@ int test_SBM_column_permutation_all(void);
 int test_SBM_row_permutation_all(void);
 
 int SBM_extract_component_3x3_all(void);
+
+int SBM_pack_blocks_all(void);
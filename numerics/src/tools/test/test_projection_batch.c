@@ -0,0 +1,157 @@
+/* Siconos is a program dedicated to modeling, simulation and control
+ * of non smooth dynamical systems.
+ *
+ * Copyright 2022 INRIA.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+*/
+
+/* The batched cone projections and local errors give the same results as
+ * the functions for one contact, for all the cases of the projection and
+ * numbers of contacts that are not multiples of the block size. */
+
+#include <stdio.h>                 // for printf
+#include <stdlib.h>                // for malloc, free, rand, srand
+#include <string.h>                // for memcpy, memcmp
+#include "fc3d_compute_error.h"    // for fc3d_compute_and_add_error_batch
+#include "projectionOnCone.h"      // for projectionOnCone_batch, projecti...
+
+static double random_value(void)
+{
+  return 2.0 * (double)rand() / (double)RAND_MAX - 1.0;
+}
+
+/* random vectors, with some zero tangent or normal components and some
+ * zero coefficients of friction */
+static void random_contacts(unsigned int nc, double* r, double* mu)
+{
+  for(unsigned int i = 0; i < nc; i++)
+  {
+    for(int k = 0; k < 3; k++)
+      r[3 * i + k] = random_value();
+    switch(i % 7)
+    {
+    case 0:
+      r[3 * i + 1] = r[3 * i + 2] = 0.0;
+      break;
+    case 1:
+      r[3 * i] = 0.0;
+      break;
+    default:
+      break;
+    }
+    mu[i] = (i % 11 == 3) ? 0.0 : 0.1 + (double)(rand() % 10) / 10.0;
+  }
+}
+
+static int test_projections(unsigned int nc)
+{
+  int info = 0;
+  double* r = (double*)malloc(3 * nc * sizeof(double));
+  double* mu = (double*)malloc(nc * sizeof(double));
+  double* ref = (double*)malloc(3 * nc * sizeof(double));
+  double* r0 = (double*)malloc(nc * sizeof(double));
+  double* r1 = (double*)malloc(nc * sizeof(double));
+  double* r2 = (double*)malloc(nc * sizeof(double));
+
+  random_contacts(nc, r, mu);
+
+  memcpy(ref, r, 3 * nc * sizeof(double));
+  for(unsigned int i = 0; i < nc; i++)
+  {
+    projectionOnCone(&ref[3 * i], mu[i]);
+    r0[i] = r[3 * i];
+    r1[i] = r[3 * i + 1];
+    r2[i] = r[3 * i + 2];
+  }
+  projectionOnCone_soa(nc, r0, r1, r2, mu);
+  for(unsigned int i = 0; i < nc; i++)
+    if(r0[i] != ref[3 * i] || r1[i] != ref[3 * i + 1] || r2[i] != ref[3 * i + 2])
+    {
+      printf("projectionOnCone_soa, %u contacts: contact %u differs\n", nc, i);
+      info = 1;
+      break;
+    }
+
+  double* u = (double*)malloc(3 * nc * sizeof(double));
+  memcpy(u, r, 3 * nc * sizeof(double));
+  projectionOnCone_batch(nc, r, mu);
+  if(memcmp(r, ref, 3 * nc * sizeof(double)))
+  {
+    printf("projectionOnCone_batch, %u contacts: results differ\n", nc);
+    info = 1;
+  }
+
+  /* the dual cone is not defined for mu = 0 */
+  for(unsigned int i = 0; i < nc; i++)
+    if(mu[i] == 0.0) mu[i] = 0.5;
+  memcpy(ref, u, 3 * nc * sizeof(double));
+  for(unsigned int i = 0; i < nc; i++)
+    projectionOnDualCone(&ref[3 * i], mu[i]);
+  projectionOnDualCone_batch(nc, u, mu);
+  if(memcmp(u, ref, 3 * nc * sizeof(double)))
+  {
+    printf("projectionOnDualCone_batch, %u contacts: results differ\n", nc);
+    info = 1;
+  }
+
+  free(r);
+  free(mu);
+  free(ref);
+  free(r0);
+  free(r1);
+  free(r2);
+  free(u);
+  return info;
+}
+
+static int test_error(unsigned int nc)
+{
+  double* r = (double*)malloc(3 * nc * sizeof(double));
+  double* u = (double*)malloc(3 * nc * sizeof(double));
+  double* mu = (double*)malloc(nc * sizeof(double));
+  random_contacts(nc, r, mu);
+  random_contacts(nc, u, mu);
+  random_contacts(nc, r, mu);
+
+  double worktmp[3];
+  double error_ref = 1.0, error = 1.0;
+  for(unsigned int i = 0; i < nc; i++)
+    fc3d_unitary_compute_and_add_error(&r[3 * i], &u[3 * i], mu[i], &error_ref, worktmp);
+  fc3d_compute_and_add_error_batch(nc, r, u, mu, &error);
+
+  free(r);
+  free(u);
+  free(mu);
+  if(error != error_ref)
+  {
+    printf("fc3d_compute_and_add_error_batch, %u contacts: %.17g instead of %.17g\n",
+           nc, error, error_ref);
+    return 1;
+  }
+  return 0;
+}
+
+int main(void)
+{
+  int info = 0;
+  unsigned int sizes[] = {1, 7, 16, 17, 100, 1001};
+  srand(1);
+  for(unsigned int k = 0; k < sizeof(sizes) / sizeof(sizes[0]); k++)
+  {
+    info += test_projections(sizes[k]);
+    info += test_error(sizes[k]);
+  }
+  printf("End of test, info = %i\n", info);
+  return info;
+}
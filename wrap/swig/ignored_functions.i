@@ -16,6 +16,7 @@
 %ignore SimpleMatrix::SimpleMatrix(SiconosMatrix const &);
 %ignore SimpleMatrix::operator ()(unsigned int,unsigned int) const;
 %ignore SimpleMatrix::operator =(SiconosMatrix const &);
+%ignore SimpleMatrix::Solve(double*,unsigned int);
 %ignore SiconosVector::operator ()(unsigned int) const;
 %ignore SiconosVector::operator [](unsigned int) const;
 %ignore operator ==(SiconosVector const &,SiconosVector const &);